@@ -0,0 +1,15 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+// Function prototypes
+void batch_add_point(int x, int y, SDL_Color);
+void batch_add_rect(const SDL_Rect *, SDL_Color);
+void batch_destroy(void);
+void batch_flush(void);
+
+// External function prototypes
+void render_draw_points(const SDL_Point *points, int count);
+void render_fill_rects(const SDL_Rect *rects, int count);
+void render_set_draw_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,14 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+// Function prototypes
+void benchmark_begin_frame(void);
+bool benchmark_end_frame(void);
+void benchmark_end_stage(unsigned short stage);
+void benchmark_start(unsigned int num_frames, const char *path);
+bool benchmark_stop(void);
+
+// External function prototypes
+Uint32 compositor_hash(Uint32 hash, const void *data, size_t size);
+
+#endif
\ No newline at end of file
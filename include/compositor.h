@@ -0,0 +1,20 @@
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+// Function prototypes
+bool compositor_begin_layer(unsigned short index, Uint32 key);
+void compositor_destroy(void);
+void compositor_end_layer(unsigned short index);
+Uint32 compositor_hash(Uint32 hash, const void *data, size_t size);
+void compositor_invalidate(unsigned short index);
+
+// External function prototypes
+void render_clear(void);
+void render_copy(SDL_Texture *, const SDL_Rect *src, const SDL_Rect *dst);
+SDL_Texture *render_create_texture(Uint32 format, int access, int w, int h);
+void render_destroy_texture(SDL_Texture *);
+void render_set_draw_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+SDL_Texture *render_set_target(SDL_Texture *);
+bool render_set_texture_blend_mode(SDL_Texture *, SDL_BlendMode);
+
+#endif
\ No newline at end of file
@@ -15,6 +15,17 @@ void gfx_draw_diamond(SDL_Renderer *, int x, int y, int size, SDL_Color);
 void gfx_draw_fill_circle(SDL_Renderer *, int xc, int yc, int radius, SDL_Color);
 void gfx_draw_fill_diamond(SDL_Renderer *, int x, int y, int size, SDL_Color);
 double maths_distance_between_points(double x1, double y1, double x2, double y2);
+int path_find_nearest_segment(const WaypointPath *, Point, int first_segment);
+double path_get_progress(const WaypointPath *, int segment, Point position);
+double path_get_remaining_length(const WaypointPath *, int index);
+void render_draw_line(int x1, int y1, int x2, int y2);
+void render_fill_rect(const SDL_Rect *);
+void render_set_draw_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+unsigned short render_set_layer(unsigned short layer);
+float route_get_progress(void);
+bool route_is_planning(void);
+void text_draw_label(TextLabel *, int x, int y);
+TextLabel *text_get_label(const char *text, unsigned short font_size, SDL_Color);
 void utils_add_thousand_separators(int num, char *result, size_t result_size);
 void utils_convert_seconds_to_time_string(int seconds, char timeString[]);
 
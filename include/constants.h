@@ -18,6 +18,10 @@
 #define G_LAUNCH 0.7 * G_CONSTANT // Default: 0.7 * G_CONSTANT
 #define G_THRUST 1 * G_CONSTANT   // Default: 1 * G_CONSTANT
 
+// Floating origin
+#define ORIGIN_SECTION_SIZE 10000                  // Unit of the absolute origin. Default: 10000
+#define ORIGIN_REBASE_DISTANCE ORIGIN_SECTION_SIZE // Rebase local frame beyond this distance. Default: ORIGIN_SECTION_SIZE
+
 // Background stars
 #define BSTARS_SPEED_FACTOR 0.04                  // Default: 0.04
 #define BSTARS_MAX_OPACITY 140                    // Default: 140
@@ -30,6 +34,65 @@
 #define GSTARS_SCALE 10                           // Designates gstars scaling compared to universe mode. Default: 10
 #define SPEED_LINES_NUM 8                         // Number of rows and columns for the speeding lines array. Default: 8
 
+// Point batch
+#define BATCH_MAX_BUCKETS 1024     // Color buckets, must be a power of 2. Default: 1024
+#define BATCH_ALPHA_STEP 8         // Quantization step of bucket opacity. Default: 8
+#define BATCH_INITIAL_CAPACITY 256 // Initial points per bucket. Default: 256
+
+// Render commands
+#define RENDER_INITIAL_CAPACITY 1024 // Initial commands, points, rects and vertices per frame. Default: 1024
+#define RENDER_FRAMES 3              // Frames being recorded, waiting and being drawn. Default: 3
+
+// Simulation thread
+#define SIMULATION_THREAD 1       // Run the simulation off the main thread, except in replays. Default: 1
+#define SIMULATION_MAX_EVENTS 256 // Input events waiting for the simulation. Default: 256
+
+// Job system
+#define JOBS_MAX_WORKERS 16    // One less worker thread than the CPUs is started, up to this many. Default: 16
+#define JOBS_DEQUE_SIZE 256    // Parts of parallel fors a worker can hold, must be a power of 2. Default: 256
+#define JOBS_MAX_RANGES 64     // Parts a parallel for is split into, at most. Default: 64
+#define JOBS_QUEUE_SIZE 64     // Initial capacity of the heap of background jobs of a worker. Default: 64
+
+// Profiler
+#ifndef PROFILER_ON
+#define PROFILER_ON 1 // Scopes compile out with PROFILER_ON 0, as in make release. Default: 1
+#endif
+#define PROFILER_MAX_DEPTH 16     // Nested scopes per thread. Default: 16
+#define PROFILER_HISTORY 120      // Frames in the graph and the percentiles. Default: 120
+#define PROFILER_REFRESH 30       // Frames between updates of the percentiles. Default: 30
+#define PROFILER_GRAPH_HEIGHT 120 // Height of two frame budgets, in pixels. Default: 120
+#if PROFILER_ON
+#define PROFILER_BEGIN(scope) profiler_begin_scope(scope)
+#define PROFILER_END(scope) profiler_end_scope(scope)
+#else
+#define PROFILER_BEGIN(scope)
+#define PROFILER_END(scope)
+#endif
+#if PROFILER_ON
+#define COUNTERS_ADD(counter, amount) counters_add(counter, amount)
+#else
+#define COUNTERS_ADD(counter, amount)
+#endif
+
+// Trace
+#define TRACE_FRAMES 300        // Frames in a capture started with T. Default: 300
+#define TRACE_MAX_EVENTS 262144 // Events in a capture; Later events are dropped. Default: 262144
+#define TRACE_MAX_THREADS 32    // Threads named in a trace. Default: 32
+
+// Circles
+#define CIRCLE_TABLE_SIZE 4096 // Points in the unit circle table, must be a power of 2. Default: 4096
+#define CIRCLE_MIN_SEGMENTS 16 // Default: 16
+#define CIRCLE_TOLERANCE 0.25  // Max distance in pixels between a circle and its segments. Default: 0.25
+#define DISC_TEXTURE_LEVELS 9  // Disc sprites with radius 1 to 2^(levels - 1) pixels. Default: 9
+
+// Text
+#define TEXT_FIRST_GLYPH 32                                     // First character in glyph atlases. Default: 32 (space)
+#define TEXT_LAST_GLYPH 255                                     // Last character in glyph atlases (Latin-1). Default: 255
+#define TEXT_GLYPH_COUNT (TEXT_LAST_GLYPH - TEXT_FIRST_GLYPH + 1) // Default: (TEXT_LAST_GLYPH - TEXT_FIRST_GLYPH + 1)
+#define TEXT_ATLAS_COLUMNS 16                                   // Default: 16
+#define TEXT_MAX_LENGTH 128                                     // Max characters in a label, including terminator. Default: 128
+#define TEXT_CACHE_SIZE 128                                     // Labels kept laid out between frames. Default: 128
+
 // Game settings
 #define BSTARS_ON 1      // Default: 1
 #define SPEED_LINES_ON 1 // Default: 1
@@ -70,7 +133,6 @@
 #define ZOOM_MAP_STEP_SWITCH 0.01            // Default: 0.01
 #define ZOOM_MAP_SWITCH 0.002                // Default: 0.002
 #define ZOOM_MAP_MIN ZOOM_MAP_SWITCH - 0.001 // Default: ZOOM_MAP_SWITCH - 0.001
-#define ZOOM_UNIVERSE_STAR_SYSTEMS 0.0005    // Default: 0.0005
 #define ZOOM_UNIVERSE 0.01                   // Universe scale. Default: 0.01
 #define ZOOM_UNIVERSE_MIN 0.01               // Universe scale. Default: 0.01
 #define ZOOM_UNIVERSE_STEP 0.001             // Default: 0.001
@@ -89,6 +151,8 @@
 #define UNIVERSE_SECTION_SIZE 10000 // Default: 10000
 #define UNIVERSE_X_LIMIT 200000000  // Default: 200000000
 #define UNIVERSE_Y_LIMIT 200000000  // Default: 200000000
+#define GALAXIES_TILE_COLUMNS 4     // Columns of sections generated together by a thread. Default: 4
+#define GALAXIES_BENCHMARK_SEED 1   // Default: 1
 
 // Galaxy
 #define GALAXY_REGION_SIZE 30      // Sections per axis. Even number; Default: 30
@@ -98,6 +162,15 @@
                                    // We use this in the modulo operations of the hash function output
 #define GALAXY_SECTION_SIZE 100000 // Default: 100000
 
+// Region prefetch
+#define STARS_PREFETCH_SHIFTS 2     // Region shifts predicted from the velocity of the ship. Default: 2
+#define STARS_PREFETCH_LOOKAHEAD 60 // Seconds ahead that shifts are predicted. Default: 60
+#define STARS_BENCHMARK_SEED 1      // Default: 1
+#define STARS_BENCHMARK_SHIFTS 16   // Region shifts of each flight of the prefetch benchmark. Default: 16
+
+// Star system population
+#define STARS_POPULATE_BUDGET 8 // Visible star systems populated in the background at a time. Default: 8
+
 // Starting position
 #define UNIVERSE_START_X -140000
 #define UNIVERSE_START_Y -70000 // Class 1: -140000, -70000
@@ -125,6 +198,13 @@
 #define GALAXY_6_RADIUS_MIN 25000 // Default: 25000
 #define GALAXY_6_RADIUS_MAX 3000  // Default: 3000 (+ 25000 = 28000) (max 30000)
 
+// Galaxy clouds
+#define GALAXY_CLOUD_LEVELS 4      // Pre-rendered cloud textures per galaxy. Default: 4
+#define GALAXY_CLOUD_MIN_SIZE 128  // Size of the smallest cloud texture in pixels. Default: 128
+#define GALAXY_CLOUD_CACHE_SIZE 32 // Galaxies with pre-rendered clouds; Further visible galaxies are drawn star by star. Default: 32
+#define GALAXY_CLOUD_JOBS 4        // Galaxy clouds generated in the background at a time. Default: 4
+#define GALAXY_CLOUD_JOB_BATCHES 8 // Batches of gstars generated by a background job before they are drawn. Default: 8
+
 // Stars
 #define STAR_1_RADIUS_MIN 120 // Default: 120
 #define STAR_1_RADIUS_MAX 100 // Default: 100
@@ -139,6 +219,11 @@
 #define STAR_6_RADIUS_MIN 860 // Default: 860
 #define STAR_6_RADIUS_MAX 200 // Default: 200
 
+// Star system level of detail, by projected radius in pixels
+#define STAR_LOD_DISC_RADIUS 1     // Body radius to draw a disc instead of a point. Default: 1
+#define STAR_LOD_ORBITS_RADIUS 25  // Cutoff radius to populate the system and draw planets and orbits. Default: 25
+#define STAR_LOD_SYSTEM_RADIUS 200 // Cutoff radius to draw moons and their orbits. Default: 200
+
 // Planets
 #define MAX_PLANETS 12 // Default: 10
 
@@ -212,4 +297,35 @@
 #define WAYPOINT_LINE_WIDTH 300
 #define WAYPOINT_ORBIT_RADII 3
 
+// Replay
+#define REPLAY_MAGIC "GRVR"         // File signature
+#define REPLAY_VERSION 1            // Increase when the file format changes
+#define REPLAY_MAX_FRAME_EVENTS 256 // Default: 256
+
+// Route planner
+#define ROUTE_OBSTACLE_VERTICES 12     // Vertices of the polygon around a star cutoff. Default: 12
+#define ROUTE_CLEARANCE 1.02           // Distance of polygon edges from the star, in cutoffs. Default: 1.02
+#define ROUTE_SECTION_MARGIN 4         // Sections around a segment that can hold a star reaching it. Default: 4
+#define ROUTE_MAX_DETOUR_DEPTH 3       // Nested obstacles to go around when a detour is blocked. Default: 3
+#define ROUTE_HEURISTIC_WEIGHT 1.05    // Paths are at most this much longer than the shortest one. Default: 1.05
+#define ROUTE_MAX_EXPANSIONS 50000     // Planning time budget, in nodes. Default: 50000
+#define ROUTE_MAX_SECTIONS 4194304     // Memory budget, in sections. Default: 4194304
+#define ROUTE_SMOOTHING_LOOKAHEAD 8    // Points to look ahead when shortening a path. Default: 8
+#define ROUTE_JOB_STEP 64              // Nodes expanded between checks for cancellation. Default: 64
+#define ROUTE_JOB_PUBLISH_INTERVAL 100 // Milliseconds between partial paths. Default: 100
+#define ROUTE_CACHE_SIZE 16            // Routes kept for repeated requests. Default: 16
+#define ROUTE_BENCHMARK_SEED 1         // Default: 1
+
+// Itinerary planner
+#define ITINERARY_MAX_HOP 16           // Sections between the centers of consecutive galaxies. Default: 16
+#define ITINERARY_INTERIOR_WEIGHT 2.0  // Cost of travel inside galaxies relative to gaps; UNIVERSE_SPEED_LIMIT / GALAXY_SPEED_LIMIT. Default: 2.0
+#define ITINERARY_MAX_GALAXIES 16384   // Memory and time budget, in galaxies. Default: 16384
+#define ITINERARY_HEURISTIC_WEIGHT 1.5 // Itineraries cost at most this factor more than the cheapest. Default: 1.5
+#define ITINERARY_EXIT_MARGIN 4        // Galaxy sections between the edge of a galaxy and the ends of its leg. Default: 4
+
+// Benchmark
+#define BENCHMARK_FRAMES 600          // Frames to run if not specified. Default: 600
+#define OFFSCREEN_DISPLAY_WIDTH 1920  // Framebuffer size if not set by a scenario. Default: 1920
+#define OFFSCREEN_DISPLAY_HEIGHT 1080 // Default: 1080
+
 #endif /* CONSTANTS_H */
@@ -6,10 +6,21 @@ void controls_create_table(GameState *, const Camera *);
 void controls_run_state(GameState *, InputState *, bool is_game_started, const NavigationState *, Bstar *bstars, Gstar *menustars, const Camera *);
 
 // External function prototypes
+bool compositor_begin_layer(unsigned short index, Uint32 key);
+void compositor_end_layer(unsigned short index);
+Uint32 compositor_hash(Uint32 hash, const void *data, size_t size);
+void compositor_invalidate(unsigned short index);
 void gfx_draw_menu_galaxy_cloud(const Camera *, Gstar *menustars);
 void gfx_draw_speed_lines(float velocity, const Camera *, Speed);
 void gfx_update_bstars_position(int state, bool camera_on, const NavigationState *, Bstar *bstars, const Camera *, Speed, double distance);
 void menu_draw_menu(GameState *, InputState *, bool is_game_started);
+void render_copy(SDL_Texture *, const SDL_Rect *src, const SDL_Rect *dst);
+void render_draw_line(int x1, int y1, int x2, int y2);
+void render_fill_rect(const SDL_Rect *);
+void render_set_draw_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+unsigned short render_set_layer(unsigned short layer);
 void sdl_set_cursor(InputState *, unsigned short cursor_type);
+void text_draw_label(TextLabel *, int x, int y);
+TextLabel *text_get_label(const char *text, unsigned short font_size, SDL_Color);
 
 #endif
\ No newline at end of file
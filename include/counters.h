@@ -0,0 +1,18 @@
+#ifndef COUNTERS_H
+#define COUNTERS_H
+
+// Function prototypes
+void counters_add(unsigned short counter, int amount);
+void counters_draw(const NavigationState *, const Camera *);
+void counters_end_frame(void);
+bool counters_write(const char *path, const NavigationState *);
+
+// External function prototypes
+void render_fill_rect(const SDL_Rect *);
+RenderStats render_get_stats(void);
+void render_set_draw_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+unsigned short render_set_layer(unsigned short layer);
+void text_draw_label(TextLabel *, int x, int y);
+TextLabel *text_get_label(const char *text, unsigned short font_size, SDL_Color);
+
+#endif
\ No newline at end of file
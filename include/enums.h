@@ -151,10 +151,159 @@ enum
     STAR_INFO_COUNT
 };
 
+enum
+{
+    REPLAY_OFF,
+    REPLAY_RECORD,
+    REPLAY_PLAY
+};
+
+// Levels of detail of a star system in Map and Universe, from least to most detailed
+enum
+{
+    STAR_LOD_POINT,  // Star as a point
+    STAR_LOD_DISC,   // Star as a disc
+    STAR_LOD_ORBITS, // Star, planets and their orbits
+    STAR_LOD_SYSTEM  // Star, planets, moons and their orbits
+};
+
+// Rendering backends
+enum
+{
+    BACKEND_WINDOW,
+    BACKEND_HIDDEN,   // Hidden window without vsync, for replays
+    BACKEND_OFFSCREEN // Software rendering into a surface, without a window
+};
+
+// Benchmark stages of a frame
+enum
+{
+    BENCHMARK_STAGE_EVENTS,
+    BENCHMARK_STAGE_UPDATE, // Update the game state and record draw commands
+    BENCHMARK_STAGE_RENDER, // Submit draw commands
+    BENCHMARK_STAGE_COUNT
+};
+
+enum
+{
+    RENDER_POINTS,
+    RENDER_LINES,
+    RENDER_RECTS,
+    RENDER_FILL_RECTS,
+    RENDER_COPY,
+    RENDER_GEOMETRY,
+    RENDER_CLEAR
+};
+
+// Renderer calls made on the render thread
+enum
+{
+    RENDER_REQUEST_CREATE_TEXTURE,
+    RENDER_REQUEST_CREATE_TEXTURE_FROM_SURFACE,
+    RENDER_REQUEST_SET_BLEND_MODE,
+    RENDER_REQUEST_SET_SCALE_MODE
+};
+
+// Tags of background jobs, cancelled together when the player moves away
+enum
+{
+    JOB_TAG_NONE = 0,
+    JOB_TAG_ROUTE = 1,  // Route planning
+    JOB_TAG_REGION = 2,  // Work around the ship, in the current galaxy
+    JOB_TAG_GALAXY = 4,  // Work for the current galaxy
+    JOB_TAG_UNIVERSE = 8 // Work for the galaxies in view
+};
+
+// Engine counters, in the order they are listed in the counters overlay
+enum
+{
+    COUNTER_SEEDS_BSTARS,
+    COUNTER_SEEDS_GSTARS,
+    COUNTER_SEEDS_GALAXY_SECTIONS,
+    COUNTER_SEEDS_GALAXIES,
+    COUNTER_SEEDS_STAR_SECTIONS,
+    COUNTER_SEEDS_STARS,
+    COUNTER_SEEDS_STAR_SYSTEMS,
+    COUNTER_STARS_CREATED,
+    COUNTER_STARS_EVICTED,
+    COUNTER_GALAXIES_CREATED,
+    COUNTER_GALAXIES_EVICTED,
+    COUNTER_STAR_COPY_BYTES,
+    COUNTER_GALAXY_COPY_BYTES,
+    COUNTER_POPULATE_CALLS,
+    COUNTER_TEXT_TEXTURES,
+    COUNTER_DRAW_CALLS,
+    COUNTER_COUNT
+};
+
+// Scopes of the frame profiler, in the order they are stacked in the graph
+enum
+{
+    PROFILER_SCOPE_EVENTS,
+    PROFILER_SCOPE_UPDATE,   // Game state, without the scopes below
+    PROFILER_SCOPE_STARS,    // Star generation
+    PROFILER_SCOPE_GALAXIES, // Galaxy generation
+    PROFILER_SCOPE_GSTARS,   // Galaxy clouds
+    PROFILER_SCOPE_BSTARS,   // Background stars
+    PROFILER_SCOPE_PHYSICS,
+    PROFILER_SCOPE_DRAW_STARS, // Star systems
+    PROFILER_SCOPE_DRAW_GALAXIES,
+    PROFILER_SCOPE_DRAW_SHIP, // Ship and waypoint path
+    PROFILER_SCOPE_CONSOLE,   // Console text, FPS and profiler
+    PROFILER_SCOPE_RENDER,    // Submit draw commands
+    PROFILER_SCOPE_PRESENT,
+    PROFILER_SCOPE_COUNT
+};
+
+// Layers are drawn in this order
+enum
+{
+    RENDER_LAYER_BACKGROUND, // Order-independent; Sorted by state
+    RENDER_LAYER_WORLD,
+    RENDER_LAYER_UI
+};
+
+// Layers cached by the compositor
+enum
+{
+    COMPOSITOR_MENU,
+    COMPOSITOR_CONTROLS_TABLE,
+    COMPOSITOR_LAYER_COUNT
+};
+
 enum
 {
     PATH_POINT_STRAIGHT,
     PATH_POINT_TURN
 };
 
+// Fixed nodes of the route planner, followed by the vertices around stars
+enum
+{
+    ROUTE_NODE_START,
+    ROUTE_NODE_DESTINATION,
+    ROUTE_NODE_VERTICES
+};
+
+// Results of route_find_blocker() other than the obstacle index of a star
+enum
+{
+    ROUTE_BLOCKER_ERROR = -2, // Memory for sections or obstacles could not be allocated
+    ROUTE_BLOCKER_NONE        // The segment is clear
+};
+
+enum
+{
+    ROUTE_SEARCH_RUNNING,
+    ROUTE_SEARCH_FOUND,
+    ROUTE_SEARCH_FAILED
+};
+
+enum
+{
+    ITINERARY_LEG_NONE,    // The waypoint is in the current galaxy
+    ITINERARY_LEG_FOUND,
+    ITINERARY_LEG_PLANNING // The itinerary is being planned in the background
+};
+
 #endif /* ENUMS_H */
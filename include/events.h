@@ -2,14 +2,22 @@
 #define EVENTS_H
 
 // Function prototypes
-void events_loop(GameState *, InputState *, GameEvents *, NavigationState *, const Camera *);
+void events_loop(GameState *, InputState *, GameEvents *, NavigationState *, const Camera *, int (*poll_event)(SDL_Event *));
 void events_set_cursor(GameState *, InputState *);
 
 // External function prototypes
 void game_change_state(GameState *, GameEvents *, int new_state);
 long double game_zoom_generate_preview_stars(unsigned short galaxy_class);
+bool maths_points_equal(Point, Point);
 bool menu_is_hovering_menu(GameState *game_state, InputState *input_state);
+void path_destroy(WaypointPath *);
+SDL_Cursor *render_set_cursor(SDL_Cursor *);
+void replay_get_mouse_state(int *x, int *y);
+Uint32 replay_get_ticks(void);
+void route_cancel_job(void);
 void stars_cleanup_planets(CelestialBody *);
+void stars_copy_star(Star *destination, const Star *source);
 void stars_initialize_star(Star *);
+bool trace_start(const char *file_path, int first_frame, int frames);
 
 #endif
\ No newline at end of file
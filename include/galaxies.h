@@ -2,20 +2,38 @@
 #define GALAXIES_H
 
 // Function prototypes
+void galaxies_benchmark(int runs);
+void galaxies_clear_gstars_jobs(void);
 void galaxies_clear_table(GalaxyEntry *galaxies[]);
+void galaxies_copy_galaxy(Galaxy *destination, const Galaxy *source);
 void galaxies_draw_galaxy(const InputState *, NavigationState *, Galaxy *, const Camera *, int state, long double scale);
 void galaxies_draw_info_box(const Galaxy *, const Camera *);
 void galaxies_generate(GameEvents *, NavigationState *, Point);
+void galaxies_generate_gstars(const InputState *, NavigationState *, const Ship *, const Camera *, long double scale);
 Galaxy *galaxies_get_entry(GalaxyEntry *galaxies[], Point);
+float galaxies_get_radius(Point, unsigned short *class);
 Galaxy *galaxies_nearest_circumference(const NavigationState *, Point, int exclude);
+bool galaxies_section_has_galaxy(Point);
+void galaxies_set_async(bool async);
 
 // External function prototypes
+void counters_add(unsigned short counter, int amount);
 void gfx_draw_circle(SDL_Renderer *, const Camera *, int xc, int yc, int radius, SDL_Color);
-void gfx_draw_circle_approximation(SDL_Renderer *, const Camera *, int x, int y, int r, SDL_Color);
 void gfx_draw_galaxy_cloud(Galaxy *, const Camera *, int gstars_count, bool high_definition, long double scale);
 void gfx_generate_gstars(Galaxy *, bool high_definition);
 bool gfx_is_object_in_camera(const Camera *, double x, double y, float radius, long double scale);
 void gfx_project_galaxy_on_edge(int state, const NavigationState *, Galaxy *, const Camera *, long double scale);
+void jobs_cancel(unsigned short tags);
+void jobs_cancel_handle(JobHandle *);
+void jobs_finish_handle(JobHandle *);
+int jobs_get_num_workers(void);
+float jobs_get_priority(Point position, Point camera_position, Point ship_position);
+void jobs_init_handle(JobHandle *);
+bool jobs_is_handle_cancelled(JobHandle *);
+bool jobs_is_handle_done(JobHandle *);
+void jobs_parallel_for(int count, int grain, void (*function)(void *data, int start, int end), void *data);
+bool jobs_release_handle(JobHandle *);
+void jobs_submit(void (*function)(void *data), void *data, unsigned short tag, float priority);
 bool maths_check_point_in_array(Point, Point arr[], int len);
 double maths_distance_between_points(double x1, double y1, double x2, double y2);
 double maths_get_nearest_section_line(double offset, int size);
@@ -24,7 +42,16 @@ uint64_t maths_hash_position_to_index(Point, int modulo, int entity_type);
 uint64_t maths_hash_position_to_uint64(Point);
 uint64_t maths_hash_position_to_uint64_2(Point);
 bool maths_points_equal(Point, Point);
+void render_fill_rect(const SDL_Rect *);
+void render_set_draw_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+unsigned short render_set_layer(unsigned short layer);
+void stars_clear_populations(void);
 void stars_clear_table(StarEntry *stars[], const NavigationState *, bool delete_all);
+void text_draw_label(TextLabel *, int x, int y);
+TextLabel *text_get_label(const char *text, unsigned short font_size, SDL_Color);
+void trace_add_instant(const char *name);
+void trace_add_span(const char *name, Uint64 start, Uint64 end);
+void trace_count_allocation(size_t size);
 void utils_add_thousand_separators(int num, char *result, size_t result_size);
 
 #endif
\ No newline at end of file
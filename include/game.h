@@ -15,15 +15,18 @@ void console_draw_position_console(const GameState *, const NavigationState *, c
 void console_draw_ship_console(const GameState *, const InputState *, const NavigationState *, const Ship *, const Camera *);
 void console_draw_star_console(const Star *, const Camera *);
 void console_draw_waypoint_console(const NavigationState *, const Ship *, const Camera *);
+void counters_add(unsigned short counter, int amount);
 void galaxies_clear_table(GalaxyEntry *galaxies[]);
+void galaxies_copy_galaxy(Galaxy *destination, const Galaxy *source);
 void galaxies_draw_galaxy(const InputState *, NavigationState *, Galaxy *, const Camera *, int state, long double scale);
 void galaxies_draw_info_box(const Galaxy *, const Camera *);
 void galaxies_generate(GameEvents *, NavigationState *, Point);
+void galaxies_generate_gstars(const InputState *, NavigationState *, const Ship *, const Camera *, long double scale);
 Galaxy *galaxies_get_entry(GalaxyEntry *galaxies[], Point);
 Galaxy *galaxies_nearest_circumference(const NavigationState *, Point, int exclude);
 void gfx_calculate_waypoint_path(NavigationState *);
 void gfx_draw_circle(SDL_Renderer *, const Camera *, int xc, int yc, int radius, SDL_Color);
-void gfx_draw_circle_approximation(SDL_Renderer *, const Camera *, int x, int y, int r, SDL_Color color);
+void gfx_draw_fill_circle(SDL_Renderer *, int xc, int yc, int radius, SDL_Color);
 void gfx_draw_screen_frame(Camera *);
 void gfx_draw_section_lines(Camera *, int state, SDL_Color color, long double scale);
 void gfx_draw_speed_arc(const Ship *, const Camera *, long double scale);
@@ -40,6 +43,8 @@ bool gfx_toggle_star_info_hover(InputState *, const NavigationState *, const Cam
 void gfx_update_bstars_position(int state, bool camera_on, const NavigationState *, Bstar *bstars, const Camera *, Speed speed, double distance);
 void gfx_update_camera(Camera *, Point, long double scale);
 void gfx_update_gstars_position(Galaxy *, Point, const Camera *, double distance, double limit);
+void itinerary_clear(void);
+void jobs_cancel(unsigned short tags);
 double maths_distance_between_points(double x1, double y1, double x2, double y2);
 double maths_get_nearest_section_line(double offset, int size);
 uint64_t maths_hash_position_to_uint64(Point);
@@ -47,18 +52,39 @@ bool maths_is_point_in_circle(Point, Point, double radius);
 bool maths_is_point_on_line(Point, Point, Point);
 bool maths_points_equal(Point, Point);
 void menu_update_menu_entries(GameState *, GameEvents *);
+Point origin_get_absolute_position(const Origin *, LocalPoint);
+LocalPoint origin_get_local_position(const Origin *, Point);
+bool origin_rebase(Origin *, LocalPoint *);
+void origin_reset(Origin *, Point);
+void origin_sync_ship(Origin *, Ship *);
+void path_destroy(WaypointPath *);
+int path_find_nearest_segment(const WaypointPath *, Point, int first_segment);
 void phys_calculate_orbital_velocity(float distance, float angle, float radius, float *vx, float *vy);
 void phys_update_velocity(Vector *velocity, const Ship *);
+void profiler_begin_scope(unsigned short scope);
+void profiler_end_scope(unsigned short scope);
+void render_copy_ex(SDL_Texture *, const SDL_Rect *src, const SDL_Rect *dst, double angle, const SDL_Point *center, SDL_RendererFlip);
+void render_draw_line(int x1, int y1, int x2, int y2);
+void render_draw_point(int x, int y);
+void render_set_draw_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+void route_cancel_job(void);
+void route_clear_cache(void);
+bool route_is_planning(void);
 void stars_clear_table(StarEntry *stars[], const NavigationState *, bool delete_all);
+void stars_copy_star(Star *destination, const Star *source);
 void stars_delete_outside_region(StarEntry *stars[], const NavigationState *, double bx, double by, int region_size);
 void stars_draw_info_box(NavigationState *, const Star *, const Camera *);
 void stars_draw_planets_info_box(InputState *, NavigationState *, Star *, const Camera *);
-void stars_draw_star_system(GameState *, const InputState *, NavigationState *, CelestialBody *, const Camera *);
-void stars_draw_universe_star_system(GameState *, const InputState *, NavigationState *, CelestialBody *, const Camera *);
+void stars_draw_star_system(GameState *, const InputState *, NavigationState *, CelestialBody *, unsigned short lod, const Camera *);
+void stars_draw_universe_star_system(GameState *, const InputState *, NavigationState *, CelestialBody *, unsigned short lod, const Camera *);
 void stars_generate(GameState *, GameEvents *, NavigationState *, Bstar *bstars, Ship *);
 void stars_generate_preview(GameEvents *, NavigationState *, const Camera *, long double scale);
+unsigned short stars_get_lod(const Star *, long double scale);
 void stars_initialize_star(Star *);
 void stars_populate_body(CelestialBody *, Point, pcg32_random_t rng, long double scale);
+void stars_populate_visible(const InputState *, NavigationState *, const Camera *, int state, long double scale);
+void stars_prefetch_regions(const NavigationState *, const Ship *);
 void stars_update_orbital_positions(GameState *, const InputState *, NavigationState *, CelestialBody *, Ship *, const Camera *, unsigned short star_class);
+void trace_add_instant(const char *name);
 
 #endif
\ No newline at end of file
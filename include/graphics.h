@@ -4,9 +4,11 @@
 // Function prototypes
 void gfx_calculate_waypoint_path(NavigationState *);
 void gfx_create_default_colors(void);
+void gfx_destroy_bstars_textures(void);
+void gfx_destroy_disc_textures(void);
+void gfx_destroy_galaxy_clouds(void);
 void gfx_draw_button(char *text, unsigned short font_size, SDL_Rect, SDL_Color, SDL_Color);
 void gfx_draw_circle(SDL_Renderer *, const Camera *, int xc, int yc, int radius, SDL_Color);
-void gfx_draw_circle_approximation(SDL_Renderer *, const Camera *, int x, int y, int r, SDL_Color);
 void gfx_draw_diamond(SDL_Renderer *, int x, int y, int size, SDL_Color);
 void gfx_draw_galaxy_cloud(Galaxy *, const Camera *, int gstars_count, bool high_definition, long double scale);
 void gfx_draw_fill_circle(SDL_Renderer *, int xc, int yc, int radius, SDL_Color);
@@ -35,6 +37,11 @@ void gfx_update_camera(Camera *, Point, long double scale);
 void gfx_update_gstars_position(Galaxy *, Point, const Camera *, double distance, double limit);
 
 // External function prototypes
+void batch_add_point(int x, int y, SDL_Color);
+void batch_add_rect(const SDL_Rect *, SDL_Color);
+void batch_flush(void);
+void counters_add(unsigned short counter, int amount);
+unsigned short itinerary_get_leg(const NavigationState *, Point *exit, Point *entry);
 void maths_closest_point_outside_circle(double cx, double cy, double radius, double radius_ratio, double px, double py, double *x, double *y, double degrees);
 double maths_distance_between_points(double x1, double y1, double x2, double y2);
 double maths_get_nearest_section_line(double offset, int size);
@@ -43,14 +50,39 @@ uint64_t maths_hash_position_to_uint64(Point);
 uint64_t maths_hash_position_to_uint64_2(Point);
 bool maths_is_point_in_circle(Point, Point, double radius);
 bool maths_is_point_in_rectangle(Point, Point rect[]);
-void maths_move_point_along_line(double x1, double y1, double x2, double y2, double step, double *x, double *y);
 bool maths_line_intersects_camera(const Camera *, double x1, double y1, double x2, double y2);
 bool maths_line_intersects_circle(double x1, double y1, double x2, double y2, double cx, double cy, double radius);
 bool maths_points_equal(Point, Point);
+bool path_add_point(WaypointPath *, unsigned short type, Point position);
+WaypointPath *path_create(int max_points);
+void path_destroy(WaypointPath *);
+bool path_get_visible_range(const WaypointPath *, Point min, Point max, int *first, int *last);
+void path_set_point(WaypointPath *, int index, Point position);
+void render_clear(void);
+void render_copy(SDL_Texture *, const SDL_Rect *src, const SDL_Rect *dst);
+void render_copy_ex(SDL_Texture *, const SDL_Rect *src, const SDL_Rect *dst, double angle, const SDL_Point *center, SDL_RendererFlip);
+void render_copy_modulated(SDL_Texture *, const SDL_Rect *src, const SDL_Rect *dst, SDL_Color mod);
+SDL_Texture *render_create_texture(Uint32 format, int access, int w, int h);
+SDL_Texture *render_create_texture_from_surface(SDL_Surface *);
+void render_destroy_texture(SDL_Texture *);
+void render_draw_line(int x1, int y1, int x2, int y2);
+void render_draw_lines(const SDL_Point *points, int count);
+void render_fill_rect(const SDL_Rect *);
+void render_geometry(SDL_Texture *, const SDL_Vertex *vertices, int num_vertices, const int *indices, int num_indices);
+void render_set_blend_mode(SDL_BlendMode);
+void render_set_draw_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+unsigned short render_set_layer(unsigned short layer);
+SDL_Texture *render_set_target(SDL_Texture *);
+bool render_set_texture_blend_mode(SDL_Texture *, SDL_BlendMode);
+void render_set_texture_scale_mode(SDL_Texture *, SDL_ScaleMode);
+bool route_is_planning(void);
+bool route_poll_job(PathPoint **path, int *num_points);
+void route_start_job(const NavigationState *, Point origin, Point start, Point destination, Point star_position, int planet_index);
 void stars_initialize_star(Star *);
 double stars_nearest_star_distance(Point, Galaxy *, uint64_t initseq, int galaxy_density);
 Star *stars_nearest_star_in_nav_state(const NavigationState *, Point, bool exclude);
-int stars_nearest_stars_to_point(const NavigationState *, Point, Star *stars[]);
 unsigned short stars_size_class(float distance);
+void text_draw_label(TextLabel *, int x, int y);
+TextLabel *text_get_label(const char *text, unsigned short font_size, SDL_Color);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,20 @@
+#ifndef ITINERARY_H
+#define ITINERARY_H
+
+// Function prototypes
+void itinerary_benchmark(const NavigationState *, int runs);
+void itinerary_clear(void);
+unsigned short itinerary_get_leg(const NavigationState *, Point *exit, Point *entry);
+void itinerary_set_async(bool async);
+
+// External function prototypes
+float galaxies_get_radius(Point, unsigned short *class);
+bool galaxies_section_has_galaxy(Point);
+void jobs_finish_handle(JobHandle *);
+void jobs_init_handle(JobHandle *);
+bool jobs_is_handle_done(JobHandle *);
+bool jobs_release_handle(JobHandle *);
+void jobs_submit(void (*function)(void *data), void *data, unsigned short tag, float priority);
+bool maths_points_equal(Point, Point);
+
+#endif
\ No newline at end of file
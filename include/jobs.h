@@ -0,0 +1,25 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+// Function prototypes
+void jobs_cancel(unsigned short tags);
+void jobs_cancel_handle(JobHandle *);
+bool jobs_create(void);
+void jobs_destroy(void);
+void jobs_finish_handle(JobHandle *);
+int jobs_get_num_workers(void);
+float jobs_get_priority(Point position, Point camera_position, Point ship_position);
+void jobs_init_handle(JobHandle *);
+bool jobs_is_cancelled(void);
+bool jobs_is_handle_cancelled(JobHandle *);
+bool jobs_is_handle_done(JobHandle *);
+void jobs_parallel_for(int count, int grain, void (*function)(void *data, int start, int end), void *data);
+bool jobs_release_handle(JobHandle *);
+void jobs_submit(void (*function)(void *data), void *data, unsigned short tag, float priority);
+
+// External function prototypes
+double maths_distance_between_points(double x1, double y1, double x2, double y2);
+void trace_add_span(const char *name, Uint64 start, Uint64 end);
+void trace_name_thread(const char *name);
+
+#endif
\ No newline at end of file
@@ -9,11 +9,22 @@ void menu_run_state(GameState *, InputState *, bool is_game_started, const Navig
 void menu_update_menu_entries(GameState *, GameEvents *);
 
 // External function prototypes
+bool compositor_begin_layer(unsigned short index, Uint32 key);
+void compositor_end_layer(unsigned short index);
+Uint32 compositor_hash(Uint32 hash, const void *data, size_t size);
+void compositor_invalidate(unsigned short index);
+void counters_add(unsigned short counter, int amount);
 Galaxy *galaxies_get_entry(GalaxyEntry *galaxies[], Point);
 void gfx_draw_menu_galaxy_cloud(const Camera *, Gstar *menustars);
 void gfx_draw_speed_lines(float velocity, const Camera *, Speed);
 void gfx_generate_menu_gstars(Galaxy *, Gstar *menustars);
 void gfx_update_bstars_position(int state, bool camera_on, const NavigationState *, Bstar *bstars, const Camera *, Speed, double distance);
 bool maths_is_point_in_rectangle(Point, Point rect[]);
+void render_copy(SDL_Texture *, const SDL_Rect *src, const SDL_Rect *dst);
+void render_fill_rect(const SDL_Rect *);
+void render_set_draw_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+unsigned short render_set_layer(unsigned short layer);
+void text_draw_label(TextLabel *, int x, int y);
+TextLabel *text_get_label(const char *text, unsigned short font_size, SDL_Color);
 
 #endif
\ No newline at end of file
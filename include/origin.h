@@ -0,0 +1,14 @@
+#ifndef ORIGIN_H
+#define ORIGIN_H
+
+// Function prototypes
+Point origin_get_absolute_position(const Origin *, LocalPoint);
+LocalPoint origin_get_local_position(const Origin *, Point);
+bool origin_rebase(Origin *, LocalPoint *);
+void origin_reset(Origin *, Point);
+void origin_sync_ship(Origin *, Ship *);
+
+// External function prototypes
+bool maths_points_equal(Point, Point);
+
+#endif
\ No newline at end of file
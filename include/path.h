@@ -0,0 +1,14 @@
+#ifndef PATH_H
+#define PATH_H
+
+// Function prototypes
+bool path_add_point(WaypointPath *, unsigned short type, Point position);
+WaypointPath *path_create(int max_points);
+void path_destroy(WaypointPath *);
+int path_find_nearest_segment(const WaypointPath *, Point, int first_segment);
+double path_get_progress(const WaypointPath *, int segment, Point position);
+double path_get_remaining_length(const WaypointPath *, int index);
+bool path_get_visible_range(const WaypointPath *, Point min, Point max, int *first, int *last);
+void path_set_point(WaypointPath *, int index, Point position);
+
+#endif
\ No newline at end of file
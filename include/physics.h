@@ -6,4 +6,7 @@ void phys_apply_gravity_to_ship(GameState *, const InputState *, NavigationState
 void phys_calculate_orbital_velocity(float distance, float angle, float radius, float *vx, float *vy);
 void phys_update_velocity(Vector *velocity, const Ship *);
 
+// External function prototypes
+LocalPoint origin_get_local_position(const Origin *, Point);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,21 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Function prototypes
+void profiler_begin_scope(unsigned short scope);
+bool profiler_create(void);
+void profiler_draw(const Camera *);
+void profiler_end_frame(void);
+void profiler_end_scope(unsigned short scope);
+
+// External function prototypes
+void render_draw_line(int x1, int y1, int x2, int y2);
+void render_fill_rect(const SDL_Rect *);
+void render_fill_rects(const SDL_Rect *rects, int count);
+void render_set_draw_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+unsigned short render_set_layer(unsigned short layer);
+void text_draw_label(TextLabel *, int x, int y);
+TextLabel *text_get_label(const char *text, unsigned short font_size, SDL_Color);
+void trace_add_span(const char *name, Uint64 start, Uint64 end);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+// Function prototypes
+void render_clear(void);
+void render_copy(SDL_Texture *, const SDL_Rect *src, const SDL_Rect *dst);
+void render_copy_ex(SDL_Texture *, const SDL_Rect *src, const SDL_Rect *dst, double angle, const SDL_Point *center, SDL_RendererFlip);
+void render_copy_modulated(SDL_Texture *, const SDL_Rect *src, const SDL_Rect *dst, SDL_Color mod);
+bool render_create_frames(void);
+SDL_Texture *render_create_texture(Uint32 format, int access, int w, int h);
+SDL_Texture *render_create_texture_from_surface(SDL_Surface *);
+void render_destroy(void);
+void render_destroy_texture(SDL_Texture *);
+void render_draw_frame(void);
+void render_draw_line(int x1, int y1, int x2, int y2);
+void render_draw_lines(const SDL_Point *points, int count);
+void render_draw_point(int x, int y);
+void render_draw_points(const SDL_Point *points, int count);
+void render_draw_rect(const SDL_Rect *);
+void render_end_frame(void);
+void render_fill_rect(const SDL_Rect *);
+void render_fill_rects(const SDL_Rect *rects, int count);
+void render_geometry(SDL_Texture *, const SDL_Vertex *vertices, int num_vertices, const int *indices, int num_indices);
+RenderStats render_get_stats(void);
+void render_publish_frame(void);
+void render_set_blend_mode(SDL_BlendMode);
+SDL_Cursor *render_set_cursor(SDL_Cursor *);
+void render_set_draw_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+unsigned short render_set_layer(unsigned short layer);
+SDL_Texture *render_set_target(SDL_Texture *);
+bool render_set_texture_blend_mode(SDL_Texture *, SDL_BlendMode);
+void render_set_texture_scale_mode(SDL_Texture *, SDL_ScaleMode);
+void render_submit(void);
+bool render_wait_frame(Uint32 timeout);
+
+// External function prototypes
+void counters_add(unsigned short counter, int amount);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,15 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+// Function prototypes
+bool replay_begin_frame(void);
+void replay_end_frame(const GameState *, const InputState *, const Ship *);
+void replay_get_mouse_state(int *x, int *y);
+Uint32 replay_get_ticks(void);
+bool replay_is_playing(void);
+int replay_poll_event(SDL_Event *);
+bool replay_start_playback(const char *path);
+bool replay_start_recording(const char *path);
+void replay_stop(void);
+
+#endif
\ No newline at end of file
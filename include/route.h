@@ -0,0 +1,24 @@
+#ifndef ROUTE_H
+#define ROUTE_H
+
+// Function prototypes
+void route_benchmark(const NavigationState *, int runs);
+void route_cancel_job(void);
+void route_clear_cache(void);
+float route_get_progress(void);
+bool route_is_planning(void);
+bool route_poll_job(PathPoint **path, int *num_points);
+void route_set_async(bool async);
+void route_start_job(const NavigationState *, Point origin, Point start, Point destination, Point star_position, int planet_index);
+
+// External function prototypes
+void jobs_cancel_handle(JobHandle *);
+void jobs_init_handle(JobHandle *);
+bool jobs_is_handle_cancelled(JobHandle *);
+bool jobs_release_handle(JobHandle *);
+void jobs_submit(void (*function)(void *data), void *data, unsigned short tag, float priority);
+double stars_nearest_star_distance(Point, Galaxy *, uint64_t initseq, int galaxy_density);
+bool stars_section_has_star(Point, const Galaxy *, uint64_t initseq);
+unsigned short stars_size_class(float distance);
+
+#endif
\ No newline at end of file
@@ -3,7 +3,11 @@
 
 // Function prototypes
 void sdl_cleanup(SDL_Window *);
-bool sdl_initialize(SDL_Window *);
+bool sdl_initialize(SDL_Window *, unsigned short backend);
 bool sdl_ttf_load_fonts(SDL_Window *);
 
+// External function prototypes
+bool text_create_atlases(void);
+void text_destroy_atlases(void);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+// Function prototypes
+bool simulation_is_running(void);
+void simulation_push_event(const SDL_Event *);
+void simulation_run_frame(Simulation *, int (*poll_event)(SDL_Event *));
+bool simulation_start(Simulation *);
+void simulation_stop(void);
+
+// External function prototypes
+void benchmark_end_stage(unsigned short stage);
+void console_draw_fps(unsigned int fps, const Camera *);
+void console_measure_fps(GameState *, unsigned int *last_time, unsigned int *frame_count);
+void controls_run_state(GameState *, InputState *, bool is_game_started, const NavigationState *, Bstar *bstars, Gstar *menustars, const Camera *);
+void counters_draw(const NavigationState *, const Camera *);
+void counters_end_frame(void);
+void events_loop(GameState *, InputState *, GameEvents *, NavigationState *, const Camera *, int (*poll_event)(SDL_Event *));
+void events_set_cursor(GameState *, InputState *);
+void game_reset(GameState *, InputState *, GameEvents *, NavigationState *, Bstar *bstars, Ship *, Camera *, bool reset);
+void game_run_map_state(GameState *, InputState *, GameEvents *, NavigationState *, Bstar *bstars, Ship *, Camera *);
+void game_run_navigate_state(GameState *, InputState *, GameEvents *, NavigationState *, Bstar *bstars, Ship *, Camera *);
+void game_run_universe_state(GameState *, InputState *, GameEvents *, NavigationState *, Ship *, Camera *);
+void menu_run_state(GameState *, InputState *, bool is_game_started, const NavigationState *, Bstar *bstars, Gstar *menustars, Camera *);
+void profiler_begin_scope(unsigned short scope);
+void profiler_draw(const Camera *);
+void profiler_end_frame(void);
+void profiler_end_scope(unsigned short scope);
+bool render_create_frames(void);
+void render_publish_frame(void);
+void trace_end_frame(void);
+void trace_name_thread(const char *name);
+
+#endif
\ No newline at end of file
@@ -7,6 +7,20 @@ typedef struct
     double y;
 } Point;
 
+// Struct for a position relative to the floating origin
+typedef struct
+{
+    float x;
+    float y;
+} LocalPoint;
+
+// Struct for the floating origin of the local frame
+typedef struct
+{
+    int64_t section_x; // Absolute origin in ORIGIN_SECTION_SIZE units
+    int64_t section_y;
+} Origin;
+
 // Structs for the controls table
 typedef struct
 {
@@ -32,13 +46,40 @@ typedef struct
     bool disabled;
 } MenuButton;
 
+// Struct for the glyph atlas of a font size
+typedef struct
+{
+    SDL_Texture *texture;
+    int w;
+    int h;
+    int height;                        // Font height
+    SDL_Rect glyphs[TEXT_GLYPH_COUNT]; // Glyph boxes in the texture; Width is the advance
+} GlyphAtlas;
+
+// Struct for a text label laid out from a glyph atlas
+typedef struct
+{
+    bool in_use;
+    Uint32 hash;
+    unsigned int last_used;
+    char text[TEXT_MAX_LENGTH];
+    unsigned short font_size;
+    SDL_Color color;
+    int w;
+    int h;
+    int x; // Position of the vertices
+    int y;
+    int num_glyphs;
+    SDL_Vertex vertices[4 * TEXT_MAX_LENGTH];
+} TextLabel;
+
 // Struct for an info box entry
 typedef struct
 {
     char text[128];
     unsigned short font_size;
     SDL_Rect rect;
-    SDL_Texture *text_texture;
+    TextLabel *text_label;
     SDL_Rect texture_rect;
 } InfoBoxEntry;
 
@@ -72,6 +113,7 @@ typedef struct
 } PointState;
 
 typedef struct PathPoint PathPoint;
+typedef struct WaypointPath WaypointPath;
 
 typedef struct CelestialBody
 {
@@ -94,9 +136,9 @@ typedef struct CelestialBody
     unsigned short level;
     bool is_selected; // Whether the body is selected in Map
     char galaxy_name[MAX_OBJECT_NAME];
+    Point galaxy_position; // Universe position of the galaxy
     WaypointButton waypoint_button;
-    PathPoint *waypoint_path;
-    int waypoint_points;
+    WaypointPath *waypoint_path; // NULL if there is no path
 } CelestialBody;
 
 typedef CelestialBody Planet;
@@ -109,6 +151,24 @@ typedef struct PathPoint
     Point position;
 } PathPoint;
 
+// Struct for the bounding box of path segments
+typedef struct PathBox
+{
+    Point min;
+    Point max;
+} PathBox;
+
+// Struct for a waypoint path with cumulative lengths and a tree of segment bounding boxes
+typedef struct WaypointPath
+{
+    PathPoint *points;
+    double *lengths; // Arc length from the first point to each point
+    int num_points;
+    int max_points;
+    PathBox *boxes; // Implicit tree; Node 1 is the root, the box of segment i is node num_leaves + i
+    int num_leaves; // Power of 2
+} WaypointPath;
+
 // Struct for a star entry in stars hash table
 typedef struct StarEntry
 {
@@ -149,6 +209,17 @@ typedef struct
     Gstar gstars_hd[MAX_GSTARS];
 } Galaxy;
 
+// Struct for the pre-rendered textures of a galaxy cloud
+typedef struct
+{
+    bool in_use;
+    Point position; // Galaxy position
+    bool high_definition;
+    unsigned int last_used;
+    SDL_Texture *levels[GALAXY_CLOUD_LEVELS]; // Level n is GALAXY_CLOUD_MIN_SIZE << n pixels wide, drawn from the stars at that size
+    int gstars_count[GALAXY_CLOUD_LEVELS];    // Stars drawn in each level
+} GalaxyCloud;
+
 // Struct for a galaxy entry in galaxies hash table
 typedef struct GalaxyEntry
 {
@@ -163,6 +234,7 @@ typedef struct Ship
     char *image;
     int radius;
     Point position;
+    LocalPoint local_position; // Position relative to nav_state->origin
     Point previous_position;
     float angle; // Reference is the vertical axis
     float vx;
@@ -176,6 +248,106 @@ typedef struct Ship
     SDL_Point rotation_pt;
 } Ship;
 
+// Struct for a bucket of points and rects that share a draw color
+typedef struct
+{
+    bool in_use;
+    Uint32 key;
+    SDL_Color color;
+    SDL_Point *points;
+    int num_points;
+    int max_points;
+    SDL_Rect *rects;
+    int num_rects;
+    int max_rects;
+} PointBucket;
+
+// Struct for a deferred draw command
+typedef struct
+{
+    unsigned short type;
+    unsigned short layer;
+    SDL_Texture *target; // Render target, or NULL for the screen
+    SDL_BlendMode blend_mode;
+    SDL_Color color; // Draw color, or color and alpha modulation of copied textures
+    SDL_Texture *texture;
+    int first; // First item in the points, rects or vertices of the frame
+    int count;
+    int first_index; // First item in the indices of the frame
+    int num_indices;
+    bool has_src;
+    SDL_Rect src;
+    bool has_dst;
+    SDL_Rect dst;
+    double angle;
+    bool has_center;
+    SDL_Point center;
+    SDL_RendererFlip flip;
+} RenderCommand;
+
+// Struct for the render statistics of a frame
+typedef struct
+{
+    int commands; // Commands recorded
+    int batches;  // Draw calls issued for them
+} RenderStats;
+
+// Struct for the commands of a frame, recorded by the simulation and drawn by the render thread
+typedef struct
+{
+    RenderCommand *commands;
+    int num_commands;
+    int max_commands;
+    SDL_Point *points;
+    int num_points;
+    int max_points;
+    SDL_Rect *rects;
+    int num_rects;
+    int max_rects;
+    SDL_Vertex *vertices;
+    int num_vertices;
+    int max_vertices;
+    int *indices;
+    int num_indices;
+    int max_indices;
+    int *order;
+    int max_order;
+    SDL_Texture **destroyed_textures; // Destroyed once the frame has been drawn
+    int num_destroyed_textures;
+    int max_destroyed_textures;
+    bool has_targets; // Whether the frame draws into textures, which must not be dropped
+    SDL_Cursor *cursor;
+    RenderStats stats;
+} RenderFrame;
+
+// Struct for a call to the renderer, made on the render thread on behalf of another thread
+typedef struct
+{
+    unsigned short type;
+    Uint32 format;
+    int access;
+    int w;
+    int h;
+    SDL_Surface *surface;
+    SDL_BlendMode blend_mode;
+    SDL_ScaleMode scale_mode;
+    SDL_Texture *texture; // Texture to change, or created texture
+    int result;           // Return value of the call
+    bool is_done;
+} RenderRequest;
+
+// Struct for a layer cached by the compositor
+typedef struct
+{
+    SDL_Texture *texture;
+    int w; // Size of the texture, kept here so that it is not queried from the recording thread
+    int h;
+    bool is_dirty;
+    Uint32 key; // Hash of what the content depends on
+    bool is_rendering;
+    SDL_Texture *previous_target;
+} CompositorLayer;
+
 // Struct for a background star
 typedef struct
 {
@@ -218,6 +390,8 @@ typedef struct
     bool zoom_in;
     bool zoom_out;
     bool fps_on;
+    bool profiler_on;
+    bool counters_on;
     bool orbits_on;
     bool autopilot_on;
     unsigned short selected_menu_button_index;
@@ -275,6 +449,7 @@ typedef struct
     Point map_offset;
     Point universe_offset;
     Point cross_line; // Keep track of nearest line position
+    Origin origin;    // Floating origin of the ship's local frame, for its motion and the gravity on it
     Vector velocity;
     uint64_t initseq; // Output sequence for the RNG of stars; Changes for every new current_galaxy
 } NavigationState;
@@ -296,4 +471,307 @@ typedef struct
     unsigned short table_num_rows;
 } GameState;
 
+// Struct for a section in the occupancy table of the route planner
+typedef struct
+{
+    bool in_use;
+    int64_t x; // Position in sections
+    int64_t y;
+    bool has_star;
+    unsigned short class; // Star class, or 0 if not calculated yet
+    int obstacle;         // Index in the obstacles of the planner, or -1
+} RouteSection;
+
+// Struct for a star cutoff that routes go around
+typedef struct
+{
+    Point position;
+    double cutoff;
+} RouteObstacle;
+
+// Struct for a node of the route planner
+typedef struct
+{
+    double g; // Length of the shortest known path from the start
+    int parent;
+    bool is_closed;
+} RouteNode;
+
+// Struct for an entry in the open set of the route planner
+typedef struct
+{
+    double f; // Estimated length of the path through the node
+    int node;
+} RouteOpenEntry;
+
+// Struct for the state of a route search
+// Nodes are the start, the destination and the vertices of polygons around star cutoffs.
+typedef struct
+{
+    Galaxy *galaxy;
+    uint64_t initseq;
+    Point start;
+    Point destination;
+    RouteSection *sections; // Open addressing hash table
+    int max_sections;
+    int num_sections;
+    RouteObstacle *obstacles;
+    int max_obstacles;
+    int num_obstacles;
+    RouteNode *nodes;
+    RouteOpenEntry *open; // Binary heap
+    int max_open;
+    int num_open;
+    int expansions;
+    int best_node;        // Expanded node closest to the destination, for partial paths
+    double best_distance; // Distance of the best node to the destination
+    bool is_out_of_memory;
+} RoutePlanner;
+
+// Struct for the key of a cached route
+typedef struct
+{
+    Point galaxy_position;
+    int64_t section_x; // Section of the ship when the route was planned
+    int64_t section_y;
+    Point star_position; // Destination star, or exit of the galaxy for legs to other galaxies
+    int planet_index;    // Destination planet, or -1 for the star
+} RouteKey;
+
+// Struct for a planned route kept for later requests with the same key
+typedef struct
+{
+    bool in_use;
+    RouteKey key;
+    unsigned int last_used;
+    PathPoint *path; // From the start of the route, without the ship position
+    int num_points;
+} RouteCacheEntry;
+
+// Struct for the state of a background job shared with the thread that started it
+// The data of the job is freed by the last one to release it; See jobs_init_handle().
+typedef struct
+{
+    SDL_atomic_t refcount;
+    SDL_atomic_t is_cancelled;
+    SDL_atomic_t is_done; // Whether the result of the job is ready
+} JobHandle;
+
+// Struct for a route planned in the background
+typedef struct
+{
+    JobHandle handle;
+    SDL_mutex *mutex;
+    Galaxy *galaxy; // Copy of the fields used to generate stars, so that the current galaxy can change while planning
+    uint64_t initseq;
+    RouteKey key;
+    Point origin; // Position of the ship, added before the start
+    Point start;
+    Point destination;
+    PathPoint *path; // Latest path, until it is taken by the main thread
+    int num_points;
+    bool has_update;
+    bool is_complete;
+    bool is_found; // Whether the final path was planned and can be cached
+    float progress;
+} RouteJob;
+
+// Struct for a galaxy in the search of the itinerary planner
+typedef struct
+{
+    Point position; // Universe position
+    float radius;
+    double g; // Cost of the cheapest known itinerary from the start
+    int parent;
+    bool is_closed;
+} ItineraryNode;
+
+// Struct for the state of an itinerary search
+// Nodes are galaxies, found by querying the galaxy generator around the galaxies that are expanded.
+typedef struct
+{
+    ItineraryNode *nodes;
+    int num_nodes;
+    int *table; // Open addressing hash table of nodes by section, -1 if empty
+    int max_table;
+    RouteOpenEntry *open; // Binary heap
+    int max_open;
+    int num_open;
+    int expansions;
+    bool is_out_of_memory;
+} ItinerarySearch;
+
+// Struct for the galaxies on the way to the waypoint, from the galaxy where the itinerary was planned to the galaxy of the waypoint
+typedef struct
+{
+    Point *positions; // Universe positions of the galaxies
+    float *radii;
+    int num_galaxies;
+    int current; // Last galaxy of the itinerary the ship has been in
+    bool is_partial; // Whether the search ran out of budget; The last hop runs from the galaxy closest to the destination
+} Itinerary;
+
+// Struct for an itinerary planned in the background
+typedef struct
+{
+    JobHandle handle;
+    Point start;
+    Point destination;
+    Itinerary itinerary;
+} ItineraryJob;
+
+// Struct for the state updated by the simulation every frame
+typedef struct
+{
+    GameState *game_state;
+    InputState *input_state;
+    GameEvents *game_events;
+    NavigationState *nav_state;
+    Bstar *bstars;
+    Gstar *menustars;
+    Ship *ship;
+    Camera *camera;
+    unsigned int last_time; // Time keeping of the FPS counter
+    unsigned int frame_count;
+} Simulation;
+
+// Struct for the stars of a region generated ahead of the ship
+typedef struct
+{
+    JobHandle handle;
+    Galaxy *galaxy; // Copy of the fields used to generate stars
+    uint64_t initseq;
+    Point origin; // Center of the region the ship comes from, whose stars exist
+    Point target; // Center of the region the ship heads to
+    Star **stars; // Stars of the sections of the target outside the origin
+    int num_stars;
+} StarsPrefetch;
+
+// Struct for a star system populated in the background, before its star is hovered or selected
+typedef struct
+{
+    JobHandle handle;
+    Star *star; // Copy of the star, whose planets and moons are created by the job
+    long double scale;
+} StarsPopulation;
+
+// Struct for a universe region whose galaxies are created in parallel, in tiles of columns of sections
+typedef struct
+{
+    GalaxyEntry **galaxies; // Hash table of existing galaxies; Only read while the galaxies are created
+    double left_boundary;
+    double top_boundary;
+    Galaxy *created[UNIVERSE_REGION_SIZE * UNIVERSE_REGION_SIZE]; // New galaxies by column and row, NULL if none
+} GalaxiesRegion;
+
+// Struct for batches of gstars of a galaxy generated in the background
+typedef struct
+{
+    JobHandle handle;
+    Galaxy *galaxy; // Copy of the fields used to generate gstars, to which the job adds the new gstars
+    bool high_definition;
+    int initialized;     // Initialized groups of sections of the galaxy when the job started
+    int last_star_index; // Index of the first gstar written by the job
+    bool is_in_view;     // Whether the galaxy still needed gstars in the last frame; Used by the main thread
+} GstarsJob;
+
+// Struct for a galaxy whose gstars are to be generated in the background
+typedef struct
+{
+    const Galaxy *galaxy;
+    bool high_definition;
+    float priority;
+} GstarsCandidate;
+
+// Struct for a background job of the job system
+typedef struct
+{
+    void (*function)(void *data);
+    void *data;
+    float priority; // Distance to the player; Lower runs first
+    unsigned int order; // Jobs with the same priority run in the order they were submitted
+    unsigned short tag;
+    SDL_atomic_t is_cancelled;
+} Job;
+
+// Struct for a part of the range of a parallel for
+typedef struct
+{
+    void (*function)(void *data, int start, int end);
+    void *data;
+    int start;
+    int end;
+    SDL_atomic_t *pending; // Parts of the parallel for that have not finished
+} JobRange;
+
+// Struct for a worker thread of the job system
+// The deque holds parts of parallel fors: the worker takes the newest one, other threads steal the oldest one.
+// The heap holds the background jobs submitted to the worker; Idle workers steal them by priority.
+typedef struct
+{
+    SDL_Thread *thread;
+    SDL_SpinLock lock; // Guards the deque, the heap and the job being run
+    JobRange *deque[JOBS_DEQUE_SIZE];
+    unsigned int top;    // Oldest range
+    unsigned int bottom; // After the newest range
+    Job **jobs;          // Binary heap of background jobs, by priority
+    int num_jobs;
+    int max_jobs;
+    Job *job; // Background job being run
+} JobWorker;
+
+// Struct for the open profiler scopes of a thread
+typedef struct
+{
+    unsigned short scopes[PROFILER_MAX_DEPTH];
+    Uint64 starts[PROFILER_MAX_DEPTH];
+    Uint64 children[PROFILER_MAX_DEPTH]; // Time of the nested scopes, which is not counted in the scope
+    int depth;
+} ProfilerStack;
+
+// Struct for an event of a trace capture, in the Chrome trace event format
+typedef struct
+{
+    SDL_atomic_t is_written; // Set once the event is complete, as threads add events concurrently
+    char phase;              // 'X' for a span, 'i' for an instant, 'C' for a counter
+    const char *name;
+    SDL_threadID thread;
+    Uint64 start;    // Performance counter
+    Uint64 duration; // Performance counter ticks, for spans
+    int value;       // For counters
+} TraceEvent;
+
+// Struct for the chain lengths of a hash table, in the counters overlay
+typedef struct
+{
+    int num_entries;
+    int num_chains; // Buckets with at least one entry
+    int max_length;
+    int lengths[4]; // Chains of 1, 2, 3, and 4 or more entries
+} CountersTable;
+
+// Struct for an event in a replay file
+typedef struct
+{
+    Uint32 type;
+    Sint32 x;
+    Sint32 y;
+    Sint32 code; // Mouse button, motion state or key scancode
+} ReplayEvent;
+
+// Struct for the header of a replay file
+typedef struct
+{
+    char magic[4];
+    Uint32 version;
+    Sint32 display_w;
+    Sint32 display_h;
+    Sint32 fps;
+    Sint32 galaxy_scale;
+    double universe_start_x;
+    double universe_start_y;
+    double galaxy_start_x;
+    double galaxy_start_y;
+} ReplayHeader;
+
 #endif /* STRUCTS_H */
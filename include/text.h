@@ -0,0 +1,16 @@
+#ifndef TEXT_H
+#define TEXT_H
+
+// Function prototypes
+bool text_create_atlases(void);
+void text_destroy_atlases(void);
+void text_draw_label(TextLabel *, int x, int y);
+TextLabel *text_get_label(const char *text, unsigned short font_size, SDL_Color);
+
+// External function prototypes
+void counters_add(unsigned short counter, int amount);
+SDL_Texture *render_create_texture_from_surface(SDL_Surface *);
+void render_geometry(SDL_Texture *, const SDL_Vertex *vertices, int num_vertices, const int *indices, int num_indices);
+bool render_set_texture_blend_mode(SDL_Texture *, SDL_BlendMode);
+
+#endif
\ No newline at end of file
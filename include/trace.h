@@ -0,0 +1,15 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Function prototypes
+void trace_add_counter(const char *name, int value);
+void trace_add_instant(const char *name);
+void trace_add_span(const char *name, Uint64 start, Uint64 end);
+void trace_count_allocation(size_t size);
+void trace_destroy(void);
+void trace_end_frame(void);
+bool trace_is_capturing(void);
+void trace_name_thread(const char *name);
+bool trace_start(const char *file_path, int first_frame, int frames);
+
+#endif
\ No newline at end of file
@@ -5,9 +5,16 @@
 void utils_add_thousand_separators(int num, char *result, size_t result_size);
 void utils_cleanup_resources(GameState *, InputState *, NavigationState *, Bstar *bstars, Ship *);
 void utils_convert_seconds_to_time_string(int seconds, char timeString[]);
+bool utils_parse_int(const char *text, int min, int max, int *value);
 
 // External function prototypes
+void batch_destroy(void);
+void compositor_destroy(void);
+void gfx_destroy_bstars_textures(void);
+void gfx_destroy_disc_textures(void);
+void gfx_destroy_galaxy_clouds(void);
 void galaxies_clear_table(GalaxyEntry *galaxies[]);
+void render_destroy(void);
 void stars_clear_table(StarEntry *stars[], const NavigationState *, bool delete_all);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,191 @@
+/*
+ * batch.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <SDL2/SDL.h>
+
+#include "../include/constants.h"
+#include "../include/enums.h"
+#include "../include/structs.h"
+#include "../include/batch.h"
+
+// External variable definitions
+extern SDL_Renderer *renderer;
+
+// Static variable definitions
+static PointBucket buckets[BATCH_MAX_BUCKETS];
+static int num_buckets = 0;
+
+// Static function prototypes
+static PointBucket *batch_get_bucket(SDL_Color);
+static bool batch_grow(void **items, int *capacity, size_t item_size);
+
+/**
+ * Queues a point to be drawn with the given color on the next flush.
+ *
+ * @param x The x-coordinate of the point.
+ * @param y The y-coordinate of the point.
+ * @param color The color of the point. The alpha channel is quantized to BATCH_ALPHA_STEP.
+ *
+ * @return void
+ */
+void batch_add_point(int x, int y, SDL_Color color)
+{
+    PointBucket *bucket = batch_get_bucket(color);
+
+    if (bucket == NULL)
+        return;
+
+    if (bucket->num_points >= bucket->max_points && !batch_grow((void **)&bucket->points, &bucket->max_points, sizeof(SDL_Point)))
+        return;
+
+    bucket->points[bucket->num_points].x = x;
+    bucket->points[bucket->num_points].y = y;
+    bucket->num_points++;
+}
+
+/**
+ * Queues a filled rectangle to be drawn with the given color on the next flush.
+ *
+ * @param rect A pointer to the rectangle.
+ * @param color The color of the rectangle. The alpha channel is quantized to BATCH_ALPHA_STEP.
+ *
+ * @return void
+ */
+void batch_add_rect(const SDL_Rect *rect, SDL_Color color)
+{
+    PointBucket *bucket = batch_get_bucket(color);
+
+    if (bucket == NULL)
+        return;
+
+    if (bucket->num_rects >= bucket->max_rects && !batch_grow((void **)&bucket->rects, &bucket->max_rects, sizeof(SDL_Rect)))
+        return;
+
+    bucket->rects[bucket->num_rects] = *rect;
+    bucket->num_rects++;
+}
+
+/**
+ * Frees the memory of all buckets.
+ *
+ * @return void
+ */
+void batch_destroy(void)
+{
+    for (int i = 0; i < BATCH_MAX_BUCKETS; i++)
+    {
+        free(buckets[i].points);
+        free(buckets[i].rects);
+
+        buckets[i] = (PointBucket){0};
+    }
+
+    num_buckets = 0;
+}
+
+/**
+ * Draws all queued points and rectangles, one draw call per color bucket, and empties the batch.
+ * Bucket memory is kept for the next frame.
+ *
+ * @return void
+ */
+void batch_flush(void)
+{
+    if (num_buckets == 0)
+        return;
+
+    for (int i = 0; i < BATCH_MAX_BUCKETS; i++)
+    {
+        PointBucket *bucket = &buckets[i];
+
+        if (!bucket->in_use)
+            continue;
+
+        render_set_draw_color(bucket->color.r, bucket->color.g, bucket->color.b, bucket->color.a);
+
+        if (bucket->num_points > 0)
+            render_draw_points(bucket->points, bucket->num_points);
+
+        if (bucket->num_rects > 0)
+            render_fill_rects(bucket->rects, bucket->num_rects);
+
+        bucket->in_use = false;
+        bucket->num_points = 0;
+        bucket->num_rects = 0;
+    }
+
+    num_buckets = 0;
+}
+
+/**
+ * Finds the bucket for a color, or claims an empty one.
+ * Buckets are kept in an open-addressing hash table keyed by the color.
+ *
+ * @param color The draw color. The alpha channel is quantized to BATCH_ALPHA_STEP.
+ *
+ * @return A pointer to the bucket, or NULL if the color is fully transparent.
+ */
+static PointBucket *batch_get_bucket(SDL_Color color)
+{
+    int alpha = ((color.a + BATCH_ALPHA_STEP / 2) / BATCH_ALPHA_STEP) * BATCH_ALPHA_STEP;
+    color.a = alpha > 255 ? 255 : alpha;
+
+    if (color.a == 0)
+        return NULL;
+
+    Uint32 key = (Uint32)color.r << 24 | (Uint32)color.g << 16 | (Uint32)color.b << 8 | color.a;
+    int index = (int)(((key * 2654435761u) >> 16) & (BATCH_MAX_BUCKETS - 1));
+
+    while (buckets[index].in_use)
+    {
+        if (buckets[index].key == key)
+            return &buckets[index];
+
+        index = (index + 1) & (BATCH_MAX_BUCKETS - 1);
+    }
+
+    // Keep the table sparse, otherwise probing gets slow; Draw what we have and start over
+    if (num_buckets >= BATCH_MAX_BUCKETS * 3 / 4)
+    {
+        batch_flush();
+        index = (int)(((key * 2654435761u) >> 16) & (BATCH_MAX_BUCKETS - 1));
+    }
+
+    buckets[index].in_use = true;
+    buckets[index].key = key;
+    buckets[index].color = color;
+    num_buckets++;
+
+    return &buckets[index];
+}
+
+/**
+ * Doubles the capacity of a bucket array.
+ *
+ * @param items A pointer to the array.
+ * @param capacity A pointer to the capacity of the array.
+ * @param item_size The size of each item.
+ *
+ * @return True if the array was resized, false otherwise.
+ */
+static bool batch_grow(void **items, int *capacity, size_t item_size)
+{
+    int new_capacity = *capacity > 0 ? *capacity * 2 : BATCH_INITIAL_CAPACITY;
+    void *new_items = realloc(*items, new_capacity * item_size);
+
+    if (new_items == NULL)
+    {
+        fprintf(stderr, "Error: Could not allocate memory for point batch.\n");
+        return false;
+    }
+
+    *items = new_items;
+    *capacity = new_capacity;
+
+    return true;
+}
@@ -0,0 +1,188 @@
+/*
+ * benchmark.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <SDL2/SDL.h>
+
+#include "../include/constants.h"
+#include "../include/enums.h"
+#include "../include/benchmark.h"
+
+// External variable definitions
+extern SDL_DisplayMode display_mode;
+extern SDL_Renderer *renderer;
+
+// Static variable definitions
+static bool is_running = false;
+static unsigned int max_frames = 0;
+static unsigned int frames = 0;
+static const char *hash_path = NULL;
+static Uint64 stage_start = 0;
+static Uint64 stage_totals[BENCHMARK_STAGE_COUNT];
+static Uint64 stage_max[BENCHMARK_STAGE_COUNT];
+static const char *stage_names[BENCHMARK_STAGE_COUNT] = {"events", "update", "render"};
+
+// Static function prototypes
+static bool benchmark_hash_framebuffer(Uint32 *hash);
+
+/**
+ * Starts timing a frame.
+ *
+ * @return void
+ */
+void benchmark_begin_frame(void)
+{
+    if (!is_running)
+        return;
+
+    stage_start = SDL_GetPerformanceCounter();
+}
+
+/**
+ * Ends a frame.
+ *
+ * @return False if the requested number of frames has been run, true otherwise.
+ */
+bool benchmark_end_frame(void)
+{
+    if (!is_running)
+        return true;
+
+    return ++frames < max_frames;
+}
+
+/**
+ * Ends a stage of the frame. The stage lasts from the end of the previous stage,
+ * or the start of the frame.
+ *
+ * @param stage The stage.
+ *
+ * @return void
+ */
+void benchmark_end_stage(unsigned short stage)
+{
+    if (!is_running)
+        return;
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    Uint64 elapsed = now - stage_start;
+
+    stage_totals[stage] += elapsed;
+
+    if (elapsed > stage_max[stage])
+        stage_max[stage] = elapsed;
+
+    stage_start = now;
+}
+
+/**
+ * Calculates an FNV-1a hash of the pixels of the screen.
+ * Pixels are read in a fixed format, so that the hash does not depend on the renderer.
+ *
+ * @param hash A pointer to the hash to set.
+ *
+ * @return True if the pixels could be read, false otherwise.
+ */
+static bool benchmark_hash_framebuffer(Uint32 *hash)
+{
+    int pitch = display_mode.w * 4;
+    Uint8 *pixels = malloc((size_t)pitch * display_mode.h);
+
+    if (pixels == NULL)
+    {
+        fprintf(stderr, "Error: Could not allocate memory for framebuffer.\n");
+        return false;
+    }
+
+    if (SDL_RenderReadPixels(renderer, NULL, SDL_PIXELFORMAT_ARGB8888, pixels, pitch) != 0)
+    {
+        SDL_Log("Could not read framebuffer: %s\n", SDL_GetError());
+        free(pixels);
+        return false;
+    }
+
+    *hash = compositor_hash(0, pixels, (size_t)pitch * display_mode.h);
+    free(pixels);
+
+    return true;
+}
+
+/**
+ * Starts a benchmark run of a number of frames.
+ *
+ * @param num_frames The number of frames to run.
+ * @param path The path of the file to write the framebuffer hash to, or NULL to only print it.
+ *
+ * @return void
+ */
+void benchmark_start(unsigned int num_frames, const char *path)
+{
+    is_running = true;
+    max_frames = num_frames;
+    frames = 0;
+    hash_path = path;
+
+    for (int i = 0; i < BENCHMARK_STAGE_COUNT; i++)
+    {
+        stage_totals[i] = 0;
+        stage_max[i] = 0;
+    }
+}
+
+/**
+ * Ends a benchmark run. Prints the mean and maximum time of each stage, and the hash
+ * of the last frame. The hash is also written to the hash file, for golden-image comparison.
+ * Must be called before the renderer is destroyed.
+ *
+ * @return True if the hash was computed and written, false otherwise.
+ */
+bool benchmark_stop(void)
+{
+    if (!is_running)
+        return true;
+
+    is_running = false;
+
+    double frequency = (double)SDL_GetPerformanceFrequency();
+    double total = 0;
+
+    printf("Benchmark: %u frames at %dx%d\n", frames, display_mode.w, display_mode.h);
+
+    for (int i = 0; i < BENCHMARK_STAGE_COUNT; i++)
+    {
+        double stage_total = stage_totals[i] * 1000 / frequency;
+        total += stage_total;
+
+        printf("  %-8s %10.1f ms total, %8.3f ms/frame, %8.3f ms max\n",
+               stage_names[i], stage_total, frames > 0 ? stage_total / frames : 0, stage_max[i] * 1000 / frequency);
+    }
+
+    printf("  %-8s %10.1f ms total, %8.3f ms/frame\n", "frame", total, frames > 0 ? total / frames : 0);
+
+    Uint32 hash;
+
+    if (!benchmark_hash_framebuffer(&hash))
+        return false;
+
+    printf("Framebuffer hash: %08x\n", hash);
+
+    if (hash_path == NULL)
+        return true;
+
+    FILE *file = fopen(hash_path, "w");
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "Error: Could not create hash file %s.\n", hash_path);
+        return false;
+    }
+
+    fprintf(file, "%08x\n", hash);
+    fclose(file);
+
+    return true;
+}
@@ -0,0 +1,157 @@
+/*
+ * compositor.c
+ */
+
+#include <stdbool.h>
+
+#include <SDL2/SDL.h>
+
+#include "../include/constants.h"
+#include "../include/enums.h"
+#include "../include/structs.h"
+#include "../include/compositor.h"
+
+// External variable definitions
+extern SDL_DisplayMode display_mode;
+
+// Static variable definitions
+static CompositorLayer layers[COMPOSITOR_LAYER_COUNT];
+
+/**
+ * Starts drawing a cached layer. The layer is redrawn only if its key changed or it was invalidated;
+ * Otherwise the caller skips drawing and the cached texture is used.
+ * Every call must be followed by compositor_end_layer().
+ *
+ * @param index The layer.
+ * @param key A hash of everything the content of the layer depends on, such as the camera and scale.
+ *
+ * @return True if the caller must draw the content of the layer, false otherwise.
+ */
+bool compositor_begin_layer(unsigned short index, Uint32 key)
+{
+    static bool has_blend_mode = false;
+    static bool is_blend_mode_supported = true;
+    static SDL_BlendMode premultiplied_blend_mode;
+    CompositorLayer *layer = &layers[index];
+
+    // Renderers without custom blend modes, such as the software renderer, draw every layer directly
+    if (!is_blend_mode_supported)
+        return true;
+
+    if (!has_blend_mode)
+    {
+        premultiplied_blend_mode = SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                                                              SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+        has_blend_mode = true;
+    }
+
+    if (layer->texture == NULL || layer->w != display_mode.w || layer->h != display_mode.h)
+    {
+        render_destroy_texture(layer->texture);
+        layer->texture = render_create_texture(SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, display_mode.w, display_mode.h);
+        layer->w = display_mode.w;
+        layer->h = display_mode.h;
+        layer->is_dirty = true;
+
+        // Without a texture, the content is drawn directly every frame
+        if (layer->texture == NULL)
+        {
+            SDL_Log("Could not create compositor layer: %s\n", SDL_GetError());
+            return true;
+        }
+
+        // Blending onto a transparent target leaves premultiplied colors in the texture
+        if (!render_set_texture_blend_mode(layer->texture, premultiplied_blend_mode))
+        {
+            SDL_Log("Premultiplied blending is not supported by the renderer, compositor layers are not cached\n");
+            render_destroy_texture(layer->texture);
+            layer->texture = NULL;
+            is_blend_mode_supported = false;
+            return true;
+        }
+    }
+
+    if (!layer->is_dirty && layer->key == key)
+        return false;
+
+    layer->key = key;
+    layer->is_dirty = false;
+    layer->is_rendering = true;
+    layer->previous_target = render_set_target(layer->texture);
+
+    render_set_draw_color(0, 0, 0, 0);
+    render_clear();
+
+    return true;
+}
+
+/**
+ * Destroys the textures of all layers.
+ *
+ * @return void
+ */
+void compositor_destroy(void)
+{
+    for (int i = 0; i < COMPOSITOR_LAYER_COUNT; i++)
+    {
+        if (layers[i].texture != NULL)
+            SDL_DestroyTexture(layers[i].texture);
+
+        layers[i] = (CompositorLayer){0};
+    }
+}
+
+/**
+ * Finishes drawing a cached layer and draws its texture on the screen.
+ *
+ * @param index The layer.
+ *
+ * @return void
+ */
+void compositor_end_layer(unsigned short index)
+{
+    CompositorLayer *layer = &layers[index];
+
+    if (layer->is_rendering)
+    {
+        render_set_target(layer->previous_target);
+        layer->is_rendering = false;
+    }
+
+    if (layer->texture != NULL)
+        render_copy(layer->texture, NULL, NULL);
+}
+
+/**
+ * Adds data to an FNV-1a hash, used to build layer keys.
+ *
+ * @param hash The hash so far, or 0 to start a new one.
+ * @param data A pointer to the data.
+ * @param size The size of the data.
+ *
+ * @return The hash.
+ */
+Uint32 compositor_hash(Uint32 hash, const void *data, size_t size)
+{
+    const Uint8 *bytes = data;
+
+    if (hash == 0)
+        hash = 2166136261u;
+
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ bytes[i]) * 16777619u;
+
+    return hash;
+}
+
+/**
+ * Marks a layer to be redrawn the next time it is drawn, for content changes that are not part of its key.
+ *
+ * @param index The layer.
+ *
+ * @return void
+ */
+void compositor_invalidate(unsigned short index)
+{
+    layers[index].is_dirty = true;
+}
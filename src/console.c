@@ -15,7 +15,6 @@
 #include "../include/console.h"
 
 // External variable definitions
-extern TTF_Font *fonts[];
 extern SDL_Renderer *renderer;
 extern SDL_Color colors[];
 
@@ -33,24 +32,22 @@ static void console_draw_velocity_vector(const Ship *, Point, const Camera *);
 
 void console_draw_fps(unsigned int fps, const Camera *camera)
 {
+    unsigned short previous_layer = render_set_layer(RENDER_LAYER_UI);
+
     char fps_text[16];
     memset(fps_text, 0, sizeof(fps_text));
     sprintf(fps_text, "%d", fps);
 
-    // Create text texture
-    SDL_Surface *fps_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_22], fps_text, colors[COLOR_CYAN_100]);
-    SDL_Texture *fps_texture = SDL_CreateTextureFromSurface(renderer, fps_surface);
-    SDL_Rect fps_texture_rect;
-    fps_texture_rect.x = 30;
-    fps_texture_rect.y = camera->h - 40;
-    fps_texture_rect.w = fps_surface->w;
-    fps_texture_rect.h = fps_surface->h;
-    SDL_RenderCopy(renderer, fps_texture, NULL, &fps_texture_rect);
-    SDL_FreeSurface(fps_surface);
-
-    // Destroy texture
-    SDL_DestroyTexture(fps_texture);
-    fps_texture = NULL;
+    // Get text label
+    TextLabel *fps_label = text_get_label(fps_text, FONT_SIZE_22, colors[COLOR_CYAN_100]);
+    SDL_Rect fps_rect;
+    fps_rect.x = 30;
+    fps_rect.y = camera->h - 40;
+    fps_rect.w = fps_label->w;
+    fps_rect.h = fps_label->h;
+    text_draw_label(fps_label, fps_rect.x, fps_rect.y);
+
+    render_set_layer(previous_layer);
 }
 
 /**
@@ -64,8 +61,10 @@ void console_draw_fps(unsigned int fps, const Camera *camera)
  */
 void console_draw_position_console(const GameState *game_state, const NavigationState *nav_state, const Camera *camera)
 {
+    unsigned short previous_layer = render_set_layer(RENDER_LAYER_UI);
+
     // Draw background box
-    SDL_SetRenderDrawColor(renderer, 12, 12, 12, 230);
+    render_set_draw_color(12, 12, 12, 230);
     int box_width = 300;
     int box_height = 70;
     int padding = INFO_BOX_PADDING;
@@ -77,28 +76,26 @@ void console_draw_position_console(const GameState *game_state, const Navigation
     box_rect.w = box_width;
     box_rect.h = box_height;
 
-    SDL_RenderFillRect(renderer, &box_rect);
+    render_fill_rect(&box_rect);
 
     // Draw separator line
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 20);
+    render_set_draw_color(255, 255, 255, 20);
     int section_width = 100;
     int separator_1_x = (camera->w / 2) - (section_width / 2);
     int separator_y1 = camera->h - (box_height + padding);
     int separator_y2 = separator_y1 + box_height;
 
-    SDL_RenderDrawLine(renderer, separator_1_x, separator_y1, separator_1_x, separator_y2);
+    render_draw_line(separator_1_x, separator_y1, separator_1_x, separator_y2);
 
     // Zoom
     char *zoom_title = "ZOOM";
-    SDL_Surface *zoom_title_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_12], zoom_title, colors[COLOR_WHITE_100]);
-    SDL_Texture *zoom_title_texture = SDL_CreateTextureFromSurface(renderer, zoom_title_surface);
-    SDL_Rect zoom_title_texture_rect;
-    zoom_title_texture_rect.w = zoom_title_surface->w;
-    zoom_title_texture_rect.h = zoom_title_surface->h;
-    zoom_title_texture_rect.x = (camera->w / 2) - section_width - (zoom_title_texture_rect.w / 2);
-    zoom_title_texture_rect.y = box_rect.y + inner_padding;
-    SDL_RenderCopy(renderer, zoom_title_texture, NULL, &zoom_title_texture_rect);
-    SDL_FreeSurface(zoom_title_surface);
+    TextLabel *zoom_title_label = text_get_label(zoom_title, FONT_SIZE_12, colors[COLOR_WHITE_100]);
+    SDL_Rect zoom_title_rect;
+    zoom_title_rect.w = zoom_title_label->w;
+    zoom_title_rect.h = zoom_title_label->h;
+    zoom_title_rect.x = (camera->w / 2) - section_width - (zoom_title_rect.w / 2);
+    zoom_title_rect.y = box_rect.y + inner_padding;
+    text_draw_label(zoom_title_label, zoom_title_rect.x, zoom_title_rect.y);
 
     char zoom_value[16];
     memset(zoom_value, 0, sizeof(zoom_value));
@@ -117,15 +114,13 @@ void console_draw_position_console(const GameState *game_state, const Navigation
     else
         sprintf(zoom_value, "%.2Lf", 100 * game_state->game_scale);
 
-    SDL_Surface *zoom_value_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_15], zoom_value, colors[COLOR_WHITE_180]);
-    SDL_Texture *zoom_value_texture = SDL_CreateTextureFromSurface(renderer, zoom_value_surface);
-    SDL_Rect zoom_value_texture_rect;
-    zoom_value_texture_rect.w = zoom_value_surface->w;
-    zoom_value_texture_rect.h = zoom_value_surface->h;
-    zoom_value_texture_rect.x = (camera->w / 2) - section_width - (zoom_value_texture_rect.w / 2);
-    zoom_value_texture_rect.y = box_rect.y + 3.4 * inner_padding;
-    SDL_RenderCopy(renderer, zoom_value_texture, NULL, &zoom_value_texture_rect);
-    SDL_FreeSurface(zoom_value_surface);
+    TextLabel *zoom_value_label = text_get_label(zoom_value, FONT_SIZE_15, colors[COLOR_WHITE_180]);
+    SDL_Rect zoom_value_rect;
+    zoom_value_rect.w = zoom_value_label->w;
+    zoom_value_rect.h = zoom_value_label->h;
+    zoom_value_rect.x = (camera->w / 2) - section_width - (zoom_value_rect.w / 2);
+    zoom_value_rect.y = box_rect.y + 3.4 * inner_padding;
+    text_draw_label(zoom_value_label, zoom_value_rect.x, zoom_value_rect.y);
 
     // Position
     Point offset = {.x = 0.0, .y = 0.0};
@@ -181,15 +176,13 @@ void console_draw_position_console(const GameState *game_state, const Navigation
         offset.y = nav_state->map_offset.y;
     }
 
-    SDL_Surface *position_title_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_12], position_title, colors[COLOR_WHITE_100]);
-    SDL_Texture *position_title_texture = SDL_CreateTextureFromSurface(renderer, position_title_surface);
-    SDL_Rect position_title_texture_rect;
-    position_title_texture_rect.w = position_title_surface->w;
-    position_title_texture_rect.h = position_title_surface->h;
-    position_title_texture_rect.x = (camera->w / 2) + (section_width / 2) - (position_title_texture_rect.w / 2);
-    position_title_texture_rect.y = box_rect.y + inner_padding;
-    SDL_RenderCopy(renderer, position_title_texture, NULL, &position_title_texture_rect);
-    SDL_FreeSurface(position_title_surface);
+    TextLabel *position_title_label = text_get_label(position_title, FONT_SIZE_12, colors[COLOR_WHITE_100]);
+    SDL_Rect position_title_rect;
+    position_title_rect.w = position_title_label->w;
+    position_title_rect.h = position_title_label->h;
+    position_title_rect.x = (camera->w / 2) + (section_width / 2) - (position_title_rect.w / 2);
+    position_title_rect.y = box_rect.y + inner_padding;
+    text_draw_label(position_title_label, position_title_rect.x, position_title_rect.y);
 
     char position_x_value[32];
     memset(position_x_value, 0, sizeof(position_x_value));
@@ -197,15 +190,13 @@ void console_draw_position_console(const GameState *game_state, const Navigation
     memset(position_x_text, 0, sizeof(position_x_value));
     utils_add_thousand_separators((int)offset.x, position_x_value, sizeof(position_x_value));
     sprintf(position_x_text, "X: %*s%s", 1, "", position_x_value);
-    SDL_Surface *position_x_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_12], position_x_text, colors[COLOR_WHITE_140]);
-    SDL_Texture *position_x_texture = SDL_CreateTextureFromSurface(renderer, position_x_surface);
-    SDL_Rect position_x_texture_rect;
-    position_x_texture_rect.w = position_x_surface->w;
-    position_x_texture_rect.h = position_x_surface->h;
-    position_x_texture_rect.x = (camera->w / 2);
-    position_x_texture_rect.y = box_rect.y + 3 * inner_padding;
-    SDL_RenderCopy(renderer, position_x_texture, NULL, &position_x_texture_rect);
-    SDL_FreeSurface(position_x_surface);
+    TextLabel *position_x_label = text_get_label(position_x_text, FONT_SIZE_12, colors[COLOR_WHITE_140]);
+    SDL_Rect position_x_rect;
+    position_x_rect.w = position_x_label->w;
+    position_x_rect.h = position_x_label->h;
+    position_x_rect.x = (camera->w / 2);
+    position_x_rect.y = box_rect.y + 3 * inner_padding;
+    text_draw_label(position_x_label, position_x_rect.x, position_x_rect.y);
 
     char position_y_value[32];
     memset(position_y_value, 0, sizeof(position_y_value));
@@ -213,27 +204,15 @@ void console_draw_position_console(const GameState *game_state, const Navigation
     memset(position_y_text, 0, sizeof(position_y_value));
     utils_add_thousand_separators((int)offset.y, position_y_value, sizeof(position_y_value));
     sprintf(position_y_text, "Y: %*s%s", 1, "", position_y_value);
-    SDL_Surface *position_y_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_12], position_y_text, colors[COLOR_WHITE_140]);
-    SDL_Texture *position_y_texture = SDL_CreateTextureFromSurface(renderer, position_y_surface);
-    SDL_Rect position_y_texture_rect;
-    position_y_texture_rect.w = position_y_surface->w;
-    position_y_texture_rect.h = position_y_surface->h;
-    position_y_texture_rect.x = (camera->w / 2);
-    position_y_texture_rect.y = box_rect.y + 5 * inner_padding;
-    SDL_RenderCopy(renderer, position_y_texture, NULL, &position_y_texture_rect);
-    SDL_FreeSurface(position_y_surface);
-
-    // Destroy the textures
-    SDL_DestroyTexture(zoom_title_texture);
-    zoom_title_texture = NULL;
-    SDL_DestroyTexture(zoom_value_texture);
-    zoom_value_texture = NULL;
-    SDL_DestroyTexture(position_title_texture);
-    position_title_texture = NULL;
-    SDL_DestroyTexture(position_x_texture);
-    position_x_texture = NULL;
-    SDL_DestroyTexture(position_y_texture);
-    position_y_texture = NULL;
+    TextLabel *position_y_label = text_get_label(position_y_text, FONT_SIZE_12, colors[COLOR_WHITE_140]);
+    SDL_Rect position_y_rect;
+    position_y_rect.w = position_y_label->w;
+    position_y_rect.h = position_y_label->h;
+    position_y_rect.x = (camera->w / 2);
+    position_y_rect.y = box_rect.y + 5 * inner_padding;
+    text_draw_label(position_y_label, position_y_rect.x, position_y_rect.y);
+
+    render_set_layer(previous_layer);
 }
 
 /**
@@ -249,8 +228,10 @@ void console_draw_position_console(const GameState *game_state, const Navigation
  */
 void console_draw_ship_console(const GameState *game_state, const InputState *input_state, const NavigationState *nav_state, const Ship *ship, const Camera *camera)
 {
+    unsigned short previous_layer = render_set_layer(RENDER_LAYER_UI);
+
     // Draw background box
-    SDL_SetRenderDrawColor(renderer, 12, 12, 12, 230);
+    render_set_draw_color(12, 12, 12, 230);
     int box_width = 500;
     int box_height = 70;
     int padding = INFO_BOX_PADDING;
@@ -262,10 +243,10 @@ void console_draw_ship_console(const GameState *game_state, const InputState *in
     box_rect.w = box_width;
     box_rect.h = box_height;
 
-    SDL_RenderFillRect(renderer, &box_rect);
+    render_fill_rect(&box_rect);
 
     // Draw separator lines
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 20);
+    render_set_draw_color(255, 255, 255, 20);
 
     int section_width = 100;
     int separator_1_x = (camera->w / 2) - 1.5 * section_width;
@@ -275,36 +256,32 @@ void console_draw_ship_console(const GameState *game_state, const InputState *in
     int separator_y1 = camera->h - (box_height + padding);
     int separator_y2 = separator_y1 + box_height;
 
-    SDL_RenderDrawLine(renderer, separator_1_x, separator_y1, separator_1_x, separator_y2);
-    SDL_RenderDrawLine(renderer, separator_2_x, separator_y1, separator_2_x, separator_y2);
-    SDL_RenderDrawLine(renderer, separator_3_x, separator_y1, separator_3_x, separator_y2);
-    SDL_RenderDrawLine(renderer, separator_4_x, separator_y1, separator_4_x, separator_y2);
+    render_draw_line(separator_1_x, separator_y1, separator_1_x, separator_y2);
+    render_draw_line(separator_2_x, separator_y1, separator_2_x, separator_y2);
+    render_draw_line(separator_3_x, separator_y1, separator_3_x, separator_y2);
+    render_draw_line(separator_4_x, separator_y1, separator_4_x, separator_y2);
 
     // Zoom
     char *zoom_title = "ZOOM";
-    SDL_Surface *zoom_title_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_12], zoom_title, colors[COLOR_WHITE_100]);
-    SDL_Texture *zoom_title_texture = SDL_CreateTextureFromSurface(renderer, zoom_title_surface);
-    SDL_Rect zoom_title_texture_rect;
-    zoom_title_texture_rect.w = zoom_title_surface->w;
-    zoom_title_texture_rect.h = zoom_title_surface->h;
-    zoom_title_texture_rect.x = (camera->w / 2) - 2 * section_width - (zoom_title_texture_rect.w / 2);
-    zoom_title_texture_rect.y = box_rect.y + inner_padding;
-    SDL_RenderCopy(renderer, zoom_title_texture, NULL, &zoom_title_texture_rect);
-    SDL_FreeSurface(zoom_title_surface);
+    TextLabel *zoom_title_label = text_get_label(zoom_title, FONT_SIZE_12, colors[COLOR_WHITE_100]);
+    SDL_Rect zoom_title_rect;
+    zoom_title_rect.w = zoom_title_label->w;
+    zoom_title_rect.h = zoom_title_label->h;
+    zoom_title_rect.x = (camera->w / 2) - 2 * section_width - (zoom_title_rect.w / 2);
+    zoom_title_rect.y = box_rect.y + inner_padding;
+    text_draw_label(zoom_title_label, zoom_title_rect.x, zoom_title_rect.y);
 
     char zoom_value[16];
     memset(zoom_value, 0, sizeof(zoom_value));
     sprintf(zoom_value, "%.2Lf", 100 * game_state->game_scale);
 
-    SDL_Surface *zoom_value_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_15], zoom_value, colors[COLOR_WHITE_180]);
-    SDL_Texture *zoom_value_texture = SDL_CreateTextureFromSurface(renderer, zoom_value_surface);
-    SDL_Rect zoom_value_texture_rect;
-    zoom_value_texture_rect.w = zoom_value_surface->w;
-    zoom_value_texture_rect.h = zoom_value_surface->h;
-    zoom_value_texture_rect.x = (camera->w / 2) - 2 * section_width - (zoom_value_texture_rect.w / 2);
-    zoom_value_texture_rect.y = box_rect.y + 3.4 * inner_padding;
-    SDL_RenderCopy(renderer, zoom_value_texture, NULL, &zoom_value_texture_rect);
-    SDL_FreeSurface(zoom_value_surface);
+    TextLabel *zoom_value_label = text_get_label(zoom_value, FONT_SIZE_15, colors[COLOR_WHITE_180]);
+    SDL_Rect zoom_value_rect;
+    zoom_value_rect.w = zoom_value_label->w;
+    zoom_value_rect.h = zoom_value_label->h;
+    zoom_value_rect.x = (camera->w / 2) - 2 * section_width - (zoom_value_rect.w / 2);
+    zoom_value_rect.y = box_rect.y + 3.4 * inner_padding;
+    text_draw_label(zoom_value_label, zoom_value_rect.x, zoom_value_rect.y);
 
     // Velocity vector
     Point center = {.x = (camera->w / 2) - 1 * section_width,
@@ -313,15 +290,13 @@ void console_draw_ship_console(const GameState *game_state, const InputState *in
 
     // Speed
     char *speed_title = "SPEED";
-    SDL_Surface *speed_title_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_12], speed_title, colors[COLOR_WHITE_100]);
-    SDL_Texture *speed_title_texture = SDL_CreateTextureFromSurface(renderer, speed_title_surface);
-    SDL_Rect speed_title_texture_rect;
-    speed_title_texture_rect.w = speed_title_surface->w;
-    speed_title_texture_rect.h = speed_title_surface->h;
-    speed_title_texture_rect.x = (camera->w / 2) + 0 * section_width - (speed_title_texture_rect.w / 2);
-    speed_title_texture_rect.y = box_rect.y + inner_padding;
-    SDL_RenderCopy(renderer, speed_title_texture, NULL, &speed_title_texture_rect);
-    SDL_FreeSurface(speed_title_surface);
+    TextLabel *speed_title_label = text_get_label(speed_title, FONT_SIZE_12, colors[COLOR_WHITE_100]);
+    SDL_Rect speed_title_rect;
+    speed_title_rect.w = speed_title_label->w;
+    speed_title_rect.h = speed_title_label->h;
+    speed_title_rect.x = (camera->w / 2) + 0 * section_width - (speed_title_rect.w / 2);
+    speed_title_rect.y = box_rect.y + inner_padding;
+    text_draw_label(speed_title_label, speed_title_rect.x, speed_title_rect.y);
 
     char speed_value[16];
     memset(speed_value, 0, sizeof(speed_value));
@@ -337,65 +312,55 @@ void console_draw_ship_console(const GameState *game_state, const InputState *in
         speed_corrected = star_speed_limit;
 
     sprintf(speed_value, "%d", (int)speed_corrected);
-    SDL_Surface *speed_value_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_22], speed_value, colors[COLOR_WHITE_180]);
-    SDL_Texture *speed_value_texture = SDL_CreateTextureFromSurface(renderer, speed_value_surface);
-    SDL_Rect speed_value_texture_rect;
-    speed_value_texture_rect.w = speed_value_surface->w;
-    speed_value_texture_rect.h = speed_value_surface->h;
-    speed_value_texture_rect.x = (camera->w / 2) + 0 * section_width - (speed_value_texture_rect.w / 2);
-    speed_value_texture_rect.y = box_rect.y + 3.4 * inner_padding;
-    SDL_RenderCopy(renderer, speed_value_texture, NULL, &speed_value_texture_rect);
-    SDL_FreeSurface(speed_value_surface);
+    TextLabel *speed_value_label = text_get_label(speed_value, FONT_SIZE_22, colors[COLOR_WHITE_180]);
+    SDL_Rect speed_value_rect;
+    speed_value_rect.w = speed_value_label->w;
+    speed_value_rect.h = speed_value_label->h;
+    speed_value_rect.x = (camera->w / 2) + 0 * section_width - (speed_value_rect.w / 2);
+    speed_value_rect.y = box_rect.y + 3.4 * inner_padding;
+    text_draw_label(speed_value_label, speed_value_rect.x, speed_value_rect.y);
 
     // Position
     char *position_title = "POSITION";
-    SDL_Surface *position_title_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_12], position_title, colors[COLOR_WHITE_100]);
-    SDL_Texture *position_title_texture = SDL_CreateTextureFromSurface(renderer, position_title_surface);
-    SDL_Rect position_title_texture_rect;
-    position_title_texture_rect.w = position_title_surface->w;
-    position_title_texture_rect.h = position_title_surface->h;
-    position_title_texture_rect.x = (camera->w / 2) + 1 * section_width - (position_title_texture_rect.w / 2);
-    position_title_texture_rect.y = box_rect.y + inner_padding;
-    SDL_RenderCopy(renderer, position_title_texture, NULL, &position_title_texture_rect);
-    SDL_FreeSurface(position_title_surface);
+    TextLabel *position_title_label = text_get_label(position_title, FONT_SIZE_12, colors[COLOR_WHITE_100]);
+    SDL_Rect position_title_rect;
+    position_title_rect.w = position_title_label->w;
+    position_title_rect.h = position_title_label->h;
+    position_title_rect.x = (camera->w / 2) + 1 * section_width - (position_title_rect.w / 2);
+    position_title_rect.y = box_rect.y + inner_padding;
+    text_draw_label(position_title_label, position_title_rect.x, position_title_rect.y);
 
     char position_x_value[32];
     memset(position_x_value, 0, sizeof(position_x_value));
     utils_add_thousand_separators((int)nav_state->navigate_offset.x, position_x_value, sizeof(position_x_value));
-    SDL_Surface *position_x_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_12], position_x_value, colors[COLOR_WHITE_140]);
-    SDL_Texture *position_x_texture = SDL_CreateTextureFromSurface(renderer, position_x_surface);
-    SDL_Rect position_x_texture_rect;
-    position_x_texture_rect.w = position_x_surface->w;
-    position_x_texture_rect.h = position_x_surface->h;
-    position_x_texture_rect.x = (camera->w / 2) + 1 * section_width - (position_x_texture_rect.w / 2);
-    position_x_texture_rect.y = box_rect.y + 3 * inner_padding;
-    SDL_RenderCopy(renderer, position_x_texture, NULL, &position_x_texture_rect);
-    SDL_FreeSurface(position_x_surface);
+    TextLabel *position_x_label = text_get_label(position_x_value, FONT_SIZE_12, colors[COLOR_WHITE_140]);
+    SDL_Rect position_x_rect;
+    position_x_rect.w = position_x_label->w;
+    position_x_rect.h = position_x_label->h;
+    position_x_rect.x = (camera->w / 2) + 1 * section_width - (position_x_rect.w / 2);
+    position_x_rect.y = box_rect.y + 3 * inner_padding;
+    text_draw_label(position_x_label, position_x_rect.x, position_x_rect.y);
 
     char position_y_value[32];
     memset(position_y_value, 0, sizeof(position_y_value));
     utils_add_thousand_separators((int)nav_state->navigate_offset.y, position_y_value, sizeof(position_y_value));
-    SDL_Surface *position_y_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_12], position_y_value, colors[COLOR_WHITE_140]);
-    SDL_Texture *position_y_texture = SDL_CreateTextureFromSurface(renderer, position_y_surface);
-    SDL_Rect position_y_texture_rect;
-    position_y_texture_rect.w = position_y_surface->w;
-    position_y_texture_rect.h = position_y_surface->h;
-    position_y_texture_rect.x = (camera->w / 2) + 1 * section_width - (position_x_texture_rect.w / 2);
-    position_y_texture_rect.y = box_rect.y + 5 * inner_padding;
-    SDL_RenderCopy(renderer, position_y_texture, NULL, &position_y_texture_rect);
-    SDL_FreeSurface(position_y_surface);
+    TextLabel *position_y_label = text_get_label(position_y_value, FONT_SIZE_12, colors[COLOR_WHITE_140]);
+    SDL_Rect position_y_rect;
+    position_y_rect.w = position_y_label->w;
+    position_y_rect.h = position_y_label->h;
+    position_y_rect.x = (camera->w / 2) + 1 * section_width - (position_x_rect.w / 2);
+    position_y_rect.y = box_rect.y + 5 * inner_padding;
+    text_draw_label(position_y_label, position_y_rect.x, position_y_rect.y);
 
     // Autopilot
     char *autopilot_title = "AUTOPILOT";
-    SDL_Surface *autopilot_title_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_12], autopilot_title, colors[COLOR_WHITE_100]);
-    SDL_Texture *autopilot_title_texture = SDL_CreateTextureFromSurface(renderer, autopilot_title_surface);
-    SDL_Rect autopilot_title_texture_rect;
-    autopilot_title_texture_rect.w = autopilot_title_surface->w;
-    autopilot_title_texture_rect.h = autopilot_title_surface->h;
-    autopilot_title_texture_rect.x = (camera->w / 2) + 2 * section_width - (autopilot_title_texture_rect.w / 2);
-    autopilot_title_texture_rect.y = box_rect.y + inner_padding;
-    SDL_RenderCopy(renderer, autopilot_title_texture, NULL, &autopilot_title_texture_rect);
-    SDL_FreeSurface(autopilot_title_surface);
+    TextLabel *autopilot_title_label = text_get_label(autopilot_title, FONT_SIZE_12, colors[COLOR_WHITE_100]);
+    SDL_Rect autopilot_title_rect;
+    autopilot_title_rect.w = autopilot_title_label->w;
+    autopilot_title_rect.h = autopilot_title_label->h;
+    autopilot_title_rect.x = (camera->w / 2) + 2 * section_width - (autopilot_title_rect.w / 2);
+    autopilot_title_rect.y = box_rect.y + inner_padding;
+    text_draw_label(autopilot_title_label, autopilot_title_rect.x, autopilot_title_rect.y);
 
     char autopilot_value[16];
     SDL_Color autopilot_color;
@@ -410,35 +375,15 @@ void console_draw_ship_console(const GameState *game_state, const InputState *in
         sprintf(autopilot_value, "%s", "OFF");
         autopilot_color = colors[COLOR_RED];
     }
-    SDL_Surface *autopilot_value_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_18], autopilot_value, autopilot_color);
-    SDL_Texture *autopilot_value_texture = SDL_CreateTextureFromSurface(renderer, autopilot_value_surface);
-    SDL_Rect autopilot_value_texture_rect;
-    autopilot_value_texture_rect.w = autopilot_value_surface->w;
-    autopilot_value_texture_rect.h = autopilot_value_surface->h;
-    autopilot_value_texture_rect.x = (camera->w / 2) + 2 * section_width - (autopilot_value_texture_rect.w / 2);
-    autopilot_value_texture_rect.y = box_rect.y + 3.4 * inner_padding;
-    SDL_RenderCopy(renderer, autopilot_value_texture, NULL, &autopilot_value_texture_rect);
-    SDL_FreeSurface(autopilot_value_surface);
-
-    // Destroy the textures
-    SDL_DestroyTexture(zoom_title_texture);
-    zoom_title_texture = NULL;
-    SDL_DestroyTexture(zoom_value_texture);
-    zoom_value_texture = NULL;
-    SDL_DestroyTexture(speed_title_texture);
-    speed_title_texture = NULL;
-    SDL_DestroyTexture(speed_value_texture);
-    speed_value_texture = NULL;
-    SDL_DestroyTexture(position_title_texture);
-    position_title_texture = NULL;
-    SDL_DestroyTexture(position_x_texture);
-    position_x_texture = NULL;
-    SDL_DestroyTexture(position_y_texture);
-    position_y_texture = NULL;
-    SDL_DestroyTexture(autopilot_title_texture);
-    autopilot_title_texture = NULL;
-    SDL_DestroyTexture(autopilot_value_texture);
-    autopilot_value_texture = NULL;
+    TextLabel *autopilot_value_label = text_get_label(autopilot_value, FONT_SIZE_18, autopilot_color);
+    SDL_Rect autopilot_value_rect;
+    autopilot_value_rect.w = autopilot_value_label->w;
+    autopilot_value_rect.h = autopilot_value_label->h;
+    autopilot_value_rect.x = (camera->w / 2) + 2 * section_width - (autopilot_value_rect.w / 2);
+    autopilot_value_rect.y = box_rect.y + 3.4 * inner_padding;
+    text_draw_label(autopilot_value_label, autopilot_value_rect.x, autopilot_value_rect.y);
+
+    render_set_layer(previous_layer);
 }
 
 /**
@@ -451,8 +396,10 @@ void console_draw_ship_console(const GameState *game_state, const InputState *in
  */
 void console_draw_star_console(const Star *star, const Camera *camera)
 {
+    unsigned short previous_layer = render_set_layer(RENDER_LAYER_UI);
+
     // Draw background box
-    SDL_SetRenderDrawColor(renderer, 12, 12, 12, 230);
+    render_set_draw_color(12, 12, 12, 230);
     int box_width = INFO_BOX_WIDTH;
     int box_height = 70;
     int padding = INFO_BOX_PADDING;
@@ -464,28 +411,26 @@ void console_draw_star_console(const Star *star, const Camera *camera)
     box_rect.w = box_width;
     box_rect.h = box_height;
 
-    SDL_RenderFillRect(renderer, &box_rect);
+    render_fill_rect(&box_rect);
 
     // Star name
     char star_name[128];
     memset(star_name, 0, sizeof(star_name));
     sprintf(star_name, "%s", star->name);
-    SDL_Surface *star_name_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_18], star_name, colors[COLOR_WHITE_140]);
-    SDL_Texture *star_name_texture = SDL_CreateTextureFromSurface(renderer, star_name_surface);
-    SDL_Rect star_name_texture_rect;
-    star_name_texture_rect.w = star_name_surface->w;
-    star_name_texture_rect.h = star_name_surface->h;
-    star_name_texture_rect.x = camera->w - (box_width + padding) + 1.5 * padding + inner_padding;
-    star_name_texture_rect.y = camera->h - padding - (box_height / 2) - (star_name_texture_rect.h / 2) + 1;
-    SDL_RenderCopy(renderer, star_name_texture, NULL, &star_name_texture_rect);
-    SDL_FreeSurface(star_name_surface);
-    SDL_DestroyTexture(star_name_texture);
-    star_name_texture = NULL;
+    TextLabel *star_name_label = text_get_label(star_name, FONT_SIZE_18, colors[COLOR_WHITE_140]);
+    SDL_Rect star_name_rect;
+    star_name_rect.w = star_name_label->w;
+    star_name_rect.h = star_name_label->h;
+    star_name_rect.x = camera->w - (box_width + padding) + 1.5 * padding + inner_padding;
+    star_name_rect.y = camera->h - padding - (box_height / 2) - (star_name_rect.h / 2) + 1;
+    text_draw_label(star_name_label, star_name_rect.x, star_name_rect.y);
 
     // Star circle
     int x_star = camera->w - (box_width + padding) + inner_padding + 5;
-    int y_star = star_name_texture_rect.y - 2 + padding / 2;
+    int y_star = star_name_rect.y - 2 + padding / 2;
     gfx_draw_fill_circle(renderer, x_star, y_star, 8, star->color);
+
+    render_set_layer(previous_layer);
 }
 
 /**
@@ -519,8 +464,8 @@ static void console_draw_velocity_vector(const Ship *ship, Point center, const C
     float end_x = center.x + velocity_x * VELOCITY_VECTOR_LENGTH;
     float end_y = center.y + velocity_y * VELOCITY_VECTOR_LENGTH;
 
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 100);
-    SDL_RenderDrawLine(renderer, (int)start_x, (int)start_y, (int)end_x, (int)end_y);
+    render_set_draw_color(255, 255, 255, 100);
+    render_draw_line((int)start_x, (int)start_y, (int)end_x, (int)end_y);
 
     // Calculate the position of the arrow points
     float arrow_x1 = end_x - velocity_x * ARROW_SIZE + velocity_y * ARROW_SIZE / 2;
@@ -529,9 +474,9 @@ static void console_draw_velocity_vector(const Ship *ship, Point center, const C
     float arrow_y2 = end_y - velocity_y * ARROW_SIZE + velocity_x * ARROW_SIZE / 2;
 
     // Draw the arrow
-    SDL_RenderDrawLine(renderer, (int)end_x, (int)end_y, (int)arrow_x1, (int)arrow_y1);
-    SDL_RenderDrawLine(renderer, (int)end_x, (int)end_y, (int)arrow_x2, (int)arrow_y2);
-    SDL_RenderDrawLine(renderer, (int)arrow_x1, (int)arrow_y1, (int)arrow_x2, (int)arrow_y2);
+    render_draw_line((int)end_x, (int)end_y, (int)arrow_x1, (int)arrow_y1);
+    render_draw_line((int)end_x, (int)end_y, (int)arrow_x2, (int)arrow_y2);
+    render_draw_line((int)arrow_x1, (int)arrow_y1, (int)arrow_x2, (int)arrow_y2);
 
     // Draw circle around vector
     gfx_draw_circle(renderer, camera, center.x, center.y, 20, colors[COLOR_CYAN_70]);
@@ -548,8 +493,10 @@ static void console_draw_velocity_vector(const Ship *ship, Point center, const C
  */
 void console_draw_waypoint_console(const NavigationState *nav_state, const Ship *ship, const Camera *camera)
 {
+    unsigned short previous_layer = render_set_layer(RENDER_LAYER_UI);
+
     // Draw background box
-    SDL_SetRenderDrawColor(renderer, 12, 12, 12, 230);
+    render_set_draw_color(12, 12, 12, 230);
     int box_width = INFO_BOX_WIDTH;
     int box_height = 110;
     int padding = INFO_BOX_PADDING;
@@ -562,41 +509,36 @@ void console_draw_waypoint_console(const NavigationState *nav_state, const Ship
     box_rect.w = box_width;
     box_rect.h = box_height;
 
-    SDL_RenderFillRect(renderer, &box_rect);
+    render_fill_rect(&box_rect);
 
     // Star name
     char star_name[128];
     memset(star_name, 0, sizeof(star_name));
     sprintf(star_name, "%s", nav_state->waypoint_star->name);
-    SDL_Surface *star_name_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_18], star_name, colors[COLOR_WHITE_140]);
-    SDL_Texture *star_name_texture = SDL_CreateTextureFromSurface(renderer, star_name_surface);
-    SDL_Rect star_name_texture_rect;
-    star_name_texture_rect.w = star_name_surface->w;
-    star_name_texture_rect.h = star_name_surface->h;
-    star_name_texture_rect.x = camera->w - (box_width + padding) + 1.5 * padding + inner_padding;
-    star_name_texture_rect.y = camera->h - (box_height + padding) + (star_name_height - star_name_texture_rect.h) / 2 + 1;
-    SDL_RenderCopy(renderer, star_name_texture, NULL, &star_name_texture_rect);
-    SDL_FreeSurface(star_name_surface);
-    SDL_DestroyTexture(star_name_texture);
-    star_name_texture = NULL;
+    TextLabel *star_name_label = text_get_label(star_name, FONT_SIZE_18, colors[COLOR_WHITE_140]);
+    SDL_Rect star_name_rect;
+    star_name_rect.w = star_name_label->w;
+    star_name_rect.h = star_name_label->h;
+    star_name_rect.x = camera->w - (box_width + padding) + 1.5 * padding + inner_padding;
+    star_name_rect.y = camera->h - (box_height + padding) + (star_name_height - star_name_rect.h) / 2 + 1;
+    text_draw_label(star_name_label, star_name_rect.x, star_name_rect.y);
 
     // Star diamond
     int x_star = camera->w - (box_width + padding) + inner_padding + 5;
-    int y_star = star_name_texture_rect.y - 2 + padding / 2;
+    int y_star = star_name_rect.y - 2 + padding / 2;
     gfx_draw_diamond(renderer, x_star, y_star, PROJECTION_RADIUS + 6, nav_state->waypoint_star->color);
     gfx_draw_fill_diamond(renderer, x_star, y_star, PROJECTION_RADIUS, nav_state->waypoint_star->color);
 
-    // Distance
-    double distance_waypoint = 0.0;
-
-    for (int i = nav_state->next_path_point; i < nav_state->waypoint_star->waypoint_points - 1; i++)
-    {
-        distance_waypoint += maths_distance_between_points(nav_state->waypoint_star->waypoint_path[i].position.x, nav_state->waypoint_star->waypoint_path[i].position.y,
-                                                           nav_state->waypoint_star->waypoint_path[i + 1].position.x, nav_state->waypoint_star->waypoint_path[i + 1].position.y);
-    }
+    // Distance along the path from the point closest to the ship
+    const WaypointPath *path = nav_state->waypoint_star->waypoint_path;
+    int segment = path_find_nearest_segment(path, ship->position, nav_state->next_path_point - 1);
+    double distance_waypoint;
 
-    distance_waypoint += maths_distance_between_points(nav_state->waypoint_star->waypoint_path[nav_state->next_path_point].position.x, nav_state->waypoint_star->waypoint_path[nav_state->next_path_point].position.y,
-                                                       ship->position.x, ship->position.y);
+    if (segment >= 0)
+        distance_waypoint = path_get_remaining_length(path, 0) - path_get_progress(path, segment, ship->position);
+    else
+        distance_waypoint = maths_distance_between_points(path->points[path->num_points - 1].position.x, path->points[path->num_points - 1].position.y,
+                                                          ship->position.x, ship->position.y);
 
     char distance_text[16];
     memset(distance_text, 0, sizeof(distance_text));
@@ -606,7 +548,10 @@ void console_draw_waypoint_console(const NavigationState *nav_state, const Ship
     char time_text[16];
     memset(time_text, 0, sizeof(time_text));
 
-    if (nav_state->velocity.magnitude > 5)
+    // Show progress while the route is planned
+    if (route_is_planning())
+        sprintf(time_text, "route %d%%", (int)(route_get_progress() * 100));
+    else if (nav_state->velocity.magnitude > 5)
     {
         int seconds = distance_waypoint / nav_state->velocity.magnitude;
         utils_convert_seconds_to_time_string(seconds, time_text);
@@ -618,16 +563,15 @@ void console_draw_waypoint_console(const NavigationState *nav_state, const Ship
     memset(distance_row_text, 0, sizeof(distance_row_text));
     sprintf(distance_row_text, "Distance: %*s %s %*s (%s)", 1, "", distance_text, 1, "", time_text);
 
-    SDL_Surface *distance_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_14], distance_row_text, colors[COLOR_WHITE_140]);
-    SDL_Texture *distance_texture = SDL_CreateTextureFromSurface(renderer, distance_surface);
-    SDL_Rect distance_texture_rect = {.x = camera->w - (box_width - 2.5 * padding),
+    TextLabel *distance_label = text_get_label(distance_row_text, FONT_SIZE_14, colors[COLOR_WHITE_140]);
+    SDL_Rect distance_rect = {.x = camera->w - (box_width - 2.5 * padding),
                                       .y = camera->h - (box_height + padding) + star_name_height,
-                                      .w = distance_surface->w,
-                                      .h = distance_surface->h};
+                                      .w = distance_label->w,
+                                      .h = distance_label->h};
+
+    text_draw_label(distance_label, distance_rect.x, distance_rect.y);
 
-    SDL_FreeSurface(distance_surface);
-    SDL_RenderCopy(renderer, distance_texture, NULL, &distance_texture_rect);
-    SDL_DestroyTexture(distance_texture);
+    render_set_layer(previous_layer);
 }
 
 /**
@@ -13,7 +13,6 @@
 #include "../include/controls.h"
 
 // External variable definitions
-extern TTF_Font *fonts[];
 extern SDL_Renderer *renderer;
 extern SDL_Color colors[];
 
@@ -124,13 +123,19 @@ void controls_create_table(GameState *game_state, const Camera *camera)
 
     // General Controls
     sprintf(game_state->controls_groups[3].title, "%s", "General controls");
-    game_state->controls_groups[3].num_controls = 2;
+    game_state->controls_groups[3].num_controls = 5;
 
     sprintf(game_state->controls_groups[3].controls[0].key, "%s", "F");
-    sprintf(game_state->controls_groups[3].controls[1].key, "%s", "Esc");
+    sprintf(game_state->controls_groups[3].controls[1].key, "%s", "K");
+    sprintf(game_state->controls_groups[3].controls[2].key, "%s", "P");
+    sprintf(game_state->controls_groups[3].controls[3].key, "%s", "T");
+    sprintf(game_state->controls_groups[3].controls[4].key, "%s", "Esc");
 
     sprintf(game_state->controls_groups[3].controls[0].description, "%s", "Toggle FPS");
-    sprintf(game_state->controls_groups[3].controls[1].description, "%s", "Show menu / Pause");
+    sprintf(game_state->controls_groups[3].controls[1].description, "%s", "Toggle counters");
+    sprintf(game_state->controls_groups[3].controls[2].description, "%s", "Toggle profiler");
+    sprintf(game_state->controls_groups[3].controls[3].description, "%s", "Capture trace");
+    sprintf(game_state->controls_groups[3].controls[4].description, "%s", "Show menu / Pause");
 
     // Initialize game_state variables
     int line_height = 50;
@@ -145,6 +150,8 @@ void controls_create_table(GameState *game_state, const Camera *camera)
     {
         game_state->table_num_rows += game_state->controls_groups[i].num_controls;
     }
+
+    compositor_invalidate(COMPOSITOR_CONTROLS_TABLE);
 }
 
 /**
@@ -157,107 +164,111 @@ void controls_create_table(GameState *game_state, const Camera *camera)
  */
 static void controls_draw_table(const GameState *game_state, const Camera *camera)
 {
-    int margin = 80;
-    int line_height = 50;
-    int padding = 10;
-
-    // Define the table rectangle
-    SDL_Rect table_rect = {
-        (camera->w / 2) - (camera->w / 4),
-        margin,
-        (camera->w / 2) + (camera->w / 4) - margin,
-        game_state->table_num_rows * (line_height + 2 * padding + 1) // Add 1 for border bottom
-    };
-
-    SDL_SetRenderDrawColor(renderer, 12, 12, 12, 230);
+    unsigned short previous_layer = render_set_layer(RENDER_LAYER_UI);
 
-    // Define the cell width and height
-    int cell_width = table_rect.w / 2;
-    int cell_height = line_height + 2 * padding + 1;
+    // The table is redrawn only when it is scrolled
+    Uint32 key = compositor_hash(0, &game_state->table_top_row, sizeof(game_state->table_top_row));
+    key = compositor_hash(key, &game_state->table_num_rows, sizeof(game_state->table_num_rows));
+    key = compositor_hash(key, &game_state->table_num_rows_displayed, sizeof(game_state->table_num_rows_displayed));
 
-    // Define the starting coordinates for the first cell
-    int x = table_rect.x;
-    int y = table_rect.y - (game_state->table_top_row * cell_height);
-
-    // Loop through groups
-    for (int i = 0; i < MAX_CONTROLS_GROUPS && y < table_rect.y + table_rect.h; i++)
+    if (compositor_begin_layer(COMPOSITOR_CONTROLS_TABLE, key))
     {
-        if (y >= margin && y < camera->h - margin - cell_height / 2)
-        {
-            // Render the group title
-            SDL_Surface *title_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_26], game_state->controls_groups[i].title, colors[COLOR_WHITE_140]);
-            SDL_Texture *title_texture = SDL_CreateTextureFromSurface(renderer, title_surface);
-            SDL_Rect title_rect = {
-                x + padding,
-                y + padding + (line_height / 2) - (title_surface->h / 2),
-                title_surface->w,
-                title_surface->h};
-            SDL_RenderCopy(renderer, title_texture, NULL, &title_rect);
-            SDL_FreeSurface(title_surface);
-            SDL_DestroyTexture(title_texture);
-        }
-
-        y += cell_height;
-
-        // Loop through the controls and render each cell
-        for (int j = 0; j < game_state->controls_groups[i].num_controls && y < table_rect.y + table_rect.h; j++)
+        int margin = 80;
+        int line_height = 50;
+        int padding = 10;
+
+        // Define the table rectangle
+        SDL_Rect table_rect = {
+            (camera->w / 2) - (camera->w / 4),
+            margin,
+            (camera->w / 2) + (camera->w / 4) - margin,
+            game_state->table_num_rows * (line_height + 2 * padding + 1) // Add 1 for border bottom
+        };
+
+        render_set_draw_color(12, 12, 12, 230);
+
+        // Define the cell width and height
+        int cell_width = table_rect.w / 2;
+        int cell_height = line_height + 2 * padding + 1;
+
+        // Define the starting coordinates for the first cell
+        int x = table_rect.x;
+        int y = table_rect.y - (game_state->table_top_row * cell_height);
+
+        // Loop through groups
+        for (int i = 0; i < MAX_CONTROLS_GROUPS && y < table_rect.y + table_rect.h; i++)
         {
             if (y >= margin && y < camera->h - margin - cell_height / 2)
             {
-                SDL_SetRenderDrawColor(renderer, 255, 255, 255, 25);
-                SDL_RenderDrawLine(renderer, table_rect.x, y, table_rect.x + table_rect.w, y);
-
-                // Render the control key and description
-                SDL_Surface *key_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_18], game_state->controls_groups[i].controls[j].key, colors[COLOR_WHITE_140]);
-                SDL_Texture *key_texture = SDL_CreateTextureFromSurface(renderer, key_surface);
-                SDL_Surface *description_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_18], game_state->controls_groups[i].controls[j].description, colors[COLOR_WHITE_140]);
-                SDL_Texture *description_texture = SDL_CreateTextureFromSurface(renderer, description_surface);
-
-                SDL_Rect key_rect = {
+                // Render the group title
+                TextLabel *title_label = text_get_label(game_state->controls_groups[i].title, FONT_SIZE_26, colors[COLOR_WHITE_140]);
+                SDL_Rect title_rect = {
                     x + padding,
-                    y + padding + (line_height / 2) - (key_surface->h / 2),
-                    key_surface->w,
-                    key_surface->h};
-                SDL_Rect description_rect = {
-                    x + padding + cell_width,
-                    y + padding + (line_height / 2) - (description_surface->h / 2),
-                    description_surface->w,
-                    description_surface->h};
-
-                SDL_RenderCopy(renderer, key_texture, NULL, &key_rect);
-                SDL_RenderCopy(renderer, description_texture, NULL, &description_rect);
-
-                SDL_FreeSurface(key_surface);
-                SDL_FreeSurface(description_surface);
-                SDL_DestroyTexture(key_texture);
-                SDL_DestroyTexture(description_texture);
+                    y + padding + (line_height / 2) - (title_label->h / 2),
+                    title_label->w,
+                    title_label->h};
+                text_draw_label(title_label, title_rect.x, title_rect.y);
             }
 
-            // Update the y coordinate for the next cell
             y += cell_height;
-        }
 
-        if (i < MAX_CONTROLS_GROUPS - 1)
-        {
-            if (y >= margin && y < camera->h - margin - cell_height / 2)
-                SDL_RenderDrawLine(renderer, table_rect.x, y, table_rect.x + table_rect.w, y);
+            // Loop through the controls and render each cell
+            for (int j = 0; j < game_state->controls_groups[i].num_controls && y < table_rect.y + table_rect.h; j++)
+            {
+                if (y >= margin && y < camera->h - margin - cell_height / 2)
+                {
+                    render_set_draw_color(255, 255, 255, 25);
+                    render_draw_line(table_rect.x, y, table_rect.x + table_rect.w, y);
+
+                    // Render the control key and description
+                    TextLabel *key_label = text_get_label(game_state->controls_groups[i].controls[j].key, FONT_SIZE_18, colors[COLOR_WHITE_140]);
+                    TextLabel *description_label = text_get_label(game_state->controls_groups[i].controls[j].description, FONT_SIZE_18, colors[COLOR_WHITE_140]);
+
+                    SDL_Rect key_rect = {
+                        x + padding,
+                        y + padding + (line_height / 2) - (key_label->h / 2),
+                        key_label->w,
+                        key_label->h};
+                    SDL_Rect description_rect = {
+                        x + padding + cell_width,
+                        y + padding + (line_height / 2) - (description_label->h / 2),
+                        description_label->w,
+                        description_label->h};
+
+                    text_draw_label(key_label, key_rect.x, key_rect.y);
+                    text_draw_label(description_label, description_rect.x, description_rect.y);
+                }
+
+                // Update the y coordinate for the next cell
+                y += cell_height;
+            }
 
-            // Add an empty row
-            y += cell_height;
+            if (i < MAX_CONTROLS_GROUPS - 1)
+            {
+                if (y >= margin && y < camera->h - margin - cell_height / 2)
+                    render_draw_line(table_rect.x, y, table_rect.x + table_rect.w, y);
+
+                // Add an empty row
+                y += cell_height;
+            }
         }
+
+        int total_height = camera->h - 2 * margin;
+        int scrollbar_height = total_height * game_state->table_num_rows_displayed / game_state->table_num_rows;
+        int scrollbar_y = margin + total_height * game_state->table_top_row / game_state->table_num_rows;
+
+        render_set_draw_color(200, 200, 200, 255);
+        SDL_Rect scrollbar_rect = {
+            table_rect.x + table_rect.w,
+            scrollbar_y,
+            10,
+            scrollbar_height};
+        render_fill_rect(&scrollbar_rect);
     }
 
-    int total_height = camera->h - 2 * margin;
-    int scrollbar_height = total_height * game_state->table_num_rows_displayed / game_state->table_num_rows;
-    int scrollbar_y = margin + total_height * game_state->table_top_row / game_state->table_num_rows;
-
-    SDL_SetRenderDrawColor(renderer, 200, 200, 200, 255);
-    SDL_Rect scrollbar_rect = {
-        table_rect.x + table_rect.w,
-        scrollbar_y,
-        10,
-        scrollbar_height};
-    SDL_RenderFillRect(renderer, &scrollbar_rect);
+    compositor_end_layer(COMPOSITOR_CONTROLS_TABLE);
+
+    render_set_layer(previous_layer);
 }
 
 /**
@@ -280,9 +291,9 @@ void controls_run_state(GameState *game_state, InputState *input_state, bool is_
     gfx_update_bstars_position(game_state->state, input_state->camera_on, nav_state, bstars, camera, speed, 0);
 
     // Draw logo
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
-    SDL_RenderFillRect(renderer, &game_state->logo.rect);
-    SDL_RenderCopy(renderer, game_state->logo.text_texture, NULL, &game_state->logo.texture_rect);
+    render_set_draw_color(0, 0, 0, 0);
+    render_fill_rect(&game_state->logo.rect);
+    render_copy(game_state->logo.text_texture, NULL, &game_state->logo.texture_rect);
 
     // Draw menu
     menu_draw_menu(game_state, input_state, is_game_started);
@@ -0,0 +1,277 @@
+/*
+ * counters.c
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include "../include/constants.h"
+#include "../include/enums.h"
+#include "../include/structs.h"
+#include "../include/counters.h"
+
+// External variable definitions
+extern SDL_Color colors[];
+
+// Static variable definitions
+static SDL_atomic_t frame_counts[COUNTER_COUNT]; // Counts of the current frame, added from any thread
+static int last_counts[COUNTER_COUNT];           // Counts of the previous frame
+static int peak_counts[COUNTER_COUNT];           // Highest count of a frame
+static long long total_counts[COUNTER_COUNT];
+static unsigned int num_frames = 0;
+static const char *counter_names[COUNTER_COUNT] = {"seeds bstars", "seeds gstars", "seeds galaxy sections", "seeds galaxies",
+                                                   "seeds star sections", "seeds stars", "seeds star systems",
+                                                   "stars created", "stars evicted", "galaxies created", "galaxies evicted",
+                                                   "star copy bytes", "galaxy copy bytes", "populate calls", "text textures",
+                                                   "draw calls"};
+
+// Static function prototypes
+static void counters_add_chain(CountersTable *, int length);
+static void counters_draw_table(const char *name, const CountersTable *, int x, int y);
+static void counters_measure_galaxies(GalaxyEntry *const galaxies[], CountersTable *);
+static void counters_measure_stars(StarEntry *const stars[], CountersTable *);
+static void counters_write_table(FILE *file, const char *name, const CountersTable *, int num_buckets);
+
+/**
+ * Adds to a counter of the current frame. Can be called from any thread.
+ *
+ * @param counter The counter.
+ * @param amount The amount to add.
+ *
+ * @return void
+ */
+void counters_add(unsigned short counter, int amount)
+{
+    SDL_AtomicAdd(&frame_counts[counter], amount);
+}
+
+/**
+ * Adds a chain of a hash table to the distribution of its chain lengths.
+ *
+ * @param table A pointer to the CountersTable.
+ * @param length The number of entries in the chain.
+ *
+ * @return void
+ */
+static void counters_add_chain(CountersTable *table, int length)
+{
+    if (length == 0)
+        return;
+
+    table->num_entries += length;
+    table->num_chains++;
+    table->max_length = MAX(table->max_length, length);
+    table->lengths[(length < 4 ? length : 4) - 1]++;
+}
+
+/**
+ * Draws the counters overlay: the counts of the previous frame, the highest count of a frame and the total
+ * of each counter, the chain lengths of the hash tables of stars and galaxies, and the render statistics
+ * of the last frame.
+ *
+ * @param nav_state A pointer to the current NavigationState object.
+ * @param camera A pointer to the current Camera object.
+ *
+ * @return void
+ */
+void counters_draw(const NavigationState *nav_state, const Camera *camera)
+{
+    unsigned short previous_layer = render_set_layer(RENDER_LAYER_UI);
+
+    int width = 420;
+    int row_height = 18;
+    int x = camera->w - width - 30;
+    int y = 30;
+
+    SDL_Rect background = {.x = x - 10, .y = y - 10, .w = width + 20, .h = (COUNTER_COUNT + 6) * row_height + 20};
+    render_set_draw_color(0, 0, 0, 160);
+    render_fill_rect(&background);
+
+    TextLabel *header_label = text_get_label("frame, peak, total", FONT_SIZE_14, colors[COLOR_WHITE_100]);
+    text_draw_label(header_label, x + 170, y);
+
+    for (int c = 0; c < COUNTER_COUNT; c++)
+    {
+        y += row_height;
+
+        TextLabel *name_label = text_get_label(counter_names[c], FONT_SIZE_14, colors[COLOR_WHITE_100]);
+        text_draw_label(name_label, x, y);
+
+        char counts_text[64];
+        sprintf(counts_text, "%9d %9d %12lld", last_counts[c], peak_counts[c], total_counts[c]);
+
+        TextLabel *counts_label = text_get_label(counts_text, FONT_SIZE_14, colors[COLOR_WHITE_100]);
+        text_draw_label(counts_label, x + 170, y);
+    }
+
+    // Chain lengths of the hash tables
+    CountersTable stars_table = {0};
+    CountersTable galaxies_table = {0};
+
+    counters_measure_stars(nav_state->stars, &stars_table);
+    counters_measure_galaxies(nav_state->galaxies, &galaxies_table);
+
+    y += 2 * row_height;
+
+    TextLabel *chains_label = text_get_label("entries, chains, max, 1, 2, 3, 4+", FONT_SIZE_14, colors[COLOR_WHITE_100]);
+    text_draw_label(chains_label, x + 170, y);
+
+    counters_draw_table("stars table", &stars_table, x, y + row_height);
+    counters_draw_table("galaxies table", &galaxies_table, x, y + 2 * row_height);
+
+    // Render statistics of the last frame
+    RenderStats stats = render_get_stats();
+    char stats_text[48];
+    sprintf(stats_text, "%d commands, %d batches", stats.commands, stats.batches);
+
+    TextLabel *render_label = text_get_label("render", FONT_SIZE_14, colors[COLOR_WHITE_100]);
+    text_draw_label(render_label, x, y + 4 * row_height);
+
+    TextLabel *stats_label = text_get_label(stats_text, FONT_SIZE_14, colors[COLOR_WHITE_100]);
+    text_draw_label(stats_label, x + 170, y + 4 * row_height);
+
+    render_set_layer(previous_layer);
+}
+
+/**
+ * Draws a row of the counters overlay with the chain lengths of a hash table.
+ *
+ * @param name The name of the table.
+ * @param table A pointer to the CountersTable.
+ * @param x The x coordinate of the row.
+ * @param y The y coordinate of the row.
+ *
+ * @return void
+ */
+static void counters_draw_table(const char *name, const CountersTable *table, int x, int y)
+{
+    TextLabel *name_label = text_get_label(name, FONT_SIZE_14, colors[COLOR_WHITE_100]);
+    text_draw_label(name_label, x, y);
+
+    char chains_text[64];
+    sprintf(chains_text, "%5d %5d %3d %5d %4d %3d %3d", table->num_entries, table->num_chains, table->max_length,
+            table->lengths[0], table->lengths[1], table->lengths[2], table->lengths[3]);
+
+    TextLabel *chains_label = text_get_label(chains_text, FONT_SIZE_14, colors[COLOR_WHITE_100]);
+    text_draw_label(chains_label, x + 170, y);
+}
+
+/**
+ * Ends a frame of the simulation. The counts of the frame are added to the totals and the peaks.
+ *
+ * @return void
+ */
+void counters_end_frame(void)
+{
+    for (int c = 0; c < COUNTER_COUNT; c++)
+    {
+        last_counts[c] = SDL_AtomicSet(&frame_counts[c], 0);
+        peak_counts[c] = MAX(peak_counts[c], last_counts[c]);
+        total_counts[c] += last_counts[c];
+    }
+
+    num_frames++;
+}
+
+/**
+ * Measures the chain lengths of a hash table of galaxies.
+ *
+ * @param galaxies An array of pointers to GalaxyEntry structures.
+ * @param table A pointer to the CountersTable to fill.
+ *
+ * @return void
+ */
+static void counters_measure_galaxies(GalaxyEntry *const galaxies[], CountersTable *table)
+{
+    for (int s = 0; s < MAX_GALAXIES; s++)
+    {
+        int length = 0;
+
+        for (GalaxyEntry *entry = galaxies[s]; entry != NULL; entry = entry->next)
+            length++;
+
+        counters_add_chain(table, length);
+    }
+}
+
+/**
+ * Measures the chain lengths of a hash table of stars.
+ *
+ * @param stars An array of pointers to StarEntry structures.
+ * @param table A pointer to the CountersTable to fill.
+ *
+ * @return void
+ */
+static void counters_measure_stars(StarEntry *const stars[], CountersTable *table)
+{
+    for (int s = 0; s < MAX_STARS; s++)
+    {
+        int length = 0;
+
+        for (StarEntry *entry = stars[s]; entry != NULL; entry = entry->next)
+            length++;
+
+        counters_add_chain(table, length);
+    }
+}
+
+/**
+ * Writes the totals of the counters, their mean and peak per frame, and the chain lengths
+ * of the hash tables of stars and galaxies at exit.
+ *
+ * @param path The path of the file.
+ * @param nav_state A pointer to the current NavigationState object.
+ *
+ * @return True if the file was written, false otherwise.
+ */
+bool counters_write(const char *path, const NavigationState *nav_state)
+{
+    FILE *file = fopen(path, "w");
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "Error: Could not open counters file %s.\n", path);
+        return false;
+    }
+
+    fprintf(file, "Counters over %u frames\n", num_frames);
+    fprintf(file, "%-22s %14s %12s %12s\n", "counter", "total", "per frame", "peak");
+
+    for (int c = 0; c < COUNTER_COUNT; c++)
+        fprintf(file, "%-22s %14lld %12.1f %12d\n", counter_names[c], total_counts[c],
+                num_frames > 0 ? (double)total_counts[c] / num_frames : 0, peak_counts[c]);
+
+    CountersTable stars_table = {0};
+    CountersTable galaxies_table = {0};
+
+    counters_measure_stars(nav_state->stars, &stars_table);
+    counters_measure_galaxies(nav_state->galaxies, &galaxies_table);
+
+    fprintf(file, "\n");
+    counters_write_table(file, "stars table", &stars_table, MAX_STARS);
+    counters_write_table(file, "galaxies table", &galaxies_table, MAX_GALAXIES);
+
+    fclose(file);
+
+    return true;
+}
+
+/**
+ * Writes the chain lengths of a hash table.
+ *
+ * @param file The file to write to.
+ * @param name The name of the table.
+ * @param table A pointer to the CountersTable.
+ * @param num_buckets The number of buckets of the table.
+ *
+ * @return void
+ */
+static void counters_write_table(FILE *file, const char *name, const CountersTable *table, int num_buckets)
+{
+    fprintf(file, "%s: %d entries in %d of %d buckets, longest chain %d, chains of 1, 2, 3, 4+: %d, %d, %d, %d\n",
+            name, table->num_entries, table->num_chains, num_buckets, table->max_length,
+            table->lengths[0], table->lengths[1], table->lengths[2], table->lengths[3]);
+}
@@ -19,16 +19,17 @@
  * @param game_events A pointer to the current GameEvents object.
  * @param nav_state A pointer to the current NavigationState object.
  * @param camera A pointer to the current Camera object.
+ * @param poll_event The event source, e.g. SDL_PollEvent or replay_poll_event.
  *
  * @return void
  */
-void events_loop(GameState *game_state, InputState *input_state, GameEvents *game_events, NavigationState *nav_state, const Camera *camera)
+void events_loop(GameState *game_state, InputState *input_state, GameEvents *game_events, NavigationState *nav_state, const Camera *camera, int (*poll_event)(SDL_Event *))
 {
     SDL_Event event;
     static int save_state;
     const double epsilon = ZOOM_EPSILON / GALAXY_SCALE;
 
-    while (SDL_PollEvent(&event))
+    while (poll_event(&event))
     {
         switch (event.type)
         {
@@ -59,7 +60,7 @@ void events_loop(GameState *game_state, InputState *input_state, GameEvents *gam
                 else if (game_state->state == MAP && input_state->is_hovering_star)
                     input_state->clicked_inside_star = true;
 
-                Uint32 current_time = SDL_GetTicks();
+                Uint32 current_time = replay_get_ticks();
 
                 // Detect double-clicks
                 if (current_time - input_state->last_click_time < DOUBLE_CLICK_INTERVAL)
@@ -259,14 +260,16 @@ void events_loop(GameState *game_state, InputState *input_state, GameEvents *gam
                         {
                             if (input_state->is_hovering_star_waypoint_button)
                             {
+                                // The waypoint changes, so stop planning the route to the previous one
+                                route_cancel_job();
+
                                 if (strcmp(nav_state->waypoint_star->name, nav_state->selected_star->name) != 0)
-                                    memcpy(nav_state->waypoint_star, nav_state->selected_star, sizeof(Star));
+                                    stars_copy_star(nav_state->waypoint_star, nav_state->selected_star);
                                 else
                                 {
-                                    if (nav_state->waypoint_star->waypoint_points > 0)
+                                    if (nav_state->waypoint_star->waypoint_path != NULL)
                                     {
-                                        if (nav_state->waypoint_star->waypoint_path != NULL)
-                                            free(nav_state->waypoint_star->waypoint_path);
+                                        path_destroy(nav_state->waypoint_star->waypoint_path);
 
                                         if (nav_state->waypoint_star->planets[0] != NULL)
                                             stars_cleanup_planets(nav_state->waypoint_star);
@@ -292,10 +295,11 @@ void events_loop(GameState *game_state, InputState *input_state, GameEvents *gam
 
                             if (input_state->is_hovering_planet_waypoint_button)
                             {
-                                if (nav_state->waypoint_star->waypoint_points > 0)
+                                route_cancel_job();
+
+                                if (nav_state->waypoint_star->waypoint_path != NULL)
                                 {
-                                    if (nav_state->waypoint_star->waypoint_path != NULL)
-                                        free(nav_state->waypoint_star->waypoint_path);
+                                    path_destroy(nav_state->waypoint_star->waypoint_path);
 
                                     if (nav_state->waypoint_star->planets[0] != NULL)
                                         stars_cleanup_planets(nav_state->waypoint_star);
@@ -315,7 +319,7 @@ void events_loop(GameState *game_state, InputState *input_state, GameEvents *gam
                                 }
 
                                 if (strcmp(nav_state->waypoint_star->name, nav_state->selected_star->name) != 0)
-                                    memcpy(nav_state->waypoint_star, nav_state->selected_star, sizeof(Star));
+                                    stars_copy_star(nav_state->waypoint_star, nav_state->selected_star);
 
                                 if (nav_state->waypoint_planet_index != input_state->selected_star_info_planet_index)
                                     nav_state->waypoint_planet_index = input_state->selected_star_info_planet_index;
@@ -401,7 +405,7 @@ void events_loop(GameState *game_state, InputState *input_state, GameEvents *gam
                         if (input_state->is_hovering_star)
                         {
                             if (strcmp(nav_state->selected_star->name, nav_state->current_star->name) != 0)
-                                memcpy(nav_state->selected_star, nav_state->current_star, sizeof(Star));
+                                stars_copy_star(nav_state->selected_star, nav_state->current_star);
 
                             nav_state->selected_star->is_selected = true;
                         }
@@ -418,7 +422,7 @@ void events_loop(GameState *game_state, InputState *input_state, GameEvents *gam
                         if (input_state->is_hovering_star)
                         {
                             if (strcmp(nav_state->selected_star->name, nav_state->current_star->name) != 0)
-                                memcpy(nav_state->selected_star, nav_state->current_star, sizeof(Star));
+                                stars_copy_star(nav_state->selected_star, nav_state->current_star);
 
                             nav_state->selected_star->is_selected = true;
                         }
@@ -437,7 +441,7 @@ void events_loop(GameState *game_state, InputState *input_state, GameEvents *gam
                 }
             }
 
-            SDL_SetCursor(input_state->previous_cursor);
+            render_set_cursor(input_state->previous_cursor);
             input_state->previous_cursor = NULL;
             input_state->is_mouse_dragging = false;
             break;
@@ -458,8 +462,7 @@ void events_loop(GameState *game_state, InputState *input_state, GameEvents *gam
                     if (!input_state->is_hovering_star_info)
                     {
                         input_state->is_mouse_dragging = true;
-                        input_state->previous_cursor = SDL_GetCursor();
-                        SDL_SetCursor(input_state->drag_cursor);
+                        input_state->previous_cursor = render_set_cursor(input_state->drag_cursor);
                         input_state->click_count = 0;
                         input_state->clicked_inside_galaxy = false;
                         input_state->clicked_inside_star = false;
@@ -501,7 +504,7 @@ void events_loop(GameState *game_state, InputState *input_state, GameEvents *gam
         case SDL_MOUSEWHEEL:
             // Get the current mouse position
             int mouse_x, mouse_y;
-            SDL_GetMouseState(&mouse_x, &mouse_y);
+            replay_get_mouse_state(&mouse_x, &mouse_y);
 
             double zoom_universe_step = ZOOM_UNIVERSE_STEP;
             double zoom_step = ZOOM_STEP;
@@ -618,9 +621,9 @@ void events_loop(GameState *game_state, InputState *input_state, GameEvents *gam
                 if (game_state->state == NAVIGATE)
                 {
                     bool waypoint_path_exists = nav_state->waypoint_star->initialized &&
-                                                nav_state->waypoint_star->waypoint_points > 0 &&
+                                                nav_state->waypoint_star->waypoint_path != NULL &&
                                                 !input_state->zoom_in && !input_state->zoom_out &&
-                                                strcmp(nav_state->current_galaxy->name, nav_state->waypoint_star->galaxy_name) == 0;
+                                                maths_points_equal(nav_state->current_galaxy->position, nav_state->buffer_galaxy->position);
 
                     if (waypoint_path_exists)
                         input_state->autopilot_on = !input_state->autopilot_on;
@@ -637,6 +640,10 @@ void events_loop(GameState *game_state, InputState *input_state, GameEvents *gam
                 // Toggle FPS
                 input_state->fps_on = !input_state->fps_on;
                 break;
+            case SDL_SCANCODE_K:
+                // Toggle counters
+                input_state->counters_on = !input_state->counters_on;
+                break;
             case SDL_SCANCODE_M:
                 // Enter Map
                 if (game_state->state == UNIVERSE)
@@ -665,6 +672,10 @@ void events_loop(GameState *game_state, InputState *input_state, GameEvents *gam
                 // Toggle orbits
                 input_state->orbits_on = !input_state->orbits_on;
                 break;
+            case SDL_SCANCODE_P:
+                // Toggle profiler
+                input_state->profiler_on = !input_state->profiler_on;
+                break;
             case SDL_SCANCODE_S:
                 // Stop ship
                 if (game_state->state == NAVIGATE)
@@ -673,6 +684,11 @@ void events_loop(GameState *game_state, InputState *input_state, GameEvents *gam
                     input_state->autopilot_on = false;
                 }
                 break;
+            case SDL_SCANCODE_T:
+                // Capture a trace of the next frames
+                if (PROFILER_ON)
+                    trace_start(NULL, 0, TRACE_FRAMES);
+                break;
             case SDL_SCANCODE_U:
                 // Enter Universe
                 if (game_state->state == MAP)
@@ -897,6 +913,7 @@ void events_loop(GameState *game_state, InputState *input_state, GameEvents *gam
 
 /**
  * Sets the cursor to the appropriate type based on the current game state and input state.
+ * The cursor is shown when the frame is drawn.
  *
  * @param game_state A pointer to the current GameState object.
  * @param input_state A pointer to the current InputState object.
@@ -908,30 +925,30 @@ void events_set_cursor(GameState *game_state, InputState *input_state)
     if (game_state->state == MENU || game_state->state == CONTROLS)
     {
         if (menu_is_hovering_menu(game_state, input_state))
-            SDL_SetCursor(input_state->pointing_cursor);
+            render_set_cursor(input_state->pointing_cursor);
         else
-            SDL_SetCursor(input_state->default_cursor);
+            render_set_cursor(input_state->default_cursor);
     }
     else if (game_state->state == NAVIGATE)
     {
-        SDL_SetCursor(input_state->default_cursor);
+        render_set_cursor(input_state->default_cursor);
     }
     else if (game_state->state == MAP || game_state->state == UNIVERSE)
     {
         if (!input_state->is_mouse_dragging && !input_state->is_hovering_star_info)
         {
             if (input_state->is_hovering_star)
-                SDL_SetCursor(input_state->pointing_cursor);
+                render_set_cursor(input_state->pointing_cursor);
             else
-                SDL_SetCursor(input_state->default_cursor);
+                render_set_cursor(input_state->default_cursor);
         }
 
         if (input_state->is_hovering_star_info)
         {
             if (input_state->is_hovering_planet_waypoint_button || input_state->is_hovering_star_waypoint_button)
-                SDL_SetCursor(input_state->pointing_cursor);
+                render_set_cursor(input_state->pointing_cursor);
             else
-                SDL_SetCursor(input_state->default_cursor);
+                render_set_cursor(input_state->default_cursor);
         }
     }
 }
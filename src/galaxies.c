@@ -16,17 +16,29 @@
 #include "../include/galaxies.h"
 
 // External variable definitions
-extern TTF_Font *fonts[];
 extern SDL_Renderer *renderer;
 extern SDL_Color colors[];
 
+// Static variable definitions
+static GstarsJob *gstars_jobs[GALAXY_CLOUD_JOBS]; // Galaxies in view whose gstars are generated in the background
+static bool is_async = true;
+
 // Static function prototypes
 static void galaxies_add_entry(GalaxyEntry *galaxies[], Point, Galaxy *);
+static void galaxies_adopt_gstars_job(NavigationState *, const GstarsJob *);
+static void galaxies_create_columns(void *data, int start, int end);
 static Galaxy *galaxies_create_galaxy(Point);
+static int galaxies_create_region(GalaxyEntry *galaxies[], double bx, double by, bool is_parallel);
 static void galaxies_delete_entry(GalaxyEntry *galaxies[], Point);
 static bool galaxies_entry_exists(GalaxyEntry *galaxies[], Point);
+static bool galaxies_find_gstars_job(const Galaxy *, bool high_definition);
+static bool galaxies_is_equal_table(GalaxyEntry *a[], GalaxyEntry *b[]);
+static bool galaxies_is_in_focus(const InputState *, const NavigationState *, const Galaxy *, const Camera *, long double scale);
 static double galaxies_nearest_center_distance(Point);
+static void galaxies_release_gstars_job(GstarsJob *);
+static void galaxies_run_gstars_job(void *data);
 static unsigned short galaxies_size_class(float distance);
+static GstarsJob *galaxies_start_gstars_job(const Galaxy *, bool high_definition, float priority);
 
 /**
  * Adds a new entry to the galaxy hash table at the given position.
@@ -57,6 +69,139 @@ static void galaxies_add_entry(GalaxyEntry *galaxies[], Point position, Galaxy *
     galaxies[index] = entry;
 }
 
+/**
+ * Adds the gstars generated by a background job to its galaxy, unless the galaxy was deleted
+ * or its gstars were generated on the main thread meanwhile.
+ *
+ * @param nav_state A pointer to the current NavigationState object.
+ * @param job A pointer to the GstarsJob.
+ *
+ * @return void
+ */
+static void galaxies_adopt_gstars_job(NavigationState *nav_state, const GstarsJob *job)
+{
+    Galaxy *galaxy = galaxies_get_entry(nav_state->galaxies, job->galaxy->position);
+
+    if (galaxy == NULL)
+        return;
+
+    const Galaxy *copy = job->galaxy;
+
+    // The gstars before the last index are final; The last one is replaced by the next batch
+    if (job->high_definition)
+    {
+        if (galaxy->initialized_hd != job->initialized || galaxy->last_star_index_hd != job->last_star_index)
+            return;
+
+        memcpy(&galaxy->gstars_hd[job->last_star_index], &copy->gstars_hd[job->last_star_index],
+               (copy->last_star_index_hd - job->last_star_index) * sizeof(Gstar));
+        galaxy->initialized_hd = copy->initialized_hd;
+        galaxy->last_star_index_hd = copy->last_star_index_hd;
+        galaxy->sections_in_group_hd = copy->sections_in_group_hd;
+        galaxy->total_groups_hd = copy->total_groups_hd;
+    }
+    else
+    {
+        if (galaxy->initialized != job->initialized || galaxy->last_star_index != job->last_star_index)
+            return;
+
+        memcpy(&galaxy->gstars[job->last_star_index], &copy->gstars[job->last_star_index],
+               (copy->last_star_index - job->last_star_index) * sizeof(Gstar));
+        galaxy->initialized = copy->initialized;
+        galaxy->last_star_index = copy->last_star_index;
+        galaxy->sections_in_group = copy->sections_in_group;
+        galaxy->total_groups = copy->total_groups;
+    }
+}
+
+/**
+ * Creates the galaxies of random regions of the universe, first on the current thread and then
+ * in parallel tiles, and prints the time of both, the speedup per thread and whether the two
+ * hash tables are identical.
+ *
+ * @param runs The number of regions to create.
+ *
+ * @return void
+ */
+void galaxies_benchmark(int runs)
+{
+    GalaxyEntry *serial_galaxies[MAX_GALAXIES] = {NULL};
+    GalaxyEntry *parallel_galaxies[MAX_GALAXIES] = {NULL};
+    int num_threads = jobs_get_num_workers() + 1;
+    double total_serial_time = 0;
+    double total_parallel_time = 0;
+    int total_galaxies = 0;
+    int different = 0;
+
+    // Use a local rng, so that every run creates the same regions
+    pcg32_random_t rng;
+    pcg32_srandom_r(&rng, GALAXIES_BENCHMARK_SEED, GALAXIES_BENCHMARK_SEED);
+
+    printf("Galaxies benchmark: %d regions of %d x %d sections, %d threads, tiles of %d columns\n",
+           runs, UNIVERSE_REGION_SIZE, UNIVERSE_REGION_SIZE, num_threads, GALAXIES_TILE_COLUMNS);
+    printf("  %8s %10s %10s %8s %10s %10s\n", "galaxies", "serial ms", "tiles ms", "speedup", "/thread", "identical");
+
+    for (int i = 0; i < runs; i++)
+    {
+        // Regions are centered on random section lines inside the universe
+        double angle = (pcg32_random_r(&rng) % 3600) * M_PI / 1800;
+        double distance = (pcg32_random_r(&rng) % 1001) / 1000.0 * UNIVERSE_X_LIMIT;
+        double bx = maths_get_nearest_section_line(cos(angle) * distance, UNIVERSE_SECTION_SIZE);
+        double by = maths_get_nearest_section_line(sin(angle) * distance, UNIVERSE_SECTION_SIZE);
+
+        Uint64 start_counter = SDL_GetPerformanceCounter();
+        int num_galaxies = galaxies_create_region(serial_galaxies, bx, by, false);
+        double serial_time = (double)(SDL_GetPerformanceCounter() - start_counter) * 1000 / SDL_GetPerformanceFrequency();
+
+        start_counter = SDL_GetPerformanceCounter();
+        galaxies_create_region(parallel_galaxies, bx, by, true);
+        double parallel_time = (double)(SDL_GetPerformanceCounter() - start_counter) * 1000 / SDL_GetPerformanceFrequency();
+
+        bool is_identical = galaxies_is_equal_table(serial_galaxies, parallel_galaxies);
+        double speedup = parallel_time > 0 ? serial_time / parallel_time : 0;
+
+        printf("  %8d %10.3f %10.3f %8.2f %10.2f %10s\n",
+               num_galaxies, serial_time, parallel_time, speedup, speedup / num_threads, is_identical ? "yes" : "no");
+
+        total_serial_time += serial_time;
+        total_parallel_time += parallel_time;
+        total_galaxies += num_galaxies;
+
+        if (!is_identical)
+            different++;
+
+        galaxies_clear_table(serial_galaxies);
+        galaxies_clear_table(parallel_galaxies);
+    }
+
+    if (runs <= 0)
+        return;
+
+    double speedup = total_parallel_time > 0 ? total_serial_time / total_parallel_time : 0;
+
+    printf("  %8.0f %10.3f %10.3f %8.2f %10.2f %10s\n",
+           (double)total_galaxies / runs, total_serial_time / runs, total_parallel_time / runs,
+           speedup, speedup / num_threads, different == 0 ? "yes" : "no");
+}
+
+/**
+ * Cancels the gstars that are generated in the background.
+ *
+ * @return void
+ */
+void galaxies_clear_gstars_jobs(void)
+{
+    for (int i = 0; i < GALAXY_CLOUD_JOBS; i++)
+    {
+        if (gstars_jobs[i] == NULL)
+            continue;
+
+        jobs_cancel_handle(&gstars_jobs[i]->handle);
+        galaxies_release_gstars_job(gstars_jobs[i]);
+        gstars_jobs[i] = NULL;
+    }
+}
+
 /**
  * Clear the entire hash table of galaxies.
  *
@@ -82,55 +227,70 @@ void galaxies_clear_table(GalaxyEntry *galaxies[])
 }
 
 /**
- * Generates a new Galaxy struct with random characteristics based on the provided position.
+ * Copies a galaxy into a snapshot, such as current_galaxy, and counts the bytes copied.
  *
- * @param position The position of the new Galaxy.
+ * @param destination A pointer to the Galaxy to copy to.
+ * @param source A pointer to the Galaxy to copy.
  *
- * @return A pointer to the new Galaxy struct.
+ * @return void
  */
-static Galaxy *galaxies_create_galaxy(Point position)
+void galaxies_copy_galaxy(Galaxy *destination, const Galaxy *source)
 {
-    // Find distance to nearest galaxy center
-    double distance = galaxies_nearest_center_distance(position);
+    memcpy(destination, source, sizeof(Galaxy));
+    COUNTERS_ADD(COUNTER_GALAXY_COPY_BYTES, sizeof(Galaxy));
+}
 
-    unsigned short class = galaxies_size_class(distance);
+/**
+ * Creates the new galaxies of a tile of columns of sections of a region. Tiles run in parallel;
+ * The hash table is only read, and each galaxy is written to the slot of its own section.
+ *
+ * @param data A pointer to the GalaxiesRegion.
+ * @param start The first column of the tile.
+ * @param end The column after the last column of the tile.
+ *
+ * @return void
+ */
+static void galaxies_create_columns(void *data, int start, int end)
+{
+    GalaxiesRegion *region = data;
+    Uint64 tile_start = SDL_GetPerformanceCounter();
 
-    // Use a local rng
-    pcg32_random_t rng;
+    for (int column = start; column < end; column++)
+    {
+        double ix = region->left_boundary + column * UNIVERSE_SECTION_SIZE;
 
-    // Create rng seed by combining x,y values
-    uint64_t seed = maths_hash_position_to_uint64_2(position);
+        for (int row = 0; row < UNIVERSE_REGION_SIZE; row++)
+        {
+            double iy = region->top_boundary + row * UNIVERSE_SECTION_SIZE;
 
-    // Seed with a fixed constant
-    pcg32_srandom_r(&rng, seed, seed); // Unique sequence for this seed
+            // Check that point is within universe radius
+            if (sqrt(ix * ix + iy * iy) > UNIVERSE_X_LIMIT)
+                continue;
 
-    float radius;
+            Point position = {.x = ix, .y = iy};
 
-    switch (class)
-    {
-    case GALAXY_1:
-        radius = abs(pcg32_random_r(&rng)) % GALAXY_1_RADIUS_MAX + GALAXY_1_RADIUS_MIN;
-        break;
-    case GALAXY_2:
-        radius = abs(pcg32_random_r(&rng)) % GALAXY_2_RADIUS_MAX + GALAXY_2_RADIUS_MIN;
-        break;
-    case GALAXY_3:
-        radius = abs(pcg32_random_r(&rng)) % GALAXY_3_RADIUS_MAX + GALAXY_3_RADIUS_MIN;
-        break;
-    case GALAXY_4:
-        radius = abs(pcg32_random_r(&rng)) % GALAXY_4_RADIUS_MAX + GALAXY_4_RADIUS_MIN;
-        break;
-    case GALAXY_5:
-        radius = abs(pcg32_random_r(&rng)) % GALAXY_5_RADIUS_MAX + GALAXY_5_RADIUS_MIN;
-        break;
-    case GALAXY_6:
-        radius = abs(pcg32_random_r(&rng)) % GALAXY_6_RADIUS_MAX + GALAXY_6_RADIUS_MIN;
-        break;
-    default:
-        radius = abs(pcg32_random_r(&rng)) % GALAXY_1_RADIUS_MAX + GALAXY_1_RADIUS_MIN;
-        break;
+            // Create galaxy, unless it exists in hash table
+            if (galaxies_section_has_galaxy(position) && !galaxies_entry_exists(region->galaxies, position))
+                region->created[column * UNIVERSE_REGION_SIZE + row] = galaxies_create_galaxy(position);
+        }
     }
 
+    if (PROFILER_ON)
+        trace_add_span("galaxies tile", tile_start, SDL_GetPerformanceCounter());
+}
+
+/**
+ * Generates a new Galaxy struct with random characteristics based on the provided position.
+ *
+ * @param position The position of the new Galaxy.
+ *
+ * @return A pointer to the new Galaxy struct.
+ */
+static Galaxy *galaxies_create_galaxy(Point position)
+{
+    unsigned short class;
+    float radius = galaxies_get_radius(position, &class);
+
     // Allocate memory for Galaxy
     Galaxy *galaxy = (Galaxy *)malloc(sizeof(Galaxy));
 
@@ -140,6 +300,11 @@ static Galaxy *galaxies_create_galaxy(Point position)
         return NULL;
     }
 
+    COUNTERS_ADD(COUNTER_GALAXIES_CREATED, 1);
+
+    if (PROFILER_ON)
+        trace_count_allocation(sizeof(Galaxy));
+
     // Generate unique galaxy position hash
     uint64_t position_hash = maths_hash_position_to_uint64_2(position);
 
@@ -178,6 +343,71 @@ static Galaxy *galaxies_create_galaxy(Point position)
     return galaxy;
 }
 
+/**
+ * Creates the galaxies of a region of UNIVERSE_REGION_SIZE * UNIVERSE_REGION_SIZE sections that are
+ * not in the hash table yet. Galaxies are created in tiles of GALAXIES_TILE_COLUMNS columns, in parallel,
+ * then added to the hash table column by column, in the order of a serial scan, so that the hash table
+ * is the same whatever the number of threads.
+ *
+ * @param galaxies[] The hash table of galaxies.
+ * @param bx The x coordinate of the section line at the center of the region.
+ * @param by The y coordinate of the section line at the center of the region.
+ * @param is_parallel Whether the tiles run on the worker threads or on the current thread.
+ *
+ * @return The number of galaxies created.
+ */
+static int galaxies_create_region(GalaxyEntry *galaxies[], double bx, double by, bool is_parallel)
+{
+    // bx,by are at the center of the region
+    double left_boundary = bx - ((UNIVERSE_REGION_SIZE / 2) * UNIVERSE_SECTION_SIZE);
+    double right_boundary = bx + ((UNIVERSE_REGION_SIZE / 2) * UNIVERSE_SECTION_SIZE);
+    double top_boundary = by - ((UNIVERSE_REGION_SIZE / 2) * UNIVERSE_SECTION_SIZE);
+    double bottom_boundary = by + ((UNIVERSE_REGION_SIZE / 2) * UNIVERSE_SECTION_SIZE);
+
+    // Add a buffer zone of <UNIVERSE_REGION_SIZE> sections beyond universe radius
+    int radius_plus_buffer = UNIVERSE_X_LIMIT + UNIVERSE_REGION_SIZE * UNIVERSE_SECTION_SIZE;
+    int in_horizontal_bounds = left_boundary > -radius_plus_buffer && right_boundary < radius_plus_buffer;
+    int in_vertical_bounds = top_boundary > -radius_plus_buffer && bottom_boundary < radius_plus_buffer;
+
+    if (!in_horizontal_bounds || !in_vertical_bounds)
+        return 0;
+
+    GalaxiesRegion *region = (GalaxiesRegion *)calloc(1, sizeof(GalaxiesRegion));
+
+    if (region == NULL)
+    {
+        fprintf(stderr, "Error: Could not allocate memory for GalaxiesRegion.\n");
+        return 0;
+    }
+
+    region->galaxies = galaxies;
+    region->left_boundary = left_boundary;
+    region->top_boundary = top_boundary;
+
+    if (is_parallel)
+        jobs_parallel_for(UNIVERSE_REGION_SIZE, GALAXIES_TILE_COLUMNS, galaxies_create_columns, region);
+    else
+        galaxies_create_columns(region, 0, UNIVERSE_REGION_SIZE);
+
+    // Add galaxies to hash table
+    int num_galaxies = 0;
+
+    for (int i = 0; i < UNIVERSE_REGION_SIZE * UNIVERSE_REGION_SIZE; i++)
+    {
+        Galaxy *galaxy = region->created[i];
+
+        if (galaxy == NULL)
+            continue;
+
+        galaxies_add_entry(galaxies, galaxy->position, galaxy);
+        num_galaxies++;
+    }
+
+    free(region);
+
+    return num_galaxies;
+}
+
 /**
  * Deletes a GalaxyEntry from the hash table by its position and frees associated memory.
  *
@@ -200,6 +430,7 @@ static void galaxies_delete_entry(GalaxyEntry *galaxies[], Point position)
         {
             // Clean up galaxy
             free(entry->galaxy);
+            COUNTERS_ADD(COUNTER_GALAXIES_EVICTED, 1);
             entry->galaxy = NULL;
 
             if (previous == NULL)
@@ -238,17 +469,19 @@ void galaxies_draw_galaxy(const InputState *input_state, NavigationState *nav_st
     Point galaxy_position = {.x = x, .y = y};
 
     bool galaxy_is_selected = strcmp(nav_state->current_galaxy->name, galaxy->name) == 0 && nav_state->current_galaxy->is_selected;
-    bool galaxy_is_hovered = strcmp(nav_state->current_galaxy->name, galaxy->name) == 0 && input_state->is_hovering_galaxy;
 
-    if (galaxy_is_selected || galaxy_is_hovered ||
-        (maths_is_point_in_circle(input_state->mouse_position, galaxy_position, cutoff) &&
-         gfx_is_object_in_camera(camera, galaxy->position.x, galaxy->position.y, galaxy->radius, scale * GALAXY_SCALE)))
+    if (galaxies_is_in_focus(input_state, nav_state, galaxy, camera, scale))
     {
         // Reset stars and update current_galaxy
         if (strcmp(nav_state->current_galaxy->name, galaxy->name) != 0)
         {
             stars_clear_table(nav_state->stars, nav_state, false);
-            memcpy(nav_state->current_galaxy, galaxy, sizeof(Galaxy));
+            galaxies_copy_galaxy(nav_state->current_galaxy, galaxy);
+            jobs_cancel(JOB_TAG_REGION | JOB_TAG_GALAXY);
+            stars_clear_populations();
+
+            if (PROFILER_ON)
+                trace_add_instant("switch galaxy");
         }
 
         // Draw cutoff area circles
@@ -259,17 +492,7 @@ void galaxies_draw_galaxy(const InputState *input_state, NavigationState *nav_st
         else
             color_code = COLOR_MAGENTA_100;
 
-        if (2 * cutoff * scale > camera->h)
-            gfx_draw_circle_approximation(renderer, camera, x, y, cutoff, colors[color_code]);
-        else
-            gfx_draw_circle(renderer, camera, x, y, cutoff, colors[color_code]);
-
-        // Generate gstars
-        if (!galaxy->initialized || galaxy->initialized < galaxy->total_groups)
-            gfx_generate_gstars(galaxy, false);
-
-        if (!galaxy->initialized_hd || galaxy->initialized_hd < galaxy->total_groups_hd)
-            gfx_generate_gstars(galaxy, true);
+        gfx_draw_circle(renderer, camera, x, y, cutoff, colors[color_code]);
 
         double zoom_generate_preview_stars;
 
@@ -314,12 +537,7 @@ void galaxies_draw_galaxy(const InputState *input_state, NavigationState *nav_st
         // Draw galaxy cloud
         if (gfx_is_object_in_camera(camera, galaxy->position.x, galaxy->position.y, galaxy->radius, scale * GALAXY_SCALE) &&
             !maths_is_point_in_circle(input_state->mouse_position, galaxy_position, cutoff))
-        {
-            if (!galaxy->initialized || galaxy->initialized < galaxy->total_groups)
-                gfx_generate_gstars(galaxy, false);
-
             gfx_draw_galaxy_cloud(galaxy, camera, galaxy->last_star_index, false, scale);
-        }
         // Draw galaxy projection
         else if (PROJECTIONS_ON)
         {
@@ -340,8 +558,10 @@ void galaxies_draw_galaxy(const InputState *input_state, NavigationState *nav_st
  */
 void galaxies_draw_info_box(const Galaxy *galaxy, const Camera *camera)
 {
+    unsigned short previous_layer = render_set_layer(RENDER_LAYER_UI);
+
     // Draw background box
-    SDL_SetRenderDrawColor(renderer, 12, 12, 12, 230);
+    render_set_draw_color(12, 12, 12, 230);
     int width = INFO_BOX_WIDTH;
     int height = GALAXY_INFO_BOX_HEIGHT;
     int padding = INFO_BOX_PADDING;
@@ -352,7 +572,7 @@ void galaxies_draw_info_box(const Galaxy *galaxy, const Camera *camera)
     info_box_rect.w = width;
     info_box_rect.h = height;
 
-    SDL_RenderFillRect(renderer, &info_box_rect);
+    render_fill_rect(&info_box_rect);
 
     // Create info array
     InfoBoxEntry entries[GALAXY_INFO_COUNT];
@@ -394,18 +614,14 @@ void galaxies_draw_info_box(const Galaxy *galaxy, const Camera *camera)
     sprintf(entries[GALAXY_INFO_STARS].text, "Stars: %*s%s", 7, "", stars_text);
     entries[GALAXY_INFO_STARS].font_size = FONT_SIZE_15;
 
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 0);
+    render_set_draw_color(255, 255, 255, 0);
 
     for (int i = 0; i < GALAXY_INFO_COUNT; i++)
     {
-        // Create a texture from the entry text
-        SDL_Surface *text_surface = TTF_RenderText_Blended(fonts[entries[i].font_size], entries[i].text, colors[COLOR_WHITE_180]);
-        SDL_Texture *text_texture = SDL_CreateTextureFromSurface(renderer, text_surface);
-        entries[i].text_texture = text_texture;
-        entries[i].texture_rect.w = text_surface->w;
-        entries[i].texture_rect.h = text_surface->h;
-
-        SDL_FreeSurface(text_surface);
+        // Get a label for the entry text
+        entries[i].text_label = text_get_label(entries[i].text, entries[i].font_size, colors[COLOR_WHITE_180]);
+        entries[i].texture_rect.w = entries[i].text_label->w;
+        entries[i].texture_rect.h = entries[i].text_label->h;
     }
 
     // Name
@@ -417,12 +633,12 @@ void galaxies_draw_info_box(const Galaxy *galaxy, const Camera *camera)
     entries[GALAXY_INFO_NAME].rect.x = camera->w - (width + padding);
     entries[GALAXY_INFO_NAME].rect.y = camera->h - (height + padding);
 
-    SDL_RenderFillRect(renderer, &entries[GALAXY_INFO_NAME].rect);
+    render_fill_rect(&entries[GALAXY_INFO_NAME].rect);
 
     entries[GALAXY_INFO_NAME].texture_rect.x = entries[GALAXY_INFO_NAME].rect.x + inner_padding;
     entries[GALAXY_INFO_NAME].texture_rect.y = entries[GALAXY_INFO_NAME].rect.y + (entries[GALAXY_INFO_NAME].rect.h - entries[GALAXY_INFO_NAME].texture_rect.h) / 2;
 
-    SDL_RenderCopy(renderer, entries[GALAXY_INFO_NAME].text_texture, NULL, &entries[GALAXY_INFO_NAME].texture_rect);
+    text_draw_label(entries[GALAXY_INFO_NAME].text_label, entries[GALAXY_INFO_NAME].texture_rect.x, entries[GALAXY_INFO_NAME].texture_rect.y);
 
     // Type
     entries[GALAXY_INFO_TYPE].rect.w = width;
@@ -430,12 +646,12 @@ void galaxies_draw_info_box(const Galaxy *galaxy, const Camera *camera)
     entries[GALAXY_INFO_TYPE].rect.x = camera->w - (width + padding);
     entries[GALAXY_INFO_TYPE].rect.y = camera->h - (height + padding) + name_height;
 
-    SDL_RenderFillRect(renderer, &entries[GALAXY_INFO_TYPE].rect);
+    render_fill_rect(&entries[GALAXY_INFO_TYPE].rect);
 
     entries[GALAXY_INFO_TYPE].texture_rect.x = entries[GALAXY_INFO_TYPE].rect.x + inner_padding;
     entries[GALAXY_INFO_TYPE].texture_rect.y = entries[GALAXY_INFO_TYPE].rect.y + (entries[GALAXY_INFO_TYPE].rect.h - entries[GALAXY_INFO_TYPE].texture_rect.h) / 2;
 
-    SDL_RenderCopy(renderer, entries[GALAXY_INFO_TYPE].text_texture, NULL, &entries[GALAXY_INFO_TYPE].texture_rect);
+    text_draw_label(entries[GALAXY_INFO_TYPE].text_label, entries[GALAXY_INFO_TYPE].texture_rect.x, entries[GALAXY_INFO_TYPE].texture_rect.y);
 
     // Set the position for the rest of the entries
     for (int i = 2; i < GALAXY_INFO_COUNT; i++)
@@ -445,22 +661,17 @@ void galaxies_draw_info_box(const Galaxy *galaxy, const Camera *camera)
         entries[i].rect.x = camera->w - (width + padding);
         entries[i].rect.y = camera->h - (height + padding) + name_height + (i - 1) * entry_height;
 
-        SDL_RenderFillRect(renderer, &entries[i].rect);
+        render_fill_rect(&entries[i].rect);
 
         // Set the position of the text within the entry
         entries[i].texture_rect.x = entries[i].rect.x + inner_padding;
         entries[i].texture_rect.y = entries[i].rect.y + (entries[i].rect.h - entries[i].texture_rect.h) / 2;
 
-        // Render the text texture onto the entry
-        SDL_RenderCopy(renderer, entries[i].text_texture, NULL, &entries[i].texture_rect);
+        // Render the text label onto the entry
+        text_draw_label(entries[i].text_label, entries[i].texture_rect.x, entries[i].texture_rect.y);
     }
 
-    // Destroy the textures
-    for (int i = 0; i < GALAXY_INFO_COUNT; i++)
-    {
-        SDL_DestroyTexture(entries[i].text_texture);
-        entries[i].text_texture = NULL;
-    }
+    render_set_layer(previous_layer);
 }
 
 /**
@@ -492,6 +703,30 @@ static bool galaxies_entry_exists(GalaxyEntry *galaxies[], Point position)
     return false;
 }
 
+/**
+ * Finds the job that generates gstars of a galaxy in the background, and marks it as still in view.
+ *
+ * @param galaxy A pointer to the Galaxy.
+ * @param high_definition A boolean to find the job of the high definition gstars.
+ *
+ * @return True if the job exists, false otherwise.
+ */
+static bool galaxies_find_gstars_job(const Galaxy *galaxy, bool high_definition)
+{
+    for (int i = 0; i < GALAXY_CLOUD_JOBS; i++)
+    {
+        GstarsJob *job = gstars_jobs[i];
+
+        if (job != NULL && job->high_definition == high_definition && maths_points_equal(job->galaxy->position, galaxy->position))
+        {
+            job->is_in_view = true;
+            return true;
+        }
+    }
+
+    return false;
+}
+
 /**
  * Generates galaxies within a region of the universe, determined by offset.
  * If this is the first time calling the function, updates the navigation state
@@ -525,55 +760,8 @@ void galaxies_generate(GameEvents *game_events, NavigationState *nav_state, Poin
             nav_state->universe_cross_line.y = by;
     }
 
-    // Define a region of UNIVERSE_REGION_SIZE * UNIVERSE_REGION_SIZE
-    // bx,by are at the center of this area
-    double ix, iy;
-    double left_boundary = bx - ((UNIVERSE_REGION_SIZE / 2) * UNIVERSE_SECTION_SIZE);
-    double right_boundary = bx + ((UNIVERSE_REGION_SIZE / 2) * UNIVERSE_SECTION_SIZE);
-    double top_boundary = by - ((UNIVERSE_REGION_SIZE / 2) * UNIVERSE_SECTION_SIZE);
-    double bottom_boundary = by + ((UNIVERSE_REGION_SIZE / 2) * UNIVERSE_SECTION_SIZE);
-
-    // Add a buffer zone of <UNIVERSE_REGION_SIZE> sections beyond universe radius
-    int radius_plus_buffer = UNIVERSE_X_LIMIT + UNIVERSE_REGION_SIZE * UNIVERSE_SECTION_SIZE;
-    int in_horizontal_bounds = left_boundary > -radius_plus_buffer && right_boundary < radius_plus_buffer;
-    int in_vertical_bounds = top_boundary > -radius_plus_buffer && bottom_boundary < radius_plus_buffer;
-
-    // Use a local rng
-    pcg32_random_t rng;
-
-    for (ix = left_boundary; ix < right_boundary && in_horizontal_bounds; ix += UNIVERSE_SECTION_SIZE)
-    {
-        for (iy = top_boundary; iy < bottom_boundary && in_vertical_bounds; iy += UNIVERSE_SECTION_SIZE)
-        {
-            // Check that point is within universe radius
-            if (sqrt(ix * ix + iy * iy) > UNIVERSE_X_LIMIT)
-                continue;
-
-            // Create rng seed by combining x,y values
-            Point position = {.x = ix, .y = iy};
-            uint64_t seed = maths_hash_position_to_uint64_2(position);
-
-            // Seed with a fixed constant
-            pcg32_srandom_r(&rng, seed, 1);
-
-            int has_galaxy = abs(pcg32_random_r(&rng)) % 1000 < UNIVERSE_DENSITY;
-
-            if (has_galaxy)
-            {
-                // Check whether galaxy exists in hash table
-                if (galaxies_entry_exists(nav_state->galaxies, position))
-                    continue;
-                else
-                {
-                    // Create galaxy
-                    Galaxy *galaxy = galaxies_create_galaxy(position);
-
-                    // Add galaxy to hash table
-                    galaxies_add_entry(nav_state->galaxies, position, galaxy);
-                }
-            }
-        }
-    }
+    // Create the galaxies of the region of UNIVERSE_REGION_SIZE * UNIVERSE_REGION_SIZE sections around bx,by
+    galaxies_create_region(nav_state->galaxies, bx, by, true);
 
     // Delete galaxies that end up outside the region
     for (int s = 0; s < MAX_GALAXIES; s++)
@@ -629,6 +817,217 @@ Galaxy *galaxies_get_entry(GalaxyEntry *galaxies[], Point position)
     return NULL;
 }
 
+/**
+ * Generates the gstars of the galaxies that are drawn this frame, in the background.
+ * Galaxies in focus also generate their high definition gstars. The gstars of the jobs that are done
+ * are added to their galaxies, and new jobs start for the galaxies nearest to the camera and the ship;
+ * Jobs of galaxies that left the view are cancelled. Without worker threads, or if generation is synchronous,
+ * the next batch of gstars of each galaxy is generated on the calling thread.
+ *
+ * @param input_state A pointer to the current InputState object.
+ * @param nav_state A pointer to the current NavigationState object.
+ * @param ship A pointer to the current Ship object.
+ * @param camera A pointer to the current Camera object.
+ * @param scale A long double representing the current scale of the universe.
+ *
+ * @return void
+ */
+void galaxies_generate_gstars(const InputState *input_state, NavigationState *nav_state, const Ship *ship, const Camera *camera, long double scale)
+{
+    bool is_parallel = is_async && jobs_get_num_workers() > 0;
+
+    // Adopt the gstars that are ready
+    for (int i = 0; i < GALAXY_CLOUD_JOBS; i++)
+    {
+        if (gstars_jobs[i] != NULL && jobs_is_handle_done(&gstars_jobs[i]->handle))
+        {
+            galaxies_adopt_gstars_job(nav_state, gstars_jobs[i]);
+            galaxies_release_gstars_job(gstars_jobs[i]);
+            gstars_jobs[i] = NULL;
+        }
+
+        if (gstars_jobs[i] != NULL)
+            gstars_jobs[i]->is_in_view = false;
+    }
+
+    Point ship_position = {.x = nav_state->galaxy_offset.current_x + ship->position.x / GALAXY_SCALE,
+                           .y = nav_state->galaxy_offset.current_y + ship->position.y / GALAXY_SCALE};
+    GstarsCandidate nearest[GALAXY_CLOUD_JOBS];
+    int num_nearest = 0;
+
+    for (int i = 0; i < MAX_GALAXIES; i++)
+    {
+        for (GalaxyEntry *entry = nav_state->galaxies[i]; entry != NULL; entry = entry->next)
+        {
+            Galaxy *galaxy = entry->galaxy;
+            bool is_in_focus = galaxies_is_in_focus(input_state, nav_state, galaxy, camera, scale);
+            bool generate = false;
+            bool generate_hd = false;
+
+            if (is_in_focus || gfx_is_object_in_camera(camera, galaxy->position.x, galaxy->position.y, galaxy->radius, scale * GALAXY_SCALE))
+                generate = !galaxy->initialized || galaxy->initialized < galaxy->total_groups;
+
+            if (is_in_focus)
+                generate_hd = !galaxy->initialized_hd || galaxy->initialized_hd < galaxy->total_groups_hd;
+
+            if (!is_parallel)
+            {
+                if (generate)
+                    gfx_generate_gstars(galaxy, false);
+
+                if (generate_hd)
+                    gfx_generate_gstars(galaxy, true);
+
+                continue;
+            }
+
+            float priority = jobs_get_priority(galaxy->position, nav_state->universe_offset, ship_position);
+
+            for (int hd = 0; hd <= 1; hd++)
+            {
+                if (!(hd ? generate_hd : generate) || galaxies_find_gstars_job(galaxy, hd))
+                    continue;
+
+                if (num_nearest == GALAXY_CLOUD_JOBS && priority >= nearest[num_nearest - 1].priority)
+                    continue;
+
+                // Insert in order of priority, dropping the farthest galaxy if the list is full
+                int j = num_nearest < GALAXY_CLOUD_JOBS ? num_nearest++ : num_nearest - 1;
+
+                for (; j > 0 && nearest[j - 1].priority > priority; j--)
+                    nearest[j] = nearest[j - 1];
+
+                nearest[j] = (GstarsCandidate){.galaxy = galaxy, .high_definition = hd, .priority = priority};
+            }
+        }
+    }
+
+    // Cancel the jobs of the galaxies that left the view; Their gstars so far are still adopted
+    for (int i = 0; i < GALAXY_CLOUD_JOBS; i++)
+    {
+        if (gstars_jobs[i] != NULL && !gstars_jobs[i]->is_in_view)
+            jobs_cancel_handle(&gstars_jobs[i]->handle);
+    }
+
+    // Start the jobs of the nearest galaxies
+    for (int i = 0, n = 0; i < GALAXY_CLOUD_JOBS && n < num_nearest; i++)
+    {
+        if (gstars_jobs[i] != NULL)
+            continue;
+
+        gstars_jobs[i] = galaxies_start_gstars_job(nearest[n].galaxy, nearest[n].high_definition, nearest[n].priority);
+        n++;
+    }
+}
+
+/**
+ * Calculates the size class and the radius of the galaxy of a universe section,
+ * without creating the galaxy.
+ *
+ * @param position The position of the section.
+ * @param class A pointer to the size class of the galaxy.
+ *
+ * @return The radius of the galaxy.
+ */
+float galaxies_get_radius(Point position, unsigned short *class)
+{
+    // Find distance to nearest galaxy center
+    double distance = galaxies_nearest_center_distance(position);
+
+    *class = galaxies_size_class(distance);
+
+    // Use a local rng
+    pcg32_random_t rng;
+
+    // Create rng seed by combining x,y values
+    uint64_t seed = maths_hash_position_to_uint64_2(position);
+
+    // Seed with a fixed constant
+    pcg32_srandom_r(&rng, seed, seed); // Unique sequence for this seed
+    COUNTERS_ADD(COUNTER_SEEDS_GALAXIES, 1);
+
+    switch (*class)
+    {
+    case GALAXY_1:
+        return abs(pcg32_random_r(&rng)) % GALAXY_1_RADIUS_MAX + GALAXY_1_RADIUS_MIN;
+    case GALAXY_2:
+        return abs(pcg32_random_r(&rng)) % GALAXY_2_RADIUS_MAX + GALAXY_2_RADIUS_MIN;
+    case GALAXY_3:
+        return abs(pcg32_random_r(&rng)) % GALAXY_3_RADIUS_MAX + GALAXY_3_RADIUS_MIN;
+    case GALAXY_4:
+        return abs(pcg32_random_r(&rng)) % GALAXY_4_RADIUS_MAX + GALAXY_4_RADIUS_MIN;
+    case GALAXY_5:
+        return abs(pcg32_random_r(&rng)) % GALAXY_5_RADIUS_MAX + GALAXY_5_RADIUS_MIN;
+    case GALAXY_6:
+        return abs(pcg32_random_r(&rng)) % GALAXY_6_RADIUS_MAX + GALAXY_6_RADIUS_MIN;
+    default:
+        return abs(pcg32_random_r(&rng)) % GALAXY_1_RADIUS_MAX + GALAXY_1_RADIUS_MIN;
+    }
+}
+
+/**
+ * Compares two hash tables of galaxies, entry by entry, in the order of their chains.
+ *
+ * @param a[] The first hash table of galaxies.
+ * @param b[] The second hash table of galaxies.
+ *
+ * @return True if the tables hold the same galaxies in the same order, false otherwise.
+ */
+static bool galaxies_is_equal_table(GalaxyEntry *a[], GalaxyEntry *b[])
+{
+    for (int s = 0; s < MAX_GALAXIES; s++)
+    {
+        GalaxyEntry *entry_a = a[s];
+        GalaxyEntry *entry_b = b[s];
+
+        while (entry_a != NULL && entry_b != NULL)
+        {
+            if (entry_a->x != entry_b->x || entry_a->y != entry_b->y)
+                return false;
+
+            if (strcmp(entry_a->galaxy->name, entry_b->galaxy->name) != 0 ||
+                entry_a->galaxy->class != entry_b->galaxy->class ||
+                entry_a->galaxy->radius != entry_b->galaxy->radius)
+                return false;
+
+            entry_a = entry_a->next;
+            entry_b = entry_b->next;
+        }
+
+        if (entry_a != NULL || entry_b != NULL)
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Checks whether a galaxy is in focus: selected, hovered, or under the cursor and in the camera.
+ * A galaxy in focus shows its cutoff and its high definition gstars.
+ *
+ * @param input_state A pointer to the current InputState object.
+ * @param nav_state A pointer to the current NavigationState object.
+ * @param galaxy A pointer to the Galaxy.
+ * @param camera A pointer to the current Camera object.
+ * @param scale A long double representing the current scale of the universe.
+ *
+ * @return True if the galaxy is in focus, false otherwise.
+ */
+static bool galaxies_is_in_focus(const InputState *input_state, const NavigationState *nav_state, const Galaxy *galaxy, const Camera *camera, long double scale)
+{
+    bool is_current = strcmp(nav_state->current_galaxy->name, galaxy->name) == 0;
+
+    if (is_current && (nav_state->current_galaxy->is_selected || input_state->is_hovering_galaxy))
+        return true;
+
+    double cutoff = galaxy->cutoff * scale * GALAXY_SCALE;
+    Point galaxy_position = {.x = (int)((galaxy->position.x - camera->x) * scale * GALAXY_SCALE),
+                             .y = (int)((galaxy->position.y - camera->y) * scale * GALAXY_SCALE)};
+
+    return maths_is_point_in_circle(input_state->mouse_position, galaxy_position, cutoff) &&
+           gfx_is_object_in_camera(camera, galaxy->position.x, galaxy->position.y, galaxy->radius, scale * GALAXY_SCALE);
+}
+
 /**
  * Calculates the distance to the nearest galaxy center from a given position.
  * Uses a search algorithm that checks points in inner circumferences first and works
@@ -648,9 +1047,6 @@ static double galaxies_nearest_center_distance(Point position)
     Point checked_points[MAX_NEAREST_STARS];
     int num_checked_points = 0;
 
-    // Use a local rng
-    pcg32_random_t rng;
-
     for (int i = 1; i <= 6; i++)
     {
         for (double ix = position.x - i * UNIVERSE_SECTION_SIZE; ix <= position.x + i * UNIVERSE_SECTION_SIZE; ix += UNIVERSE_SECTION_SIZE)
@@ -667,15 +1063,7 @@ static double galaxies_nearest_center_distance(Point position)
 
                 checked_points[num_checked_points++] = p;
 
-                // Create rng seed by combining x,y values
-                uint64_t seed = maths_hash_position_to_uint64_2(p);
-
-                // Seed with a fixed constant
-                pcg32_srandom_r(&rng, seed, 1);
-
-                int has_galaxy = abs(pcg32_random_r(&rng)) % 1000 < UNIVERSE_DENSITY;
-
-                if (has_galaxy)
+                if (galaxies_section_has_galaxy(p))
                 {
                     double distance = maths_distance_between_points(ix, iy, position.x, position.y);
 
@@ -746,6 +1134,85 @@ Galaxy *galaxies_nearest_circumference(const NavigationState *nav_state, Point p
     return closest;
 }
 
+/**
+ * Releases a reference to a gstars job, and frees it if it was the last one.
+ *
+ * @param job A pointer to the GstarsJob.
+ *
+ * @return void
+ */
+static void galaxies_release_gstars_job(GstarsJob *job)
+{
+    if (!jobs_release_handle(&job->handle))
+        return;
+
+    free(job->galaxy);
+    free(job);
+}
+
+/**
+ * Generates up to <GALAXY_CLOUD_JOB_BATCHES> batches of gstars of the copy of a galaxy.
+ * Runs on a worker thread of the job system.
+ *
+ * @param data A pointer to the GstarsJob.
+ *
+ * @return void
+ */
+static void galaxies_run_gstars_job(void *data)
+{
+    GstarsJob *job = data;
+    Galaxy *galaxy = job->galaxy;
+
+    for (int i = 0; i < GALAXY_CLOUD_JOB_BATCHES && !jobs_is_handle_cancelled(&job->handle); i++)
+    {
+        gfx_generate_gstars(galaxy, job->high_definition);
+
+        if (job->high_definition && galaxy->initialized_hd >= galaxy->total_groups_hd)
+            break;
+
+        if (!job->high_definition && galaxy->initialized >= galaxy->total_groups)
+            break;
+    }
+
+    jobs_finish_handle(&job->handle);
+    galaxies_release_gstars_job(job);
+}
+
+/**
+ * Sets whether gstars are generated on worker threads. Replays generate them on the calling thread,
+ * so that galaxy clouds are drawn the same on every run.
+ *
+ * @param async Whether to generate on worker threads.
+ *
+ * @return void
+ */
+void galaxies_set_async(bool async)
+{
+    is_async = async;
+}
+
+/**
+ * Checks whether a universe section has a galaxy. Uses a local rng seeded with the position of the section.
+ *
+ * @param position The position of the section.
+ *
+ * @return True if the section has a galaxy, false otherwise.
+ */
+bool galaxies_section_has_galaxy(Point position)
+{
+    // Use a local rng
+    pcg32_random_t rng;
+
+    // Create rng seed by combining x,y values
+    uint64_t seed = maths_hash_position_to_uint64_2(position);
+
+    // Seed with a fixed constant
+    pcg32_srandom_r(&rng, seed, 1);
+    COUNTERS_ADD(COUNTER_SEEDS_GALAXY_SECTIONS, 1);
+
+    return abs(pcg32_random_r(&rng)) % 1000 < UNIVERSE_DENSITY;
+}
+
 /**
  * Returns the size class of a galaxy based on its distance from the player position.
  *
@@ -770,3 +1237,56 @@ static unsigned short galaxies_size_class(float distance)
     else
         return GALAXY_1;
 }
+
+/**
+ * Starts generating gstars of a galaxy in the background.
+ *
+ * @param galaxy A pointer to the Galaxy.
+ * @param high_definition A boolean to generate the high definition gstars.
+ * @param priority The priority of the job, from jobs_get_priority().
+ *
+ * @return A pointer to the GstarsJob, or NULL if it could not be created.
+ */
+static GstarsJob *galaxies_start_gstars_job(const Galaxy *galaxy, bool high_definition, float priority)
+{
+    GstarsJob *job = (GstarsJob *)calloc(1, sizeof(GstarsJob));
+
+    if (job == NULL)
+    {
+        fprintf(stderr, "Error: Could not allocate memory for gstars job.\n");
+        return NULL;
+    }
+
+    job->galaxy = (Galaxy *)malloc(sizeof(Galaxy));
+
+    if (job->galaxy == NULL)
+    {
+        fprintf(stderr, "Error: Could not allocate memory for gstars job.\n");
+        free(job);
+        return NULL;
+    }
+
+    // Only the fields used to generate gstars are copied; The job writes the gstars after the last index
+    Galaxy *copy = job->galaxy;
+    copy->radius = galaxy->radius;
+    copy->position = galaxy->position;
+    copy->initialized = galaxy->initialized;
+    copy->initialized_hd = galaxy->initialized_hd;
+    copy->last_star_index = galaxy->last_star_index;
+    copy->last_star_index_hd = galaxy->last_star_index_hd;
+    copy->sections_in_group = galaxy->sections_in_group;
+    copy->sections_in_group_hd = galaxy->sections_in_group_hd;
+    copy->total_groups = galaxy->total_groups;
+    copy->total_groups_hd = galaxy->total_groups_hd;
+
+    job->high_definition = high_definition;
+    job->initialized = high_definition ? galaxy->initialized_hd : galaxy->initialized;
+    job->last_star_index = high_definition ? galaxy->last_star_index_hd : galaxy->last_star_index;
+    job->is_in_view = true;
+
+    jobs_init_handle(&job->handle);
+
+    jobs_submit(galaxies_run_gstars_job, job, JOB_TAG_UNIVERSE, priority);
+
+    return job;
+}
@@ -19,18 +19,22 @@ extern SDL_DisplayMode display_mode;
 extern SDL_Renderer *renderer;
 extern SDL_Color colors[];
 
+// Static variable definitions
+static const char *state_names[] = {"enter menu", "enter navigate", "enter map", "enter universe", "resume", "new game", "enter controls", "quit"};
+
 // Static function prototypes
 static void game_draw_ship(GameState *, const InputState *, const NavigationState *, Ship *, const Camera *);
 static void game_engage_autopilot(InputState *, GameEvents *, NavigationState *, Ship *, double distance);
 static void game_put_ship_in_orbit(CelestialBody *, Ship *, int radii);
 static void game_scroll_map(const GameState *, const InputState *, NavigationState *, const Camera *);
 static void game_scroll_universe(const GameState *, const InputState *, GameEvents *, NavigationState *, const Camera *);
-static void game_update_ship_position(GameState *, const InputState *, Ship *, const Camera *);
+static void game_update_ship_position(GameState *, const InputState *, NavigationState *, Ship *, const Camera *);
 static void game_zoom_map(GameState *, InputState *, GameEvents *, NavigationState *);
 static void game_zoom_universe(GameState *, InputState *, GameEvents *, NavigationState *);
 
 /**
  * Changes the state of the game to a new state and updates relevant game events.
+ * The change is marked in the trace capture, if one is running.
  *
  * @param game_state A pointer to the current GameState object.
  * @param game_events A pointer to the current GameEvents object.
@@ -42,6 +46,9 @@ void game_change_state(GameState *game_state, GameEvents *game_events, int new_s
 {
     game_state->state = new_state;
 
+    if (PROFILER_ON)
+        trace_add_instant(state_names[new_state]);
+
     if (game_state->state == NAVIGATE)
         game_events->is_game_started = true;
     else if (game_state->state == CONTROLS)
@@ -67,6 +74,8 @@ Ship game_create_ship(int radius, Point position, long double scale)
     ship.radius = radius;
     ship.position.x = (int)position.x;
     ship.position.y = (int)position.y;
+    ship.local_position.x = 0;
+    ship.local_position.y = 0;
     ship.previous_position.x = 0;
     ship.previous_position.y = 0;
     ship.vx = 0.0;
@@ -114,7 +123,7 @@ static void game_draw_ship(GameState *game_state, const InputState *input_state,
 {
     if (gfx_is_object_in_camera(camera, ship->position.x, ship->position.y, ship->radius, game_state->game_scale))
     {
-        SDL_RenderCopyEx(renderer, ship->texture, &ship->main_img_rect, &ship->rect, ship->angle, &ship->rotation_pt, SDL_FLIP_NONE);
+        render_copy_ex(ship->texture, &ship->main_img_rect, &ship->rect, ship->angle, &ship->rotation_pt, SDL_FLIP_NONE);
     }
     // Draw ship projection
     else if (PROJECTIONS_ON)
@@ -122,11 +131,11 @@ static void game_draw_ship(GameState *game_state, const InputState *input_state,
 
     // Draw thrust
     if (input_state->thrust_on)
-        SDL_RenderCopyEx(renderer, ship->texture, &ship->thrust_img_rect, &ship->rect, ship->angle, &ship->rotation_pt, SDL_FLIP_NONE);
+        render_copy_ex(ship->texture, &ship->thrust_img_rect, &ship->rect, ship->angle, &ship->rotation_pt, SDL_FLIP_NONE);
 
     // Draw reverse thrust
     if (input_state->reverse_on)
-        SDL_RenderCopyEx(renderer, ship->texture, &ship->reverse_img_rect, &ship->rect, ship->angle, &ship->rotation_pt, SDL_FLIP_NONE);
+        render_copy_ex(ship->texture, &ship->reverse_img_rect, &ship->rect, ship->angle, &ship->rotation_pt, SDL_FLIP_NONE);
 }
 
 /**
@@ -145,17 +154,17 @@ static void game_engage_autopilot(InputState *input_state, GameEvents *game_even
     game_events->deccelerate_to_waypoint = false;
 
     // Ship must point to next path point
-    double segment_dx = nav_state->waypoint_star->waypoint_path[nav_state->next_path_point - 1].position.x - nav_state->waypoint_star->waypoint_path[nav_state->next_path_point].position.x;
-    double segment_dy = nav_state->waypoint_star->waypoint_path[nav_state->next_path_point - 1].position.y - nav_state->waypoint_star->waypoint_path[nav_state->next_path_point].position.y;
+    double segment_dx = nav_state->waypoint_star->waypoint_path->points[nav_state->next_path_point - 1].position.x - nav_state->waypoint_star->waypoint_path->points[nav_state->next_path_point].position.x;
+    double segment_dy = nav_state->waypoint_star->waypoint_path->points[nav_state->next_path_point - 1].position.y - nav_state->waypoint_star->waypoint_path->points[nav_state->next_path_point].position.y;
     double segment_angle = atan2(-segment_dx, segment_dy) * 180.0 / M_PI;
 
-    double ship_to_point_dx = ship->position.x - nav_state->waypoint_star->waypoint_path[nav_state->next_path_point].position.x;
-    double ship_to_point_dy = ship->position.y - nav_state->waypoint_star->waypoint_path[nav_state->next_path_point].position.y;
+    double ship_to_point_dx = ship->position.x - nav_state->waypoint_star->waypoint_path->points[nav_state->next_path_point].position.x;
+    double ship_to_point_dy = ship->position.y - nav_state->waypoint_star->waypoint_path->points[nav_state->next_path_point].position.y;
     double ship_to_point_angle = atan2(-ship_to_point_dx, ship_to_point_dy) * 180.0 / M_PI;
 
     // Check whether ship is on the segment line
-    bool ship_on_segment = maths_is_point_on_line(nav_state->waypoint_star->waypoint_path[nav_state->next_path_point - 1].position,
-                                                  nav_state->waypoint_star->waypoint_path[nav_state->next_path_point].position,
+    bool ship_on_segment = maths_is_point_on_line(nav_state->waypoint_star->waypoint_path->points[nav_state->next_path_point - 1].position,
+                                                  nav_state->waypoint_star->waypoint_path->points[nav_state->next_path_point].position,
                                                   ship->position);
 
     if (ship_on_segment && nav_state->velocity.magnitude > GALAXY_SPEED_LIMIT - 1)
@@ -239,7 +248,9 @@ static void game_engage_autopilot(InputState *input_state, GameEvents *game_even
     if (diff >= 360)
         diff -= 360;
 
-    int speed_limit = GALAXY_SPEED_LIMIT;
+    // Legs to other galaxies run at the speed limit of the universe between galaxies
+    double distance_galaxy_center = sqrt(ship->position.x * ship->position.x + ship->position.y * ship->position.y);
+    int speed_limit = distance_galaxy_center < nav_state->current_galaxy->radius * GALAXY_SCALE ? GALAXY_SPEED_LIMIT : UNIVERSE_SPEED_LIMIT;
     double ship_velocity = sqrt((ship->vx * ship->vx) + (ship->vy * ship->vy));
 
     if (game_events->autopilot_rotated_ship)
@@ -268,15 +279,17 @@ static void game_engage_autopilot(InputState *input_state, GameEvents *game_even
         game_events->autopilot_rotated_ship = true;
 
     // Deccelerate when approaching last point in path
+    // The waypoint is only reached on the leg through its galaxy
+    bool is_final_leg = maths_points_equal(nav_state->waypoint_star->galaxy_position, nav_state->current_galaxy->position);
     bool ship_in_waypoint_cutoff = false;
     bool ship_in_planet_cutoff = false;
 
-    if (nav_state->waypoint_star->initialized)
+    if (nav_state->waypoint_star->initialized && is_final_leg)
         ship_in_waypoint_cutoff = maths_is_point_in_circle(ship->position,
                                                            nav_state->waypoint_star->position,
                                                            nav_state->waypoint_star->cutoff);
 
-    if (nav_state->waypoint_planet_index >= 0)
+    if (nav_state->waypoint_planet_index >= 0 && is_final_leg)
         ship_in_planet_cutoff = maths_is_point_in_circle(ship->position,
                                                          nav_state->waypoint_star->planets[nav_state->waypoint_planet_index]->position,
                                                          nav_state->waypoint_star->planets[nav_state->waypoint_planet_index]->cutoff);
@@ -301,7 +314,7 @@ static void game_engage_autopilot(InputState *input_state, GameEvents *game_even
             game_events->deccelerate_to_waypoint = true;
 
             // Draw reverse thrust
-            SDL_RenderCopyEx(renderer, ship->texture, &ship->reverse_img_rect, &ship->rect, ship->angle, &ship->rotation_pt, SDL_FLIP_NONE);
+            render_copy_ex(ship->texture, &ship->reverse_img_rect, &ship->rect, ship->angle, &ship->rotation_pt, SDL_FLIP_NONE);
         }
     }
 
@@ -321,15 +334,18 @@ static void game_engage_autopilot(InputState *input_state, GameEvents *game_even
             velocity_angle += 360.0;
 
         if (fabs(ship_to_point_angle - velocity_angle) > 1 || speed_limit - ship_velocity > 1)
-            SDL_RenderCopyEx(renderer, ship->texture, &ship->thrust_img_rect, &ship->rect, ship->angle, &ship->rotation_pt, SDL_FLIP_NONE);
+            render_copy_ex(ship->texture, &ship->thrust_img_rect, &ship->rect, ship->angle, &ship->rotation_pt, SDL_FLIP_NONE);
     }
 
     // Disengage autopilot
-    if (nav_state->next_path_point > nav_state->waypoint_star->waypoint_points)
+    if (nav_state->next_path_point > (unsigned int)nav_state->waypoint_star->waypoint_path->num_points)
         input_state->autopilot_on = false;
 
     double arrived_at_waypoint = false;
 
+    if (!is_final_leg)
+        return;
+
     // Star
     if (nav_state->waypoint_planet_index < 0)
     {
@@ -417,9 +433,14 @@ void game_reset(GameState *game_state, InputState *input_state, GameEvents *game
     game_state->game_scale_override = 0;
 
     // InputState
-    input_state->default_cursor = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_ARROW);
-    input_state->pointing_cursor = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_HAND);
-    input_state->drag_cursor = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_SIZEALL);
+    // Cursors are created once, on the main thread; New games are started by the simulation
+    if (!reset)
+    {
+        input_state->default_cursor = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_ARROW);
+        input_state->pointing_cursor = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_HAND);
+        input_state->drag_cursor = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_SIZEALL);
+    }
+
     input_state->previous_cursor = NULL;
     input_state->mouse_position.x = 0;
     input_state->mouse_position.y = 0;
@@ -442,6 +463,8 @@ void game_reset(GameState *game_state, InputState *input_state, GameEvents *game
     input_state->zoom_in = false;
     input_state->zoom_out = false;
     input_state->fps_on = true;
+    input_state->profiler_on = false;
+    input_state->counters_on = false;
     input_state->orbits_on = SHOW_ORBITS;
     input_state->autopilot_on = false;
     input_state->selected_menu_button_index = 0;
@@ -513,6 +536,10 @@ void game_reset(GameState *game_state, InputState *input_state, GameEvents *game
     ship->previous_position.y = 0;
     ship->angle = 0;
 
+    // Center local frame on ship
+    origin_reset(&nav_state->origin, ship->position);
+    ship->local_position = origin_get_local_position(&nav_state->origin, ship->position);
+
     // Sync camera position with ship
     camera->x = ship->position.x - (display_mode.w / 2);
     camera->y = ship->position.y - (display_mode.h / 2);
@@ -633,11 +660,15 @@ void game_reset(GameState *game_state, InputState *input_state, GameEvents *game
     }
     else
     {
-        if (nav_state->waypoint_star->waypoint_path != NULL)
+        route_cancel_job();
+        route_clear_cache();
+        itinerary_clear();
+
+        // Waypoints in other galaxies have no path until the ship reaches the galaxy of a leg
+        if (nav_state->waypoint_star->initialized)
         {
-            free(nav_state->waypoint_star->waypoint_path);
+            path_destroy(nav_state->waypoint_star->waypoint_path);
             nav_state->waypoint_star->waypoint_path = NULL;
-            nav_state->waypoint_star->waypoint_points = 0;
             stars_initialize_star(nav_state->waypoint_star);
         }
     }
@@ -646,13 +677,13 @@ void game_reset(GameState *game_state, InputState *input_state, GameEvents *game
     nav_state->next_path_point = 1;
 
     // Copy current_galaxy_copy to current_galaxy
-    memcpy(nav_state->current_galaxy, current_galaxy_copy, sizeof(Galaxy));
+    galaxies_copy_galaxy(nav_state->current_galaxy, current_galaxy_copy);
 
     // Set current galaxy as selected
     nav_state->current_galaxy->is_selected = true;
 
     // Copy current_galaxy to buffer_galaxy
-    memcpy(nav_state->buffer_galaxy, nav_state->current_galaxy, sizeof(Galaxy));
+    galaxies_copy_galaxy(nav_state->buffer_galaxy, nav_state->current_galaxy);
 
     // Generate background stars
     gfx_generate_bstars(game_events, nav_state, bstars, camera, false);
@@ -700,7 +731,7 @@ void game_run_map_state(GameState *game_state, InputState *input_state, GameEven
             // Reset galaxy to current position
             if (!maths_points_equal(nav_state->current_galaxy->position, nav_state->buffer_galaxy->position))
             {
-                memcpy(nav_state->current_galaxy, nav_state->buffer_galaxy, sizeof(Galaxy));
+                galaxies_copy_galaxy(nav_state->current_galaxy, nav_state->buffer_galaxy);
 
                 // Reset galaxy_offset
                 nav_state->galaxy_offset.current_x = nav_state->galaxy_offset.buffer_x;
@@ -713,13 +744,13 @@ void game_run_map_state(GameState *game_state, InputState *input_state, GameEven
                 if (nav_state->current_star != NULL && nav_state->buffer_star != NULL)
                 {
                     if (strcmp(nav_state->current_star->name, nav_state->buffer_star->name) != 0)
-                        memcpy(nav_state->current_star, nav_state->buffer_star, sizeof(Star));
+                        stars_copy_star(nav_state->current_star, nav_state->buffer_star);
 
                     // Select current star
                     if (nav_state->selected_star != NULL && nav_state->buffer_star != NULL)
                     {
                         if (strcmp(nav_state->selected_star->name, nav_state->buffer_star->name) != 0)
-                            memcpy(nav_state->selected_star, nav_state->buffer_star, sizeof(Star));
+                            stars_copy_star(nav_state->selected_star, nav_state->buffer_star);
 
                         nav_state->selected_star->is_selected = true;
                     }
@@ -735,13 +766,13 @@ void game_run_map_state(GameState *game_state, InputState *input_state, GameEven
                 if (nav_state->current_star != NULL && nav_state->waypoint_star != NULL)
                 {
                     if (strcmp(nav_state->current_star->name, nav_state->waypoint_star->name) != 0)
-                        memcpy(nav_state->current_star, nav_state->waypoint_star, sizeof(Star));
+                        stars_copy_star(nav_state->current_star, nav_state->waypoint_star);
                 }
 
                 if (nav_state->waypoint_star != NULL)
                 {
                     if (strcmp(nav_state->selected_star->name, nav_state->waypoint_star->name) != 0)
-                        memcpy(nav_state->selected_star, nav_state->waypoint_star, sizeof(Star));
+                        stars_copy_star(nav_state->selected_star, nav_state->waypoint_star);
                 }
 
                 nav_state->selected_star->is_selected = true;
@@ -766,7 +797,10 @@ void game_run_map_state(GameState *game_state, InputState *input_state, GameEven
     }
 
     game_zoom_map(game_state, input_state, game_events, nav_state);
+
+    PROFILER_BEGIN(PROFILER_SCOPE_STARS);
     stars_generate(game_state, game_events, nav_state, bstars, ship);
+    PROFILER_END(PROFILER_SCOPE_STARS);
     gfx_update_camera(camera, nav_state->map_offset, game_state->game_scale);
 
     if (!game_events->switch_to_universe)
@@ -800,14 +834,23 @@ void game_run_map_state(GameState *game_state, InputState *input_state, GameEven
     }
 
     // Create galaxy cloud
+    PROFILER_BEGIN(PROFILER_SCOPE_GSTARS);
+
     if (!nav_state->current_galaxy->initialized_hd || nav_state->current_galaxy->initialized_hd < nav_state->current_galaxy->total_groups_hd)
         gfx_generate_gstars(nav_state->current_galaxy, true);
 
+    PROFILER_END(PROFILER_SCOPE_GSTARS);
+
     game_scroll_map(game_state, input_state, nav_state, camera);
 
     // Process star system
     if (!game_events->switch_to_universe && !game_events->is_entering_map && !input_state->zoom_in && !input_state->zoom_out)
     {
+        PROFILER_BEGIN(PROFILER_SCOPE_DRAW_STARS);
+
+        // Populate the visible star systems before they are hovered
+        stars_populate_visible(input_state, nav_state, camera, MAP, game_state->game_scale);
+
         for (int i = 0; i < MAX_STARS; i++)
         {
             if (nav_state->stars[i] != NULL)
@@ -824,11 +867,15 @@ void game_run_map_state(GameState *game_state, InputState *input_state, GameEven
                         continue;
                     }
 
-                    stars_draw_star_system(game_state, input_state, nav_state, entry->star, camera);
+                    unsigned short lod = stars_get_lod(entry->star, game_state->game_scale);
+
+                    stars_draw_star_system(game_state, input_state, nav_state, entry->star, lod, camera);
                     entry = entry->next;
                 }
             }
         }
+
+        PROFILER_END(PROFILER_SCOPE_DRAW_STARS);
     }
 
     // Waypoint star
@@ -857,13 +904,14 @@ void game_run_map_state(GameState *game_state, InputState *input_state, GameEven
         gfx_toggle_star_hover(input_state, nav_state, camera, game_state->game_scale, MAP);
 
     // Calculate and draw waypoint path
+    // Paths are in the coordinates of the galaxy of the ship
     if (nav_state->waypoint_star->initialized &&
         !input_state->zoom_in && !input_state->zoom_out &&
-        strcmp(nav_state->current_galaxy->name, nav_state->waypoint_star->galaxy_name) == 0)
+        maths_points_equal(nav_state->current_galaxy->position, nav_state->buffer_galaxy->position))
     {
         gfx_calculate_waypoint_path(nav_state);
 
-        if (nav_state->waypoint_star->waypoint_path != NULL && nav_state->waypoint_star->waypoint_points > 0)
+        if (nav_state->waypoint_star->waypoint_path != NULL)
             gfx_draw_waypoint_path(game_state, nav_state, camera);
     }
 
@@ -882,18 +930,18 @@ void game_run_map_state(GameState *game_state, InputState *input_state, GameEven
         gfx_project_ship_on_edge(game_state->state, input_state, nav_state, ship, camera, game_state->game_scale);
     }
     else
-        SDL_RenderCopyEx(renderer, ship->projection->texture, &ship->projection->main_img_rect, &ship->projection->rect, ship->projection->angle, &ship->projection->rotation_pt, SDL_FLIP_NONE);
+        render_copy_ex(ship->projection->texture, &ship->projection->main_img_rect, &ship->projection->rect, ship->projection->angle, &ship->projection->rotation_pt, SDL_FLIP_NONE);
 
     // Draw galaxy cutoff circle
     int cutoff = nav_state->current_galaxy->cutoff * GALAXY_SCALE * game_state->game_scale;
     int cx = -camera->x * game_state->game_scale;
     int cy = -camera->y * game_state->game_scale;
-    gfx_draw_circle_approximation(renderer, camera, cx, cy, cutoff, colors[COLOR_CYAN_70]);
+    gfx_draw_circle(renderer, camera, cx, cy, cutoff, colors[COLOR_CYAN_70]);
 
     // Draw cross at position
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 128);
-    SDL_RenderDrawLine(renderer, (camera->w / 2) - 7, camera->h / 2, (camera->w / 2) + 7, camera->h / 2);
-    SDL_RenderDrawLine(renderer, camera->w / 2, (camera->h / 2) - 7, camera->w / 2, (camera->h / 2) + 7);
+    render_set_draw_color(255, 255, 255, 128);
+    render_draw_line((camera->w / 2) - 7, camera->h / 2, (camera->w / 2) + 7, camera->h / 2);
+    render_draw_line(camera->w / 2, (camera->h / 2) - 7, camera->w / 2, (camera->h / 2) + 7);
 
     if (nav_state->selected_star->initialized && nav_state->selected_star->is_selected)
     {
@@ -910,7 +958,10 @@ void game_run_map_state(GameState *game_state, InputState *input_state, GameEven
         stars_draw_info_box(nav_state, nav_state->current_star, camera);
     }
 
+    PROFILER_BEGIN(PROFILER_SCOPE_CONSOLE);
     console_draw_position_console(game_state, nav_state, camera);
+    PROFILER_END(PROFILER_SCOPE_CONSOLE);
+
     gfx_draw_screen_frame(camera);
 
     if (game_events->switch_to_map)
@@ -950,7 +1001,7 @@ void game_run_navigate_state(GameState *game_state, InputState *input_state, Gam
         // Reset stars and galaxy to current position
         if (!maths_points_equal(nav_state->current_galaxy->position, nav_state->buffer_galaxy->position))
         {
-            memcpy(nav_state->current_galaxy, nav_state->buffer_galaxy, sizeof(Galaxy));
+            galaxies_copy_galaxy(nav_state->current_galaxy, nav_state->buffer_galaxy);
 
             // Reset galaxy_offset
             nav_state->galaxy_offset.current_x = nav_state->galaxy_offset.buffer_x;
@@ -982,7 +1033,7 @@ void game_run_navigate_state(GameState *game_state, InputState *input_state, Gam
     if (nav_state->current_star != NULL && nav_state->selected_star != NULL)
     {
         if (strcmp(nav_state->selected_star->name, nav_state->buffer_star->name) != 0)
-            memcpy(nav_state->selected_star, nav_state->buffer_star, sizeof(Star));
+            stars_copy_star(nav_state->selected_star, nav_state->buffer_star);
 
         nav_state->selected_star->is_selected = true;
     }
@@ -1012,8 +1063,15 @@ void game_run_navigate_state(GameState *game_state, InputState *input_state, Gam
     }
 
     if (input_state->camera_on)
+    {
+        PROFILER_BEGIN(PROFILER_SCOPE_STARS);
         stars_generate(game_state, game_events, nav_state, bstars, ship);
 
+        // Generate the regions ahead of the ship before it reaches them
+        stars_prefetch_regions(nav_state, ship);
+        PROFILER_END(PROFILER_SCOPE_STARS);
+    }
+
     if (input_state->camera_on)
         gfx_update_camera(camera, nav_state->navigate_offset, game_state->game_scale);
 
@@ -1027,6 +1085,8 @@ void game_run_navigate_state(GameState *game_state, InputState *input_state, Gam
         // Draw galaxy cloud
         if (GSTARS_ON)
         {
+            PROFILER_BEGIN(PROFILER_SCOPE_GSTARS);
+
             Point ship_position_current = {.x = ship->position.x, .y = ship->position.y};
             static double limit_current;
 
@@ -1059,15 +1119,22 @@ void game_run_navigate_state(GameState *game_state, InputState *input_state, Gam
 
                 gfx_update_gstars_position(nav_state->previous_galaxy, ship_position_previous, camera, distance_previous, limit_previous);
             }
+
+            PROFILER_END(PROFILER_SCOPE_GSTARS);
         }
 
         // Draw background stars
         if (BSTARS_ON)
         {
+            PROFILER_BEGIN(PROFILER_SCOPE_BSTARS);
+
+            // The previous field is drawn until the new one has been generated
             if (game_events->generate_bstars)
                 gfx_generate_bstars(game_events, nav_state, bstars, camera, true);
-            else
-                gfx_update_bstars_position(game_state->state, input_state->camera_on, nav_state, bstars, camera, speed, distance_galaxy_center);
+
+            gfx_update_bstars_position(game_state->state, input_state->camera_on, nav_state, bstars, camera, speed, distance_galaxy_center);
+
+            PROFILER_END(PROFILER_SCOPE_BSTARS);
         }
 
         if (SPEED_LINES_ON && input_state->camera_on)
@@ -1089,8 +1156,14 @@ void game_run_navigate_state(GameState *game_state, InputState *input_state, Gam
 
                 while (entry != NULL)
                 {
+                    PROFILER_BEGIN(PROFILER_SCOPE_PHYSICS);
                     stars_update_orbital_positions(game_state, input_state, nav_state, entry->star, ship, camera, entry->star->class);
-                    stars_draw_star_system(game_state, input_state, nav_state, entry->star, camera);
+                    PROFILER_END(PROFILER_SCOPE_PHYSICS);
+
+                    PROFILER_BEGIN(PROFILER_SCOPE_DRAW_STARS);
+                    stars_draw_star_system(game_state, input_state, nav_state, entry->star, STAR_LOD_SYSTEM, camera);
+                    PROFILER_END(PROFILER_SCOPE_DRAW_STARS);
+
                     entry = entry->next;
                 }
             }
@@ -1115,19 +1188,24 @@ void game_run_navigate_state(GameState *game_state, InputState *input_state, Gam
         game_put_ship_in_orbit(body, ship, WAYPOINT_ORBIT_RADII);
 
         // Clean up waypoint
-        free(nav_state->waypoint_star->waypoint_path);
+        route_cancel_job();
+        path_destroy(nav_state->waypoint_star->waypoint_path);
         nav_state->waypoint_star->waypoint_path = NULL;
-        nav_state->waypoint_star->waypoint_points = 0;
         nav_state->waypoint_planet_index = -1;
         stars_initialize_star(nav_state->waypoint_star);
 
         game_events->arrived_at_waypoint = false;
     }
 
+    // Take the path of a route planned in the background, or start the leg through a new galaxy on the way
+    if ((route_is_planning() || nav_state->waypoint_star->waypoint_path == NULL) && nav_state->waypoint_star->initialized &&
+        maths_points_equal(nav_state->current_galaxy->position, nav_state->buffer_galaxy->position))
+        gfx_calculate_waypoint_path(nav_state);
+
     bool waypoint_path_exists = nav_state->waypoint_star->initialized &&
-                                nav_state->waypoint_star->waypoint_points > 0 &&
+                                nav_state->waypoint_star->waypoint_path != NULL &&
                                 !input_state->zoom_in && !input_state->zoom_out &&
-                                strcmp(nav_state->current_galaxy->name, nav_state->waypoint_star->galaxy_name) == 0;
+                                maths_points_equal(nav_state->current_galaxy->position, nav_state->buffer_galaxy->position);
 
     if (waypoint_path_exists)
     {
@@ -1139,11 +1217,13 @@ void game_run_navigate_state(GameState *game_state, InputState *input_state, Gam
             gfx_calculate_waypoint_path(nav_state);
 
         // Draw waypoint path
+        PROFILER_BEGIN(PROFILER_SCOPE_DRAW_SHIP);
         gfx_draw_waypoint_path(game_state, nav_state, camera);
+        PROFILER_END(PROFILER_SCOPE_DRAW_SHIP);
 
         double distance_ship_to_waypoint = maths_distance_between_points(ship->position.x, ship->position.y,
-                                                                         nav_state->waypoint_star->waypoint_path[nav_state->waypoint_star->waypoint_points - 1].position.x,
-                                                                         nav_state->waypoint_star->waypoint_path[nav_state->waypoint_star->waypoint_points - 1].position.y);
+                                                                         nav_state->waypoint_star->waypoint_path->points[nav_state->waypoint_star->waypoint_path->num_points - 1].position.x,
+                                                                         nav_state->waypoint_star->waypoint_path->points[nav_state->waypoint_star->waypoint_path->num_points - 1].position.y);
 
         // Autopilot
         if (input_state->autopilot_on)
@@ -1152,39 +1232,27 @@ void game_run_navigate_state(GameState *game_state, InputState *input_state, Gam
             game_events->autopilot_rotated_ship = false;
 
         // Increment next point in path
-        double distance_ship_to_next_point = maths_distance_between_points(nav_state->waypoint_star->waypoint_path[nav_state->next_path_point].position.x,
-                                                                           nav_state->waypoint_star->waypoint_path[nav_state->next_path_point].position.y,
+        double distance_ship_to_next_point = maths_distance_between_points(nav_state->waypoint_star->waypoint_path->points[nav_state->next_path_point].position.x,
+                                                                           nav_state->waypoint_star->waypoint_path->points[nav_state->next_path_point].position.y,
                                                                            ship->position.x,
                                                                            ship->position.y);
 
         if (distance_ship_to_next_point < WAYPOINT_CIRCLE_RADIUS)
             nav_state->next_path_point++;
 
-        // Make sure that the closest point to ship is set as next_path_point
+        // Make sure that the end of the segment closest to ship is set as next_path_point
         if (distance_ship_to_waypoint > nav_state->buffer_star->cutoff)
         {
-            double min_dist = INFINITY;
-            int closest_point_index = -1;
-
-            for (int i = nav_state->next_path_point; i < nav_state->waypoint_star->waypoint_points; i++)
-            {
-                double distance = sqrt(pow(nav_state->waypoint_star->waypoint_path[i].position.x - ship->position.x, 2) +
-                                       pow(nav_state->waypoint_star->waypoint_path[i].position.y - ship->position.y, 2));
-
-                if (distance < min_dist)
-                {
-                    min_dist = distance;
-                    closest_point_index = i;
-                }
-            }
+            int segment = path_find_nearest_segment(nav_state->waypoint_star->waypoint_path, ship->position, nav_state->next_path_point - 1);
 
-            if (closest_point_index > nav_state->next_path_point)
-                nav_state->next_path_point = closest_point_index;
+            if (segment + 1 > (int)nav_state->next_path_point)
+                nav_state->next_path_point = segment + 1;
         }
     }
     else
     {
-        if (input_state->autopilot_on)
+        // Keep the autopilot on while the leg through a new galaxy is planned
+        if (input_state->autopilot_on && !route_is_planning())
             input_state->autopilot_on = false;
     }
 
@@ -1206,14 +1274,18 @@ void game_run_navigate_state(GameState *game_state, InputState *input_state, Gam
         }
     }
 
+    PROFILER_BEGIN(PROFILER_SCOPE_PHYSICS);
     phys_update_velocity(&nav_state->velocity, ship);
-    game_update_ship_position(game_state, input_state, ship, camera);
+    game_update_ship_position(game_state, input_state, nav_state, ship, camera);
+    PROFILER_END(PROFILER_SCOPE_PHYSICS);
 
     // Update position
     nav_state->navigate_offset.x = ship->position.x;
     nav_state->navigate_offset.y = ship->position.y;
 
+    PROFILER_BEGIN(PROFILER_SCOPE_DRAW_SHIP);
     game_draw_ship(game_state, input_state, nav_state, ship, camera);
+    PROFILER_END(PROFILER_SCOPE_DRAW_SHIP);
 
     // Check for nearest galaxy, excluding current galaxy
     if (game_events->has_exited_galaxy && PROJECTIONS_ON)
@@ -1243,22 +1315,30 @@ void game_run_navigate_state(GameState *game_state, InputState *input_state, Gam
     }
 
     // Create galaxy cloud
+    PROFILER_BEGIN(PROFILER_SCOPE_GSTARS);
+
     if (!nav_state->current_galaxy->initialized_hd || nav_state->current_galaxy->initialized_hd < nav_state->current_galaxy->total_groups_hd)
         gfx_generate_gstars(nav_state->current_galaxy, true);
 
+    PROFILER_END(PROFILER_SCOPE_GSTARS);
+
     // Draw star console
+    PROFILER_BEGIN(PROFILER_SCOPE_CONSOLE);
+
     if (nav_state->current_star != NULL)
     {
         // Get distance from current_star
         double distance_star = maths_distance_between_points(nav_state->current_star->position.x, nav_state->current_star->position.y, nav_state->navigate_offset.x, nav_state->navigate_offset.y);
 
-        if (nav_state->waypoint_star->initialized && nav_state->waypoint_star->waypoint_points > 0)
+        if (nav_state->waypoint_star->initialized && nav_state->waypoint_star->waypoint_path != NULL)
             console_draw_waypoint_console(nav_state, ship, camera);
         else if (distance_star < nav_state->current_star->cutoff)
             console_draw_star_console(nav_state->current_star, camera);
     }
 
     console_draw_ship_console(game_state, input_state, nav_state, ship, camera);
+    PROFILER_END(PROFILER_SCOPE_CONSOLE);
+
     gfx_draw_screen_frame(camera);
 
     if (game_events->is_exiting_map)
@@ -1318,12 +1398,15 @@ void game_run_universe_state(GameState *game_state, InputState *input_state, Gam
         if (!game_events->switch_to_universe)
         {
             if (strcmp(nav_state->current_galaxy->name, nav_state->buffer_galaxy->name) != 0)
-                memcpy(nav_state->current_galaxy, nav_state->buffer_galaxy, sizeof(Galaxy));
+                galaxies_copy_galaxy(nav_state->current_galaxy, nav_state->buffer_galaxy);
         }
 
         if (game_events->is_centering_universe)
             stars_clear_table(nav_state->stars, nav_state, false);
 
+        // The ship is out of view; Work around it is no longer needed
+        jobs_cancel(JOB_TAG_REGION);
+
         nav_state->current_galaxy->is_selected = true;
 
         // Initialize cross lines for stars preview
@@ -1336,7 +1419,9 @@ void game_run_universe_state(GameState *game_state, InputState *input_state, Gam
 
         // Generate galaxies
         Point offset = {.x = nav_state->galaxy_offset.current_x, .y = nav_state->galaxy_offset.current_y};
+        PROFILER_BEGIN(PROFILER_SCOPE_GALAXIES);
         galaxies_generate(game_events, nav_state, offset);
+        PROFILER_END(PROFILER_SCOPE_GALAXIES);
 
         if (game_events->is_entering_universe && !game_state->save_scale)
             game_state->save_scale = game_state->game_scale;
@@ -1377,7 +1462,11 @@ void game_run_universe_state(GameState *game_state, InputState *input_state, Gam
         game_events->start_stars_preview = true;
     }
     else
+    {
+        PROFILER_BEGIN(PROFILER_SCOPE_GALAXIES);
         galaxies_generate(game_events, nav_state, nav_state->universe_offset);
+        PROFILER_END(PROFILER_SCOPE_GALAXIES);
+    }
 
     gfx_draw_section_lines(camera, game_state->state, colors[COLOR_ORANGE_32], game_state->game_scale * GALAXY_SCALE);
 
@@ -1392,7 +1481,9 @@ void game_run_universe_state(GameState *game_state, InputState *input_state, Gam
             nav_state->map_offset.x = (nav_state->universe_offset.x - nav_state->current_galaxy->position.x) * GALAXY_SCALE;
             nav_state->map_offset.y = (nav_state->universe_offset.y - nav_state->current_galaxy->position.y) * GALAXY_SCALE;
 
+            PROFILER_BEGIN(PROFILER_SCOPE_STARS);
             stars_generate_preview(game_events, nav_state, camera, game_state->game_scale);
+            PROFILER_END(PROFILER_SCOPE_STARS);
             game_events->start_stars_preview = false;
             game_events->zoom_preview = false;
         }
@@ -1401,6 +1492,12 @@ void game_run_universe_state(GameState *game_state, InputState *input_state, Gam
     // Draw galaxies
     if (!game_events->is_entering_universe && !input_state->is_mouse_double_clicked)
     {
+        PROFILER_BEGIN(PROFILER_SCOPE_GSTARS);
+        galaxies_generate_gstars(input_state, nav_state, ship, camera, game_state->game_scale);
+        PROFILER_END(PROFILER_SCOPE_GSTARS);
+
+        PROFILER_BEGIN(PROFILER_SCOPE_DRAW_GALAXIES);
+
         for (int i = 0; i < MAX_GALAXIES; i++)
         {
             if (nav_state->galaxies[i] != NULL)
@@ -1415,6 +1512,8 @@ void game_run_universe_state(GameState *game_state, InputState *input_state, Gam
                 }
             }
         }
+
+        PROFILER_END(PROFILER_SCOPE_DRAW_GALAXIES);
     }
 
     // Check if mouse is over current galaxy
@@ -1425,13 +1524,18 @@ void game_run_universe_state(GameState *game_state, InputState *input_state, Gam
     gfx_update_camera(camera, nav_state->universe_offset, game_state->game_scale * GALAXY_SCALE);
 
     // Draw cross at position
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 128);
-    SDL_RenderDrawLine(renderer, (camera->w / 2) - 7, camera->h / 2, (camera->w / 2) + 7, camera->h / 2);
-    SDL_RenderDrawLine(renderer, camera->w / 2, (camera->h / 2) - 7, camera->w / 2, (camera->h / 2) + 7);
+    render_set_draw_color(255, 255, 255, 128);
+    render_draw_line((camera->w / 2) - 7, camera->h / 2, (camera->w / 2) + 7, camera->h / 2);
+    render_draw_line(camera->w / 2, (camera->h / 2) - 7, camera->w / 2, (camera->h / 2) + 7);
 
     // Draw stars and star systems
     if (game_state->game_scale >= zoom_generate_preview_stars - epsilon)
     {
+        PROFILER_BEGIN(PROFILER_SCOPE_DRAW_STARS);
+
+        // Populate the visible star systems before they are hovered
+        stars_populate_visible(input_state, nav_state, camera, UNIVERSE, game_state->game_scale);
+
         for (int i = 0; i < MAX_STARS; i++)
         {
             if (nav_state->stars[i] != NULL)
@@ -1448,38 +1552,20 @@ void game_run_universe_state(GameState *game_state, InputState *input_state, Gam
                         continue;
                     }
 
+                    unsigned short lod = stars_get_lod(entry->star, game_state->game_scale);
+
                     // Calculate opacity
                     float opacity = entry->star->class * (255 / 6);
 
                     if (opacity < 120)
                         opacity = 120.0f;
 
-                    double zoom_threshold;
-
-                    switch (entry->star->class)
-                    {
-                    case 1:
-                        zoom_threshold = ZOOM_UNIVERSE_STAR_SYSTEMS;
-                        break;
-                    case 2:
-                        zoom_threshold = ZOOM_UNIVERSE_STAR_SYSTEMS - 0.0002;
-                        break;
-                    case 3:
-                    case 4:
-                        zoom_threshold = ZOOM_UNIVERSE_STAR_SYSTEMS - 0.0003;
-                        break;
-                    case 5:
-                    case 6:
-                        zoom_threshold = ZOOM_UNIVERSE_STAR_SYSTEMS - 0.0004;
-                        break;
-                    default:
-                        zoom_threshold = ZOOM_UNIVERSE_STAR_SYSTEMS;
-                        break;
-                    }
+                    // Points fade in until the scale at which the star system is drawn
+                    double zoom_threshold = STAR_LOD_ORBITS_RADIUS / entry->star->cutoff;
 
                     opacity = (((game_state->game_scale - zoom_generate_preview_stars) / (zoom_threshold - zoom_generate_preview_stars)) * (255.0f - opacity) + opacity);
 
-                    if (game_state->game_scale >= zoom_threshold)
+                    if (lod >= STAR_LOD_ORBITS)
                         opacity = 255.0f;
 
                     // Check if mouse is inside star cutoff
@@ -1503,43 +1589,55 @@ void game_run_universe_state(GameState *game_state, InputState *input_state, Gam
 
                         // Seed with a fixed constant
                         pcg32_srandom_r(&rng, seed, seed);
+                        COUNTERS_ADD(COUNTER_SEEDS_STAR_SYSTEMS, 1);
 
                         // Draw star cutoff circle
                         if ((strcmp(nav_state->selected_star->name, entry->star->name) != 0 || !nav_state->selected_star->is_selected) &&
                             strcmp(nav_state->waypoint_star->name, entry->star->name) != 0)
                             gfx_draw_circle(renderer, camera, x, y, star_cutoff, colors[COLOR_MAGENTA_120]);
 
+                        // The info boxes list the planets, so the system is created even if it is not drawn
                         stars_populate_body(entry->star, entry->star->position, rng, game_state->game_scale);
 
-                        // Draw star systems
-                        if (game_state->game_scale >= zoom_threshold - epsilon)
+                        // Draw star systems that are large enough to be seen
+                        if (lod >= STAR_LOD_ORBITS)
+                            stars_draw_universe_star_system(game_state, input_state, nav_state, entry->star, lod, camera);
+                        else if (lod == STAR_LOD_DISC)
                         {
-                            stars_draw_universe_star_system(game_state, input_state, nav_state, entry->star, camera);
+                            SDL_Color star_color = {entry->star->color.r, entry->star->color.g, entry->star->color.b, (int)opacity};
+                            gfx_draw_fill_circle(renderer, x, y, (int)(entry->star->radius * game_state->game_scale), star_color);
                         }
                         else
                         {
-                            SDL_SetRenderDrawColor(renderer, entry->star->color.r, entry->star->color.g, entry->star->color.b, (int)opacity);
-                            SDL_RenderDrawPoint(renderer, x, y);
+                            render_set_draw_color(entry->star->color.r, entry->star->color.g, entry->star->color.b, (int)opacity);
+                            render_draw_point(x, y);
                         }
 
                         // Set star as current_star
                         if (nav_state->current_star != NULL && distance_star <= star_cutoff)
                         {
                             if (strcmp(nav_state->current_star->name, entry->star->name) != 0)
-                                memcpy(nav_state->current_star, entry->star, sizeof(Star));
+                                stars_copy_star(nav_state->current_star, entry->star);
                         }
                     }
+                    else if (lod == STAR_LOD_DISC)
+                    {
+                        SDL_Color star_color = {entry->star->color.r, entry->star->color.g, entry->star->color.b, (int)opacity};
+                        gfx_draw_fill_circle(renderer, x, y, (int)(entry->star->radius * game_state->game_scale), star_color);
+                    }
                     else
                     {
                         // Draw points
-                        SDL_SetRenderDrawColor(renderer, entry->star->color.r, entry->star->color.g, entry->star->color.b, (int)opacity);
-                        SDL_RenderDrawPoint(renderer, x, y);
+                        render_set_draw_color(entry->star->color.r, entry->star->color.g, entry->star->color.b, (int)opacity);
+                        render_draw_point(x, y);
                     }
 
                     entry = entry->next;
                 }
             }
         }
+
+        PROFILER_END(PROFILER_SCOPE_DRAW_STARS);
     }
 
     // Calculate waypoint path
@@ -1547,11 +1645,11 @@ void game_run_universe_state(GameState *game_state, InputState *input_state, Gam
         game_state->game_scale >= zoom_generate_preview_stars - epsilon &&
         !game_events->start_stars_preview && !game_events->lazy_load_started &&
         !input_state->zoom_in && !input_state->zoom_out &&
-        strcmp(nav_state->current_galaxy->name, nav_state->waypoint_star->galaxy_name) == 0)
+        maths_points_equal(nav_state->current_galaxy->position, nav_state->buffer_galaxy->position))
     {
         gfx_calculate_waypoint_path(nav_state);
 
-        if (nav_state->waypoint_star->waypoint_points > 0)
+        if (nav_state->waypoint_star->waypoint_path != NULL)
             gfx_draw_waypoint_path(game_state, nav_state, camera);
     }
 
@@ -1570,7 +1668,7 @@ void game_run_universe_state(GameState *game_state, InputState *input_state, Gam
             gfx_project_ship_on_edge(game_state->state, input_state, nav_state, ship, camera, game_state->game_scale);
         }
         else
-            SDL_RenderCopyEx(renderer, ship->projection->texture, &ship->projection->main_img_rect, &ship->projection->rect, ship->projection->angle, &ship->projection->rotation_pt, SDL_FLIP_NONE);
+            render_copy_ex(ship->projection->texture, &ship->projection->main_img_rect, &ship->projection->rect, ship->projection->angle, &ship->projection->rotation_pt, SDL_FLIP_NONE);
     }
 
     // Toggle star hover / Draw star info box
@@ -1682,14 +1780,21 @@ void game_run_universe_state(GameState *game_state, InputState *input_state, Gam
     // Draw galaxy info box
     if (nav_state->current_galaxy->is_selected)
     {
+        PROFILER_BEGIN(PROFILER_SCOPE_GSTARS);
+
         if (!nav_state->current_galaxy->initialized || nav_state->current_galaxy->initialized < nav_state->current_galaxy->total_groups)
             gfx_generate_gstars(nav_state->current_galaxy, false);
 
+        PROFILER_END(PROFILER_SCOPE_GSTARS);
+
         if (game_state->game_scale <= zoom_threshold + epsilon)
             galaxies_draw_info_box(nav_state->current_galaxy, camera);
     }
 
+    PROFILER_BEGIN(PROFILER_SCOPE_CONSOLE);
     console_draw_position_console(game_state, nav_state, camera);
+    PROFILER_END(PROFILER_SCOPE_CONSOLE);
+
     gfx_draw_screen_frame(camera);
 
     if (game_events->is_exiting_map)
@@ -1801,12 +1906,13 @@ static void game_scroll_universe(const GameState *game_state, const InputState *
  *
  * @param game_state A pointer to the current GameState object.
  * @param input_state A pointer to the current InputState object.
+ * @param nav_state A pointer to the current NavigationState object.
  * @param ship A pointer to the ship to update.
  * @param camera A pointer to the current Camera object.
  *
  * @return void
  */
-static void game_update_ship_position(GameState *game_state, const InputState *input_state, Ship *ship, const Camera *camera)
+static void game_update_ship_position(GameState *game_state, const InputState *input_state, NavigationState *nav_state, Ship *ship, const Camera *camera)
 {
     float radians;
 
@@ -1848,9 +1954,17 @@ static void game_update_ship_position(GameState *game_state, const InputState *i
         ship->vy = 0;
     }
 
-    // Update ship position
-    ship->position.x += (float)ship->vx / FPS;
-    ship->position.y += (float)ship->vy / FPS;
+    // Pick up position changes made outside the local frame
+    origin_sync_ship(&nav_state->origin, ship);
+
+    // Update ship position in the local frame
+    ship->local_position.x += ship->vx / FPS;
+    ship->local_position.y += ship->vy / FPS;
+
+    // Move origin along with the ship to keep local coordinates small
+    origin_rebase(&nav_state->origin, &ship->local_position);
+
+    ship->position = origin_get_absolute_position(&nav_state->origin, ship->local_position);
 
     if (input_state->camera_on)
     {
@@ -16,91 +16,107 @@
 #include "../include/graphics.h"
 
 // External variable definitions
-extern TTF_Font *fonts[];
 extern SDL_Renderer *renderer;
 extern SDL_Color colors[];
 
+// Static variable definitions
+static GalaxyCloud galaxy_clouds[GALAXY_CLOUD_CACHE_SIZE];
+static unsigned int galaxy_clouds_clock = 0;
+static SDL_Texture *disc_textures[DISC_TEXTURE_LEVELS];
+static SDL_Texture *bstars_textures[2]; // The front texture is drawn while stars are generated into the back one
+static SDL_Point bstars_sizes[2];       // Sizes of the background star textures
+static int bstars_front = 0;
+static Point bstars_offset; // Scroll position of the field, in pixels
+
 // Static function prototypes
-static void gfx_calculate_path_segment(double cx, double cy, double px, double py, double radius, int direction, double *x, double *y);
-static bool gfx_has_line_of_sight(NavigationState *, double x1, double y1, double x2, double y2, Star *stars[], int max_stars);
-static void gfx_move_point_on_circumference(NavigationState *, Point *, Star *stars[], int max_stars);
-static void gfx_normalize_waypoint_path(NavigationState *, PathPoint path[], int total_points);
-static void gfx_shift_path_segment(NavigationState *, Point, Star *stars[], int max_stars, double *x, double *y);
+static bool gfx_draw_bstars_texture(const Bstar *bstars, int start, int end, const Camera *, bool clear);
+static void gfx_draw_circle_arc(SDL_Renderer *, double xc, double yc, double radius, double start, double end);
+static bool gfx_draw_galaxy_cloud_texture(const Galaxy *, const Camera *, int gstars_count, bool high_definition, long double scale, float opacity_factor);
+static int gfx_get_circle_visible_arcs(const Camera *, double xc, double yc, double radius, double arcs[][2]);
+static SDL_Texture *gfx_get_disc_texture(SDL_Renderer *, int level);
+static GalaxyCloud *gfx_get_galaxy_cloud(const Galaxy *, bool high_definition);
+static bool gfx_render_galaxy_cloud_level(GalaxyCloud *, const Galaxy *, int gstars_count, bool high_definition, int level);
 static int gfx_update_projection_opacity(double distance, int region_size, int section_size);
 static void gfx_update_projection_position(const NavigationState *, void *ptr, int entity_type, const Camera *, int state, long double scale);
 
 /**
- * Takes a point outside a circle and calculates a new point at <step> distance that is closer to the circle
- * in a clockwise or counter-clockwise direction.
- *
- * @param cx The x-coordinate of the star's center.
- * @param cy The y-coordinate of the star's center.
- * @param px The x-coordinate of the point outside the star.
- * @param py The y-coordinate of the point outside the star.
- * @param radius The cutoff of the star.
- * @param direction Whether the direction of the new point is clockwise to the original point or counter-clockwise.
- * @param x The x-coordinate of the new point.
- * @param y The y-coordinate of the new point.
+ * Calculates a path between the current position and the waypoint star, around the cutoffs of stars on the way.
+ * The route is planned in the background; Partial paths are published as they improve, until the final one.
+ * If the waypoint is in another galaxy, the path is the leg of the itinerary through the current galaxy,
+ * and continues in a straight line to the next galaxy. The itinerary is planned in the background too.
+ *
+ * @param nav_state A pointer to the current NavigationState object.
  *
  * @return void
  */
-static void gfx_calculate_path_segment(double cx, double cy, double px, double py, double radius, int direction, double *x, double *y)
+void gfx_calculate_waypoint_path(NavigationState *nav_state)
 {
-    double step = radius * 0.1;
-    double dist = sqrt((px - cx) * (px - cx) + (py - cy) * (py - cy));
-    double mx = (px + cx) / 2.0;
-    double my = (py + cy) / 2.0;
-    double d = sqrt(radius * radius - dist * dist / 4.0);
-    double dx = cx - px;
-    double dy = cy - py;
-    double perpendicular_x = dy / dist * d;
-    double perpendicular_y = -dx / dist * d;
+    PathPoint *path;
+    int total_points;
+    bool is_final_leg = maths_points_equal(nav_state->waypoint_star->galaxy_position, nav_state->current_galaxy->position);
+    Point exit, entry;
 
-    if (direction == 1)
+    // Replace the path with the latest one planned
+    if (route_poll_job(&path, &total_points))
     {
-        *x = mx + perpendicular_x;
-        *y = my + perpendicular_y;
-    }
-    else
-    {
-        *x = mx - perpendicular_x;
-        *y = my - perpendicular_y;
-    }
+        WaypointPath *waypoint_path = path_create(total_points + 1);
 
-    double scale = step / sqrt((*x - px) * (*x - px) + (*y - py) * (*y - py));
-    *x = px + (*x - px) * scale;
-    *y = py + (*y - py) * scale;
-}
+        for (int i = 0; waypoint_path != NULL && i < total_points; i++)
+        {
+            if (!path_add_point(waypoint_path, path[i].type, path[i].position))
+            {
+                path_destroy(waypoint_path);
+                waypoint_path = NULL;
+            }
+        }
 
-/**
- * Calculates a path between the current position and the waypoint star.
- *
- * @param nav_state A pointer to the current NavigationState object.
- *
- * @return void
- */
-void gfx_calculate_waypoint_path(NavigationState *nav_state)
-{
-    if (nav_state->waypoint_star->waypoint_points > 0 && nav_state->waypoint_planet_index >= 0)
+        if (waypoint_path != NULL && !is_final_leg && itinerary_get_leg(nav_state, &exit, &entry) == ITINERARY_LEG_FOUND && !maths_points_equal(exit, entry) &&
+            !path_add_point(waypoint_path, PATH_POINT_STRAIGHT, entry))
+        {
+            path_destroy(waypoint_path);
+            waypoint_path = NULL;
+        }
+
+        free(path);
+        path_destroy(nav_state->waypoint_star->waypoint_path);
+        nav_state->waypoint_star->waypoint_path = waypoint_path;
+        nav_state->next_path_point = 1;
+    }
+
+    if (nav_state->waypoint_star->waypoint_path != NULL && nav_state->waypoint_planet_index >= 0 && is_final_leg)
     {
         // Update last point in path (planet)
-        if (nav_state->waypoint_star->waypoint_path != NULL)
-            nav_state->waypoint_star->waypoint_path[nav_state->waypoint_star->waypoint_points - 1].position =
-                nav_state->waypoint_star->planets[nav_state->waypoint_planet_index]->position;
+        path_set_point(nav_state->waypoint_star->waypoint_path, nav_state->waypoint_star->waypoint_path->num_points - 1,
+                       nav_state->waypoint_star->planets[nav_state->waypoint_planet_index]->position);
 
         return;
     }
-    else if (nav_state->waypoint_star->waypoint_points > 0)
+    else if (nav_state->waypoint_star->waypoint_path != NULL || route_is_planning())
         return;
 
-    double buffer_x = nav_state->buffer_star->position.x;
-    double buffer_y = nav_state->buffer_star->position.y;
     double start_x = nav_state->navigate_offset.x;
     double start_y = nav_state->navigate_offset.y;
     double dest_x;
     double dest_y;
+    Point star_position = nav_state->waypoint_star->position;
+    int planet_index = nav_state->waypoint_planet_index;
+    unsigned short leg = is_final_leg ? ITINERARY_LEG_NONE : itinerary_get_leg(nav_state, &exit, &entry);
+
+    // The path is calculated once the itinerary to the galaxy of the waypoint is planned
+    if (leg == ITINERARY_LEG_PLANNING)
+        return;
+
+    bool is_leg = leg == ITINERARY_LEG_FOUND;
 
-    if (nav_state->waypoint_planet_index >= 0)
+    if (is_leg)
+    {
+        // Legs are cached by their exit
+        dest_x = exit.x;
+        dest_y = exit.y;
+        star_position = exit;
+        planet_index = -1;
+    }
+    else if (nav_state->waypoint_planet_index >= 0)
     {
         dest_x = nav_state->waypoint_star->planets[nav_state->waypoint_planet_index]->position.x;
         dest_y = nav_state->waypoint_star->planets[nav_state->waypoint_planet_index]->position.y;
@@ -111,23 +127,46 @@ void gfx_calculate_waypoint_path(NavigationState *nav_state)
         dest_y = nav_state->waypoint_star->position.y;
     }
 
-    double dest_cutoff = nav_state->waypoint_star->cutoff;
+    // Outside the galaxy, the route starts at its edge, on the side of the ship
+    double edge = nav_state->current_galaxy->radius * GALAXY_SCALE + ITINERARY_EXIT_MARGIN * GALAXY_SECTION_SIZE;
+    double distance_center = sqrt(start_x * start_x + start_y * start_y);
+
+    if (distance_center > edge)
+    {
+        // There are no stars on the way if the route does not cross the galaxy
+        if (is_leg && !maths_line_intersects_circle(start_x, start_y, dest_x, dest_y, 0, 0, nav_state->current_galaxy->radius * GALAXY_SCALE))
+        {
+            WaypointPath *waypoint_path = path_create(3);
+
+            if (waypoint_path != NULL &&
+                (!path_add_point(waypoint_path, PATH_POINT_STRAIGHT, (Point){start_x, start_y}) ||
+                 !path_add_point(waypoint_path, PATH_POINT_STRAIGHT, exit) ||
+                 (!maths_points_equal(exit, entry) && !path_add_point(waypoint_path, PATH_POINT_STRAIGHT, entry))))
+            {
+                path_destroy(waypoint_path);
+                waypoint_path = NULL;
+            }
+
+            nav_state->waypoint_star->waypoint_path = waypoint_path;
+            nav_state->next_path_point = 1;
+
+            return;
+        }
+
+        route_start_job(nav_state, (Point){start_x, start_y}, (Point){start_x * edge / distance_center, start_y * edge / distance_center},
+                        (Point){dest_x, dest_y}, star_position, planet_index);
+
+        return;
+    }
+
+    double buffer_x = nav_state->buffer_star->position.x;
+    double buffer_y = nav_state->buffer_star->position.y;
     double x = start_x;
     double y = start_y;
     int direction;
     double degrees;
-    int total_points = 0;
-
-    // 1. Add starting position to path
-    PathPoint *raw_path;
 
-    raw_path = (PathPoint *)malloc(sizeof(PathPoint));
-    raw_path[total_points].type = PATH_POINT_STRAIGHT;
-    raw_path[total_points].position.x = start_x;
-    raw_path[total_points].position.y = start_y;
-    total_points++;
-
-    // 2. Move starting position outside star cutoff if needed
+    // 1. Move starting position outside star cutoff if needed
     if (maths_is_point_in_circle((Point){start_x, start_y},
                                  (Point){buffer_x, buffer_y},
                                  nav_state->buffer_star->cutoff))
@@ -164,107 +203,10 @@ void gfx_calculate_waypoint_path(NavigationState *nav_state)
                                                    degrees);
             }
         }
-
-        if (x != start_x && y != start_y)
-        {
-            // Add new starting position outside circle to path
-            raw_path = (PathPoint *)realloc(raw_path, (total_points + 1) * sizeof(PathPoint));
-            raw_path[total_points].type = PATH_POINT_STRAIGHT;
-            raw_path[total_points].position.x = x;
-            raw_path[total_points].position.y = y;
-            total_points++;
-        }
-    }
-
-    // 3. Calculate path
-    double _x = x;
-    double _y = y;
-    double bx, by;
-
-    bool path_reached_waypoint = maths_is_point_in_circle((Point){_x, _y}, (Point){dest_x, dest_y}, dest_cutoff) ||
-                                 maths_line_intersects_circle(x, y, _x, _y, dest_x, dest_y, dest_cutoff);
-
-    while (!path_reached_waypoint)
-    {
-        unsigned short segment_type = PATH_POINT_STRAIGHT;
-
-        // Move point (_x,_y) closer to waypoint
-        double step = GALAXY_SECTION_SIZE * 0.5;
-        maths_move_point_along_line(x, y, dest_x, dest_y, step, &_x, &_y);
-
-        // Find nearest stars to (_x,_y)
-        Star *nearest_stars[MAX_NEAREST_STARS];
-
-        for (int i = 0; i < MAX_NEAREST_STARS; i++)
-            nearest_stars[i] = NULL;
-
-        bx = maths_get_nearest_section_line(_x, GALAXY_SECTION_SIZE);
-        by = maths_get_nearest_section_line(_y, GALAXY_SECTION_SIZE);
-        int nearest_stars_count = stars_nearest_stars_to_point(nav_state, (Point){bx, by}, nearest_stars);
-
-        if (nearest_stars_count > 0)
-        {
-            for (int s = 0; s < nearest_stars_count; s++)
-            {
-                if (nearest_stars[s] != NULL && strcmp(nearest_stars[s]->name, nav_state->waypoint_star->name) != 0)
-                {
-                    direction = maths_get_rotation_direction(nearest_stars[s]->position.x, nearest_stars[s]->position.y,
-                                                             x, y,
-                                                             dest_x, dest_y);
-
-                    bool star_obstructs_path = maths_is_point_in_circle((Point){_x, _y},
-                                                                        (Point){nearest_stars[s]->position.x, nearest_stars[s]->position.y},
-                                                                        nearest_stars[s]->cutoff) ||
-                                               maths_line_intersects_circle(x, y,
-                                                                            _x, _y,
-                                                                            nearest_stars[s]->position.x, nearest_stars[s]->position.y,
-                                                                            nearest_stars[s]->cutoff);
-
-                    if (star_obstructs_path)
-                    {
-                        segment_type = PATH_POINT_TURN;
-
-                        gfx_calculate_path_segment(nearest_stars[s]->position.x, nearest_stars[s]->position.y,
-                                                   x, y,
-                                                   nearest_stars[s]->cutoff,
-                                                   direction,
-                                                   &_x, &_y);
-
-                        gfx_shift_path_segment(nav_state, (Point){x, y}, nearest_stars, nearest_stars_count, &_x, &_y);
-
-                        x = _x;
-                        y = _y;
-                    }
-                }
-            }
-        }
-
-        x = _x;
-        y = _y;
-
-        // Add point to path
-        raw_path = (PathPoint *)realloc(raw_path, (total_points + 1) * sizeof(PathPoint));
-        raw_path[total_points].type = segment_type;
-        raw_path[total_points].position.x = x;
-        raw_path[total_points].position.y = y;
-        total_points++;
-
-        path_reached_waypoint = maths_is_point_in_circle((Point){_x, _y}, (Point){dest_x, dest_y}, dest_cutoff) ||
-                                maths_line_intersects_circle(x, y, _x, _y, dest_x, dest_y, dest_cutoff);
     }
 
-    // 4. Add waypoint star position to path
-    raw_path = (PathPoint *)realloc(raw_path, (total_points + 1) * sizeof(PathPoint));
-    raw_path[total_points].type = PATH_POINT_STRAIGHT;
-    raw_path[total_points].position.x = dest_x;
-    raw_path[total_points].position.y = dest_y;
-    total_points++;
-
-    // 5. Normalize path
-    gfx_normalize_waypoint_path(nav_state, raw_path, total_points);
-
-    // 6. Clean up raw path
-    free(raw_path);
+    // 2. Plan a route around star cutoffs, or reuse a cached one
+    route_start_job(nav_state, (Point){start_x, start_y}, (Point){x, y}, (Point){dest_x, dest_y}, star_position, planet_index);
 }
 
 /*
@@ -331,6 +273,116 @@ void gfx_create_default_colors(void)
     colors[COLOR_RED] = (SDL_Color){255, 99, 71, 150};
 }
 
+/**
+ * Destroys the background star textures.
+ *
+ * @return void
+ */
+void gfx_destroy_bstars_textures(void)
+{
+    for (int i = 0; i < 2; i++)
+    {
+        if (bstars_textures[i] != NULL)
+            SDL_DestroyTexture(bstars_textures[i]);
+
+        bstars_textures[i] = NULL;
+        bstars_sizes[i] = (SDL_Point){0, 0};
+    }
+}
+
+/**
+ * Destroys all disc sprites.
+ *
+ * @return void
+ */
+void gfx_destroy_disc_textures(void)
+{
+    for (int i = 0; i < DISC_TEXTURE_LEVELS; i++)
+    {
+        if (disc_textures[i] != NULL)
+            SDL_DestroyTexture(disc_textures[i]);
+
+        disc_textures[i] = NULL;
+    }
+}
+
+/**
+ * Destroys all pre-rendered galaxy cloud textures.
+ *
+ * @return void
+ */
+void gfx_destroy_galaxy_clouds(void)
+{
+    for (int i = 0; i < GALAXY_CLOUD_CACHE_SIZE; i++)
+    {
+        for (int j = 0; j < GALAXY_CLOUD_LEVELS; j++)
+        {
+            if (galaxy_clouds[i].levels[j] != NULL)
+                SDL_DestroyTexture(galaxy_clouds[i].levels[j]);
+        }
+
+        galaxy_clouds[i] = (GalaxyCloud){0};
+    }
+}
+
+/**
+ * Draws a range of background stars into the back texture of the star field, at their unscrolled positions.
+ * The texture is created at the camera size, or recreated if the camera size changed.
+ *
+ * @param bstars Array of Bstar objects.
+ * @param start Index of the first star to draw.
+ * @param end Index after the last star to draw.
+ * @param camera A pointer to the current Camera object.
+ * @param clear Whether to clear the texture first.
+ *
+ * @return True if the stars were drawn, false otherwise.
+ */
+static bool gfx_draw_bstars_texture(const Bstar *bstars, int start, int end, const Camera *camera, bool clear)
+{
+    SDL_Texture **texture = &bstars_textures[1 - bstars_front];
+    SDL_Point *size = &bstars_sizes[1 - bstars_front];
+
+    if (*texture == NULL || size->x != camera->w || size->y != camera->h)
+    {
+        render_destroy_texture(*texture);
+
+        *texture = render_create_texture(SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, camera->w, camera->h);
+        *size = (SDL_Point){0, 0};
+
+        if (*texture == NULL)
+        {
+            SDL_Log("Could not create background stars texture: %s\n", SDL_GetError());
+            return false;
+        }
+
+        *size = (SDL_Point){camera->w, camera->h};
+        render_set_texture_blend_mode(*texture, SDL_BLENDMODE_BLEND);
+        clear = true;
+    }
+
+    SDL_Texture *previous_target = render_set_target(*texture);
+
+    if (clear)
+    {
+        render_set_draw_color(0, 0, 0, 0);
+        render_clear();
+    }
+
+    // Store star opacity in the alpha channel as is; The field opacity is applied when the texture is drawn
+    render_set_blend_mode(SDL_BLENDMODE_NONE);
+
+    for (int i = start; i < end; i++)
+    {
+        render_set_draw_color(255, 255, 255, bstars[i].opacity);
+        render_fill_rect(&bstars[i].rect);
+    }
+
+    render_set_blend_mode(SDL_BLENDMODE_BLEND);
+    render_set_target(previous_target);
+
+    return true;
+}
+
 /**
  * Draws a button with the specified text and color at the given position and size.
  *
@@ -345,34 +397,26 @@ void gfx_create_default_colors(void)
 void gfx_draw_button(char *text, unsigned short font_size, SDL_Rect rect, SDL_Color button_color, SDL_Color text_color)
 {
     // Text
-    SDL_SetRenderDrawColor(renderer, button_color.r, button_color.g, button_color.b, button_color.a);
+    render_set_draw_color(button_color.r, button_color.g, button_color.b, button_color.a);
     char button_text[64];
     memset(button_text, 0, sizeof(button_text));
     sprintf(button_text, "%s", text);
 
     // Draw button rect
-    SDL_RenderFillRect(renderer, &rect);
+    render_fill_rect(&rect);
 
-    // Text texture
-    SDL_Surface *surface = TTF_RenderText_Blended(fonts[font_size], button_text, text_color);
-    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_Rect texture_rect;
-    texture_rect.w = surface->w;
-    texture_rect.h = surface->h;
-    texture_rect.x = rect.x + (rect.w - texture_rect.w) / 2;
-    texture_rect.y = rect.y + (rect.h - texture_rect.h) / 2;
+    // Text label
+    TextLabel *label = text_get_label(button_text, font_size, text_color);
+    int text_x = rect.x + (rect.w - label->w) / 2;
+    int text_y = rect.y + (rect.h - label->h) / 2;
 
     // Draw text
-    SDL_RenderCopy(renderer, texture, NULL, &texture_rect);
-
-    // Clean-up
-    SDL_FreeSurface(surface);
-    SDL_DestroyTexture(texture);
+    text_draw_label(label, text_x, text_y);
 }
 
 /**
- * Uses the Midpoint Circle Algorithm to draw a circle with a specified radius and color, centered at (xc, yc),
- * on the given SDL_Renderer. Only draws points within the camera's view and is efficient for small circles.
+ * Draws a circle with a specified radius and color, centered at (xc, yc), on the given SDL_Renderer.
+ * Only the arcs that are within the camera's view are drawn.
  *
  * @param renderer The SDL_Renderer to draw on.
  * @param camera A pointer to the current Camera object.
@@ -385,105 +429,99 @@ void gfx_draw_button(char *text, unsigned short font_size, SDL_Rect rect, SDL_Co
  */
 void gfx_draw_circle(SDL_Renderer *renderer, const Camera *camera, int xc, int yc, int radius, SDL_Color color)
 {
-    int x = 0;
-    int y = radius;
-    int d = 3 - 2 * radius;
+    double arcs[8][2];
+    int num_arcs = gfx_get_circle_visible_arcs(camera, xc, yc, radius, arcs);
 
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-
-    // Draw the circle
-    while (y >= x)
-    {
-        // Draw the 8 points symmetrically
-        if (gfx_is_relative_position_in_camera(camera, xc + x, yc + y))
-        {
-            SDL_RenderDrawPoint(renderer, xc + x, yc + y);
-        }
-        if (gfx_is_relative_position_in_camera(camera, xc + x, yc - y))
-        {
-            SDL_RenderDrawPoint(renderer, xc + x, yc - y);
-        }
-        if (gfx_is_relative_position_in_camera(camera, xc - x, yc + y))
-        {
-            SDL_RenderDrawPoint(renderer, xc - x, yc + y);
-        }
-        if (gfx_is_relative_position_in_camera(camera, xc - x, yc - y))
-        {
-            SDL_RenderDrawPoint(renderer, xc - x, yc - y);
-        }
-        if (gfx_is_relative_position_in_camera(camera, xc + y, yc + x))
-        {
-            SDL_RenderDrawPoint(renderer, xc + y, yc + x);
-        }
-        if (gfx_is_relative_position_in_camera(camera, xc + y, yc - x))
-        {
-            SDL_RenderDrawPoint(renderer, xc + y, yc - x);
-        }
-        if (gfx_is_relative_position_in_camera(camera, xc - y, yc + x))
-        {
-            SDL_RenderDrawPoint(renderer, xc - y, yc + x);
-        }
-        if (gfx_is_relative_position_in_camera(camera, xc - y, yc - x))
-        {
-            SDL_RenderDrawPoint(renderer, xc - y, yc - x);
-        }
+    if (num_arcs == 0)
+        return;
 
-        if (d < 0)
-            d = d + 4 * x + 6;
-        else
-        {
-            d = d + 4 * (x - y) + 10;
-            y--;
-        }
+    render_set_draw_color(color.r, color.g, color.b, color.a);
 
-        x++;
-    }
+    for (int i = 0; i < num_arcs; i++)
+        gfx_draw_circle_arc(renderer, xc, yc, radius, arcs[i][0], arcs[i][1]);
 }
 
 /**
- * Draws a circle approximation using a series of bezier curves. This function will only draw segments
- * of the circle that intersect with the viewport defined by `camera` and is efficient for large circles.
+ * Draws an arc of a circle as a single polyline. The arc is extended to the nearest vertices
+ * outside [start, end] so that it reaches the edges of the camera.
+ * Vertices come from the unit circle table, unless the radius is so large that the table is too coarse.
  *
- * @param renderer The renderer to use to draw the circle.
- * @param camera A pointer to the current Camera object.
- * @param x The x coordinate of the center of the circle.
- * @param y The y coordinate of the center of the circle.
- * @param r The radius of the circle.
- * @param color The color to use when drawing the circle.
+ * @param renderer The renderer to use to draw the arc.
+ * @param xc The x-coordinate of the circle's center.
+ * @param yc The y-coordinate of the circle's center.
+ * @param radius The radius of the circle.
+ * @param start The start angle of the arc in radians.
+ * @param end The end angle of the arc in radians, greater than start.
+ *
+ * @return void
  */
-void gfx_draw_circle_approximation(SDL_Renderer *renderer, const Camera *camera, int x, int y, int r, SDL_Color color)
+static void gfx_draw_circle_arc(SDL_Renderer *renderer, double xc, double yc, double radius, double start, double end)
 {
-    const int CIRCLE_APPROXIMATION = 500;
-    int i;
-    double angle;
-    double x1, y1, x2, y2, x3, y3, x4, y4;
+    static bool has_circle_table = false;
+    static double circle_cos[CIRCLE_TABLE_SIZE];
+    static double circle_sin[CIRCLE_TABLE_SIZE];
+    static SDL_Point points[CIRCLE_TABLE_SIZE + 2];
+
+    if (!has_circle_table)
+    {
+        for (int i = 0; i < CIRCLE_TABLE_SIZE; i++)
+        {
+            circle_cos[i] = cos(2 * M_PI * i / CIRCLE_TABLE_SIZE);
+            circle_sin[i] = sin(2 * M_PI * i / CIRCLE_TABLE_SIZE);
+        }
+
+        has_circle_table = true;
+    }
 
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    // Largest angle between vertices that keeps every segment within CIRCLE_TOLERANCE of the circle
+    double max_step = radius > CIRCLE_TOLERANCE ? 2 * acos(1 - CIRCLE_TOLERANCE / radius) : M_PI;
+    double table_step = 2 * M_PI / CIRCLE_TABLE_SIZE;
+    int num_points = 0;
 
-    for (i = 0; i < CIRCLE_APPROXIMATION; i++)
+    if (max_step >= table_step)
     {
-        angle = 2 * M_PI * i / CIRCLE_APPROXIMATION;
-        x1 = x + r * cos(angle);
-        y1 = y + r * sin(angle);
-        angle = 2 * M_PI * (i + 1) / CIRCLE_APPROXIMATION;
-        x2 = x + r * cos(angle);
-        y2 = y + r * sin(angle);
+        int stride = 1;
+
+        while (stride < CIRCLE_TABLE_SIZE / CIRCLE_MIN_SEGMENTS && 2 * stride * table_step <= max_step)
+            stride *= 2;
 
-        x3 = (2 * x1 + x2) / 3;
-        y3 = (2 * y1 + y2) / 3;
-        x4 = (x1 + 2 * x2) / 3;
-        y4 = (y1 + 2 * y2) / 3;
+        int first = (int)floor(start / (stride * table_step)) * stride;
+        int last = (int)ceil(end / (stride * table_step)) * stride;
 
-        if (maths_line_intersects_camera(camera, x1, y1, x3, y3) ||
-            maths_line_intersects_camera(camera, x3, y3, x4, y4) ||
-            maths_line_intersects_camera(camera, x4, y4, x2, y2))
+        for (int i = first; i <= last && num_points < CIRCLE_TABLE_SIZE + 2; i += stride)
         {
+            int index = i & (CIRCLE_TABLE_SIZE - 1);
 
-            SDL_RenderDrawLine(renderer, x1, y1, x3, y3);
-            SDL_RenderDrawLine(renderer, x3, y3, x4, y4);
-            SDL_RenderDrawLine(renderer, x4, y4, x2, y2);
+            points[num_points].x = (int)(xc + radius * circle_cos[index]);
+            points[num_points].y = (int)(yc + radius * circle_sin[index]);
+            num_points++;
         }
     }
+    else
+    {
+        // Rotate a vector by a fixed step; Only the visible arc is walked, so the vertex count stays bounded
+        int steps = (int)ceil((end - start) / max_step);
+        steps = steps > CIRCLE_TABLE_SIZE ? CIRCLE_TABLE_SIZE : steps;
+        double step = (end - start) / steps;
+        double cos_step = cos(step);
+        double sin_step = sin(step);
+        double dx = cos(start);
+        double dy = sin(start);
+
+        for (int i = 0; i <= steps; i++)
+        {
+            points[num_points].x = (int)(xc + radius * dx);
+            points[num_points].y = (int)(yc + radius * dy);
+            num_points++;
+
+            double next_dx = dx * cos_step - dy * sin_step;
+            dy = dx * sin_step + dy * cos_step;
+            dx = next_dx;
+        }
+    }
+
+    if (num_points > 1)
+        render_draw_lines(points, num_points);
 }
 
 /**
@@ -514,13 +552,15 @@ void gfx_draw_diamond(SDL_Renderer *renderer, int x, int y, int size, SDL_Color
     points[4].y = y - size;
 
     // Draw the outline of the diamond
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-    SDL_RenderDrawLines(renderer, points, 5);
+    render_set_draw_color(color.r, color.g, color.b, color.a);
+    render_draw_lines(points, 5);
 }
 
 /**
  * Draws a cloud of stars for a given Galaxy structure, with optional high definition stars,
  * using a provided Camera structure and scaling factor.
+ * Completed clouds are drawn from pre-rendered textures when they fit in the largest level,
+ * otherwise every star is drawn as a point.
  *
  * @param galaxy A pointer to Galaxy struct.
  * @param camera A pointer to the current Camera object.
@@ -533,58 +573,129 @@ void gfx_draw_diamond(SDL_Renderer *renderer, int x, int y, int size, SDL_Color
 void gfx_draw_galaxy_cloud(Galaxy *galaxy, const Camera *camera, int gstars_count, bool high_definition, long double scale)
 {
     const double epsilon = ZOOM_EPSILON / GALAXY_SCALE;
+    float opacity_factor;
 
-    for (int i = 0; i < gstars_count; i++)
+    switch (galaxy->class)
     {
-        int x, y;
-        float opacity, star_opacity;
-
-        if (high_definition)
-            star_opacity = galaxy->gstars_hd[i].opacity;
+    case 1:
+        if (scale <= (ZOOM_UNIVERSE_MIN / GALAXY_SCALE) + epsilon)
+            opacity_factor = 0.7;
+        else if (scale <= 0.000002 + epsilon)
+            opacity_factor = 0.8;
+        else
+            opacity_factor = 1;
+        break;
+    case 2:
+        if (scale <= (ZOOM_UNIVERSE_MIN / GALAXY_SCALE) + epsilon)
+            opacity_factor = 0.8;
         else
-            star_opacity = galaxy->gstars[i].opacity;
+            opacity_factor = 1;
+        break;
+    default:
+        opacity_factor = 1;
+    }
 
-        switch (galaxy->class)
-        {
-        case 1:
-            if (scale <= (ZOOM_UNIVERSE_MIN / GALAXY_SCALE) + epsilon)
-                opacity = 0.7 * star_opacity;
-            else if (scale <= 0.000002 + epsilon)
-                opacity = 0.8 * star_opacity;
-            else
-                opacity = star_opacity;
-            break;
-        case 2:
-            if (scale <= (ZOOM_UNIVERSE_MIN / GALAXY_SCALE) + epsilon)
-                opacity = 0.8 * star_opacity;
-            else
-                opacity = star_opacity;
-            break;
-        default:
-            opacity = star_opacity;
-        }
+    bool is_complete;
+
+    if (high_definition)
+        is_complete = galaxy->total_groups_hd && galaxy->initialized_hd == galaxy->total_groups_hd;
+    else
+        is_complete = galaxy->total_groups && galaxy->initialized == galaxy->total_groups;
+
+    // Clouds lie behind everything else
+    unsigned short previous_layer = render_set_layer(RENDER_LAYER_BACKGROUND);
+
+    if (is_complete && gfx_draw_galaxy_cloud_texture(galaxy, camera, gstars_count, high_definition, scale, opacity_factor))
+    {
+        render_set_layer(previous_layer);
+        return;
+    }
+
+    for (int i = 0; i < gstars_count; i++)
+    {
+        int x, y;
+        SDL_Color color;
 
         if (high_definition)
         {
-            SDL_SetRenderDrawColor(renderer, galaxy->gstars_hd[i].color.r, galaxy->gstars_hd[i].color.g, galaxy->gstars_hd[i].color.b, (int)opacity);
+            color = galaxy->gstars_hd[i].color;
+            color.a = (int)(opacity_factor * galaxy->gstars_hd[i].opacity);
 
             x = (galaxy->position.x - camera->x + galaxy->gstars_hd[i].position.x / GALAXY_SCALE) * scale * GALAXY_SCALE;
             y = (galaxy->position.y - camera->y + galaxy->gstars_hd[i].position.y / GALAXY_SCALE) * scale * GALAXY_SCALE;
         }
         else
         {
-            SDL_SetRenderDrawColor(renderer, galaxy->gstars[i].color.r, galaxy->gstars[i].color.g, galaxy->gstars[i].color.b, (int)opacity);
+            color = galaxy->gstars[i].color;
+            color.a = (int)(opacity_factor * galaxy->gstars[i].opacity);
 
             x = (galaxy->position.x - camera->x + galaxy->gstars[i].position.x / GALAXY_SCALE) * scale * GALAXY_SCALE;
             y = (galaxy->position.y - camera->y + galaxy->gstars[i].position.y / GALAXY_SCALE) * scale * GALAXY_SCALE;
         }
 
-        SDL_RenderDrawPoint(renderer, x, y);
+        batch_add_point(x, y, color);
     }
+
+    batch_flush();
+    render_set_layer(previous_layer);
 }
 
 /**
- * Draws and fills a circle on an SDL renderer using the Midpoint Circle Algorithm.
+ * Draws a galaxy cloud by scaling the nearest pre-rendered level that is at least as large as
+ * the cloud on screen. Levels are rendered on first use and again only if the number of stars changed.
+ *
+ * @param galaxy A pointer to Galaxy struct.
+ * @param camera A pointer to the current Camera object.
+ * @param gstars_count Number of stars in the galaxy cloud.
+ * @param high_definition A boolean to indicate whether to use high definition stars or not.
+ * @param scale Scaling factor for the galaxy cloud.
+ * @param opacity_factor Opacity applied to the whole cloud.
+ *
+ * @return True if the cloud was drawn, false if it must be drawn star by star.
+ */
+static bool gfx_draw_galaxy_cloud_texture(const Galaxy *galaxy, const Camera *camera, int gstars_count, bool high_definition, long double scale, float opacity_factor)
+{
+    double radius = galaxy->radius * GALAXY_SCALE * scale;
+    int level = 0;
+
+    while (level < GALAXY_CLOUD_LEVELS && (GALAXY_CLOUD_MIN_SIZE << level) < 2 * radius + 2)
+        level++;
+
+    if (level >= GALAXY_CLOUD_LEVELS)
+        return false;
+
+    GalaxyCloud *cloud = gfx_get_galaxy_cloud(galaxy, high_definition);
+
+    if (cloud == NULL)
+        return false;
+
+    if (cloud->levels[level] == NULL || cloud->gstars_count[level] != gstars_count)
+    {
+        if (!gfx_render_galaxy_cloud_level(cloud, galaxy, gstars_count, high_definition, level))
+            return false;
+    }
+
+    // Textures hold premultiplied colors, so color and alpha are modulated together
+    Uint8 opacity = (Uint8)(255 * opacity_factor);
+
+    // The cloud radius spans (size / 2 - 1) pixels of the texture
+    int size = GALAXY_CLOUD_MIN_SIZE << level;
+    double texture_scale = radius / (size / 2 - 1);
+
+    SDL_Rect rect;
+    rect.w = (int)(size * texture_scale);
+    rect.h = rect.w;
+    rect.x = (int)((galaxy->position.x - camera->x) * scale * GALAXY_SCALE) - rect.w / 2;
+    rect.y = (int)((galaxy->position.y - camera->y) * scale * GALAXY_SCALE) - rect.h / 2;
+
+    render_copy_modulated(cloud->levels[level], NULL, &rect, (SDL_Color){opacity, opacity, opacity, opacity});
+
+    return true;
+}
+
+/**
+ * Draws and fills a circle on an SDL renderer in a single draw call. Small circles are drawn
+ * from anti-aliased disc sprites, tinted with the color; Larger circles are drawn as a triangle fan.
  *
  * @param renderer The SDL renderer to draw the circle on.
  * @param xc The x-coordinate of the circle's center.
@@ -596,36 +707,76 @@ void gfx_draw_galaxy_cloud(Galaxy *galaxy, const Camera *camera, int gstars_coun
  */
 void gfx_draw_fill_circle(SDL_Renderer *renderer, int xc, int yc, int radius, SDL_Color color)
 {
-    int x = 0;
-    int y = radius;
-    int d = 1 - radius;
-    int deltaE = 3;
-    int deltaSE = -2 * radius + 5;
-
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-
-    while (y >= x)
-    {
-        SDL_RenderDrawLine(renderer, xc - x, yc + y, xc + x, yc + y);
-        SDL_RenderDrawLine(renderer, xc - x, yc - y, xc + x, yc - y);
-        SDL_RenderDrawLine(renderer, xc - y, yc + x, xc + y, yc + x);
-        SDL_RenderDrawLine(renderer, xc - y, yc - x, xc + y, yc - x);
-        if (d < 0)
+    static SDL_Vertex vertices[CIRCLE_TABLE_SIZE + 2];
+    static int indices[3 * CIRCLE_TABLE_SIZE];
+    static bool has_indices = false;
+
+    if (radius < 0)
+        return;
+
+    int level = 0;
+
+    while (level < DISC_TEXTURE_LEVELS && (1 << level) < radius)
+        level++;
+
+    if (level < DISC_TEXTURE_LEVELS)
+    {
+        SDL_Texture *texture = gfx_get_disc_texture(renderer, level);
+
+        // Sprites are tinted through their vertices, so discs of any color share a draw call
+        if (texture != NULL)
         {
-            d += deltaE;
-            deltaE += 2;
-            deltaSE += 2;
+            static const int quad_indices[6] = {0, 1, 2, 2, 3, 0};
+            float x1 = xc - radius;
+            float y1 = yc - radius;
+            float x2 = xc + radius + 1;
+            float y2 = yc + radius + 1;
+            SDL_Vertex quad[4] = {{{x1, y1}, color, {0, 0}},
+                                  {{x2, y1}, color, {1, 0}},
+                                  {{x2, y2}, color, {1, 1}},
+                                  {{x1, y2}, color, {0, 1}}};
+
+            render_geometry(texture, quad, 4, quad_indices, 6);
+            return;
         }
-        else
+    }
+
+    if (!has_indices)
+    {
+        for (int i = 0; i < CIRCLE_TABLE_SIZE; i++)
         {
-            d += deltaSE;
-            deltaE += 2;
-            deltaSE += 4;
-            y--;
+            indices[3 * i + 0] = 0;
+            indices[3 * i + 1] = i + 1;
+            indices[3 * i + 2] = i + 2;
         }
-        x++;
+
+        has_indices = true;
+    }
+
+    // Same segment count rule as gfx_draw_circle_arc
+    double max_step = 2 * acos(1 - CIRCLE_TOLERANCE / radius);
+    int segments = (int)ceil(2 * M_PI / max_step);
+    segments = segments < CIRCLE_MIN_SEGMENTS ? CIRCLE_MIN_SEGMENTS : segments;
+    segments = segments > CIRCLE_TABLE_SIZE ? CIRCLE_TABLE_SIZE : segments;
+
+    double step = 2 * M_PI / segments;
+    double cos_step = cos(step);
+    double sin_step = sin(step);
+    double dx = 1;
+    double dy = 0;
+
+    vertices[0] = (SDL_Vertex){{xc + 0.5f, yc + 0.5f}, color, {0, 0}};
+
+    for (int i = 0; i <= segments; i++)
+    {
+        vertices[i + 1] = (SDL_Vertex){{(float)(xc + 0.5 + (radius + 0.5) * dx), (float)(yc + 0.5 + (radius + 0.5) * dy)}, color, {0, 0}};
+
+        double next_dx = dx * cos_step - dy * sin_step;
+        dy = dx * sin_step + dy * cos_step;
+        dx = next_dx;
     }
+
+    render_geometry(NULL, vertices, segments + 2, indices, 3 * segments);
 }
 
 /**
@@ -655,8 +806,8 @@ void gfx_draw_fill_diamond(SDL_Renderer *renderer, int x, int y, int size, SDL_C
     points[4].y = y - size;
 
     // Draw the outline of the diamond
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-    SDL_RenderDrawLines(renderer, points, 5);
+    render_set_draw_color(color.r, color.g, color.b, color.a);
+    render_draw_lines(points, 5);
 
     // Fill the diamond with color using scanlines
     int min_y = y - size;
@@ -693,8 +844,8 @@ void gfx_draw_fill_diamond(SDL_Renderer *renderer, int x, int y, int size, SDL_C
         // Draw the scanline segment
         if (x_left <= x_right)
         {
-            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-            SDL_RenderDrawLine(renderer, x_left, y, x_right, y);
+            render_set_draw_color(color.r, color.g, color.b, color.a);
+            render_draw_line(x_left, y, x_right, y);
         }
     }
 }
@@ -716,15 +867,20 @@ void gfx_draw_menu_galaxy_cloud(const Camera *camera, Gstar *menustars)
     {
         int x, y;
 
-        SDL_SetRenderDrawColor(renderer, menustars[i].color.r, menustars[i].color.g, menustars[i].color.b, menustars[i].opacity);
+        SDL_Color color = menustars[i].color;
+        color.a = menustars[i].opacity;
 
         x = camera->w - camera->w / 4 + (menustars[i].position.x / GALAXY_SCALE) * scaling_factor;
         y = camera->h / 3 + (menustars[i].position.y / GALAXY_SCALE) * scaling_factor;
 
-        SDL_RenderDrawPoint(renderer, x, y);
+        batch_add_point(x, y, color);
 
         i++;
     }
+
+    unsigned short previous_layer = render_set_layer(RENDER_LAYER_BACKGROUND);
+    batch_flush();
+    render_set_layer(previous_layer);
 }
 
 /**
@@ -764,11 +920,11 @@ void gfx_draw_screen_frame(Camera *camera)
     right_frame.w = 2 * PROJECTION_RADIUS;
     right_frame.h = camera->h - 4 * PROJECTION_RADIUS;
 
-    SDL_SetRenderDrawColor(renderer, 255, 165, 0, 22);
-    SDL_RenderFillRect(renderer, &top_frame);
-    SDL_RenderFillRect(renderer, &left_frame);
-    SDL_RenderFillRect(renderer, &bottom_frame);
-    SDL_RenderFillRect(renderer, &right_frame);
+    render_set_draw_color(255, 165, 0, 22);
+    render_fill_rect(&top_frame);
+    render_fill_rect(&left_frame);
+    render_fill_rect(&bottom_frame);
+    render_fill_rect(&right_frame);
 }
 
 /**
@@ -821,18 +977,19 @@ void gfx_draw_section_lines(Camera *camera, int state, SDL_Color color, long dou
         }
     }
 
+    // Lines move with the camera, so they are drawn every frame rather than cached in a compositor layer
     double bx = maths_get_nearest_section_line(camera->x, section_size);
     double by = maths_get_nearest_section_line(camera->y, section_size);
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    render_set_draw_color(color.r, color.g, color.b, color.a);
 
     for (int ix = bx; ix <= bx + camera->w / scale; ix = ix + section_size)
     {
-        SDL_RenderDrawLine(renderer, (ix - camera->x) * scale, 0, (ix - camera->x) * scale, camera->h);
+        render_draw_line((ix - camera->x) * scale, 0, (ix - camera->x) * scale, camera->h);
     }
 
     for (int iy = by; iy <= by + camera->h / scale; iy = iy + section_size)
     {
-        SDL_RenderDrawLine(renderer, 0, (iy - camera->y) * scale, camera->w, (iy - camera->y) * scale);
+        render_draw_line(0, (iy - camera->y) * scale, camera->w, (iy - camera->y) * scale);
     }
 }
 
@@ -882,7 +1039,7 @@ void gfx_draw_speed_arc(const Ship *ship, const Camera *camera, long double scal
     opacity = opacity > 255 ? 255 : opacity;
 
     // Set the renderer draw color to the circle color
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, (int)opacity);
+    render_set_draw_color(color.r, color.g, color.b, (int)opacity);
 
     // Draw the circle
     for (float angle = 0; angle < 2 * M_PI; angle += 0.01)
@@ -922,17 +1079,17 @@ void gfx_draw_speed_arc(const Ship *ship, const Camera *camera, long double scal
 
         if (dot_product_3 >= velocity_factor)
         {
-            SDL_RenderDrawLine(renderer, (int)start_x_3, (int)start_y_3, (int)end_x_3, (int)end_y_3);
+            render_draw_line((int)start_x_3, (int)start_y_3, (int)end_x_3, (int)end_y_3);
         }
 
         if (dot_product_2 >= velocity_factor)
         {
-            SDL_RenderDrawLine(renderer, (int)start_x_2, (int)start_y_2, (int)end_x_2, (int)end_y_2);
+            render_draw_line((int)start_x_2, (int)start_y_2, (int)end_x_2, (int)end_y_2);
         }
 
         if (dot_product_1 >= velocity_factor)
         {
-            SDL_RenderDrawLine(renderer, (int)start_x_1, (int)start_y_1, (int)end_x_1, (int)end_y_1);
+            render_draw_line((int)start_x_1, (int)start_y_1, (int)end_x_1, (int)end_y_1);
         }
     }
 }
@@ -1067,10 +1224,10 @@ void gfx_draw_speed_lines(float velocity, const Camera *camera, Speed speed)
             else if (scaled_opacity > base_opacity)
                 scaled_opacity = base_opacity;
 
-            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, scaled_opacity);
+            render_set_draw_color(color.r, color.g, color.b, scaled_opacity);
 
             // Draw the speed line
-            SDL_RenderDrawLine(renderer, (int)start_x, (int)start_y, (int)end_x, (int)end_y);
+            render_draw_line((int)start_x, (int)start_y, (int)end_x, (int)end_y);
 
             // Update the starting position of the line based on the velocity magnitude
             float delta_x;
@@ -1116,49 +1273,75 @@ void gfx_draw_speed_lines(float velocity, const Camera *camera, Speed speed)
 void gfx_draw_waypoint_path(const GameState *game_state, const NavigationState *nav_state, const Camera *camera)
 {
     if (game_state->state == MAP || game_state->state == UNIVERSE)
-        SDL_SetRenderDrawColor(renderer, nav_state->waypoint_star->color.r, nav_state->waypoint_star->color.g, nav_state->waypoint_star->color.b, 80);
+        render_set_draw_color(nav_state->waypoint_star->color.r, nav_state->waypoint_star->color.g, nav_state->waypoint_star->color.b, 80);
     else if (game_state->state == NAVIGATE)
-        SDL_SetRenderDrawColor(renderer, nav_state->waypoint_star->color.r, nav_state->waypoint_star->color.g, nav_state->waypoint_star->color.b, 50);
+        render_set_draw_color(nav_state->waypoint_star->color.r, nav_state->waypoint_star->color.g, nav_state->waypoint_star->color.b, 50);
+
+    const WaypointPath *path = nav_state->waypoint_star->waypoint_path;
 
-    if (nav_state->waypoint_star->waypoint_points < 1)
+    if (path == NULL)
         return;
 
-    for (int i = 1; i < nav_state->waypoint_star->waypoint_points; i++)
+    // Draw only the segments that can be visible in the camera, in path coordinates
+    Point view_min, view_max;
+
+    if (game_state->state == MAP || game_state->state == NAVIGATE)
+    {
+        view_min.x = camera->x;
+        view_min.y = camera->y;
+    }
+    else
+    {
+        view_min.x = (camera->x - nav_state->current_galaxy->position.x) * GALAXY_SCALE;
+        view_min.y = (camera->y - nav_state->current_galaxy->position.y) * GALAXY_SCALE;
+    }
+
+    view_max.x = view_min.x + camera->w / game_state->game_scale;
+    view_max.y = view_min.y + camera->h / game_state->game_scale;
+
+    int first_segment, last_segment;
+
+    if (!path_get_visible_range(path, view_min, view_max, &first_segment, &last_segment))
+    {
+        first_segment = 0;
+        last_segment = -1;
+    }
+
+    for (int i = first_segment + 1; i <= last_segment + 1; i++)
     {
         double x1, y1;
         double x2, y2;
 
         if (game_state->state == MAP || game_state->state == NAVIGATE)
         {
-            x1 = (nav_state->waypoint_star->waypoint_path[i - 1].position.x - camera->x) * game_state->game_scale;
-            y1 = (nav_state->waypoint_star->waypoint_path[i - 1].position.y - camera->y) * game_state->game_scale;
-            x2 = (nav_state->waypoint_star->waypoint_path[i].position.x - camera->x) * game_state->game_scale;
-            y2 = (nav_state->waypoint_star->waypoint_path[i].position.y - camera->y) * game_state->game_scale;
+            x1 = (path->points[i - 1].position.x - camera->x) * game_state->game_scale;
+            y1 = (path->points[i - 1].position.y - camera->y) * game_state->game_scale;
+            x2 = (path->points[i].position.x - camera->x) * game_state->game_scale;
+            y2 = (path->points[i].position.y - camera->y) * game_state->game_scale;
         }
-        else if (game_state->state == UNIVERSE)
+        else
         {
-            x1 = (nav_state->current_galaxy->position.x - camera->x + nav_state->waypoint_star->waypoint_path[i - 1].position.x / GALAXY_SCALE) * game_state->game_scale * GALAXY_SCALE;
-            y1 = (nav_state->current_galaxy->position.y - camera->y + nav_state->waypoint_star->waypoint_path[i - 1].position.y / GALAXY_SCALE) * game_state->game_scale * GALAXY_SCALE;
-            x2 = (nav_state->current_galaxy->position.x - camera->x + nav_state->waypoint_star->waypoint_path[i].position.x / GALAXY_SCALE) * game_state->game_scale * GALAXY_SCALE;
-            y2 = (nav_state->current_galaxy->position.y - camera->y + nav_state->waypoint_star->waypoint_path[i].position.y / GALAXY_SCALE) * game_state->game_scale * GALAXY_SCALE;
+            x1 = (nav_state->current_galaxy->position.x - camera->x + path->points[i - 1].position.x / GALAXY_SCALE) * game_state->game_scale * GALAXY_SCALE;
+            y1 = (nav_state->current_galaxy->position.y - camera->y + path->points[i - 1].position.y / GALAXY_SCALE) * game_state->game_scale * GALAXY_SCALE;
+            x2 = (nav_state->current_galaxy->position.x - camera->x + path->points[i].position.x / GALAXY_SCALE) * game_state->game_scale * GALAXY_SCALE;
+            y2 = (nav_state->current_galaxy->position.y - camera->y + path->points[i].position.y / GALAXY_SCALE) * game_state->game_scale * GALAXY_SCALE;
         }
 
         if (maths_line_intersects_camera(camera, x1, y1, x2, y2))
-            SDL_RenderDrawLine(renderer, (int)x1, (int)y1, (int)x2, (int)y2);
+            render_draw_line((int)x1, (int)y1, (int)x2, (int)y2);
     }
 
     // Highlight next path point
-    if (nav_state->waypoint_star->waypoint_points)
-        gfx_draw_circle(renderer, camera,
-                        (nav_state->waypoint_star->waypoint_path[nav_state->next_path_point].position.x - camera->x) * game_state->game_scale,
-                        (nav_state->waypoint_star->waypoint_path[nav_state->next_path_point].position.y - camera->y) * game_state->game_scale,
-                        WAYPOINT_CIRCLE_RADIUS * game_state->game_scale, colors[COLOR_CYAN_70]);
+    gfx_draw_circle(renderer, camera,
+                    (path->points[nav_state->next_path_point].position.x - camera->x) * game_state->game_scale,
+                    (path->points[nav_state->next_path_point].position.y - camera->y) * game_state->game_scale,
+                    WAYPOINT_CIRCLE_RADIUS * game_state->game_scale, colors[COLOR_CYAN_70]);
 
     // Draw perpendicular line at path point
-    double x1 = (nav_state->waypoint_star->waypoint_path[nav_state->next_path_point - 1].position.x - camera->x) * game_state->game_scale;
-    double y1 = (nav_state->waypoint_star->waypoint_path[nav_state->next_path_point - 1].position.y - camera->y) * game_state->game_scale;
-    double x2 = (nav_state->waypoint_star->waypoint_path[nav_state->next_path_point].position.x - camera->x) * game_state->game_scale;
-    double y2 = (nav_state->waypoint_star->waypoint_path[nav_state->next_path_point].position.y - camera->y) * game_state->game_scale;
+    double x1 = (path->points[nav_state->next_path_point - 1].position.x - camera->x) * game_state->game_scale;
+    double y1 = (path->points[nav_state->next_path_point - 1].position.y - camera->y) * game_state->game_scale;
+    double x2 = (path->points[nav_state->next_path_point].position.x - camera->x) * game_state->game_scale;
+    double y2 = (path->points[nav_state->next_path_point].position.y - camera->y) * game_state->game_scale;
 
     double slope = (y2 - y1) / (x2 - x1);
     float angle = atan(slope);
@@ -1172,8 +1355,8 @@ void gfx_draw_waypoint_path(const GameState *game_state, const NavigationState *
     int px2 = round(x2 - dx);
     int py2 = round(y2 - dy);
 
-    SDL_SetRenderDrawColor(renderer, colors[COLOR_CYAN_70].r, colors[COLOR_CYAN_70].g, colors[COLOR_CYAN_70].b, colors[COLOR_CYAN_70].a);
-    SDL_RenderDrawLine(renderer, px1, py1, px2, py2);
+    render_set_draw_color(colors[COLOR_CYAN_70].r, colors[COLOR_CYAN_70].g, colors[COLOR_CYAN_70].b, colors[COLOR_CYAN_70].a);
+    render_draw_line(px1, py1, px2, py2);
 }
 
 /**
@@ -1208,6 +1391,10 @@ void gfx_generate_bstars(GameEvents *game_events, NavigationState *nav_state, Bs
     // Set galaxy hash as initseq
     nav_state->initseq = maths_hash_position_to_uint64_2(nav_state->current_galaxy->position);
 
+    // New stars are drawn into the back texture in batches, while the previous field is still shown
+    int first_new_star = i;
+    bool is_new_field = initialized_cells == 0;
+
     // Reset final_star
     if (initialized_cells == 0)
     {
@@ -1237,6 +1424,7 @@ void gfx_generate_bstars(GameEvents *game_events, NavigationState *nav_state, Bs
 
             // Seed with a fixed constant
             pcg32_srandom_r(&rng, seed, nav_state->initseq);
+            COUNTERS_ADD(COUNTER_SEEDS_BSTARS, 1);
 
             is_star = abs(pcg32_random_r(&rng)) % BSTARS_SQUARE < BSTARS_PER_SQUARE;
 
@@ -1277,7 +1465,10 @@ void gfx_generate_bstars(GameEvents *game_events, NavigationState *nav_state, Bs
                 end = true;
 
             if (lazy_load && current_batch >= BSTARS_BATCH_SIZE)
+            {
+                gfx_draw_bstars_texture(bstars, first_new_star, i, camera, is_new_field);
                 return;
+            }
         }
     }
 
@@ -1285,10 +1476,12 @@ void gfx_generate_bstars(GameEvents *game_events, NavigationState *nav_state, Bs
     last_star_index = 0;
     initialized_cells = 0;
 
-    // printf("\n Galaxy: %s, initseq: %lu", nav_state->current_galaxy->name, nav_state->initseq);
-    // printf("\n Cells checked: %d ::: Stars found: %d", current_cell, i);
-    // printf("\n initialized cells: %d", initialized_cells);
-    // printf("\n end");
+    if (gfx_draw_bstars_texture(bstars, first_new_star, i, camera, is_new_field))
+    {
+        bstars_front = 1 - bstars_front;
+        bstars_offset.x = 0;
+        bstars_offset.y = 0;
+    }
 }
 
 /**
@@ -1427,6 +1620,7 @@ void gfx_generate_gstars(Galaxy *galaxy, bool high_definition)
 
             // Seed with a fixed constant
             pcg32_srandom_r(&rng, seed, initseq);
+            COUNTERS_ADD(COUNTER_SEEDS_GSTARS, 1);
 
             // Calculate density based on distance from center
             double density = (GALAXY_CLOUD_DENSITY / pow((distance_from_center / a + 1), 6));
@@ -1504,13 +1698,6 @@ void gfx_generate_gstars(Galaxy *galaxy, bool high_definition)
                 return;
         }
     }
-
-    // printf("\n Name: %s ::: hi_def: %d", galaxy->name, high_definition);
-    // printf("\n Groups checked: %d ::: Stars found:%d", current_group, i);
-    // printf("\n Total groups to check: %d ::: Sections in group: %d", total_groups, sections_in_group);
-    // printf("\n initialized: %d", initialized);
-    // printf("\n last_star_index: %d ::: last_star_index_hd: %d", galaxy->last_star_index, galaxy->last_star_index_hd);
-    // printf("\n end: %d", current_batch);
 }
 
 /**
@@ -1583,6 +1770,7 @@ void gfx_generate_menu_gstars(Galaxy *galaxy, Gstar *menustars)
 
             // Seed with a fixed constant
             pcg32_srandom_r(&rng, seed, initseq);
+            COUNTERS_ADD(COUNTER_SEEDS_GSTARS, 1);
 
             // Calculate density based on distance from center
             double density = (MENU_GALAXY_CLOUD_DENSITY / pow((distance_from_center / a + 1), 6));
@@ -1643,209 +1831,256 @@ void gfx_generate_menu_gstars(Galaxy *galaxy, Gstar *menustars)
 }
 
 /**
- * Checks if there is a direct line-of-sight between two points (x1,y1) and (x2,y2)
- * without intersecting any stars cutoff areas.
+ * Calculates the arcs of a circle that are inside the camera. The circle is intersected with
+ * the four edges of the camera, and each arc between two consecutive intersections is kept
+ * if its midpoint is inside the camera.
  *
- * @param nav_state A pointer to the current NavigationState object.
- * @param x1 the x-coordinate of the first point.
- * @param y1 the y-coordinate of the first point.
- * @param x2 the x-coordinate of the second point.
- * @param y2 the y-coordinate of the second point.
- * @param stars An array of pointers to stars.
- * @param max_stars The number of stars in the stars array.
- *
- * @return True if there is line of sight between the two points, false otherwise.
+ * @param camera A pointer to the current Camera object.
+ * @param xc The x-coordinate of the circle's center (relative to the camera).
+ * @param yc The y-coordinate of the circle's center (relative to the camera).
+ * @param radius The radius of the circle.
+ * @param arcs An array that receives the start and end angles of each visible arc.
+ *
+ * @return The number of visible arcs.
  */
-static bool gfx_has_line_of_sight(NavigationState *nav_state, double x1, double y1, double x2, double y2, Star *stars[], int max_stars)
+static int gfx_get_circle_visible_arcs(const Camera *camera, double xc, double yc, double radius, double arcs[][2])
 {
-    for (int i = 0; i < max_stars; i++)
+    double angles[8];
+    int num_angles = 0;
+
+    if (radius <= 0)
+        return 0;
+
+    // Circle is outside the camera
+    if (xc + radius < 0 || xc - radius > camera->w || yc + radius < 0 || yc - radius > camera->h)
+        return 0;
+
+    // Intersections with vertical edges
+    for (int i = 0; i < 2; i++)
+    {
+        double dx = (i == 0 ? 0 : camera->w) - xc;
+
+        if (fabs(dx) > radius)
+            continue;
+
+        double dy = sqrt(radius * radius - dx * dx);
+
+        if (yc - dy >= 0 && yc - dy <= camera->h)
+            angles[num_angles++] = atan2(-dy, dx);
+        if (dy > 0 && yc + dy >= 0 && yc + dy <= camera->h)
+            angles[num_angles++] = atan2(dy, dx);
+    }
+
+    // Intersections with horizontal edges
+    for (int i = 0; i < 2; i++)
+    {
+        double dy = (i == 0 ? 0 : camera->h) - yc;
+
+        if (fabs(dy) > radius)
+            continue;
+
+        double dx = sqrt(radius * radius - dy * dy);
+
+        if (xc - dx >= 0 && xc - dx <= camera->w)
+            angles[num_angles++] = atan2(dy, -dx);
+        if (dx > 0 && xc + dx >= 0 && xc + dx <= camera->w)
+            angles[num_angles++] = atan2(dy, dx);
+    }
+
+    // No intersections: the circle is either fully inside the camera or surrounds it
+    if (num_angles == 0)
     {
-        if (stars[i] != NULL)
+        if (gfx_is_relative_position_in_camera(camera, (int)(xc + radius), (int)yc))
         {
-            if (strcmp(stars[i]->name, nav_state->waypoint_star->name) == 0)
-                continue;
+            arcs[0][0] = 0;
+            arcs[0][1] = 2 * M_PI;
+            return 1;
+        }
 
-            bool star_obstructs_path = maths_is_point_in_circle((Point){x2, y2},
-                                                                (Point){stars[i]->position.x, stars[i]->position.y},
-                                                                stars[i]->cutoff) ||
-                                       maths_line_intersects_circle(x1, y1,
-                                                                    x2, y2,
-                                                                    stars[i]->position.x, stars[i]->position.y,
-                                                                    stars[i]->cutoff);
+        return 0;
+    }
 
-            if (!star_obstructs_path)
-                continue;
-            else
-                return false;
+    // Sort angles in [0, 2 * PI)
+    for (int i = 0; i < num_angles; i++)
+    {
+        if (angles[i] < 0)
+            angles[i] += 2 * M_PI;
+
+        for (int j = i; j > 0 && angles[j] < angles[j - 1]; j--)
+        {
+            double angle = angles[j];
+            angles[j] = angles[j - 1];
+            angles[j - 1] = angle;
         }
     }
 
-    return true;
-}
+    int num_arcs = 0;
 
-/**
- * Checks if an object with a given position and radius is within the bounds of the camera.
- *
- * @param camera A pointer to the current Camera object.
- * @param x The x-coordinate of the object's center.
- * @param y The y-coordinate of the object's center.
- * @param radius The radius of the object.
- * @param scale The scaling factor applied to the camera view.
- *
- * @return True if the object is within the camera bounds, false otherwise.
- */
-bool gfx_is_object_in_camera(const Camera *camera, double x, double y, float radius, long double scale)
-{
-    return x + radius >= camera->x && x - radius - camera->x < camera->w / scale &&
-           y + radius >= camera->y && y - radius - camera->y < camera->h / scale;
-}
+    for (int i = 0; i < num_angles; i++)
+    {
+        double start = angles[i];
+        double end = i + 1 < num_angles ? angles[i + 1] : angles[0] + 2 * M_PI;
 
-/**
- * Determines if a relative position (x,y) is within the bounds of the camera.
- *
- * @param camera A pointer to the current Camera object.
- * @param x The x-coordinate of the position relative to the camera.
- * @param y The y-coordinate of the position relative to the camera.
- *
- * @return True if the position is within the camera bounds, false otherwise.
- */
-bool gfx_is_relative_position_in_camera(const Camera *camera, int x, int y)
-{
-    return x >= 0 && x < camera->w && y >= 0 && y < camera->h;
-}
+        if (end - start <= 0)
+            continue;
 
-/**
- * Takes a point inside a circle and calculates the closest point on the circumference.
- *
- * @param nav_state A pointer to the current NavigationState object.
- * @param position The point inside the circle.
- * @param stars An array of pointers to nearest stars.
- * @param max_stars The number of nearest stars.
- *
- * @return void
- */
+        double middle = (start + end) / 2;
+        double x = xc + radius * cos(middle);
+        double y = yc + radius * sin(middle);
 
-static void gfx_move_point_on_circumference(NavigationState *nav_state, Point *position, Star *stars[], int max_stars)
-{
-    double radius_ratio = 1.0;
+        if (x < 0 || x > camera->w || y < 0 || y > camera->h)
+            continue;
 
-    for (int i = 0; i < max_stars; i++)
-    {
-        if (stars[i] != NULL && strcmp(stars[i]->name, nav_state->waypoint_star->name) != 0)
+        // Join with the previous arc if they touch at a corner
+        if (num_arcs > 0 && arcs[num_arcs - 1][1] == start)
+            arcs[num_arcs - 1][1] = end;
+        else
         {
-            if (maths_is_point_in_circle(*position, (Point){stars[i]->position.x, stars[i]->position.y}, stars[i]->cutoff))
-            {
-                maths_closest_point_outside_circle(stars[i]->position.x, stars[i]->position.y, stars[i]->cutoff, radius_ratio,
-                                                   position->x, position->y,
-                                                   &position->x, &position->y,
-                                                   0);
-            }
+            arcs[num_arcs][0] = start;
+            arcs[num_arcs][1] = end;
+            num_arcs++;
         }
     }
+
+    return num_arcs;
 }
 
 /**
- * Normalizes the waypoint path by moving points that are inside circles and by omitting
- * in-between points when there is a direct line of sight between distant points.
+ * Returns the white disc sprite for a level, rendering it on first use. The disc of level n
+ * has a radius of 2^n pixels; Its edge alpha is the pixel coverage, so that scaled discs look smooth.
  *
- * @param nav_state A pointer to the current NavigationState object.
- * @param path The array of path points.
- * @param total_points The number of points.
+ * @param renderer The SDL renderer to create the texture with.
+ * @param level The level of the disc.
  *
- * @return void
+ * @return The texture, or NULL if it could not be created.
  */
-
-static void gfx_normalize_waypoint_path(NavigationState *nav_state, PathPoint path[], int total_points)
+static SDL_Texture *gfx_get_disc_texture(SDL_Renderer *renderer, int level)
 {
-    if (total_points < 3)
-        return;
+    if (disc_textures[level] != NULL)
+        return disc_textures[level];
 
-    // Add first point to path
-    nav_state->waypoint_star->waypoint_path = (PathPoint *)malloc(sizeof(PathPoint));
-    nav_state->waypoint_star->waypoint_path[0].type = PATH_POINT_TURN;
-    nav_state->waypoint_star->waypoint_path[0].position = path[0].position;
-    nav_state->waypoint_star->waypoint_points = 1;
+    int radius = 1 << level;
+    int size = 2 * radius + 1;
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_ARGB8888);
+
+    if (surface == NULL)
+    {
+        SDL_Log("Could not create disc surface: %s\n", SDL_GetError());
+        return NULL;
+    }
 
-    int point_offset = 3;
+    Uint32 *pixels = (Uint32 *)surface->pixels;
 
-    for (int i = 1; i < total_points - 1 && i + point_offset < total_points; i++)
+    for (int y = 0; y < size; y++)
     {
-        Point point = path[i].position;
+        for (int x = 0; x < size; x++)
+        {
+            // Distance from the pixel center to the disc center, which is the center of the middle pixel
+            double distance = sqrt((x - radius) * (x - radius) + (y - radius) * (y - radius));
+            double coverage = radius + 0.5 - distance;
+            coverage = coverage < 0 ? 0 : (coverage > 1 ? 1 : coverage);
 
-        // Find nearest stars to (_x,_y)
-        Star *nearest_stars[MAX_NEAREST_STARS];
+            pixels[y * (surface->pitch / 4) + x] = SDL_MapRGBA(surface->format, 255, 255, 255, (Uint8)(255 * coverage));
+        }
+    }
 
-        for (int s = 0; s < MAX_NEAREST_STARS; s++)
-            nearest_stars[s] = NULL;
+    disc_textures[level] = render_create_texture_from_surface(surface);
+    SDL_FreeSurface(surface);
 
-        double bx = maths_get_nearest_section_line(point.x, GALAXY_SECTION_SIZE);
-        double by = maths_get_nearest_section_line(point.y, GALAXY_SECTION_SIZE);
-        int nearest_stars_count = stars_nearest_stars_to_point(nav_state, (Point){bx, by}, nearest_stars);
+    if (disc_textures[level] == NULL)
+    {
+        SDL_Log("Could not create disc texture: %s\n", SDL_GetError());
+        return NULL;
+    }
 
-        if (nearest_stars_count > 1)
-            gfx_move_point_on_circumference(nav_state, &point, nearest_stars, nearest_stars_count);
+    render_set_texture_blend_mode(disc_textures[level], SDL_BLENDMODE_BLEND);
+    render_set_texture_scale_mode(disc_textures[level], SDL_ScaleModeLinear);
 
-        int j = 1;
+    return disc_textures[level];
+}
 
-        // If point is a turn point, check for line of sight
-        if (nearest_stars_count > 0 &&
-            path[i + point_offset].type == PATH_POINT_TURN && path[i + point_offset - 1].type == PATH_POINT_STRAIGHT)
-        {
-            PathPoint start = path[i];
+/**
+ * Finds the pre-rendered cloud of a galaxy. If the galaxy has none, the least recently used cloud is reused,
+ * unless every cloud was used within the last GALAXY_CLOUD_CACHE_SIZE lookups. More galaxies are visible
+ * than the cache holds then, and reusing clouds would render them again every frame.
+ *
+ * @param galaxy A pointer to Galaxy struct.
+ * @param high_definition A boolean to indicate whether the cloud has high definition stars or not.
+ *
+ * @return A pointer to the GalaxyCloud object, or NULL if the galaxy must be drawn star by star.
+ */
+static GalaxyCloud *gfx_get_galaxy_cloud(const Galaxy *galaxy, bool high_definition)
+{
+    GalaxyCloud *cloud = &galaxy_clouds[0];
 
-            if (start.type == PATH_POINT_STRAIGHT)
-            {
-                while (path[i + point_offset + j].type == PATH_POINT_TURN)
-                {
-                    point = path[i + point_offset + j].position;
-
-                    if (nearest_stars_count > 1)
-                        gfx_move_point_on_circumference(nav_state, &point, nearest_stars, nearest_stars_count);
-
-                    if (gfx_has_line_of_sight(nav_state, start.position.x, start.position.y,
-                                              point.x, point.y, nearest_stars, nearest_stars_count))
-                    {
-                        j++;
-                        continue;
-                    }
-                    else
-                        break;
-                }
-            }
-        }
+    galaxy_clouds_clock++;
 
-        if (j > 1)
+    for (int i = 0; i < GALAXY_CLOUD_CACHE_SIZE; i++)
+    {
+        if (galaxy_clouds[i].in_use &&
+            galaxy_clouds[i].high_definition == high_definition &&
+            maths_points_equal(galaxy_clouds[i].position, galaxy->position))
         {
-            // Add starting point to path
-            Point start_point = path[i].position;
-            nav_state->waypoint_star->waypoint_path = (PathPoint *)realloc(nav_state->waypoint_star->waypoint_path, (nav_state->waypoint_star->waypoint_points + 1) * sizeof(PathPoint));
-            nav_state->waypoint_star->waypoint_path[nav_state->waypoint_star->waypoint_points].type = PATH_POINT_TURN;
-            nav_state->waypoint_star->waypoint_path[nav_state->waypoint_star->waypoint_points].position = start_point;
-            nav_state->waypoint_star->waypoint_points++;
-
-            // Bypass omitted points
-            i = i + point_offset + j - 2;
+            galaxy_clouds[i].last_used = galaxy_clouds_clock;
+            return &galaxy_clouds[i];
         }
-        else
-        {
-            // Add point to the new path
-            point = path[i].position;
 
-            if (nearest_stars_count > 1)
-                gfx_move_point_on_circumference(nav_state, &point, nearest_stars, nearest_stars_count);
+        if (!galaxy_clouds[i].in_use || (cloud->in_use && galaxy_clouds[i].last_used < cloud->last_used))
+            cloud = &galaxy_clouds[i];
+    }
+
+    if (cloud->in_use && galaxy_clouds_clock - cloud->last_used <= GALAXY_CLOUD_CACHE_SIZE)
+        return NULL;
 
-            nav_state->waypoint_star->waypoint_path = (PathPoint *)realloc(nav_state->waypoint_star->waypoint_path, (nav_state->waypoint_star->waypoint_points + 1) * sizeof(PathPoint));
-            nav_state->waypoint_star->waypoint_path[nav_state->waypoint_star->waypoint_points].type = PATH_POINT_TURN;
-            nav_state->waypoint_star->waypoint_path[nav_state->waypoint_star->waypoint_points].position = point;
-            nav_state->waypoint_star->waypoint_points++;
-        }
+    for (int j = 0; j < GALAXY_CLOUD_LEVELS; j++)
+    {
+        render_destroy_texture(cloud->levels[j]);
     }
 
-    // Add last point to path
-    nav_state->waypoint_star->waypoint_path = (PathPoint *)realloc(nav_state->waypoint_star->waypoint_path, (nav_state->waypoint_star->waypoint_points + 1) * sizeof(PathPoint));
-    nav_state->waypoint_star->waypoint_path[nav_state->waypoint_star->waypoint_points].type = PATH_POINT_TURN;
-    nav_state->waypoint_star->waypoint_path[nav_state->waypoint_star->waypoint_points].position = path[total_points - 1].position;
-    nav_state->waypoint_star->waypoint_points++;
+    *cloud = (GalaxyCloud){0};
+    cloud->in_use = true;
+    cloud->position = galaxy->position;
+    cloud->high_definition = high_definition;
+    cloud->last_used = galaxy_clouds_clock;
+
+    return cloud;
+}
+
+/**
+ * Checks if an object with a given position and radius is within the bounds of the camera.
+ * The test runs in floats relative to the camera, where coordinates stay small at any position.
+ *
+ * @param camera A pointer to the current Camera object.
+ * @param x The x-coordinate of the object's center.
+ * @param y The y-coordinate of the object's center.
+ * @param radius The radius of the object.
+ * @param scale The scaling factor applied to the camera view.
+ *
+ * @return True if the object is within the camera bounds, false otherwise.
+ */
+bool gfx_is_object_in_camera(const Camera *camera, double x, double y, float radius, long double scale)
+{
+    float relative_x = x - camera->x;
+    float relative_y = y - camera->y;
+    float width = camera->w / scale;
+    float height = camera->h / scale;
+
+    return relative_x + radius >= 0 && relative_x - radius < width &&
+           relative_y + radius >= 0 && relative_y - radius < height;
+}
+
+/**
+ * Determines if a relative position (x,y) is within the bounds of the camera.
+ *
+ * @param camera A pointer to the current Camera object.
+ * @param x The x-coordinate of the position relative to the camera.
+ * @param y The y-coordinate of the position relative to the camera.
+ *
+ * @return True if the position is within the camera bounds, false otherwise.
+ */
+bool gfx_is_relative_position_in_camera(const Camera *camera, int x, int y)
+{
+    return x >= 0 && x < camera->w && y >= 0 && y < camera->h;
 }
 
 /**
@@ -1948,48 +2183,94 @@ void gfx_project_ship_on_edge(int state, const InputState *input_state, const Na
     ship->projection->angle = ship->angle;
 
     // Draw ship projection
-    SDL_RenderCopyEx(renderer, ship->projection->texture, &ship->projection->main_img_rect, &ship->projection->rect, ship->projection->angle, &ship->projection->rotation_pt, SDL_FLIP_NONE);
+    render_copy_ex(ship->projection->texture, &ship->projection->main_img_rect, &ship->projection->rect, ship->projection->angle, &ship->projection->rotation_pt, SDL_FLIP_NONE);
 
     // Draw projection thrust
     if (state == NAVIGATE && input_state->thrust_on)
-        SDL_RenderCopyEx(renderer, ship->projection->texture, &ship->projection->thrust_img_rect, &ship->projection->rect, ship->projection->angle, &ship->projection->rotation_pt, SDL_FLIP_NONE);
+        render_copy_ex(ship->projection->texture, &ship->projection->thrust_img_rect, &ship->projection->rect, ship->projection->angle, &ship->projection->rotation_pt, SDL_FLIP_NONE);
 
     // Draw projection reverse
     if (state == NAVIGATE && input_state->reverse_on)
-        SDL_RenderCopyEx(renderer, ship->projection->texture, &ship->projection->reverse_img_rect, &ship->projection->rect, ship->projection->angle, &ship->projection->rotation_pt, SDL_FLIP_NONE);
+        render_copy_ex(ship->projection->texture, &ship->projection->reverse_img_rect, &ship->projection->rect, ship->projection->angle, &ship->projection->rotation_pt, SDL_FLIP_NONE);
 }
 
 /**
- * Takes a point and an array of nearest stars and checks whether the point is inside any of the stars.
- * It then moves the point just outside the star.
+ * Renders one level of a galaxy cloud texture. Stars are drawn once at the size of the level,
+ * with premultiplied colors so that the texture can be scaled and faded as a whole.
  *
- * @param nav_state A pointer to the current NavigationState object.
- * @param position The starting point outside the star.
- * @param stars An array of pointers to nearest stars.
- * @param max_stars The number of stars in the stars array.
- * @param x The x-coordinate of the new point.
- * @param y The y-coordinate of the new point.
+ * @param cloud A pointer to the GalaxyCloud object.
+ * @param galaxy A pointer to Galaxy struct.
+ * @param gstars_count Number of stars in the galaxy cloud.
+ * @param high_definition A boolean to indicate whether to use high definition stars or not.
+ * @param level The level to render.
  *
- * @return void
+ * @return True if the level was rendered, false otherwise.
  */
-
-static void gfx_shift_path_segment(NavigationState *nav_state, Point position, Star *stars[], int max_stars, double *x, double *y)
+static bool gfx_render_galaxy_cloud_level(GalaxyCloud *cloud, const Galaxy *galaxy, int gstars_count, bool high_definition, int level)
 {
-    double radius_ratio = 1.01;
+    static bool has_blend_mode = false;
+    static bool is_blend_mode_supported = true;
+    static SDL_BlendMode premultiplied_blend_mode;
+
+    // Renderers without custom blend modes, such as the software renderer, draw clouds star by star
+    if (!is_blend_mode_supported)
+        return false;
+
+    if (!has_blend_mode)
+    {
+        premultiplied_blend_mode = SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                                                              SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+        has_blend_mode = true;
+    }
+
+    int size = GALAXY_CLOUD_MIN_SIZE << level;
 
-    for (int i = 0; i < max_stars; i++)
+    if (cloud->levels[level] == NULL)
     {
-        if (stars[i] != NULL && strcmp(stars[i]->name, nav_state->waypoint_star->name) != 0)
+        cloud->levels[level] = render_create_texture(SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, size, size);
+
+        if (cloud->levels[level] == NULL)
         {
-            while (maths_is_point_in_circle((Point){*x, *y}, (Point){stars[i]->position.x, stars[i]->position.y}, stars[i]->cutoff))
-            {
-                maths_closest_point_outside_circle(stars[i]->position.x, stars[i]->position.y, stars[i]->cutoff, radius_ratio,
-                                                   *x, *y,
-                                                   x, y,
-                                                   0);
-            }
+            SDL_Log("Could not create galaxy cloud texture: %s\n", SDL_GetError());
+            return false;
         }
+
+        if (!render_set_texture_blend_mode(cloud->levels[level], premultiplied_blend_mode))
+        {
+            SDL_Log("Premultiplied blending is not supported by the renderer, galaxy clouds are not cached\n");
+            render_destroy_texture(cloud->levels[level]);
+            cloud->levels[level] = NULL;
+            is_blend_mode_supported = false;
+            return false;
+        }
+
+        render_set_texture_scale_mode(cloud->levels[level], SDL_ScaleModeLinear);
     }
+
+    SDL_Texture *previous_target = render_set_target(cloud->levels[level]);
+
+    render_set_draw_color(0, 0, 0, 0);
+    render_clear();
+
+    // Blending onto a transparent target leaves premultiplied colors in the texture
+    double center = size / 2;
+    double texture_scale = (size / 2 - 1) / (galaxy->radius * GALAXY_SCALE);
+    const Gstar *gstars = high_definition ? galaxy->gstars_hd : galaxy->gstars;
+
+    for (int i = 0; i < gstars_count; i++)
+    {
+        SDL_Color color = gstars[i].color;
+        color.a = gstars[i].opacity;
+
+        batch_add_point((int)(center + gstars[i].position.x * texture_scale), (int)(center + gstars[i].position.y * texture_scale), color);
+    }
+
+    batch_flush();
+    render_set_target(previous_target);
+
+    cloud->gstars_count[level] = gstars_count;
+
+    return true;
 }
 
 /**
@@ -2213,7 +2494,8 @@ void gfx_toggle_star_waypoint_button_hover(InputState *input_state, SDL_Rect but
 }
 
 /**
- * Updates the position and opacity of background stars.
+ * Scrolls the background stars and draws them with their current opacity.
+ * The field is drawn from its pre-rendered texture, or star by star if there is none.
  *
  * @param state The current game state.
  * @param camera_on Whether or not the camera is turned on.
@@ -2227,86 +2509,111 @@ void gfx_toggle_star_waypoint_button_hover(InputState *input_state, SDL_Rect but
  */
 void gfx_update_bstars_position(int state, bool camera_on, const NavigationState *nav_state, Bstar *bstars, const Camera *camera, Speed speed, double distance)
 {
-    int i = 0;
-    int max_bstars = (int)(camera->w * camera->h * BSTARS_PER_SQUARE / BSTARS_SQUARE);
     float max_distance = 2 * nav_state->current_galaxy->radius * GALAXY_SCALE;
 
-    while (i < max_bstars && bstars[i].final_star == true)
+    // All stars move by the same amount, so the whole field is scrolled
+    if (camera_on || state == MENU || state == CONTROLS)
     {
-        if (camera_on || state == MENU || state == CONTROLS)
-        {
-            float dx, dy;
+        float dx, dy;
 
-            if (state == MENU || state == CONTROLS)
+        if (state == MENU || state == CONTROLS)
+        {
+            dx = MENU_BSTARS_SPEED_FACTOR * speed.vx / FPS;
+            dy = MENU_BSTARS_SPEED_FACTOR * speed.vy / FPS;
+        }
+        else
+        {
+            // Limit background stars speed
+            if (nav_state->velocity.magnitude > GALAXY_SPEED_LIMIT)
             {
-                dx = MENU_BSTARS_SPEED_FACTOR * speed.vx / FPS;
-                dy = MENU_BSTARS_SPEED_FACTOR * speed.vy / FPS;
+                dx = BSTARS_SPEED_FACTOR * speed.vx / FPS;
+                dy = BSTARS_SPEED_FACTOR * speed.vy / FPS;
             }
             else
             {
-                // Limit background stars speed
-                if (nav_state->velocity.magnitude > GALAXY_SPEED_LIMIT)
-                {
-                    dx = BSTARS_SPEED_FACTOR * speed.vx / FPS;
-                    dy = BSTARS_SPEED_FACTOR * speed.vy / FPS;
-                }
-                else
-                {
-                    dx = BSTARS_SPEED_FACTOR * (nav_state->velocity.magnitude / GALAXY_SPEED_LIMIT) * speed.vx / FPS;
-                    dy = BSTARS_SPEED_FACTOR * (nav_state->velocity.magnitude / GALAXY_SPEED_LIMIT) * speed.vy / FPS;
-                }
+                dx = BSTARS_SPEED_FACTOR * (nav_state->velocity.magnitude / GALAXY_SPEED_LIMIT) * speed.vx / FPS;
+                dy = BSTARS_SPEED_FACTOR * (nav_state->velocity.magnitude / GALAXY_SPEED_LIMIT) * speed.vy / FPS;
             }
+        }
 
-            bstars[i].position.x -= dx;
-            bstars[i].position.y -= dy;
+        // Normalize within camera boundaries
+        bstars_offset.x = fmod(bstars_offset.x - dx, camera->w);
+        bstars_offset.y = fmod(bstars_offset.y - dy, camera->h);
 
-            // Normalize within camera boundaries
-            if (bstars[i].position.x > camera->w)
-            {
-                bstars[i].position.x = fmod(bstars[i].position.x, camera->w);
-            }
-            if (bstars[i].position.x < 0)
-            {
-                bstars[i].position.x += camera->w;
-            }
-            if (bstars[i].position.y > camera->h)
-            {
-                bstars[i].position.y = fmod(bstars[i].position.y, camera->h);
-            }
-            if (bstars[i].position.y < 0)
-            {
-                bstars[i].position.y += camera->h;
-            }
+        if (bstars_offset.x < 0)
+            bstars_offset.x += camera->w;
 
-            bstars[i].rect.x = (int)bstars[i].position.x;
-            bstars[i].rect.y = (int)bstars[i].position.y;
-        }
+        if (bstars_offset.y < 0)
+            bstars_offset.y += camera->h;
+    }
 
-        float opacity;
+    float opacity_factor;
 
-        if (state == MENU)
-            opacity = (double)(bstars[i].opacity * 1 / 2);
-        else if (state == CONTROLS)
-            opacity = (double)(bstars[i].opacity * 1 / 3);
-        else
+    if (state == MENU)
+        opacity_factor = 1.0 / 2;
+    else if (state == CONTROLS)
+        opacity_factor = 1.0 / 3;
+    else
+    {
+        // Fade out opacity as we move away from galaxy center
+        opacity_factor = 1 - (distance / max_distance);
+
+        // Opacity is 1/3 at center, 3/3 at max_distance
+        opacity_factor *= (3 - (2 - 2 * (distance / max_distance))) / 3;
+    }
+
+    if (opacity_factor > 1)
+        opacity_factor = 1;
+    else if (opacity_factor < 0)
+        opacity_factor = 0;
+
+    unsigned short previous_layer = render_set_layer(RENDER_LAYER_BACKGROUND);
+    SDL_Texture *texture = bstars_textures[bstars_front];
+    int x = (int)bstars_offset.x;
+    int y = (int)bstars_offset.y;
+    int w = bstars_sizes[bstars_front].x;
+    int h = bstars_sizes[bstars_front].y;
+
+    SDL_Color mod = {255, 255, 255, (Uint8)(255 * opacity_factor)};
+
+    if (texture != NULL && w == camera->w && h == camera->h)
+    {
+        // The field wraps around the screen, so it takes up to four copies to cover it
+        for (int j = 0; j < 4; j++)
         {
-            // Fade out opacity as we move away from galaxy center
-            opacity = (double)bstars[i].opacity * (1 - (distance / max_distance));
+            SDL_Rect rect = {x - (j & 1) * w, y - (j >> 1) * h, w, h};
 
-            // Opacity is 1/3 at center, 3/3 at max_distance
-            opacity = (double)(opacity * ((3 - (2 - 2 * (distance / max_distance))) / 3));
+            if ((j & 1 && x == 0) || (j >> 1 && y == 0))
+                continue;
+
+            render_copy_modulated(texture, NULL, &rect, mod);
         }
+    }
+    // After a resize, the previous field is stretched over the camera until the field of the new size is
+    // generated, since the stars array is being filled for the new size
+    else if (texture != NULL)
+        render_copy_modulated(texture, NULL, NULL, mod);
+    // Without textures, e.g. for the first field, stars are drawn as they are generated
+    else
+    {
+        int i = 0;
+        int max_bstars = (int)(camera->w * camera->h * BSTARS_PER_SQUARE / BSTARS_SQUARE);
 
-        if (opacity > 255)
-            opacity = 255;
-        else if (opacity < 0)
-            opacity = 0;
+        while (i < max_bstars && bstars[i].final_star == true)
+        {
+            SDL_Rect rect = bstars[i].rect;
+            rect.x = ((int)bstars[i].position.x + x) % camera->w;
+            rect.y = ((int)bstars[i].position.y + y) % camera->h;
 
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, (unsigned short)opacity);
-        SDL_RenderFillRect(renderer, &bstars[i].rect);
+            batch_add_rect(&rect, (SDL_Color){255, 255, 255, (unsigned short)(bstars[i].opacity * opacity_factor)});
 
-        i++;
+            i++;
+        }
+
+        batch_flush();
     }
+
+    render_set_layer(previous_layer);
 }
 
 /**
@@ -2379,11 +2686,16 @@ void gfx_update_gstars_position(Galaxy *galaxy, Point ship_position, const Camer
         else if (opacity < 0)
             opacity = 0;
 
-        SDL_SetRenderDrawColor(renderer, galaxy->gstars_hd[i].color.r, galaxy->gstars_hd[i].color.g, galaxy->gstars_hd[i].color.b, (unsigned short)opacity);
-        SDL_RenderDrawPoint(renderer, x, y);
+        SDL_Color color = galaxy->gstars_hd[i].color;
+        color.a = (unsigned short)opacity;
+        batch_add_point(x, y, color);
 
         i++;
     }
+
+    unsigned short previous_layer = render_set_layer(RENDER_LAYER_BACKGROUND);
+    batch_flush();
+    render_set_layer(previous_layer);
 }
 
 /**
@@ -0,0 +1,601 @@
+/*
+ * itinerary.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <stdbool.h>
+
+#include <SDL2/SDL.h>
+#include "../lib/pcg-c-basic-0.9/pcg_basic.h"
+
+#include "../include/constants.h"
+#include "../include/enums.h"
+#include "../include/structs.h"
+#include "../include/itinerary.h"
+
+// Static variable definitions
+static Itinerary itinerary = {0}; // Galaxies on the way to the waypoint
+static ItineraryJob *job = NULL;  // Itinerary being planned
+static bool is_async = true;
+
+// Static function prototypes
+static double itinerary_cost(const ItineraryNode *, const ItineraryNode *);
+static void itinerary_free(Itinerary *);
+static int itinerary_get_node(ItinerarySearch *, Point position);
+static bool itinerary_plan(Point start, Point destination, Itinerary *, int *expansions);
+static int itinerary_pop_open(ItinerarySearch *);
+static void itinerary_push_open(ItinerarySearch *, int node, double f);
+static void itinerary_release_job(ItineraryJob *);
+static void itinerary_run_job(void *data);
+static void itinerary_start_job(Point start, Point destination);
+static bool itinerary_take_job(Point start, Point destination);
+
+/**
+ * Plans itineraries between the current galaxy and galaxies at increasing distances,
+ * and prints the planning time, the size of the search and the number of galaxies on the way.
+ *
+ * @param nav_state A pointer to the current NavigationState object.
+ * @param runs The number of itineraries to plan for each distance.
+ *
+ * @return void
+ */
+void itinerary_benchmark(const NavigationState *nav_state, int runs)
+{
+    // Use a local rng, so that every run plans the same itineraries
+    pcg32_random_t rng;
+    pcg32_srandom_r(&rng, ROUTE_BENCHMARK_SEED, nav_state->initseq);
+
+    printf("Itinerary benchmark: from galaxy %s, %d itineraries per distance\n", nav_state->current_galaxy->name, runs);
+    printf("  %8s %10s %10s %10s %10s %8s\n", "sections", "ms/plan", "max ms", "galaxies", "hops", "partial");
+
+    for (int length = 16; length <= 4096; length *= 2)
+    {
+        double total_time = 0;
+        double max_time = 0;
+        long total_expansions = 0;
+        long total_hops = 0;
+        int partial = 0;
+
+        for (int i = 0; i < runs; i++)
+        {
+            // Find a galaxy at about the given distance, in a random direction
+            double angle = (pcg32_random_r(&rng) % 3600) * M_PI / 1800;
+            Point destination = nav_state->current_galaxy->position;
+            bool is_found = false;
+
+            for (int step = 0; step < 4 * length && !is_found; step++)
+            {
+                destination.x = nav_state->current_galaxy->position.x + round((length + step / 4) * cos(angle) + step % 2) * UNIVERSE_SECTION_SIZE;
+                destination.y = nav_state->current_galaxy->position.y + round((length + step / 4) * sin(angle) + step / 2 % 2) * UNIVERSE_SECTION_SIZE;
+                is_found = galaxies_section_has_galaxy(destination);
+            }
+
+            if (!is_found)
+                continue;
+
+            int expansions;
+            Uint64 start_time = SDL_GetPerformanceCounter();
+
+            itinerary_plan(nav_state->current_galaxy->position, destination, &itinerary, &expansions);
+
+            double time = (SDL_GetPerformanceCounter() - start_time) * 1000.0 / SDL_GetPerformanceFrequency();
+
+            total_time += time;
+            max_time = fmax(max_time, time);
+            total_expansions += expansions;
+            total_hops += itinerary.num_galaxies - 1;
+            partial += itinerary.is_partial;
+        }
+
+        printf("  %8d %10.2f %10.2f %10ld %10.1f %8d\n", length, total_time / runs, max_time,
+               total_expansions / runs, (double)total_hops / runs, partial);
+    }
+
+    itinerary_clear();
+}
+
+/**
+ * Frees the itinerary and cancels the one being planned, e.g. when the waypoint is cleared.
+ *
+ * @return void
+ */
+void itinerary_clear(void)
+{
+    if (job != NULL)
+    {
+        itinerary_release_job(job);
+        job = NULL;
+    }
+
+    itinerary_free(&itinerary);
+}
+
+/**
+ * Returns the cost of a hop between two galaxies: the gap between their edges, and the
+ * distance from the edge to the center of each galaxy, weighted by the slower speed inside galaxies.
+ * The cost is never less than the distance between the centers.
+ *
+ * @param a A pointer to the ItineraryNode of the first galaxy.
+ * @param b A pointer to the ItineraryNode of the second galaxy.
+ *
+ * @return The cost of the hop.
+ */
+static double itinerary_cost(const ItineraryNode *a, const ItineraryNode *b)
+{
+    double distance = hypot(b->position.x - a->position.x, b->position.y - a->position.y);
+    double gap = fmax(distance - a->radius - b->radius, 0);
+
+    return gap + ITINERARY_INTERIOR_WEIGHT * (a->radius + b->radius);
+}
+
+/**
+ * Frees the galaxies of an itinerary.
+ *
+ * @param itinerary A pointer to the Itinerary.
+ *
+ * @return void
+ */
+static void itinerary_free(Itinerary *itinerary)
+{
+    free(itinerary->positions);
+    free(itinerary->radii);
+    *itinerary = (Itinerary){0};
+}
+
+/**
+ * Finds the leg of the itinerary through the current galaxy, on the way to the galaxy of the waypoint.
+ * The itinerary is planned again if it leads to another galaxy, if the ship is inside a galaxy that
+ * is not on it, or if the ship reached the end of a partial itinerary. It is planned on a worker thread;
+ * Until it is ready, there is no leg.
+ *
+ * @param nav_state A pointer to the current NavigationState object.
+ * @param exit A pointer to the end of the leg through the current galaxy, in the coordinates of the galaxy.
+ * @param entry A pointer to the start of the leg through the next galaxy, in the coordinates of the current galaxy.
+ * Equal to the exit if the ship is outside the galaxy and not on the itinerary.
+ *
+ * @return ITINERARY_LEG_FOUND if there is a leg, ITINERARY_LEG_PLANNING if the itinerary is being planned,
+ *         or ITINERARY_LEG_NONE if the waypoint is in the current galaxy or the itinerary could not be planned.
+ */
+unsigned short itinerary_get_leg(const NavigationState *nav_state, Point *exit, Point *entry)
+{
+    const Galaxy *galaxy = nav_state->current_galaxy;
+    Point destination = nav_state->waypoint_star->galaxy_position;
+
+    if (maths_points_equal(galaxy->position, destination))
+        return ITINERARY_LEG_NONE;
+
+    bool is_valid = itinerary.num_galaxies > 1 && maths_points_equal(itinerary.positions[itinerary.num_galaxies - 1], destination);
+    int index = -1;
+
+    for (int i = 0; is_valid && i < itinerary.num_galaxies - 1 && index < 0; i++)
+    {
+        if (maths_points_equal(itinerary.positions[i], galaxy->position))
+            index = i;
+    }
+
+    double distance_center = sqrt(nav_state->navigate_offset.x * nav_state->navigate_offset.x + nav_state->navigate_offset.y * nav_state->navigate_offset.y);
+    bool is_inside = distance_center < galaxy->radius * GALAXY_SCALE;
+    bool is_partial_end = itinerary.is_partial && index == itinerary.num_galaxies - 2 && index > 0;
+
+    if (!is_valid || (index < 0 && is_inside) || is_partial_end)
+    {
+        if (!itinerary_take_job(galaxy->position, destination))
+        {
+            itinerary_start_job(galaxy->position, destination);
+
+            if (!itinerary_take_job(galaxy->position, destination))
+                return job != NULL ? ITINERARY_LEG_PLANNING : ITINERARY_LEG_NONE;
+        }
+
+        if (itinerary.num_galaxies == 0)
+            return ITINERARY_LEG_NONE;
+
+        index = 0;
+    }
+
+    if (index >= 0)
+        itinerary.current = index;
+
+    // Legs run along the line between the centers of consecutive galaxies
+    int next = itinerary.current + 1;
+    double dx = (itinerary.positions[next].x - galaxy->position.x) * GALAXY_SCALE;
+    double dy = (itinerary.positions[next].y - galaxy->position.y) * GALAXY_SCALE;
+    double distance = sqrt(dx * dx + dy * dy);
+    double next_edge = itinerary.radii[next] * GALAXY_SCALE + ITINERARY_EXIT_MARGIN * GALAXY_SECTION_SIZE;
+    double edge = galaxy->radius * GALAXY_SCALE + ITINERARY_EXIT_MARGIN * GALAXY_SECTION_SIZE;
+
+    entry->x = dx * (distance - next_edge) / distance;
+    entry->y = dy * (distance - next_edge) / distance;
+
+    if (index >= 0 && edge < distance - next_edge)
+    {
+        exit->x = dx * edge / distance;
+        exit->y = dy * edge / distance;
+    }
+    else
+        *exit = *entry;
+
+    return ITINERARY_LEG_FOUND;
+}
+
+/**
+ * Returns the node of the galaxy at a position, and adds it if it is new.
+ *
+ * @param search A pointer to the ItinerarySearch.
+ * @param position The universe position of the galaxy.
+ *
+ * @return The index of the node, or -1 if the memory budget has been reached.
+ */
+static int itinerary_get_node(ItinerarySearch *search, Point position)
+{
+    int64_t x = (int64_t)round(position.x / UNIVERSE_SECTION_SIZE);
+    int64_t y = (int64_t)round(position.y / UNIVERSE_SECTION_SIZE);
+    uint64_t hash = (uint64_t)x * 0x9E3779B97F4A7C15ULL ^ (uint64_t)y * 0xC2B2AE3D27D4EB4FULL;
+    int mask = search->max_table - 1;
+    int index = (int)((hash ^ (hash >> 32)) & mask);
+
+    while (search->table[index] >= 0)
+    {
+        if (maths_points_equal(search->nodes[search->table[index]].position, position))
+            return search->table[index];
+
+        index = (index + 1) & mask;
+    }
+
+    if (search->num_nodes >= ITINERARY_MAX_GALAXIES)
+    {
+        search->is_out_of_memory = true;
+        return -1;
+    }
+
+    unsigned short class;
+    int node = search->num_nodes++;
+
+    search->nodes[node] = (ItineraryNode){.position = position,
+                                          .radius = galaxies_get_radius(position, &class),
+                                          .g = INFINITY,
+                                          .parent = -1,
+                                          .is_closed = false};
+    search->table[index] = node;
+
+    return node;
+}
+
+/**
+ * Plans the itinerary between two galaxies, with A* over the galaxies of the generator. Hops are limited
+ * to ITINERARY_MAX_HOP sections, so that only the galaxies around the expanded ones are generated.
+ * If the search runs out of budget, the itinerary leads to the galaxy closest to the destination
+ * and hops from there to the destination.
+ *
+ * @param start The universe position of the first galaxy.
+ * @param destination The universe position of the last galaxy.
+ * @param itinerary A pointer to the Itinerary to replace.
+ * @param expansions A pointer to the number of galaxies expanded.
+ *
+ * @return True if an itinerary was planned, false if memory could not be allocated.
+ */
+static bool itinerary_plan(Point start, Point destination, Itinerary *itinerary, int *expansions)
+{
+    itinerary_free(itinerary);
+    *expansions = 0;
+
+    ItinerarySearch search = {0};
+    search.max_table = 2 * ITINERARY_MAX_GALAXIES;
+    search.max_open = 256;
+    search.nodes = malloc(ITINERARY_MAX_GALAXIES * sizeof(ItineraryNode));
+    search.table = malloc(search.max_table * sizeof(int));
+    search.open = malloc(search.max_open * sizeof(RouteOpenEntry));
+
+    if (search.nodes == NULL || search.table == NULL || search.open == NULL)
+    {
+        fprintf(stderr, "Error: Could not allocate memory for itinerary search.\n");
+        free(search.nodes);
+        free(search.table);
+        free(search.open);
+        return false;
+    }
+
+    for (int i = 0; i < search.max_table; i++)
+        search.table[i] = -1;
+
+    int start_node = itinerary_get_node(&search, start);
+    int destination_node = itinerary_get_node(&search, destination);
+    int best_node = start_node;
+    double best_distance = hypot(destination.x - start.x, destination.y - start.y);
+
+    search.nodes[start_node].g = 0;
+    itinerary_push_open(&search, start_node, best_distance);
+
+    while (search.num_open > 0 && !search.is_out_of_memory)
+    {
+        int node = itinerary_pop_open(&search);
+
+        if (search.nodes[node].is_closed)
+            continue;
+
+        search.nodes[node].is_closed = true;
+        search.expansions++;
+
+        if (node == destination_node)
+            break;
+
+        Point position = search.nodes[node].position;
+        double distance = hypot(destination.x - position.x, destination.y - position.y);
+
+        if (distance < best_distance)
+        {
+            best_node = node;
+            best_distance = distance;
+        }
+
+        // Galaxies within a hop
+        for (int dx = -ITINERARY_MAX_HOP; dx <= ITINERARY_MAX_HOP; dx++)
+        {
+            for (int dy = -ITINERARY_MAX_HOP; dy <= ITINERARY_MAX_HOP; dy++)
+            {
+                if ((dx == 0 && dy == 0) || dx * dx + dy * dy > ITINERARY_MAX_HOP * ITINERARY_MAX_HOP)
+                    continue;
+
+                Point neighbor_position = {.x = position.x + dx * (double)UNIVERSE_SECTION_SIZE,
+                                           .y = position.y + dy * (double)UNIVERSE_SECTION_SIZE};
+
+                // Same bounds as the galaxy generator
+                if (sqrt(neighbor_position.x * neighbor_position.x + neighbor_position.y * neighbor_position.y) > UNIVERSE_X_LIMIT ||
+                    !galaxies_section_has_galaxy(neighbor_position))
+                    continue;
+
+                int neighbor = itinerary_get_node(&search, neighbor_position);
+
+                if (neighbor < 0 || search.nodes[neighbor].is_closed)
+                    continue;
+
+                double g = search.nodes[node].g + itinerary_cost(&search.nodes[node], &search.nodes[neighbor]);
+
+                if (g < search.nodes[neighbor].g)
+                {
+                    search.nodes[neighbor].g = g;
+                    search.nodes[neighbor].parent = node;
+
+                    // Inflate the heuristic, trading optimality within the weight for far fewer expansions
+                    double h = hypot(destination.x - neighbor_position.x, destination.y - neighbor_position.y);
+                    itinerary_push_open(&search, neighbor, g + ITINERARY_HEURISTIC_WEIGHT * h);
+                }
+            }
+        }
+    }
+
+    // Without an itinerary to the destination, hop to it from the galaxy closest to it
+    int last_node = search.nodes[destination_node].is_closed ? destination_node : best_node;
+    int num_galaxies = last_node == destination_node ? 1 : 2;
+
+    for (int node = last_node; node != start_node; node = search.nodes[node].parent)
+        num_galaxies++;
+
+    itinerary->positions = malloc(num_galaxies * sizeof(Point));
+    itinerary->radii = malloc(num_galaxies * sizeof(float));
+
+    if (itinerary->positions == NULL || itinerary->radii == NULL)
+    {
+        fprintf(stderr, "Error: Could not allocate memory for itinerary.\n");
+        itinerary_free(itinerary);
+    }
+    else
+    {
+        int i = num_galaxies - 1;
+
+        if (last_node != destination_node)
+        {
+            itinerary->positions[i] = search.nodes[destination_node].position;
+            itinerary->radii[i--] = search.nodes[destination_node].radius;
+        }
+
+        for (int node = last_node; i >= 0; node = search.nodes[node].parent)
+        {
+            itinerary->positions[i] = search.nodes[node].position;
+            itinerary->radii[i--] = search.nodes[node].radius;
+        }
+
+        itinerary->num_galaxies = num_galaxies;
+        itinerary->is_partial = last_node != destination_node;
+    }
+
+    *expansions = search.expansions;
+
+    free(search.nodes);
+    free(search.table);
+    free(search.open);
+
+    return itinerary->num_galaxies > 0;
+}
+
+/**
+ * Removes the entry with the lowest estimate from the open set.
+ *
+ * @param search A pointer to the ItinerarySearch.
+ *
+ * @return The node of the entry.
+ */
+static int itinerary_pop_open(ItinerarySearch *search)
+{
+    RouteOpenEntry *open = search->open;
+    int node = open[0].node;
+    RouteOpenEntry last = open[--search->num_open];
+    int i = 0;
+
+    while (2 * i + 1 < search->num_open)
+    {
+        int child = 2 * i + 1;
+
+        if (child + 1 < search->num_open && open[child + 1].f < open[child].f)
+            child++;
+
+        if (open[child].f >= last.f)
+            break;
+
+        open[i] = open[child];
+        i = child;
+    }
+
+    open[i] = last;
+
+    return node;
+}
+
+/**
+ * Adds a node to the open set. Older entries of the node are skipped when they are removed.
+ *
+ * @param search A pointer to the ItinerarySearch.
+ * @param node The node.
+ * @param f The estimated cost of the itinerary through the node.
+ *
+ * @return void
+ */
+static void itinerary_push_open(ItinerarySearch *search, int node, double f)
+{
+    if (search->num_open >= search->max_open)
+    {
+        RouteOpenEntry *open = realloc(search->open, 2 * search->max_open * sizeof(RouteOpenEntry));
+
+        if (open == NULL)
+        {
+            fprintf(stderr, "Error: Could not allocate memory for itinerary open set.\n");
+            search->is_out_of_memory = true;
+            return;
+        }
+
+        search->open = open;
+        search->max_open *= 2;
+    }
+
+    int i = search->num_open++;
+
+    while (i > 0 && search->open[(i - 1) / 2].f > f)
+    {
+        search->open[i] = search->open[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+
+    search->open[i] = (RouteOpenEntry){.f = f, .node = node};
+}
+
+/**
+ * Releases a reference to a job, and frees it if it was the last one.
+ *
+ * @param job A pointer to the ItineraryJob.
+ *
+ * @return void
+ */
+static void itinerary_release_job(ItineraryJob *job)
+{
+    if (!jobs_release_handle(&job->handle))
+        return;
+
+    itinerary_free(&job->itinerary);
+    free(job);
+}
+
+/**
+ * Plans the itinerary of a job. Runs on a worker thread of the job system,
+ * or in the calling thread if planning is synchronous.
+ *
+ * @param data A pointer to the ItineraryJob.
+ *
+ * @return void
+ */
+static void itinerary_run_job(void *data)
+{
+    ItineraryJob *job = data;
+    int expansions;
+
+    itinerary_plan(job->start, job->destination, &job->itinerary, &expansions);
+
+    jobs_finish_handle(&job->handle);
+    itinerary_release_job(job);
+}
+
+/**
+ * Sets whether itineraries are planned on a background thread. Replays plan synchronously,
+ * so that legs are available on the same frames as when they were recorded.
+ *
+ * @param async Whether to plan on a background thread.
+ *
+ * @return void
+ */
+void itinerary_set_async(bool async)
+{
+    is_async = async;
+}
+
+/**
+ * Starts planning an itinerary on a worker thread, unless one is already being planned.
+ * The itinerary is taken with itinerary_take_job().
+ *
+ * @param start The universe position of the first galaxy.
+ * @param destination The universe position of the last galaxy.
+ *
+ * @return void
+ */
+static void itinerary_start_job(Point start, Point destination)
+{
+    if (job != NULL)
+        return;
+
+    ItineraryJob *new_job = (ItineraryJob *)calloc(1, sizeof(ItineraryJob));
+
+    if (new_job == NULL)
+    {
+        fprintf(stderr, "Error: Could not allocate memory for itinerary job.\n");
+        return;
+    }
+
+    new_job->start = start;
+    new_job->destination = destination;
+
+    jobs_init_handle(&new_job->handle);
+    job = new_job;
+
+    if (!is_async)
+    {
+        itinerary_run_job(job);
+        return;
+    }
+
+    jobs_submit(itinerary_run_job, job, JOB_TAG_ROUTE, 0);
+}
+
+/**
+ * Takes the itinerary of the job once it is planned, if it was planned between the given galaxies.
+ * A job planned between other galaxies is cancelled, since the ship or the waypoint changed galaxy.
+ *
+ * @param start The universe position of the first galaxy.
+ * @param destination The universe position of the last galaxy.
+ *
+ * @return True if the itinerary was taken, false otherwise.
+ */
+static bool itinerary_take_job(Point start, Point destination)
+{
+    if (job == NULL)
+        return false;
+
+    if (!maths_points_equal(job->start, start) || !maths_points_equal(job->destination, destination))
+    {
+        itinerary_release_job(job);
+        job = NULL;
+
+        return false;
+    }
+
+    if (!jobs_is_handle_done(&job->handle))
+        return false;
+
+    itinerary_free(&itinerary);
+    itinerary = job->itinerary;
+    job->itinerary = (Itinerary){0};
+
+    itinerary_release_job(job);
+    job = NULL;
+
+    return true;
+}
@@ -0,0 +1,797 @@
+/*
+ * jobs.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <stdbool.h>
+
+#include <SDL2/SDL.h>
+
+#include "../include/constants.h"
+#include "../include/enums.h"
+#include "../include/structs.h"
+#include "../include/jobs.h"
+
+// Static variable definitions
+static JobWorker workers[JOBS_MAX_WORKERS + 1]; // The last deque is shared by the threads that are not workers
+static int num_workers = 0;
+static SDL_TLSID worker_id = 0; // The JobWorker of the current thread, NULL if it is not a worker
+static SDL_mutex *mutex = NULL;
+static SDL_cond *cond = NULL;      // Signalled when work is added, for the sleeping workers
+static SDL_cond *done_cond = NULL; // Signalled when the last part of a parallel for finishes
+static SDL_atomic_t next_order;
+static SDL_atomic_t next_worker; // Worker that gets the next job submitted by a thread that is not a worker
+static unsigned int wakeups = 0; // Counts the times work was added, so that a worker about to sleep does not miss it
+static bool is_stopping = false;
+
+// Static function prototypes
+static const char *jobs_get_name(unsigned short tag);
+static bool jobs_is_before(const Job *a, const Job *b);
+static Job *jobs_pop_job(JobWorker *);
+static bool jobs_push_range(JobWorker *, JobRange *);
+static void jobs_run_range(JobRange *);
+static int jobs_run_worker(void *data);
+static void jobs_sift_down(JobWorker *, int index);
+static void jobs_sift_up(JobWorker *, int index);
+static Job *jobs_take_job(JobWorker *);
+static JobRange *jobs_take_range(JobWorker *);
+static void jobs_wake_workers(void);
+
+/**
+ * Cancels the background jobs with any of the given tags, queued or running.
+ * Cancelled jobs still run, before the other queued jobs, so that they free their data;
+ * They check jobs_is_cancelled() and return early.
+ *
+ * @param tags The tags of the jobs to cancel, combined with bitwise or.
+ *
+ * @return void
+ */
+void jobs_cancel(unsigned short tags)
+{
+    for (int i = 0; i < num_workers; i++)
+    {
+        JobWorker *worker = &workers[i];
+
+        SDL_AtomicLock(&worker->lock);
+
+        for (int j = 0; j < worker->num_jobs; j++)
+        {
+            if (worker->jobs[j]->tag & tags)
+            {
+                SDL_AtomicSet(&worker->jobs[j]->is_cancelled, 1);
+                worker->jobs[j]->priority = -1;
+            }
+        }
+
+        // Restore the heap order
+        for (int j = worker->num_jobs / 2 - 1; j >= 0; j--)
+            jobs_sift_down(worker, j);
+
+        if (worker->job != NULL && (worker->job->tag & tags))
+            SDL_AtomicSet(&worker->job->is_cancelled, 1);
+
+        SDL_AtomicUnlock(&worker->lock);
+    }
+}
+
+/**
+ * Cancels a background job through its handle. The job checks jobs_is_handle_cancelled() and returns early.
+ *
+ * @param handle A pointer to the JobHandle of the job.
+ *
+ * @return void
+ */
+void jobs_cancel_handle(JobHandle *handle)
+{
+    SDL_AtomicSet(&handle->is_cancelled, 1);
+}
+
+/**
+ * Starts the worker threads, one less than the CPUs, so that the simulation keeps a core.
+ *
+ * @return True if the job system was created, false otherwise. Jobs then run on the calling thread.
+ */
+bool jobs_create(void)
+{
+    int count = SDL_GetCPUCount() - 1;
+
+    if (count < 1)
+        count = 1;
+    else if (count > JOBS_MAX_WORKERS)
+        count = JOBS_MAX_WORKERS;
+
+    mutex = SDL_CreateMutex();
+    cond = SDL_CreateCond();
+    done_cond = SDL_CreateCond();
+    worker_id = SDL_TLSCreate();
+
+    if (mutex == NULL || cond == NULL || done_cond == NULL || worker_id == 0)
+    {
+        fprintf(stderr, "Error: Could not create job system.\n");
+        jobs_destroy();
+        return false;
+    }
+
+    is_stopping = false;
+
+    // Workers wait for the mutex until they are all created
+    SDL_LockMutex(mutex);
+
+    for (int i = 0; i < count; i++)
+    {
+        workers[i].jobs = (Job **)malloc(JOBS_QUEUE_SIZE * sizeof(Job *));
+
+        if (workers[i].jobs == NULL)
+        {
+            fprintf(stderr, "Error: Could not allocate memory for job queue.\n");
+            break;
+        }
+
+        workers[i].num_jobs = 0;
+        workers[i].max_jobs = JOBS_QUEUE_SIZE;
+        workers[i].thread = SDL_CreateThread(jobs_run_worker, "jobs", &workers[i]);
+
+        if (workers[i].thread == NULL)
+        {
+            SDL_Log("Could not create job thread: %s\n", SDL_GetError());
+            free(workers[i].jobs);
+            workers[i].jobs = NULL;
+            break;
+        }
+
+        num_workers++;
+    }
+
+    SDL_UnlockMutex(mutex);
+
+    if (num_workers == 0)
+    {
+        jobs_destroy();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Stops the worker threads once the queued jobs have run cancelled, and frees the job system.
+ *
+ * @return void
+ */
+void jobs_destroy(void)
+{
+    if (mutex != NULL && cond != NULL)
+    {
+        SDL_LockMutex(mutex);
+        is_stopping = true;
+        SDL_UnlockMutex(mutex);
+
+        jobs_cancel(JOB_TAG_ROUTE | JOB_TAG_REGION | JOB_TAG_GALAXY | JOB_TAG_UNIVERSE);
+        jobs_wake_workers();
+    }
+
+    for (int i = 0; i < num_workers; i++)
+    {
+        SDL_WaitThread(workers[i].thread, NULL);
+        free(workers[i].jobs);
+        workers[i].thread = NULL;
+        workers[i].jobs = NULL;
+        workers[i].num_jobs = 0;
+        workers[i].max_jobs = 0;
+    }
+
+    num_workers = 0;
+
+    if (done_cond != NULL)
+        SDL_DestroyCond(done_cond);
+
+    if (cond != NULL)
+        SDL_DestroyCond(cond);
+
+    if (mutex != NULL)
+        SDL_DestroyMutex(mutex);
+
+    done_cond = NULL;
+    cond = NULL;
+    mutex = NULL;
+}
+
+/**
+ * Marks the result of a background job as ready for the thread that started it. Called by the job.
+ *
+ * @param handle A pointer to the JobHandle of the job.
+ *
+ * @return void
+ */
+void jobs_finish_handle(JobHandle *handle)
+{
+    SDL_AtomicSet(&handle->is_done, 1);
+}
+
+/**
+ * Gets the name of a background job in the trace captures, from its tag.
+ *
+ * @param tag The tag of the job.
+ *
+ * @return The name of the job.
+ */
+static const char *jobs_get_name(unsigned short tag)
+{
+    if (tag & JOB_TAG_ROUTE)
+        return "route job";
+    else if (tag & JOB_TAG_REGION)
+        return "region job";
+    else if (tag & JOB_TAG_GALAXY)
+        return "galaxy job";
+    else if (tag & JOB_TAG_UNIVERSE)
+        return "universe job";
+    else
+        return "job";
+}
+
+/**
+ * Gets the number of worker threads.
+ *
+ * @return The number of worker threads, 0 if jobs run on the threads that submit them.
+ */
+int jobs_get_num_workers(void)
+{
+    return num_workers;
+}
+
+/**
+ * Calculates the priority of a job from the distance of its position to the player, which is the
+ * distance to the camera or to the ship, whichever is nearer.
+ *
+ * @param position The position of the job.
+ * @param camera_position The position of the center of the camera.
+ * @param ship_position The position of the ship.
+ *
+ * @return The priority of the job. Lower runs first.
+ */
+float jobs_get_priority(Point position, Point camera_position, Point ship_position)
+{
+    double camera_distance = maths_distance_between_points(position.x, position.y, camera_position.x, camera_position.y);
+    double ship_distance = maths_distance_between_points(position.x, position.y, ship_position.x, ship_position.y);
+
+    return fmin(camera_distance, ship_distance);
+}
+
+/**
+ * Initializes the handle of a background job before it is submitted, with one reference for the thread
+ * that starts the job and one for the job. Each releases its reference with jobs_release_handle().
+ *
+ * @param handle A pointer to the JobHandle in the data of the job.
+ *
+ * @return void
+ */
+void jobs_init_handle(JobHandle *handle)
+{
+    SDL_AtomicSet(&handle->refcount, 2);
+    SDL_AtomicSet(&handle->is_cancelled, 0);
+    SDL_AtomicSet(&handle->is_done, 0);
+}
+
+/**
+ * Compares two background jobs.
+ *
+ * @param a A pointer to the first Job.
+ * @param b A pointer to the second Job.
+ *
+ * @return True if the first job runs before the second one, false otherwise.
+ */
+static bool jobs_is_before(const Job *a, const Job *b)
+{
+    if (a->priority != b->priority)
+        return a->priority < b->priority;
+
+    return (int)(a->order - b->order) < 0;
+}
+
+/**
+ * Checks whether the background job that runs on the current thread has been cancelled.
+ *
+ * @return True if the job has been cancelled, false otherwise or if no background job runs on the thread.
+ */
+bool jobs_is_cancelled(void)
+{
+    if (worker_id == 0)
+        return false;
+
+    JobWorker *worker = (JobWorker *)SDL_TLSGet(worker_id);
+
+    return worker != NULL && worker->job != NULL && SDL_AtomicGet(&worker->job->is_cancelled);
+}
+
+/**
+ * Checks whether a background job has been cancelled, through its handle or by its tag.
+ *
+ * @param handle A pointer to the JobHandle of the job.
+ *
+ * @return True if the job has been cancelled, false otherwise.
+ */
+bool jobs_is_handle_cancelled(JobHandle *handle)
+{
+    return SDL_AtomicGet(&handle->is_cancelled) || jobs_is_cancelled();
+}
+
+/**
+ * Checks whether the result of a background job is ready.
+ *
+ * @param handle A pointer to the JobHandle of the job.
+ *
+ * @return True if the job has finished its result, false otherwise.
+ */
+bool jobs_is_handle_done(JobHandle *handle)
+{
+    return SDL_AtomicGet(&handle->is_done);
+}
+
+/**
+ * Splits a range into parts, runs them on the worker threads and the calling thread, and returns
+ * once they have all run. The calling thread runs the first part, then takes the other parts back or
+ * helps with other parallel fors, and sleeps once the parts left are running on workers.
+ * It never runs background jobs while it waits.
+ *
+ * @param count The number of items, from 0 to count - 1.
+ * @param grain The minimum number of items in a part.
+ * @param function The function that runs the items from start to end - 1.
+ * @param data The data passed to the function.
+ *
+ * @return void
+ */
+void jobs_parallel_for(int count, int grain, void (*function)(void *data, int start, int end), void *data)
+{
+    if (count <= 0)
+        return;
+
+    if (grain < 1)
+        grain = 1;
+
+    if (count > grain * JOBS_MAX_RANGES)
+        grain = (count + JOBS_MAX_RANGES - 1) / JOBS_MAX_RANGES;
+
+    int num_ranges = (count + grain - 1) / grain;
+
+    if (num_workers == 0 || num_ranges == 1)
+    {
+        function(data, 0, count);
+        return;
+    }
+
+    JobWorker *worker = (JobWorker *)SDL_TLSGet(worker_id);
+
+    if (worker == NULL)
+        worker = &workers[JOBS_MAX_WORKERS];
+
+    JobRange ranges[JOBS_MAX_RANGES];
+    SDL_atomic_t pending;
+    SDL_AtomicSet(&pending, num_ranges - 1);
+
+    // Push the last part first, so that the calling thread takes the parts in order and workers steal from the end
+    for (int i = num_ranges - 1; i > 0; i--)
+    {
+        int end = (i + 1) * grain;
+
+        ranges[i] = (JobRange){.function = function,
+                               .data = data,
+                               .start = i * grain,
+                               .end = end < count ? end : count,
+                               .pending = &pending};
+
+        if (!jobs_push_range(worker, &ranges[i]))
+            jobs_run_range(&ranges[i]);
+    }
+
+    jobs_wake_workers();
+
+    function(data, 0, grain);
+
+    while (SDL_AtomicGet(&pending) > 0)
+    {
+        JobRange *range = jobs_take_range(worker);
+
+        if (range != NULL)
+        {
+            jobs_run_range(range);
+            continue;
+        }
+
+        SDL_LockMutex(mutex);
+
+        while (SDL_AtomicGet(&pending) > 0)
+            SDL_CondWait(done_cond, mutex);
+
+        SDL_UnlockMutex(mutex);
+    }
+}
+
+/**
+ * Removes the first job from the heap of a worker. The lock of the worker must be held.
+ *
+ * @param worker A pointer to the JobWorker.
+ *
+ * @return A pointer to the Job, or NULL if the heap is empty.
+ */
+static Job *jobs_pop_job(JobWorker *worker)
+{
+    if (worker->num_jobs == 0)
+        return NULL;
+
+    Job *job = worker->jobs[0];
+    worker->jobs[0] = worker->jobs[--worker->num_jobs];
+    jobs_sift_down(worker, 0);
+
+    return job;
+}
+
+/**
+ * Adds a part of a parallel for to the newest end of the deque of a worker.
+ *
+ * @param worker A pointer to the JobWorker.
+ * @param range A pointer to the JobRange.
+ *
+ * @return True if the part was added, false if the deque is full.
+ */
+static bool jobs_push_range(JobWorker *worker, JobRange *range)
+{
+    bool is_pushed = false;
+
+    SDL_AtomicLock(&worker->lock);
+
+    if (worker->bottom - worker->top < JOBS_DEQUE_SIZE)
+    {
+        worker->deque[worker->bottom++ & (JOBS_DEQUE_SIZE - 1)] = range;
+        is_pushed = true;
+    }
+
+    SDL_AtomicUnlock(&worker->lock);
+
+    return is_pushed;
+}
+
+/**
+ * Releases a reference to a background job.
+ *
+ * @param handle A pointer to the JobHandle of the job.
+ *
+ * @return True if it was the last reference, in which case the caller frees the data of the job.
+ */
+bool jobs_release_handle(JobHandle *handle)
+{
+    return SDL_AtomicDecRef(&handle->refcount);
+}
+
+/**
+ * Runs a part of a parallel for and marks it as finished.
+ *
+ * @param range A pointer to the JobRange. It belongs to the thread that waits for the parallel for.
+ *
+ * @return void
+ */
+static void jobs_run_range(JobRange *range)
+{
+    SDL_atomic_t *pending = range->pending;
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    range->function(range->data, range->start, range->end);
+
+    if (PROFILER_ON)
+        trace_add_span("parallel for", start, SDL_GetPerformanceCounter());
+
+    // The range must not be used after this, as the parallel for may return
+    if (SDL_AtomicAdd(pending, -1) == 1)
+    {
+        SDL_LockMutex(mutex);
+        SDL_CondBroadcast(done_cond);
+        SDL_UnlockMutex(mutex);
+    }
+}
+
+/**
+ * Runs the jobs of a worker thread: parts of parallel fors first, since a thread waits for them,
+ * then background jobs by priority. Sleeps when there is no work, and stops once there is none left
+ * after jobs_destroy().
+ *
+ * @param data A pointer to the JobWorker.
+ *
+ * @return 0
+ */
+static int jobs_run_worker(void *data)
+{
+    JobWorker *worker = data;
+
+    SDL_TLSSet(worker_id, worker, NULL);
+
+    if (PROFILER_ON)
+        trace_name_thread("worker");
+
+    while (true)
+    {
+        SDL_LockMutex(mutex);
+        unsigned int seen_wakeups = wakeups;
+        bool was_stopping = is_stopping;
+        SDL_UnlockMutex(mutex);
+
+        JobRange *range = jobs_take_range(worker);
+
+        if (range != NULL)
+        {
+            jobs_run_range(range);
+            continue;
+        }
+
+        Job *job = jobs_take_job(worker);
+
+        if (job != NULL)
+        {
+            Uint64 start = SDL_GetPerformanceCounter();
+
+            job->function(job->data);
+
+            if (PROFILER_ON)
+                trace_add_span(jobs_get_name(job->tag), start, SDL_GetPerformanceCounter());
+
+            SDL_AtomicLock(&worker->lock);
+            worker->job = NULL;
+            SDL_AtomicUnlock(&worker->lock);
+
+            free(job);
+            continue;
+        }
+
+        // The jobs queued before the job system was stopping have all run
+        if (was_stopping)
+            break;
+
+        SDL_LockMutex(mutex);
+
+        if (seen_wakeups == wakeups && !is_stopping)
+            SDL_CondWait(cond, mutex);
+
+        SDL_UnlockMutex(mutex);
+    }
+
+    return 0;
+}
+
+/**
+ * Moves a job down the heap of a worker until the heap order is restored. The lock of the worker must be held.
+ *
+ * @param worker A pointer to the JobWorker.
+ * @param index The index of the job in the heap.
+ *
+ * @return void
+ */
+static void jobs_sift_down(JobWorker *worker, int index)
+{
+    Job **jobs = worker->jobs;
+
+    while (true)
+    {
+        int first = index;
+        int left = 2 * index + 1;
+        int right = left + 1;
+
+        if (left < worker->num_jobs && jobs_is_before(jobs[left], jobs[first]))
+            first = left;
+
+        if (right < worker->num_jobs && jobs_is_before(jobs[right], jobs[first]))
+            first = right;
+
+        if (first == index)
+            return;
+
+        Job *job = jobs[index];
+        jobs[index] = jobs[first];
+        jobs[first] = job;
+        index = first;
+    }
+}
+
+/**
+ * Moves a job up the heap of a worker until the heap order is restored. The lock of the worker must be held.
+ *
+ * @param worker A pointer to the JobWorker.
+ * @param index The index of the job in the heap.
+ *
+ * @return void
+ */
+static void jobs_sift_up(JobWorker *worker, int index)
+{
+    Job **jobs = worker->jobs;
+
+    while (index > 0)
+    {
+        int parent = (index - 1) / 2;
+
+        if (!jobs_is_before(jobs[index], jobs[parent]))
+            return;
+
+        Job *job = jobs[index];
+        jobs[index] = jobs[parent];
+        jobs[parent] = job;
+        index = parent;
+    }
+}
+
+/**
+ * Queues a background job, run by the worker threads in the order of priority. A worker queues the job
+ * in its own heap; Other threads spread their jobs over the heaps of the workers.
+ * Without worker threads, the job runs on the calling thread.
+ *
+ * @param function The function of the job. It frees its data, even when the job is cancelled.
+ * @param data The data passed to the function.
+ * @param tag The tag that cancels the job, or JOB_TAG_NONE.
+ * @param priority The priority of the job, from jobs_get_priority(). Lower runs first.
+ *
+ * @return void
+ */
+void jobs_submit(void (*function)(void *data), void *data, unsigned short tag, float priority)
+{
+    if (mutex == NULL)
+    {
+        function(data);
+        return;
+    }
+
+    Job *job = (Job *)malloc(sizeof(Job));
+
+    if (job == NULL)
+    {
+        fprintf(stderr, "Error: Could not allocate memory for job.\n");
+        function(data);
+        return;
+    }
+
+    job->function = function;
+    job->data = data;
+    job->priority = priority;
+    job->tag = tag;
+    job->order = (unsigned int)SDL_AtomicAdd(&next_order, 1);
+    SDL_AtomicSet(&job->is_cancelled, 0);
+
+    JobWorker *worker = (JobWorker *)SDL_TLSGet(worker_id);
+
+    if (worker == NULL)
+        worker = &workers[(unsigned int)SDL_AtomicAdd(&next_worker, 1) % num_workers];
+
+    SDL_AtomicLock(&worker->lock);
+
+    if (worker->num_jobs == worker->max_jobs)
+    {
+        Job **new_jobs = (Job **)realloc(worker->jobs, 2 * worker->max_jobs * sizeof(Job *));
+
+        if (new_jobs == NULL)
+        {
+            SDL_AtomicUnlock(&worker->lock);
+            fprintf(stderr, "Error: Could not reallocate memory for job queue.\n");
+            free(job);
+            function(data);
+            return;
+        }
+
+        worker->jobs = new_jobs;
+        worker->max_jobs *= 2;
+    }
+
+    worker->jobs[worker->num_jobs] = job;
+    jobs_sift_up(worker, worker->num_jobs++);
+
+    SDL_AtomicUnlock(&worker->lock);
+
+    SDL_LockMutex(mutex);
+    wakeups++;
+    SDL_CondSignal(cond);
+    SDL_UnlockMutex(mutex);
+}
+
+/**
+ * Takes the background job that runs first among the heaps of the workers, and marks it as
+ * being run by a worker. The heap of the worker comes first, so that it keeps its jobs
+ * of the same priority; The jobs of other heaps are stolen.
+ *
+ * @param worker A pointer to the JobWorker of the current thread.
+ *
+ * @return A pointer to the Job, or NULL if there is none.
+ */
+static Job *jobs_take_job(JobWorker *worker)
+{
+    JobWorker *victim = NULL;
+    Job first; // Copy of the first job found, as the job itself may be taken once its heap is unlocked
+
+    // Find the heap whose first job runs first
+    for (int i = -1; i < num_workers; i++)
+    {
+        JobWorker *other = i < 0 ? worker : &workers[i];
+
+        if (i >= 0 && other == worker)
+            continue;
+
+        SDL_AtomicLock(&other->lock);
+
+        if (other->num_jobs > 0 && (victim == NULL || jobs_is_before(other->jobs[0], &first)))
+        {
+            victim = other;
+            first = *other->jobs[0];
+        }
+
+        SDL_AtomicUnlock(&other->lock);
+    }
+
+    if (victim == NULL)
+        return NULL;
+
+    // The first job may have been taken meanwhile; The next one of the same heap runs instead
+    SDL_AtomicLock(&victim->lock);
+    Job *job = jobs_pop_job(victim);
+    SDL_AtomicUnlock(&victim->lock);
+
+    if (job == NULL && victim != worker)
+    {
+        SDL_AtomicLock(&worker->lock);
+        job = jobs_pop_job(worker);
+        SDL_AtomicUnlock(&worker->lock);
+    }
+
+    if (job != NULL)
+    {
+        SDL_AtomicLock(&worker->lock);
+        worker->job = job;
+        SDL_AtomicUnlock(&worker->lock);
+    }
+
+    return job;
+}
+
+/**
+ * Takes the newest part of a parallel for from the deque of a worker, or steals the oldest part
+ * from another deque if it is empty.
+ *
+ * @param worker A pointer to the JobWorker of the current thread.
+ *
+ * @return A pointer to the JobRange, or NULL if there is none.
+ */
+static JobRange *jobs_take_range(JobWorker *worker)
+{
+    JobRange *range = NULL;
+
+    SDL_AtomicLock(&worker->lock);
+
+    if (worker->bottom != worker->top)
+        range = worker->deque[--worker->bottom & (JOBS_DEQUE_SIZE - 1)];
+
+    SDL_AtomicUnlock(&worker->lock);
+
+    for (int i = 0; range == NULL && i <= num_workers; i++)
+    {
+        JobWorker *victim = i < num_workers ? &workers[i] : &workers[JOBS_MAX_WORKERS];
+
+        if (victim == worker)
+            continue;
+
+        SDL_AtomicLock(&victim->lock);
+
+        if (victim->bottom != victim->top)
+            range = victim->deque[victim->top++ & (JOBS_DEQUE_SIZE - 1)];
+
+        SDL_AtomicUnlock(&victim->lock);
+    }
+
+    return range;
+}
+
+/**
+ * Wakes the sleeping workers, after parts of a parallel for were added.
+ *
+ * @return void
+ */
+static void jobs_wake_workers(void)
+{
+    SDL_LockMutex(mutex);
+    wakeups++;
+    SDL_CondBroadcast(cond);
+    SDL_UnlockMutex(mutex);
+}
@@ -21,6 +21,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include <stdbool.h>
 
 #include <SDL2/SDL.h>
@@ -38,24 +39,59 @@ SDL_Renderer *renderer = NULL;
 SDL_Color colors[COLOR_COUNT];
 
 // External function prototypes
-void console_draw_fps(unsigned int fps, const Camera *);
-void console_measure_fps(GameState *, unsigned int *last_time, unsigned int *frame_count);
+void benchmark_begin_frame(void);
+bool benchmark_end_frame(void);
+void benchmark_end_stage(unsigned short stage);
+void benchmark_start(unsigned int num_frames, const char *path);
+bool benchmark_stop(void);
 void controls_create_table(GameState *, const Camera *);
-void controls_run_state(GameState *, InputState *, bool is_game_started, const NavigationState *, Bstar *bstars, Gstar *menustars, const Camera *);
-void events_loop(GameState *, InputState *, GameEvents *, NavigationState *, const Camera *);
-void events_set_cursor(GameState *, InputState *);
+bool counters_write(const char *path, const NavigationState *);
+void galaxies_benchmark(int runs);
+void galaxies_clear_gstars_jobs(void);
+void galaxies_set_async(bool async);
 Ship game_create_ship(int radius, Point, long double scale);
 void game_reset(GameState *, InputState *, GameEvents *, NavigationState *, Bstar *bstars, Ship *, Camera *, bool reset);
-void game_run_map_state(GameState *, InputState *, GameEvents *, NavigationState *, Bstar *bstars, Ship *, Camera *);
-void game_run_navigate_state(GameState *, InputState *, GameEvents *, NavigationState *, Bstar *bstars, Ship *, Camera *);
-void game_run_universe_state(GameState *, InputState *, GameEvents *, NavigationState *, Ship *, Camera *);
 void gfx_create_default_colors(void);
+void itinerary_benchmark(const NavigationState *, int runs);
+void itinerary_clear(void);
+void itinerary_set_async(bool async);
+bool jobs_create(void);
+void jobs_destroy(void);
 void menu_create(GameState *, NavigationState, Gstar *menustars);
-void menu_run_state(GameState *, InputState *, bool is_game_started, const NavigationState *, Bstar *bstars, Gstar *menustars, Camera *);
+void profiler_begin_scope(unsigned short scope);
+bool profiler_create(void);
+void profiler_end_scope(unsigned short scope);
+bool replay_begin_frame(void);
+void render_draw_frame(void);
+void render_end_frame(void);
+bool render_wait_frame(Uint32 timeout);
+void replay_end_frame(const GameState *, const InputState *, const Ship *);
+bool replay_is_playing(void);
+int replay_poll_event(SDL_Event *);
+bool replay_start_playback(const char *path);
+bool replay_start_recording(const char *path);
+void replay_stop(void);
+void route_benchmark(const NavigationState *, int runs);
+void route_cancel_job(void);
+void route_clear_cache(void);
+void route_set_async(bool async);
 void sdl_cleanup(SDL_Window *);
-bool sdl_initialize(SDL_Window *);
+bool sdl_initialize(SDL_Window *, unsigned short backend);
 bool sdl_ttf_load_fonts(SDL_Window *);
+bool simulation_is_running(void);
+void simulation_push_event(const SDL_Event *);
+void simulation_run_frame(Simulation *, int (*poll_event)(SDL_Event *));
+bool simulation_start(Simulation *);
+void simulation_stop(void);
+void stars_benchmark_prefetch(const NavigationState *, int runs);
+void stars_clear_populations(void);
+void stars_clear_prefetch(void);
+void stars_set_async(bool async);
+void trace_destroy(void);
+void trace_name_thread(const char *name);
+bool trace_start(const char *file_path, int first_frame, int frames);
 void utils_cleanup_resources(GameState *, InputState *, NavigationState *, Bstar *bstars, Ship *);
+bool utils_parse_int(const char *text, int min, int max, int *value);
 
 int main(int argc, char *argv[])
 {
@@ -66,10 +102,91 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    // Parse command-line options
+    char *record_path = NULL;
+    char *replay_path = NULL;
+    char *benchmark_path = NULL;
+    char *hash_path = NULL;
+    int benchmark_frames = BENCHMARK_FRAMES;
+    int benchmark_routes = 0;
+    int benchmark_galaxies = 0;
+    int benchmark_prefetch = 0;
+    char *trace_path = NULL;
+    int trace_from = 0;
+    int trace_frames = TRACE_FRAMES;
+    char *counters_path = NULL;
+
+    // Every option takes a value; Other arguments are ignored
+    for (int i = 1; i < argc; i++)
+    {
+        char *option = argv[i];
+        char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        bool is_valid = true;
+
+        if (strcmp(option, "--record") == 0)
+            record_path = value;
+        else if (strcmp(option, "--replay") == 0)
+            replay_path = value;
+        else if (strcmp(option, "--benchmark") == 0)
+            benchmark_path = value;
+        else if (strcmp(option, "--frames") == 0)
+            is_valid = utils_parse_int(value, 1, INT_MAX, &benchmark_frames);
+        else if (strcmp(option, "--hash") == 0)
+            hash_path = value;
+        else if (strcmp(option, "--benchmark-routes") == 0)
+            is_valid = utils_parse_int(value, 1, INT_MAX, &benchmark_routes);
+        else if (strcmp(option, "--benchmark-galaxies") == 0)
+            is_valid = utils_parse_int(value, 1, INT_MAX, &benchmark_galaxies);
+        else if (strcmp(option, "--benchmark-prefetch") == 0)
+            is_valid = utils_parse_int(value, 1, INT_MAX, &benchmark_prefetch);
+        else if (strcmp(option, "--trace") == 0)
+            trace_path = value;
+        else if (strcmp(option, "--trace-from") == 0)
+            is_valid = utils_parse_int(value, 0, INT_MAX, &trace_from);
+        else if (strcmp(option, "--trace-frames") == 0)
+            is_valid = utils_parse_int(value, 1, INT_MAX, &trace_frames);
+        else if (strcmp(option, "--counters") == 0)
+            counters_path = value;
+        else
+            continue;
+
+        if (value == NULL)
+        {
+            fprintf(stderr, "Error: Missing value for %s.\n", option);
+            return 1;
+        }
+
+        if (!is_valid)
+        {
+            fprintf(stderr, "Error: Invalid value for %s: %s.\n", option, value);
+            return 1;
+        }
+
+        i++;
+    }
+
+    // Replays run headless, without vsync or frame delay
+    // Benchmarks play a scenario back with the software renderer, without a window
+    unsigned short backend = BACKEND_WINDOW;
+
+    if (benchmark_path != NULL)
+    {
+        replay_path = benchmark_path;
+        backend = BACKEND_OFFSCREEN;
+    }
+    else if (replay_path != NULL)
+        backend = BACKEND_HIDDEN;
+    else if (benchmark_routes > 0 || benchmark_galaxies > 0 || benchmark_prefetch > 0)
+        backend = BACKEND_OFFSCREEN;
+
+    // The offscreen framebuffer is created at the display size of the scenario
+    if (benchmark_path != NULL && !replay_start_playback(replay_path))
+        return 1;
+
     // Initialize SDL
     SDL_Window *window = NULL;
 
-    if (!sdl_initialize(window))
+    if (!sdl_initialize(window, backend))
     {
         fprintf(stderr, "Error: could not initialize SDL.\n");
         return 1;
@@ -85,6 +202,43 @@ int main(int argc, char *argv[])
 
     gfx_create_default_colors();
 
+    // Profile the threads started from here on
+    if (PROFILER_ON)
+    {
+        profiler_create();
+        trace_name_thread("main");
+    }
+
+    // Start the worker threads; Without them, jobs run on the thread that submits them
+    jobs_create();
+
+    // Start recording or playback before generation, which depends on the display size
+    if (replay_path != NULL && backend != BACKEND_OFFSCREEN && !replay_start_playback(replay_path))
+    {
+        sdl_cleanup(window);
+        return 1;
+    }
+    else if (record_path != NULL && !replay_start_recording(record_path))
+    {
+        sdl_cleanup(window);
+        return 1;
+    }
+
+    // Events come from the replay module while recording or playing back
+    int (*poll_event)(SDL_Event *) = SDL_PollEvent;
+
+    if (replay_path != NULL || record_path != NULL)
+    {
+        poll_event = replay_poll_event;
+
+        // Plan itineraries and routes and generate stars and gstars synchronously,
+        // so that they are ready on the same frame in the recording and the replay
+        itinerary_set_async(false);
+        route_set_async(false);
+        galaxies_set_async(false);
+        stars_set_async(false);
+    }
+
     // Game variables
     GameState game_state;
     InputState input_state;
@@ -121,16 +275,94 @@ int main(int argc, char *argv[])
     // Set time keeping variables
     unsigned int start_time;
     unsigned int end_time;
-    unsigned int last_time = SDL_GetTicks();
-    unsigned int frame_count = 0;
 
-    // Main loop
-    while (game_state.state != QUIT)
+    Simulation simulation = {.game_state = &game_state,
+                             .input_state = &input_state,
+                             .game_events = &game_events,
+                             .nav_state = &nav_state,
+                             .bstars = bstars,
+                             .menustars = menustars,
+                             .ship = &ship,
+                             .camera = &camera,
+                             .last_time = SDL_GetTicks(),
+                             .frame_count = 0};
+
+    if (benchmark_path != NULL)
+        benchmark_start(benchmark_frames, hash_path);
+
+    // Capture a trace of the requested window of frames
+    if (PROFILER_ON && trace_path != NULL)
+        trace_start(trace_path, trace_from, trace_frames);
+
+    // Plan routes through the starting galaxy and across the universe, then exit
+    if (benchmark_routes > 0)
+    {
+        route_benchmark(&nav_state, benchmark_routes);
+        itinerary_benchmark(&nav_state, benchmark_routes);
+        game_state.state = QUIT;
+    }
+
+    // Create the galaxies of random universe regions serially and in parallel, then exit
+    if (benchmark_galaxies > 0)
+    {
+        galaxies_benchmark(benchmark_galaxies);
+        game_state.state = QUIT;
+    }
+
+    // Shift the star region along random flights through the starting galaxy, with and without prefetch, then exit
+    if (benchmark_prefetch > 0)
+    {
+        stars_benchmark_prefetch(&nav_state, benchmark_prefetch);
+        game_state.state = QUIT;
+    }
+
+    // Run the simulation on its own thread, except in replays, which run frame by frame
+    bool is_threaded = SIMULATION_THREAD && replay_path == NULL && record_path == NULL &&
+                       game_state.state != QUIT && simulation_start(&simulation);
+
+    // Render loop: forward input events to the simulation and draw the latest frame it recorded
+    while (is_threaded && simulation_is_running())
+    {
+        SDL_Event event;
+
+        while (SDL_PollEvent(&event))
+            simulation_push_event(&event);
+
+        if (render_wait_frame(1000 / FPS))
+        {
+            // Set background color
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+
+            // Clear the renderer
+            SDL_RenderClear(renderer);
+
+            PROFILER_BEGIN(PROFILER_SCOPE_RENDER);
+            render_draw_frame();
+            PROFILER_END(PROFILER_SCOPE_RENDER);
+
+            // Switch buffers, display back buffer
+            PROFILER_BEGIN(PROFILER_SCOPE_PRESENT);
+            SDL_RenderPresent(renderer);
+            PROFILER_END(PROFILER_SCOPE_PRESENT);
+        }
+    }
+
+    if (is_threaded)
+        simulation_stop();
+
+    // Main loop, when the simulation runs on this thread
+    while (!is_threaded && game_state.state != QUIT)
     {
         start_time = SDL_GetTicks();
 
-        // Process events
-        events_loop(&game_state, &input_state, &game_events, &nav_state, &camera);
+        // Stop at the end of the replay
+        if (!replay_begin_frame())
+            break;
+
+        benchmark_begin_frame();
+
+        // Process events, update the game and record draw commands
+        simulation_run_frame(&simulation, poll_event);
 
         // Set background color
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
@@ -138,43 +370,27 @@ int main(int argc, char *argv[])
         // Clear the renderer
         SDL_RenderClear(renderer);
 
-        switch (game_state.state)
-        {
-        case MENU:
-            menu_run_state(&game_state, &input_state, game_events.is_game_started, &nav_state, bstars, menustars, &camera);
-            break;
-        case NAVIGATE:
-            game_run_navigate_state(&game_state, &input_state, &game_events, &nav_state, bstars, &ship, &camera);
-            break;
-        case MAP:
-            game_run_map_state(&game_state, &input_state, &game_events, &nav_state, bstars, &ship, &camera);
-            break;
-        case UNIVERSE:
-            game_run_universe_state(&game_state, &input_state, &game_events, &nav_state, &ship, &camera);
-            break;
-        case NEW:
-            game_reset(&game_state, &input_state, &game_events, &nav_state, bstars, &ship, &camera, true);
-            break;
-        case CONTROLS:
-            controls_run_state(&game_state, &input_state, game_events.is_game_started, &nav_state, bstars, menustars, &camera);
-            break;
-        default:
-            menu_run_state(&game_state, &input_state, game_events.is_game_started, &nav_state, bstars, menustars, &camera);
-            break;
-        }
+        // Draw the commands of the frame
+        PROFILER_BEGIN(PROFILER_SCOPE_RENDER);
+        render_end_frame();
+        PROFILER_END(PROFILER_SCOPE_RENDER);
 
-        // Set mouse cursor
-        events_set_cursor(&game_state, &input_state);
+        benchmark_end_stage(BENCHMARK_STAGE_RENDER);
 
-        // Draw FPS
-        if (input_state.fps_on && FPS_ON)
-        {
-            console_measure_fps(&game_state, &last_time, &frame_count);
-            console_draw_fps(game_state.fps, &camera);
-        }
+        replay_end_frame(&game_state, &input_state, &ship);
+
+        // Stop after the requested number of frames
+        if (!benchmark_end_frame())
+            break;
+
+        // Run replays as fast as possible
+        if (replay_is_playing())
+            continue;
 
         // Switch buffers, display back buffer
+        PROFILER_BEGIN(PROFILER_SCOPE_PRESENT);
         SDL_RenderPresent(renderer);
+        PROFILER_END(PROFILER_SCOPE_PRESENT);
 
         // Get end time for this frame
         end_time = SDL_GetTicks();
@@ -184,10 +400,27 @@ int main(int argc, char *argv[])
             SDL_Delay((1000 / FPS) - (end_time - start_time));
     }
 
+    // Report timings and hash the last frame before the renderer is destroyed
+    bool benchmark_succeeded = benchmark_stop();
+
+    replay_stop();
+    route_cancel_job();
+    jobs_destroy();
+    trace_destroy();
+    stars_clear_prefetch();
+    stars_clear_populations();
+    galaxies_clear_gstars_jobs();
+    route_clear_cache();
+    itinerary_clear();
+
+    // Write the counters of the session while the hash tables still exist
+    if (PROFILER_ON && counters_path != NULL)
+        counters_write(counters_path, &nav_state);
+
     utils_cleanup_resources(&game_state, &input_state, &nav_state, bstars, &ship);
 
     // Close SDL
     sdl_cleanup(window);
 
-    return 0;
+    return benchmark_succeeded ? 0 : 1;
 }
\ No newline at end of file
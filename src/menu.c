@@ -38,6 +38,7 @@ void menu_create(GameState *game_state, NavigationState nav_state, Gstar *menust
 
     // Create logo
     menu_create_logo(&game_state->logo);
+    compositor_invalidate(COMPOSITOR_MENU);
 
     Point menu_galaxy_position = {.x = -140000, .y = -70000};
     Galaxy *menu_galaxy = galaxies_get_entry(nav_state.galaxies, menu_galaxy_position);
@@ -64,6 +65,7 @@ static void menu_create_logo(MenuButton *logo)
     // Create a texture from the text
     SDL_Surface *logo_surface = TTF_RenderText_Blended(fonts[LOGO_FONT_SIZE_32], logo->text, colors[COLOR_PLANET_1]);
     SDL_Texture *logo_texture = SDL_CreateTextureFromSurface(renderer, logo_surface);
+    COUNTERS_ADD(COUNTER_TEXT_TEXTURES, 1);
     logo->text_texture = logo_texture;
 
     // Set the position of the text within the button
@@ -84,15 +86,15 @@ static void menu_create_logo(MenuButton *logo)
  */
 static void menu_draw_footer(const Camera *camera)
 {
+    unsigned short previous_layer = render_set_layer(RENDER_LAYER_UI);
+
     int margin = 40;
 
     char footer_text[] = "Gravity v1.4.3 - Copyright \xA9 2020 Yannis Maragos";
-    SDL_Surface *footer_text_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_15], footer_text, colors[COLOR_WHITE_100]);
-    SDL_Texture *footer_text_texture = SDL_CreateTextureFromSurface(renderer, footer_text_surface);
-    SDL_Rect footer_text_rect = {camera->w - margin - footer_text_surface->w, camera->h - margin - footer_text_surface->h, footer_text_surface->w, footer_text_surface->h};
-    SDL_RenderCopy(renderer, footer_text_texture, NULL, &footer_text_rect);
-    SDL_FreeSurface(footer_text_surface);
-    SDL_DestroyTexture(footer_text_texture);
+    TextLabel *footer_text_label = text_get_label(footer_text, FONT_SIZE_15, colors[COLOR_WHITE_100]);
+    text_draw_label(footer_text_label, camera->w - margin - footer_text_label->w, camera->h - margin - footer_text_label->h);
+
+    render_set_layer(previous_layer);
 }
 
 /**
@@ -106,6 +108,8 @@ static void menu_draw_footer(const Camera *camera)
  */
 void menu_draw_menu(GameState *game_state, InputState *input_state, bool is_game_started)
 {
+    unsigned short previous_layer = render_set_layer(RENDER_LAYER_UI);
+
     int num_buttons = 0;
 
     for (int i = 0; i < MENU_BUTTON_COUNT; i++)
@@ -130,26 +134,50 @@ void menu_draw_menu(GameState *game_state, InputState *input_state, bool is_game
         if (game_state->menu[i].disabled)
             continue;
 
-        if (i == input_state->selected_menu_button_index)
-            SDL_SetRenderDrawColor(renderer, 255, 255, 255, 40);
-        else
-            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
-
         // Set the position of the button
         game_state->menu[i].rect.x = 50;
         game_state->menu[i].rect.y = 200 + 50 * num_buttons;
 
-        SDL_RenderFillRect(renderer, &game_state->menu[i].rect);
-
         // Set the position of the text within the button
         game_state->menu[i].texture_rect.x = game_state->menu[i].rect.x + (game_state->menu[i].rect.w - game_state->menu[i].texture_rect.w) / 2;
         game_state->menu[i].texture_rect.y = game_state->menu[i].rect.y + (game_state->menu[i].rect.h - game_state->menu[i].texture_rect.h) / 2;
 
-        // Render the text texture onto the button
-        SDL_RenderCopy(renderer, game_state->menu[i].text_texture, NULL, &game_state->menu[i].texture_rect);
-
         num_buttons++;
     }
+
+    // Buttons are redrawn only when the selection or a button changes
+    Uint32 key = compositor_hash(0, &input_state->selected_menu_button_index, sizeof(input_state->selected_menu_button_index));
+
+    for (int i = 0; i < MENU_BUTTON_COUNT; i++)
+    {
+        key = compositor_hash(key, &game_state->menu[i].disabled, sizeof(game_state->menu[i].disabled));
+        key = compositor_hash(key, &game_state->menu[i].text_texture, sizeof(game_state->menu[i].text_texture));
+        key = compositor_hash(key, &game_state->menu[i].rect, sizeof(game_state->menu[i].rect));
+        key = compositor_hash(key, &game_state->menu[i].texture_rect, sizeof(game_state->menu[i].texture_rect));
+    }
+
+    if (compositor_begin_layer(COMPOSITOR_MENU, key))
+    {
+        for (int i = 0; i < MENU_BUTTON_COUNT; i++)
+        {
+            if (game_state->menu[i].disabled)
+                continue;
+
+            if (i == input_state->selected_menu_button_index)
+                render_set_draw_color(255, 255, 255, 40);
+            else
+                render_set_draw_color(0, 0, 0, 0);
+
+            render_fill_rect(&game_state->menu[i].rect);
+
+            // Render the text texture onto the button
+            render_copy(game_state->menu[i].text_texture, NULL, &game_state->menu[i].texture_rect);
+        }
+    }
+
+    compositor_end_layer(COMPOSITOR_MENU);
+
+    render_set_layer(previous_layer);
 }
 
 /**
@@ -254,6 +282,7 @@ static void menu_populate_menu_array(MenuButton menu[])
         // Create a texture from the button text
         SDL_Surface *text_surface = TTF_RenderText_Blended(fonts[FONT_SIZE_15], menu[i].text, colors[COLOR_WHITE_180]);
         SDL_Texture *text_texture = SDL_CreateTextureFromSurface(renderer, text_surface);
+        COUNTERS_ADD(COUNTER_TEXT_TEXTURES, 1);
         menu[i].text_texture = text_texture;
         menu[i].texture_rect.x = 0;
         menu[i].texture_rect.y = 0;
@@ -284,9 +313,9 @@ void menu_run_state(GameState *game_state, InputState *input_state, bool is_game
     gfx_update_bstars_position(game_state->state, input_state->camera_on, nav_state, bstars, camera, speed, 0);
 
     // Draw logo
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
-    SDL_RenderFillRect(renderer, &game_state->logo.rect);
-    SDL_RenderCopy(renderer, game_state->logo.text_texture, NULL, &game_state->logo.texture_rect);
+    render_set_draw_color(0, 0, 0, 0);
+    render_fill_rect(&game_state->logo.rect);
+    render_copy(game_state->logo.text_texture, NULL, &game_state->logo.texture_rect);
 
     // Draw menu
     menu_draw_menu(game_state, input_state, is_game_started);
@@ -0,0 +1,112 @@
+/*
+ * origin.c
+ */
+
+#include <stdint.h>
+#include <math.h>
+#include <stdbool.h>
+
+#include <SDL2/SDL.h>
+
+#include "../include/constants.h"
+#include "../include/enums.h"
+#include "../include/structs.h"
+#include "../include/origin.h"
+
+/**
+ * Converts a position in the local frame to an absolute galaxy position.
+ *
+ * @param origin A pointer to the current Origin object.
+ * @param local_position A LocalPoint relative to the origin.
+ *
+ * @return The absolute position as a Point.
+ */
+Point origin_get_absolute_position(const Origin *origin, LocalPoint local_position)
+{
+    Point position;
+    position.x = (double)origin->section_x * ORIGIN_SECTION_SIZE + (double)local_position.x;
+    position.y = (double)origin->section_y * ORIGIN_SECTION_SIZE + (double)local_position.y;
+
+    return position;
+}
+
+/**
+ * Converts an absolute galaxy position to a position in the local frame.
+ *
+ * @param origin A pointer to the current Origin object.
+ * @param position The absolute position to convert.
+ *
+ * @return The position relative to the origin as a LocalPoint.
+ */
+LocalPoint origin_get_local_position(const Origin *origin, Point position)
+{
+    LocalPoint local_position;
+    local_position.x = (float)(position.x - (double)origin->section_x * ORIGIN_SECTION_SIZE);
+    local_position.y = (float)(position.y - (double)origin->section_y * ORIGIN_SECTION_SIZE);
+
+    return local_position;
+}
+
+/**
+ * Moves the origin by whole sections when a local position drifts further than
+ * ORIGIN_REBASE_DISTANCE from it. The local position is shifted by the same amount,
+ * so that its absolute position does not change.
+ *
+ * @param origin A pointer to the current Origin object.
+ * @param local_position A pointer to the LocalPoint that triggers the rebase.
+ *
+ * @return True if the origin was moved, false otherwise.
+ */
+bool origin_rebase(Origin *origin, LocalPoint *local_position)
+{
+    if (fabsf(local_position->x) <= ORIGIN_REBASE_DISTANCE && fabsf(local_position->y) <= ORIGIN_REBASE_DISTANCE)
+        return false;
+
+    int64_t shift_x = (int64_t)floor((double)local_position->x / ORIGIN_SECTION_SIZE + 0.5);
+    int64_t shift_y = (int64_t)floor((double)local_position->y / ORIGIN_SECTION_SIZE + 0.5);
+
+    origin->section_x += shift_x;
+    origin->section_y += shift_y;
+
+    // Shifting by whole sections is exact, so no precision is lost here
+    local_position->x -= (float)(shift_x * ORIGIN_SECTION_SIZE);
+    local_position->y -= (float)(shift_y * ORIGIN_SECTION_SIZE);
+
+    return true;
+}
+
+/**
+ * Places the origin at the section that is nearest to the given absolute position.
+ *
+ * @param origin A pointer to the Origin object to reset.
+ * @param position The absolute position around which to center the local frame.
+ *
+ * @return void
+ */
+void origin_reset(Origin *origin, Point position)
+{
+    origin->section_x = (int64_t)floor(position.x / ORIGIN_SECTION_SIZE + 0.5);
+    origin->section_y = (int64_t)floor(position.y / ORIGIN_SECTION_SIZE + 0.5);
+}
+
+/**
+ * Keeps the local frame of the ship in sync with its absolute position.
+ * Absolute positions may be written outside the local frame (collisions, galaxy switch, reset),
+ * in which case the origin is moved to the new position and the local position is recalculated.
+ *
+ * @param origin A pointer to the current Origin object.
+ * @param ship A pointer to the ship to sync.
+ *
+ * @return void
+ */
+void origin_sync_ship(Origin *origin, Ship *ship)
+{
+    if (maths_points_equal(ship->position, origin_get_absolute_position(origin, ship->local_position)))
+        return;
+
+    origin_reset(origin, ship->position);
+    ship->local_position = origin_get_local_position(origin, ship->position);
+
+    // Snap absolute position to the local frame so that both agree on the next frame
+    ship->position = origin_get_absolute_position(origin, ship->local_position);
+}
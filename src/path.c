@@ -0,0 +1,465 @@
+/*
+ * path.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <stdbool.h>
+
+#include <SDL2/SDL.h>
+
+#include "../include/constants.h"
+#include "../include/enums.h"
+#include "../include/structs.h"
+#include "../include/path.h"
+
+// Static function prototypes
+static double path_box_distance(const PathBox *, Point);
+static bool path_build_boxes(WaypointPath *);
+static int path_find_visible_segment(const WaypointPath *, int node, int first_leaf, int num_leaves, Point min, Point max, bool is_first);
+static void path_find_nearest(const WaypointPath *, int node, int first_leaf, int num_leaves, Point, int first_segment, double *min_distance, int *segment);
+static double path_segment_distance(const WaypointPath *, int segment, Point, double *t);
+static void path_update_box(WaypointPath *, int segment);
+
+/**
+ * Adds a point at the end of a path. Memory grows by doubling, so adding n points costs O(n) in total.
+ *
+ * @param path A pointer to the WaypointPath.
+ * @param type The type of the point.
+ * @param position The position of the point.
+ *
+ * @return True if the point was added, false if memory could not be allocated.
+ */
+bool path_add_point(WaypointPath *path, unsigned short type, Point position)
+{
+    if (path->num_points >= path->max_points)
+    {
+        int max_points = path->max_points > 0 ? 2 * path->max_points : 2;
+        PathPoint *points = realloc(path->points, max_points * sizeof(PathPoint));
+
+        if (points != NULL)
+            path->points = points;
+
+        double *lengths = realloc(path->lengths, max_points * sizeof(double));
+
+        if (lengths != NULL)
+            path->lengths = lengths;
+
+        if (points == NULL || lengths == NULL)
+        {
+            fprintf(stderr, "Error: Could not allocate memory for waypoint path.\n");
+            return false;
+        }
+
+        path->max_points = max_points;
+    }
+
+    int index = path->num_points++;
+
+    path->points[index] = (PathPoint){.type = type, .position = position};
+    path->lengths[index] = 0;
+
+    if (index == 0)
+        return true;
+
+    Point previous = path->points[index - 1].position;
+    path->lengths[index] = path->lengths[index - 1] + hypot(position.x - previous.x, position.y - previous.y);
+
+    // The tree doubles when it is full
+    if (index > path->num_leaves)
+        return path_build_boxes(path);
+
+    path_update_box(path, index - 1);
+
+    return true;
+}
+
+/**
+ * Returns the distance from a point to a bounding box.
+ *
+ * @param box A pointer to the PathBox.
+ * @param position The point.
+ *
+ * @return The distance, 0 if the point is inside the box, or INFINITY if the box is empty.
+ */
+static double path_box_distance(const PathBox *box, Point position)
+{
+    if (box->min.x > box->max.x)
+        return INFINITY;
+
+    double dx = fmax(fmax(box->min.x - position.x, position.x - box->max.x), 0);
+    double dy = fmax(fmax(box->min.y - position.y, position.y - box->max.y), 0);
+
+    return hypot(dx, dy);
+}
+
+/**
+ * Rebuilds the bounding box tree of a path, with enough leaves for all its segments.
+ *
+ * @param path A pointer to the WaypointPath.
+ *
+ * @return True if the tree was built, false if memory could not be allocated.
+ */
+static bool path_build_boxes(WaypointPath *path)
+{
+    int num_segments = path->num_points - 1;
+    int num_leaves = path->num_leaves > 0 ? path->num_leaves : 1;
+
+    while (num_leaves < num_segments)
+        num_leaves *= 2;
+
+    if (num_leaves != path->num_leaves)
+    {
+        PathBox *boxes = realloc(path->boxes, 2 * num_leaves * sizeof(PathBox));
+
+        if (boxes == NULL)
+        {
+            fprintf(stderr, "Error: Could not allocate memory for waypoint path boxes.\n");
+            return false;
+        }
+
+        path->boxes = boxes;
+        path->num_leaves = num_leaves;
+    }
+
+    for (int i = 0; i < num_leaves; i++)
+    {
+        PathBox *box = &path->boxes[num_leaves + i];
+
+        if (i < num_segments)
+        {
+            Point a = path->points[i].position;
+            Point b = path->points[i + 1].position;
+
+            box->min = (Point){.x = fmin(a.x, b.x), .y = fmin(a.y, b.y)};
+            box->max = (Point){.x = fmax(a.x, b.x), .y = fmax(a.y, b.y)};
+        }
+        else
+        {
+            // Empty box
+            box->min = (Point){.x = INFINITY, .y = INFINITY};
+            box->max = (Point){.x = -INFINITY, .y = -INFINITY};
+        }
+    }
+
+    for (int node = num_leaves - 1; node >= 1; node--)
+    {
+        const PathBox *left = &path->boxes[2 * node];
+        const PathBox *right = &path->boxes[2 * node + 1];
+
+        path->boxes[node].min = (Point){.x = fmin(left->min.x, right->min.x), .y = fmin(left->min.y, right->min.y)};
+        path->boxes[node].max = (Point){.x = fmax(left->max.x, right->max.x), .y = fmax(left->max.y, right->max.y)};
+    }
+
+    return true;
+}
+
+/**
+ * Creates an empty path.
+ *
+ * @param max_points The number of points to allocate memory for.
+ *
+ * @return A pointer to the new WaypointPath, or NULL if memory could not be allocated.
+ */
+WaypointPath *path_create(int max_points)
+{
+    WaypointPath *path = (WaypointPath *)calloc(1, sizeof(WaypointPath));
+
+    if (path == NULL)
+    {
+        fprintf(stderr, "Error: Could not allocate memory for waypoint path.\n");
+        return NULL;
+    }
+
+    if (max_points > 0)
+    {
+        path->points = malloc(max_points * sizeof(PathPoint));
+        path->lengths = malloc(max_points * sizeof(double));
+
+        if (path->points == NULL || path->lengths == NULL)
+        {
+            fprintf(stderr, "Error: Could not allocate memory for waypoint path.\n");
+            path_destroy(path);
+            return NULL;
+        }
+
+        path->max_points = max_points;
+    }
+
+    return path;
+}
+
+/**
+ * Frees the memory of a path.
+ *
+ * @param path A pointer to the WaypointPath, or NULL.
+ *
+ * @return void
+ */
+void path_destroy(WaypointPath *path)
+{
+    if (path == NULL)
+        return;
+
+    free(path->points);
+    free(path->lengths);
+    free(path->boxes);
+    free(path);
+}
+
+/**
+ * Searches a subtree for the segment closest to a point. Subtrees whose box is farther than
+ * the closest segment so far are skipped, so only O(log n) nodes are visited along a path.
+ *
+ * @param path A pointer to the WaypointPath.
+ * @param node The root of the subtree.
+ * @param first_leaf The first segment covered by the subtree.
+ * @param num_leaves The number of segments covered by the subtree.
+ * @param position The point.
+ * @param first_segment The first segment to consider.
+ * @param min_distance A pointer to the distance to the closest segment so far.
+ * @param segment A pointer to the closest segment so far.
+ *
+ * @return void
+ */
+static void path_find_nearest(const WaypointPath *path, int node, int first_leaf, int num_leaves, Point position, int first_segment, double *min_distance, int *segment)
+{
+    if (first_leaf + num_leaves <= first_segment || path_box_distance(&path->boxes[node], position) >= *min_distance)
+        return;
+
+    if (num_leaves == 1)
+    {
+        double distance = path_segment_distance(path, first_leaf, position, NULL);
+
+        if (distance < *min_distance)
+        {
+            *min_distance = distance;
+            *segment = first_leaf;
+        }
+
+        return;
+    }
+
+    // Visit the closer child first, so that the other one is more likely to be skipped
+    int half = num_leaves / 2;
+    bool is_left_first = path_box_distance(&path->boxes[2 * node], position) <= path_box_distance(&path->boxes[2 * node + 1], position);
+
+    if (is_left_first)
+    {
+        path_find_nearest(path, 2 * node, first_leaf, half, position, first_segment, min_distance, segment);
+        path_find_nearest(path, 2 * node + 1, first_leaf + half, half, position, first_segment, min_distance, segment);
+    }
+    else
+    {
+        path_find_nearest(path, 2 * node + 1, first_leaf + half, half, position, first_segment, min_distance, segment);
+        path_find_nearest(path, 2 * node, first_leaf, half, position, first_segment, min_distance, segment);
+    }
+}
+
+/**
+ * Finds the segment of a path closest to a point.
+ *
+ * @param path A pointer to the WaypointPath.
+ * @param position The point.
+ * @param first_segment The first segment to consider, e.g. to ignore segments already travelled.
+ *
+ * @return The index of the segment, or -1 if the path has no segments from first_segment on.
+ */
+int path_find_nearest_segment(const WaypointPath *path, Point position, int first_segment)
+{
+    double min_distance = INFINITY;
+    int segment = -1;
+
+    if (path->num_points < 2)
+        return -1;
+
+    path_find_nearest(path, 1, 0, path->num_leaves, position, first_segment < 0 ? 0 : first_segment, &min_distance, &segment);
+
+    return segment;
+}
+
+/**
+ * Searches a subtree for the first or last segment whose box intersects a rectangle.
+ *
+ * @param path A pointer to the WaypointPath.
+ * @param node The root of the subtree.
+ * @param first_leaf The first segment covered by the subtree.
+ * @param num_leaves The number of segments covered by the subtree.
+ * @param min The top-left corner of the rectangle.
+ * @param max The bottom-right corner of the rectangle.
+ * @param is_first Whether to find the first segment, or the last one.
+ *
+ * @return The index of the segment, or -1 if no segment intersects the rectangle.
+ */
+static int path_find_visible_segment(const WaypointPath *path, int node, int first_leaf, int num_leaves, Point min, Point max, bool is_first)
+{
+    const PathBox *box = &path->boxes[node];
+
+    if (box->min.x > max.x || box->max.x < min.x || box->min.y > max.y || box->max.y < min.y)
+        return -1;
+
+    if (num_leaves == 1)
+        return first_leaf;
+
+    int half = num_leaves / 2;
+    int segment;
+
+    if (is_first)
+    {
+        segment = path_find_visible_segment(path, 2 * node, first_leaf, half, min, max, is_first);
+
+        if (segment < 0)
+            segment = path_find_visible_segment(path, 2 * node + 1, first_leaf + half, half, min, max, is_first);
+    }
+    else
+    {
+        segment = path_find_visible_segment(path, 2 * node + 1, first_leaf + half, half, min, max, is_first);
+
+        if (segment < 0)
+            segment = path_find_visible_segment(path, 2 * node, first_leaf, half, min, max, is_first);
+    }
+
+    return segment;
+}
+
+/**
+ * Returns the arc length of a path at the point of a segment closest to a position.
+ *
+ * @param path A pointer to the WaypointPath.
+ * @param segment The segment, e.g. from path_find_nearest_segment().
+ * @param position The position.
+ *
+ * @return The distance along the path from its first point.
+ */
+double path_get_progress(const WaypointPath *path, int segment, Point position)
+{
+    double t;
+
+    path_segment_distance(path, segment, position, &t);
+
+    return path->lengths[segment] + t * (path->lengths[segment + 1] - path->lengths[segment]);
+}
+
+/**
+ * Returns the length of a path from one of its points to the end.
+ *
+ * @param path A pointer to the WaypointPath.
+ * @param index The index of the point.
+ *
+ * @return The remaining length.
+ */
+double path_get_remaining_length(const WaypointPath *path, int index)
+{
+    return path->lengths[path->num_points - 1] - path->lengths[index];
+}
+
+/**
+ * Finds the range of segments that can be visible in a rectangle. Segments between the first
+ * and the last visible one may still be outside the rectangle, if the path leaves it and comes back.
+ *
+ * @param path A pointer to the WaypointPath.
+ * @param min The top-left corner of the rectangle, in path coordinates.
+ * @param max The bottom-right corner of the rectangle, in path coordinates.
+ * @param first A pointer to the first segment in the range.
+ * @param last A pointer to the last segment in the range.
+ *
+ * @return True if a segment intersects the rectangle, false otherwise.
+ */
+bool path_get_visible_range(const WaypointPath *path, Point min, Point max, int *first, int *last)
+{
+    if (path->num_points < 2)
+        return false;
+
+    *first = path_find_visible_segment(path, 1, 0, path->num_leaves, min, max, true);
+
+    if (*first < 0)
+        return false;
+
+    *last = path_find_visible_segment(path, 1, 0, path->num_leaves, min, max, false);
+
+    return true;
+}
+
+/**
+ * Returns the distance from a point to a segment of a path.
+ *
+ * @param path A pointer to the WaypointPath.
+ * @param segment The segment.
+ * @param position The point.
+ * @param t A pointer to the position of the closest point along the segment, from 0 to 1, or NULL.
+ *
+ * @return The distance.
+ */
+static double path_segment_distance(const WaypointPath *path, int segment, Point position, double *t)
+{
+    Point a = path->points[segment].position;
+    Point b = path->points[segment + 1].position;
+    double dx = b.x - a.x;
+    double dy = b.y - a.y;
+    double length_squared = dx * dx + dy * dy;
+    double s = length_squared > 0 ? ((position.x - a.x) * dx + (position.y - a.y) * dy) / length_squared : 0;
+
+    s = fmax(0, fmin(1, s));
+
+    if (t != NULL)
+        *t = s;
+
+    return hypot(a.x + s * dx - position.x, a.y + s * dy - position.y);
+}
+
+/**
+ * Moves a point of a path, e.g. the last one when the destination is a moving planet.
+ * The boxes of its segments are updated in O(log n); Lengths are updated from the point to the end.
+ *
+ * @param path A pointer to the WaypointPath.
+ * @param index The index of the point.
+ * @param position The new position of the point.
+ *
+ * @return void
+ */
+void path_set_point(WaypointPath *path, int index, Point position)
+{
+    path->points[index].position = position;
+
+    for (int i = index > 0 ? index : 1; i < path->num_points; i++)
+    {
+        Point a = path->points[i - 1].position;
+        Point b = path->points[i].position;
+
+        path->lengths[i] = path->lengths[i - 1] + hypot(b.x - a.x, b.y - a.y);
+    }
+
+    if (index > 0)
+        path_update_box(path, index - 1);
+
+    if (index < path->num_points - 1)
+        path_update_box(path, index);
+}
+
+/**
+ * Updates the box of a segment and the boxes of the subtrees that contain it.
+ *
+ * @param path A pointer to the WaypointPath.
+ * @param segment The segment.
+ *
+ * @return void
+ */
+static void path_update_box(WaypointPath *path, int segment)
+{
+    Point a = path->points[segment].position;
+    Point b = path->points[segment + 1].position;
+    int node = path->num_leaves + segment;
+
+    path->boxes[node].min = (Point){.x = fmin(a.x, b.x), .y = fmin(a.y, b.y)};
+    path->boxes[node].max = (Point){.x = fmax(a.x, b.x), .y = fmax(a.y, b.y)};
+
+    for (node /= 2; node >= 1; node /= 2)
+    {
+        const PathBox *left = &path->boxes[2 * node];
+        const PathBox *right = &path->boxes[2 * node + 1];
+
+        path->boxes[node].min = (Point){.x = fmin(left->min.x, right->min.x), .y = fmin(left->min.y, right->min.y)};
+        path->boxes[node].max = (Point){.x = fmax(left->max.x, right->max.x), .y = fmax(left->max.y, right->max.y)};
+    }
+}
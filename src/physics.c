@@ -26,9 +26,13 @@
  */
 void phys_apply_gravity_to_ship(GameState *game_state, const InputState *input_state, NavigationState *nav_state, CelestialBody *body, Ship *ship, unsigned short star_class)
 {
-    double delta_x = body->position.x - ship->position.x;
-    double delta_y = body->position.y - ship->position.y;
-    double distance = sqrt(delta_x * delta_x + delta_y * delta_y);
+    // Gravity is calculated in the local frame of the ship, where coordinates stay small enough for floats.
+    // The ship is converted too, since a collision with a previous body may have moved it this frame.
+    LocalPoint body_position = origin_get_local_position(&nav_state->origin, body->position);
+    LocalPoint ship_position = origin_get_local_position(&nav_state->origin, ship->position);
+    float delta_x = body_position.x - ship_position.x;
+    float delta_y = body_position.y - ship_position.y;
+    float distance = sqrtf(delta_x * delta_x + delta_y * delta_y);
     float g_body;
     int is_star = body->level == LEVEL_STAR;
     int collision_point = body->radius;
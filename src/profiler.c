@@ -0,0 +1,306 @@
+/*
+ * profiler.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include "../include/constants.h"
+#include "../include/enums.h"
+#include "../include/structs.h"
+#include "../include/profiler.h"
+
+// External variable definitions
+extern SDL_Color colors[];
+
+// Static variable definitions
+static SDL_TLSID stack_id = 0; // The ProfilerStack of the current thread
+static Uint64 frequency = 0;
+static SDL_atomic_t frame_times[PROFILER_SCOPE_COUNT]; // Microseconds of the scopes in the current frame, without nested scopes
+static SDL_atomic_t depths[PROFILER_SCOPE_COUNT];      // Nesting depth of the scopes, the last time they ran
+static int history[PROFILER_SCOPE_COUNT][PROFILER_HISTORY];
+static int history_index = 0;
+static int num_frames = 0;
+static int percentiles[PROFILER_SCOPE_COUNT][3]; // p50, p95 and p99 in microseconds
+static const char *scope_names[PROFILER_SCOPE_COUNT] = {"events", "update", "stars", "galaxies", "gstars", "bstars", "physics",
+                                                        "draw stars", "draw galaxies", "draw ship", "console", "render", "present"};
+static const SDL_Color scope_colors[PROFILER_SCOPE_COUNT] = {
+    {230, 25, 75, 255},
+    {128, 128, 128, 255},
+    {255, 225, 25, 255},
+    {245, 130, 48, 255},
+    {145, 30, 180, 255},
+    {70, 240, 240, 255},
+    {240, 50, 230, 255},
+    {60, 180, 75, 255},
+    {0, 130, 200, 255},
+    {210, 245, 60, 255},
+    {250, 190, 212, 255},
+    {170, 110, 40, 255},
+    {255, 250, 200, 255}};
+
+// Static function prototypes
+static int profiler_compare_times(const void *a, const void *b);
+static ProfilerStack *profiler_get_stack(void);
+static void profiler_update_percentiles(void);
+
+/**
+ * Starts timing a scope on the current thread. Scopes nest; The time of a nested scope
+ * is not counted in the scope around it.
+ *
+ * @param scope The scope.
+ *
+ * @return void
+ */
+void profiler_begin_scope(unsigned short scope)
+{
+    ProfilerStack *stack = profiler_get_stack();
+
+    if (stack == NULL)
+        return;
+
+    if (stack->depth < PROFILER_MAX_DEPTH)
+    {
+        stack->scopes[stack->depth] = scope;
+        stack->children[stack->depth] = 0;
+        stack->starts[stack->depth] = SDL_GetPerformanceCounter();
+    }
+
+    SDL_AtomicSet(&depths[scope], stack->depth);
+    stack->depth++;
+}
+
+/**
+ * Compares two scope times, for sorting.
+ *
+ * @param a A pointer to the first time.
+ * @param b A pointer to the second time.
+ *
+ * @return A negative number, zero or a positive number if the first time is shorter, equal or longer.
+ */
+static int profiler_compare_times(const void *a, const void *b)
+{
+    return *(const int *)a - *(const int *)b;
+}
+
+/**
+ * Creates the thread-local storage of the profiler. Must be called before the threads that are profiled start.
+ *
+ * @return True if the profiler was created, false otherwise.
+ */
+bool profiler_create(void)
+{
+    frequency = SDL_GetPerformanceFrequency();
+    stack_id = SDL_TLSCreate();
+
+    if (stack_id == 0)
+    {
+        SDL_Log("Could not create profiler: %s\n", SDL_GetError());
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Draws the profiler overlay: a graph of the last <PROFILER_HISTORY> frames, with the time of the scopes
+ * stacked in each frame, and a table with the 50th, 95th and 99th percentiles of each scope.
+ *
+ * @param camera A pointer to the current Camera object.
+ *
+ * @return void
+ */
+void profiler_draw(const Camera *camera)
+{
+    if (stack_id == 0)
+        return;
+
+    unsigned short previous_layer = render_set_layer(RENDER_LAYER_UI);
+
+    int bar_width = 2;
+    int graph_width = PROFILER_HISTORY * bar_width;
+    int table_width = 300;
+    int row_height = 18;
+    int x = 30;
+    int y = camera->h - 60 - PROFILER_GRAPH_HEIGHT;
+
+    // Two frame budgets fill the height of the graph
+    double pixels_per_us = (double)PROFILER_GRAPH_HEIGHT * FPS / 2000000;
+
+    SDL_Rect background = {.x = x - 10, .y = y - 10 - (PROFILER_SCOPE_COUNT + 1) * row_height, .w = MAX(graph_width, table_width) + 20, .h = PROFILER_GRAPH_HEIGHT + 20 + (PROFILER_SCOPE_COUNT + 1) * row_height};
+    render_set_draw_color(0, 0, 0, 160);
+    render_fill_rect(&background);
+
+    // Stack the scopes of each frame, oldest on the left; Each scope is one batch of rects
+    int oldest = num_frames < PROFILER_HISTORY ? 0 : history_index;
+    int bottoms[PROFILER_HISTORY];
+    SDL_Rect rects[PROFILER_HISTORY];
+
+    for (int f = 0; f < num_frames; f++)
+        bottoms[f] = y + PROFILER_GRAPH_HEIGHT;
+
+    for (int s = 0; s < PROFILER_SCOPE_COUNT; s++)
+    {
+        int num_rects = 0;
+
+        for (int f = 0; f < num_frames; f++)
+        {
+            int height = (int)(history[s][(oldest + f) % PROFILER_HISTORY] * pixels_per_us + 0.5);
+
+            if (height <= 0 || bottoms[f] <= y)
+                continue;
+
+            if (bottoms[f] - height < y)
+                height = bottoms[f] - y;
+
+            bottoms[f] -= height;
+            rects[num_rects++] = (SDL_Rect){.x = x + f * bar_width, .y = bottoms[f], .w = bar_width, .h = height};
+        }
+
+        if (num_rects == 0)
+            continue;
+
+        render_set_draw_color(scope_colors[s].r, scope_colors[s].g, scope_colors[s].b, 255);
+        render_fill_rects(rects, num_rects);
+    }
+
+    // Frame budget
+    render_set_draw_color(255, 255, 255, 128);
+    render_draw_line(x, y + PROFILER_GRAPH_HEIGHT / 2, x + graph_width, y + PROFILER_GRAPH_HEIGHT / 2);
+
+    // Percentiles of each scope, indented by depth
+    int row_y = y - 10 - (PROFILER_SCOPE_COUNT + 1) * row_height;
+
+    TextLabel *header_label = text_get_label("p50, p95, p99 ms", FONT_SIZE_14, colors[COLOR_WHITE_100]);
+    text_draw_label(header_label, x + 150, row_y);
+
+    for (int s = 0; s < PROFILER_SCOPE_COUNT; s++)
+    {
+        row_y += row_height;
+        int indent = 10 * SDL_AtomicGet(&depths[s]);
+
+        SDL_Rect swatch = {.x = x + indent, .y = row_y + 4, .w = 8, .h = 8};
+        render_set_draw_color(scope_colors[s].r, scope_colors[s].g, scope_colors[s].b, 255);
+        render_fill_rect(&swatch);
+
+        TextLabel *name_label = text_get_label(scope_names[s], FONT_SIZE_14, colors[COLOR_WHITE_100]);
+        text_draw_label(name_label, x + indent + 14, row_y);
+
+        char times_text[48];
+        sprintf(times_text, "%7.2f %7.2f %7.2f", percentiles[s][0] / 1000.0, percentiles[s][1] / 1000.0, percentiles[s][2] / 1000.0);
+
+        TextLabel *times_label = text_get_label(times_text, FONT_SIZE_14, colors[COLOR_WHITE_100]);
+        text_draw_label(times_label, x + 150, row_y);
+    }
+
+    render_set_layer(previous_layer);
+}
+
+/**
+ * Ends a frame of the simulation. The times of the scopes that ran since the previous frame are added
+ * to the history, and the percentiles are updated every <PROFILER_REFRESH> frames.
+ *
+ * @return void
+ */
+void profiler_end_frame(void)
+{
+    if (stack_id == 0)
+        return;
+
+    for (int s = 0; s < PROFILER_SCOPE_COUNT; s++)
+        history[s][history_index] = SDL_AtomicSet(&frame_times[s], 0);
+
+    history_index = (history_index + 1) % PROFILER_HISTORY;
+
+    if (num_frames < PROFILER_HISTORY)
+        num_frames++;
+
+    if (history_index % PROFILER_REFRESH == 0)
+        profiler_update_percentiles();
+}
+
+/**
+ * Ends the innermost scope of the current thread, and adds it to the trace capture if one is running.
+ *
+ * @param scope The scope, which must be the innermost one.
+ *
+ * @return void
+ */
+void profiler_end_scope(unsigned short scope)
+{
+    ProfilerStack *stack = profiler_get_stack();
+
+    if (stack == NULL || stack->depth == 0)
+        return;
+
+    stack->depth--;
+
+    if (stack->depth >= PROFILER_MAX_DEPTH || stack->scopes[stack->depth] != scope)
+        return;
+
+    Uint64 end = SDL_GetPerformanceCounter();
+    Uint64 elapsed = end - stack->starts[stack->depth];
+
+    trace_add_span(scope_names[scope], stack->starts[stack->depth], end);
+
+    if (stack->depth > 0)
+        stack->children[stack->depth - 1] += elapsed;
+
+    Uint64 exclusive = elapsed > stack->children[stack->depth] ? elapsed - stack->children[stack->depth] : 0;
+
+    SDL_AtomicAdd(&frame_times[scope], (int)(exclusive * 1000000 / frequency));
+}
+
+/**
+ * Gets the stack of open scopes of the current thread, and creates it the first time.
+ *
+ * @return A pointer to the ProfilerStack, or NULL if the profiler has not been created.
+ */
+static ProfilerStack *profiler_get_stack(void)
+{
+    if (stack_id == 0)
+        return NULL;
+
+    ProfilerStack *stack = SDL_TLSGet(stack_id);
+
+    if (stack != NULL)
+        return stack;
+
+    stack = (ProfilerStack *)calloc(1, sizeof(ProfilerStack));
+
+    if (stack == NULL)
+    {
+        fprintf(stderr, "Error: Could not allocate memory for ProfilerStack.\n");
+        return NULL;
+    }
+
+    // Freed when the thread exits
+    SDL_TLSSet(stack_id, stack, free);
+
+    return stack;
+}
+
+/**
+ * Calculates the 50th, 95th and 99th percentiles of the times of each scope in the history.
+ *
+ * @return void
+ */
+static void profiler_update_percentiles(void)
+{
+    int times[PROFILER_HISTORY];
+
+    for (int s = 0; s < PROFILER_SCOPE_COUNT; s++)
+    {
+        memcpy(times, history[s], num_frames * sizeof(int));
+        qsort(times, num_frames, sizeof(int), profiler_compare_times);
+
+        percentiles[s][0] = times[(num_frames - 1) * 50 / 100];
+        percentiles[s][1] = times[(num_frames - 1) * 95 / 100];
+        percentiles[s][2] = times[(num_frames - 1) * 99 / 100];
+    }
+}
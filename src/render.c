@@ -0,0 +1,1230 @@
+/*
+ * render.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include <SDL2/SDL.h>
+
+#include "../include/constants.h"
+#include "../include/enums.h"
+#include "../include/structs.h"
+#include "../include/render.h"
+
+// External variable definitions
+extern SDL_Renderer *renderer;
+
+// Static variable definitions
+static RenderFrame frames[RENDER_FRAMES];
+static RenderFrame *frame = &frames[0]; // Frame being recorded
+static RenderFrame *latest = NULL;      // Last recorded frame, until it is drawn
+static RenderFrame *drawn = NULL;       // Frame being drawn
+static SDL_Color draw_color = {255, 255, 255, 255};
+static SDL_BlendMode blend_mode = SDL_BLENDMODE_BLEND;
+static unsigned short layer = RENDER_LAYER_WORLD;
+static SDL_Texture *target = NULL;
+static SDL_Cursor *cursor = NULL;
+static RenderStats last_stats = {0};
+static SDL_mutex *frames_mutex = NULL; // NULL unless frames are recorded on another thread
+static SDL_cond *frames_cond = NULL;
+static SDL_threadID render_thread_id = 0;
+static RenderRequest *request = NULL; // Pending renderer call of the recording thread
+
+// Static function prototypes
+static RenderCommand *render_add_command(unsigned short type);
+static RenderCommand *render_add_copy(SDL_Texture *, const SDL_Rect *src, const SDL_Rect *dst, double angle, const SDL_Point *center, SDL_RendererFlip);
+static void render_call(RenderRequest *);
+static bool render_can_merge(const RenderCommand *previous, const RenderCommand *next);
+static int render_compare_commands(const void *a, const void *b);
+static void render_draw_batch(int start, int end);
+static void render_draw_commands(void);
+static int render_gather_points(int start, int end, bool is_strip, int *count);
+static int render_gather_rects(int start, int end, int *count);
+static bool render_reserve(void **items, int *capacity, int count, size_t item_size);
+static void render_reset_frame(RenderFrame *);
+static void render_run_call(RenderRequest *);
+static void render_run_request(void);
+
+/**
+ * Records a new command with the current layer, blend mode and draw color.
+ * Primitives that would not change the target are dropped.
+ *
+ * @param type The type of the command.
+ *
+ * @return A pointer to the command, or NULL if it was dropped.
+ */
+static RenderCommand *render_add_command(unsigned short type)
+{
+    bool is_primitive = type != RENDER_COPY && type != RENDER_GEOMETRY && type != RENDER_CLEAR;
+
+    if (is_primitive && draw_color.a == 0 && blend_mode == SDL_BLENDMODE_BLEND)
+        return NULL;
+
+    if (!render_reserve((void **)&frame->commands, &frame->max_commands, frame->num_commands + 1, sizeof(RenderCommand)))
+        return NULL;
+
+    RenderCommand *command = &frame->commands[frame->num_commands];
+    memset(command, 0, sizeof(RenderCommand));
+    command->type = type;
+    command->layer = layer;
+    command->target = target;
+    command->blend_mode = blend_mode;
+    command->color = draw_color;
+
+    frame->num_commands++;
+    frame->stats.commands++;
+    frame->has_targets |= target != NULL;
+
+    return command;
+}
+
+/**
+ * Records a texture copy, without its color and alpha modulation.
+ *
+ * @param texture The texture to copy.
+ * @param src A pointer to the source rectangle, or NULL for the entire texture.
+ * @param dst A pointer to the destination rectangle, or NULL for the entire target.
+ * @param angle The angle of rotation in degrees, clockwise.
+ * @param center A pointer to the point around which dst is rotated, or NULL for its center.
+ * @param flip The flipping to perform on the texture.
+ *
+ * @return A pointer to the command, or NULL if it was dropped.
+ */
+static RenderCommand *render_add_copy(SDL_Texture *texture, const SDL_Rect *src, const SDL_Rect *dst, double angle, const SDL_Point *center, SDL_RendererFlip flip)
+{
+    if (texture == NULL)
+        return NULL;
+
+    RenderCommand *command = render_add_command(RENDER_COPY);
+
+    if (command == NULL)
+        return NULL;
+
+    command->texture = texture;
+
+    if (src != NULL)
+    {
+        command->has_src = true;
+        command->src = *src;
+    }
+
+    if (dst != NULL)
+    {
+        command->has_dst = true;
+        command->dst = *dst;
+    }
+
+    if (center != NULL)
+    {
+        command->has_center = true;
+        command->center = *center;
+    }
+
+    command->angle = angle;
+    command->flip = flip;
+
+    return command;
+}
+
+/**
+ * Makes a call to the renderer. Calls from another thread than the one that draws frames
+ * are made by the render thread, while the caller waits.
+ *
+ * @param call A pointer to the call, which holds its result when it returns.
+ *
+ * @return void
+ */
+static void render_call(RenderRequest *call)
+{
+    if (frames_mutex == NULL || SDL_ThreadID() == render_thread_id)
+    {
+        render_run_call(call);
+        return;
+    }
+
+    SDL_LockMutex(frames_mutex);
+
+    while (request != NULL)
+        SDL_CondWait(frames_cond, frames_mutex);
+
+    request = call;
+    SDL_CondBroadcast(frames_cond);
+
+    while (!call->is_done)
+        SDL_CondWait(frames_cond, frames_mutex);
+
+    SDL_UnlockMutex(frames_mutex);
+}
+
+/**
+ * Checks whether a command can be drawn in the same draw call as the one before it.
+ *
+ * @param previous A pointer to the previous command.
+ * @param next A pointer to the next command.
+ *
+ * @return True if the commands can be merged, false otherwise.
+ */
+static bool render_can_merge(const RenderCommand *previous, const RenderCommand *next)
+{
+    if (previous->type != next->type || previous->layer != next->layer || previous->target != next->target ||
+        previous->blend_mode != next->blend_mode)
+        return false;
+
+    bool same_color = previous->color.r == next->color.r && previous->color.g == next->color.g &&
+                      previous->color.b == next->color.b && previous->color.a == next->color.a;
+
+    switch (next->type)
+    {
+    case RENDER_POINTS:
+    case RENDER_RECTS:
+    case RENDER_FILL_RECTS:
+        return same_color;
+    case RENDER_LINES:
+    {
+        // Line strips can only be joined where one ends and the next starts
+        const SDL_Point *last = &drawn->points[previous->first + previous->count - 1];
+        const SDL_Point *first = &drawn->points[next->first];
+
+        return same_color && last->x == first->x && last->y == first->y;
+    }
+    case RENDER_GEOMETRY:
+        return previous->texture == next->texture;
+    default:
+        return false;
+    }
+}
+
+/**
+ * Records a clear of the whole render target with the current draw color.
+ *
+ * @return void
+ */
+void render_clear(void)
+{
+    render_add_command(RENDER_CLEAR);
+}
+
+/**
+ * Orders commands by layer. Background commands are also ordered by state, so that
+ * they can be merged; Other layers keep the order in which commands were recorded.
+ * Commands for offscreen targets come first and keep their order, so that textures
+ * are up to date before they are drawn on the screen.
+ *
+ * @param a A pointer to the index of the first command.
+ * @param b A pointer to the index of the second command.
+ *
+ * @return A negative, zero or positive value, as expected by qsort.
+ */
+static int render_compare_commands(const void *a, const void *b)
+{
+    int index_a = *(const int *)a;
+    int index_b = *(const int *)b;
+    const RenderCommand *command_a = &drawn->commands[index_a];
+    const RenderCommand *command_b = &drawn->commands[index_b];
+    bool is_offscreen_a = command_a->target != NULL;
+    bool is_offscreen_b = command_b->target != NULL;
+
+    if (is_offscreen_a != is_offscreen_b)
+        return is_offscreen_a ? -1 : 1;
+
+    if (is_offscreen_a)
+        return index_a < index_b ? -1 : (index_a > index_b);
+
+    if (command_a->layer != command_b->layer)
+        return command_a->layer < command_b->layer ? -1 : 1;
+
+    if (command_a->layer == RENDER_LAYER_BACKGROUND)
+    {
+        if (command_a->type != command_b->type)
+            return command_a->type < command_b->type ? -1 : 1;
+
+        if (command_a->blend_mode != command_b->blend_mode)
+            return command_a->blend_mode < command_b->blend_mode ? -1 : 1;
+
+        // Textures are not compared, their addresses would make the order differ between runs
+        Uint32 key_a = (Uint32)command_a->color.r << 24 | (Uint32)command_a->color.g << 16 | (Uint32)command_a->color.b << 8 | command_a->color.a;
+        Uint32 key_b = (Uint32)command_b->color.r << 24 | (Uint32)command_b->color.g << 16 | (Uint32)command_b->color.b << 8 | command_b->color.a;
+
+        if (key_a != key_b)
+            return key_a < key_b ? -1 : 1;
+    }
+
+    return index_a < index_b ? -1 : (index_a > index_b);
+}
+
+/**
+ * Records a texture copy, without color or alpha modulation.
+ *
+ * @param texture The texture to copy.
+ * @param src A pointer to the source rectangle, or NULL for the entire texture.
+ * @param dst A pointer to the destination rectangle, or NULL for the entire target.
+ *
+ * @return void
+ */
+void render_copy(SDL_Texture *texture, const SDL_Rect *src, const SDL_Rect *dst)
+{
+    render_copy_ex(texture, src, dst, 0, NULL, SDL_FLIP_NONE);
+}
+
+/**
+ * Records a rotated or flipped texture copy, without color or alpha modulation.
+ * The modulation of the texture itself is not read, since the render thread sets it to draw.
+ *
+ * @param texture The texture to copy.
+ * @param src A pointer to the source rectangle, or NULL for the entire texture.
+ * @param dst A pointer to the destination rectangle, or NULL for the entire target.
+ * @param angle The angle of rotation in degrees, clockwise.
+ * @param center A pointer to the point around which dst is rotated, or NULL for its center.
+ * @param flip The flipping to perform on the texture.
+ *
+ * @return void
+ */
+void render_copy_ex(SDL_Texture *texture, const SDL_Rect *src, const SDL_Rect *dst, double angle, const SDL_Point *center, SDL_RendererFlip flip)
+{
+    RenderCommand *command = render_add_copy(texture, src, dst, angle, center, flip);
+
+    if (command != NULL)
+        command->color = (SDL_Color){255, 255, 255, 255};
+}
+
+/**
+ * Records a texture copy with the given color and alpha modulation. The modulation
+ * of the texture itself is left alone, since the render thread sets it to draw.
+ *
+ * @param texture The texture to copy.
+ * @param src A pointer to the source rectangle, or NULL for the entire texture.
+ * @param dst A pointer to the destination rectangle, or NULL for the entire target.
+ * @param mod The color and alpha modulation.
+ *
+ * @return void
+ */
+void render_copy_modulated(SDL_Texture *texture, const SDL_Rect *src, const SDL_Rect *dst, SDL_Color mod)
+{
+    RenderCommand *command = render_add_copy(texture, src, dst, 0, NULL, SDL_FLIP_NONE);
+
+    if (command != NULL)
+        command->color = mod;
+}
+
+/**
+ * Prepares frames to be recorded on another thread than the calling one, which draws them.
+ *
+ * @return True if the frames could be shared, false otherwise.
+ */
+bool render_create_frames(void)
+{
+    frames_mutex = SDL_CreateMutex();
+    frames_cond = SDL_CreateCond();
+
+    if (frames_mutex == NULL || frames_cond == NULL)
+    {
+        SDL_Log("Could not create render frame lock: %s\n", SDL_GetError());
+        SDL_DestroyMutex(frames_mutex);
+        SDL_DestroyCond(frames_cond);
+        frames_mutex = NULL;
+        frames_cond = NULL;
+        return false;
+    }
+
+    render_thread_id = SDL_ThreadID();
+    latest = NULL;
+    drawn = NULL;
+
+    return true;
+}
+
+/**
+ * Creates a texture on the render thread.
+ *
+ * @param format The pixel format, one of SDL_PixelFormatEnum.
+ * @param access The texture access, one of SDL_TextureAccess.
+ * @param w The width of the texture in pixels.
+ * @param h The height of the texture in pixels.
+ *
+ * @return The texture, or NULL on failure.
+ */
+SDL_Texture *render_create_texture(Uint32 format, int access, int w, int h)
+{
+    RenderRequest call = {.type = RENDER_REQUEST_CREATE_TEXTURE, .format = format, .access = access, .w = w, .h = h};
+
+    render_call(&call);
+
+    return call.texture;
+}
+
+/**
+ * Creates a texture from a surface on the render thread. The surface is left to the caller.
+ *
+ * @param surface The surface with the pixels of the texture.
+ *
+ * @return The texture, or NULL on failure.
+ */
+SDL_Texture *render_create_texture_from_surface(SDL_Surface *surface)
+{
+    RenderRequest call = {.type = RENDER_REQUEST_CREATE_TEXTURE_FROM_SURFACE, .surface = surface};
+
+    render_call(&call);
+
+    return call.texture;
+}
+
+/**
+ * Frees the memory of the command buffer.
+ *
+ * @return void
+ */
+void render_destroy(void)
+{
+    for (int i = 0; i < RENDER_FRAMES; i++)
+    {
+        for (int j = 0; j < frames[i].num_destroyed_textures; j++)
+            SDL_DestroyTexture(frames[i].destroyed_textures[j]);
+
+        free(frames[i].destroyed_textures);
+        free(frames[i].commands);
+        free(frames[i].points);
+        free(frames[i].rects);
+        free(frames[i].vertices);
+        free(frames[i].indices);
+        free(frames[i].order);
+
+        frames[i] = (RenderFrame){0};
+    }
+
+    SDL_DestroyMutex(frames_mutex);
+    SDL_DestroyCond(frames_cond);
+    frames_mutex = NULL;
+    frames_cond = NULL;
+    frame = &frames[0];
+    latest = NULL;
+    drawn = NULL;
+}
+
+/**
+ * Destroys a texture once the commands of the frame have been submitted,
+ * since recorded commands may still refer to it.
+ *
+ * @param texture The texture to destroy.
+ *
+ * @return void
+ */
+void render_destroy_texture(SDL_Texture *texture)
+{
+    if (texture == NULL)
+        return;
+
+    if (!render_reserve((void **)&frame->destroyed_textures, &frame->max_destroyed_textures, frame->num_destroyed_textures + 1, sizeof(SDL_Texture *)))
+    {
+        // Commands that use the texture are dropped with it; Frames of another thread cannot be, so it is leaked
+        if (frames_mutex == NULL)
+        {
+            render_submit();
+            SDL_DestroyTexture(texture);
+        }
+
+        return;
+    }
+
+    frame->destroyed_textures[frame->num_destroyed_textures++] = texture;
+}
+
+/**
+ * Draws a range of merged commands with a single draw call.
+ *
+ * @param start The position of the first command in the sorted order.
+ * @param end The position after the last command in the sorted order.
+ *
+ * @return void
+ */
+static void render_draw_batch(int start, int end)
+{
+    const RenderCommand *command = &drawn->commands[drawn->order[start]];
+    int count;
+    int first;
+
+    if (command->type != RENDER_COPY)
+    {
+        SDL_SetRenderDrawBlendMode(renderer, command->blend_mode);
+        SDL_SetRenderDrawColor(renderer, command->color.r, command->color.g, command->color.b, command->color.a);
+    }
+
+    switch (command->type)
+    {
+    case RENDER_CLEAR:
+        SDL_RenderClear(renderer);
+        break;
+    case RENDER_POINTS:
+        first = render_gather_points(start, end, false, &count);
+        SDL_RenderDrawPoints(renderer, &drawn->points[first], count);
+        break;
+    case RENDER_LINES:
+        first = render_gather_points(start, end, true, &count);
+        SDL_RenderDrawLines(renderer, &drawn->points[first], count);
+        break;
+    case RENDER_RECTS:
+        first = render_gather_rects(start, end, &count);
+        SDL_RenderDrawRects(renderer, &drawn->rects[first], count);
+        break;
+    case RENDER_FILL_RECTS:
+        first = render_gather_rects(start, end, &count);
+        SDL_RenderFillRects(renderer, &drawn->rects[first], count);
+        break;
+    case RENDER_COPY:
+    {
+        const SDL_Rect *src = command->has_src ? &command->src : NULL;
+        const SDL_Rect *dst = command->has_dst ? &command->dst : NULL;
+
+        SDL_SetTextureColorMod(command->texture, command->color.r, command->color.g, command->color.b);
+        SDL_SetTextureAlphaMod(command->texture, command->color.a);
+
+        if (command->angle == 0 && command->flip == SDL_FLIP_NONE)
+            SDL_RenderCopy(renderer, command->texture, src, dst);
+        else
+            SDL_RenderCopyEx(renderer, command->texture, src, dst, command->angle, command->has_center ? &command->center : NULL, command->flip);
+
+        break;
+    }
+    case RENDER_GEOMETRY:
+    {
+        int total_vertices = 0;
+        int total_indices = 0;
+
+        for (int i = start; i < end; i++)
+        {
+            total_vertices += drawn->commands[drawn->order[i]].count;
+            total_indices += drawn->commands[drawn->order[i]].num_indices;
+        }
+
+        if (end - start == 1)
+        {
+            SDL_RenderGeometry(renderer, command->texture, &drawn->vertices[command->first], command->count, &drawn->indices[command->first_index], command->num_indices);
+            break;
+        }
+
+        // Merged geometry is copied past the recorded data, with indices rebased to the copy
+        if (!render_reserve((void **)&drawn->vertices, &drawn->max_vertices, drawn->num_vertices + total_vertices, sizeof(SDL_Vertex)) ||
+            !render_reserve((void **)&drawn->indices, &drawn->max_indices, drawn->num_indices + total_indices, sizeof(int)))
+            break;
+
+        int vertex_count = 0;
+        int index_count = 0;
+
+        for (int i = start; i < end; i++)
+        {
+            const RenderCommand *merged = &drawn->commands[drawn->order[i]];
+
+            memcpy(&drawn->vertices[drawn->num_vertices + vertex_count], &drawn->vertices[merged->first], merged->count * sizeof(SDL_Vertex));
+
+            for (int j = 0; j < merged->num_indices; j++)
+                drawn->indices[drawn->num_indices + index_count + j] = drawn->indices[merged->first_index + j] + vertex_count;
+
+            vertex_count += merged->count;
+            index_count += merged->num_indices;
+        }
+
+        SDL_RenderGeometry(renderer, command->texture, &drawn->vertices[drawn->num_vertices], vertex_count, &drawn->indices[drawn->num_indices], index_count);
+        break;
+    }
+    }
+}
+
+/**
+ * Sorts the commands of the drawn frame by target, layer and state, merges compatible neighbours
+ * and draws them. Textures queued for destruction are destroyed afterwards.
+ *
+ * @return void
+ */
+static void render_draw_commands(void)
+{
+    if (drawn->num_commands > 0 && render_reserve((void **)&drawn->order, &drawn->max_order, drawn->num_commands, sizeof(int)))
+    {
+        SDL_Texture *screen_target = SDL_GetRenderTarget(renderer);
+        SDL_Texture *current_target = screen_target;
+
+        for (int i = 0; i < drawn->num_commands; i++)
+            drawn->order[i] = i;
+
+        qsort(drawn->order, drawn->num_commands, sizeof(int), render_compare_commands);
+
+        for (int i = 0; i < drawn->num_commands;)
+        {
+            const RenderCommand *command = &drawn->commands[drawn->order[i]];
+            SDL_Texture *command_target = command->target != NULL ? command->target : screen_target;
+            int end = i + 1;
+
+            while (end < drawn->num_commands && render_can_merge(&drawn->commands[drawn->order[end - 1]], &drawn->commands[drawn->order[end]]))
+                end++;
+
+            if (command_target != current_target)
+            {
+                if (SDL_SetRenderTarget(renderer, command_target) == 0)
+                    current_target = command_target;
+                else
+                    SDL_Log("Could not set render target: %s\n", SDL_GetError());
+            }
+
+            if (command_target == current_target)
+            {
+                render_draw_batch(i, end);
+                drawn->stats.batches++;
+                COUNTERS_ADD(COUNTER_DRAW_CALLS, 1);
+            }
+
+            i = end;
+        }
+
+        if (current_target != screen_target)
+            SDL_SetRenderTarget(renderer, screen_target);
+    }
+
+    for (int i = 0; i < drawn->num_destroyed_textures; i++)
+        SDL_DestroyTexture(drawn->destroyed_textures[i]);
+
+    render_reset_frame(drawn);
+}
+
+/**
+ * Draws the frame taken by render_wait_frame() and sets its cursor.
+ * Must be called on the render thread, before the frame is presented.
+ *
+ * @return void
+ */
+void render_draw_frame(void)
+{
+    if (drawn == NULL)
+        return;
+
+    if (drawn->cursor != NULL)
+        SDL_SetCursor(drawn->cursor);
+
+    render_draw_commands();
+
+    SDL_LockMutex(frames_mutex);
+    last_stats = drawn->stats;
+    SDL_UnlockMutex(frames_mutex);
+}
+
+/**
+ * Records a line.
+ *
+ * @param x1 The x-coordinate of the start point.
+ * @param y1 The y-coordinate of the start point.
+ * @param x2 The x-coordinate of the end point.
+ * @param y2 The y-coordinate of the end point.
+ *
+ * @return void
+ */
+void render_draw_line(int x1, int y1, int x2, int y2)
+{
+    SDL_Point line[2] = {{x1, y1}, {x2, y2}};
+
+    render_draw_lines(line, 2);
+}
+
+/**
+ * Records a series of connected lines.
+ *
+ * @param line_points An array of points along the lines.
+ * @param count The number of points.
+ *
+ * @return void
+ */
+void render_draw_lines(const SDL_Point *line_points, int count)
+{
+    if (count < 2)
+        return;
+
+    if (!render_reserve((void **)&frame->points, &frame->max_points, frame->num_points + count, sizeof(SDL_Point)))
+        return;
+
+    RenderCommand *command = render_add_command(RENDER_LINES);
+
+    if (command == NULL)
+        return;
+
+    memcpy(&frame->points[frame->num_points], line_points, count * sizeof(SDL_Point));
+    command->first = frame->num_points;
+    command->count = count;
+    frame->num_points += count;
+}
+
+/**
+ * Records a point.
+ *
+ * @param x The x-coordinate of the point.
+ * @param y The y-coordinate of the point.
+ *
+ * @return void
+ */
+void render_draw_point(int x, int y)
+{
+    SDL_Point point = {x, y};
+
+    render_draw_points(&point, 1);
+}
+
+/**
+ * Records a series of points.
+ *
+ * @param new_points An array of points.
+ * @param count The number of points.
+ *
+ * @return void
+ */
+void render_draw_points(const SDL_Point *new_points, int count)
+{
+    if (count < 1)
+        return;
+
+    if (!render_reserve((void **)&frame->points, &frame->max_points, frame->num_points + count, sizeof(SDL_Point)))
+        return;
+
+    RenderCommand *command = render_add_command(RENDER_POINTS);
+
+    if (command == NULL)
+        return;
+
+    memcpy(&frame->points[frame->num_points], new_points, count * sizeof(SDL_Point));
+    command->first = frame->num_points;
+    command->count = count;
+    frame->num_points += count;
+}
+
+/**
+ * Records the outline of a rectangle.
+ *
+ * @param rect A pointer to the rectangle.
+ *
+ * @return void
+ */
+void render_draw_rect(const SDL_Rect *rect)
+{
+    if (!render_reserve((void **)&frame->rects, &frame->max_rects, frame->num_rects + 1, sizeof(SDL_Rect)))
+        return;
+
+    RenderCommand *command = render_add_command(RENDER_RECTS);
+
+    if (command == NULL)
+        return;
+
+    frame->rects[frame->num_rects] = *rect;
+    command->first = frame->num_rects;
+    command->count = 1;
+    frame->num_rects++;
+}
+
+/**
+ * Submits the commands of the frame and starts collecting statistics for the next one.
+ * Must be called once per frame, before the frame is presented, when frames are recorded
+ * and drawn on the same thread.
+ *
+ * @return void
+ */
+void render_end_frame(void)
+{
+    if (cursor != NULL)
+        SDL_SetCursor(cursor);
+
+    render_submit();
+
+    last_stats = frame->stats;
+    frame->stats = (RenderStats){0};
+    layer = RENDER_LAYER_WORLD;
+    target = NULL;
+}
+
+/**
+ * Records a filled rectangle.
+ *
+ * @param rect A pointer to the rectangle.
+ *
+ * @return void
+ */
+void render_fill_rect(const SDL_Rect *rect)
+{
+    render_fill_rects(rect, 1);
+}
+
+/**
+ * Records a series of filled rectangles.
+ *
+ * @param new_rects An array of rectangles.
+ * @param count The number of rectangles.
+ *
+ * @return void
+ */
+void render_fill_rects(const SDL_Rect *new_rects, int count)
+{
+    if (count < 1)
+        return;
+
+    if (!render_reserve((void **)&frame->rects, &frame->max_rects, frame->num_rects + count, sizeof(SDL_Rect)))
+        return;
+
+    RenderCommand *command = render_add_command(RENDER_FILL_RECTS);
+
+    if (command == NULL)
+        return;
+
+    memcpy(&frame->rects[frame->num_rects], new_rects, count * sizeof(SDL_Rect));
+    command->first = frame->num_rects;
+    command->count = count;
+    frame->num_rects += count;
+}
+
+/**
+ * Returns the points of a range of merged commands as one array. A single command
+ * is drawn from where it was recorded; Merged commands are copied past the recorded points.
+ *
+ * @param start The position of the first command in the sorted order.
+ * @param end The position after the last command in the sorted order.
+ * @param is_strip Whether the commands are line strips that share their end points.
+ * @param count A pointer to store the number of points.
+ *
+ * @return The index of the first point.
+ */
+static int render_gather_points(int start, int end, bool is_strip, int *count)
+{
+    const RenderCommand *command = &drawn->commands[drawn->order[start]];
+    int total = 0;
+
+    if (end - start == 1)
+    {
+        *count = command->count;
+        return command->first;
+    }
+
+    for (int i = start; i < end; i++)
+        total += drawn->commands[drawn->order[i]].count;
+
+    if (!render_reserve((void **)&drawn->points, &drawn->max_points, drawn->num_points + total, sizeof(SDL_Point)))
+    {
+        *count = 0;
+        return 0;
+    }
+
+    *count = 0;
+
+    for (int i = start; i < end; i++)
+    {
+        const RenderCommand *merged = &drawn->commands[drawn->order[i]];
+        int skip = is_strip && i > start ? 1 : 0;
+
+        memcpy(&drawn->points[drawn->num_points + *count], &drawn->points[merged->first + skip], (merged->count - skip) * sizeof(SDL_Point));
+        *count += merged->count - skip;
+    }
+
+    return drawn->num_points;
+}
+
+/**
+ * Returns the rectangles of a range of merged commands as one array.
+ *
+ * @param start The position of the first command in the sorted order.
+ * @param end The position after the last command in the sorted order.
+ * @param count A pointer to store the number of rectangles.
+ *
+ * @return The index of the first rectangle.
+ */
+static int render_gather_rects(int start, int end, int *count)
+{
+    const RenderCommand *command = &drawn->commands[drawn->order[start]];
+    int total = 0;
+
+    if (end - start == 1)
+    {
+        *count = command->count;
+        return command->first;
+    }
+
+    for (int i = start; i < end; i++)
+        total += drawn->commands[drawn->order[i]].count;
+
+    if (!render_reserve((void **)&drawn->rects, &drawn->max_rects, drawn->num_rects + total, sizeof(SDL_Rect)))
+    {
+        *count = 0;
+        return 0;
+    }
+
+    *count = 0;
+
+    for (int i = start; i < end; i++)
+    {
+        const RenderCommand *merged = &drawn->commands[drawn->order[i]];
+
+        memcpy(&drawn->rects[drawn->num_rects + *count], &drawn->rects[merged->first], merged->count * sizeof(SDL_Rect));
+        *count += merged->count;
+    }
+
+    return drawn->num_rects;
+}
+
+/**
+ * Records triangles. Vertices and indices are copied, so the caller can reuse its arrays.
+ *
+ * @param texture The texture to sample, or NULL for solid triangles.
+ * @param new_vertices An array of vertices.
+ * @param count The number of vertices.
+ * @param new_indices An array of vertex indices, or NULL to take the vertices in order.
+ * @param index_count The number of indices.
+ *
+ * @return void
+ */
+void render_geometry(SDL_Texture *texture, const SDL_Vertex *new_vertices, int count, const int *new_indices, int index_count)
+{
+    if (new_indices == NULL)
+        index_count = count;
+
+    if (count < 3 || index_count < 3)
+        return;
+
+    if (!render_reserve((void **)&frame->vertices, &frame->max_vertices, frame->num_vertices + count, sizeof(SDL_Vertex)) ||
+        !render_reserve((void **)&frame->indices, &frame->max_indices, frame->num_indices + index_count, sizeof(int)))
+        return;
+
+    RenderCommand *command = render_add_command(RENDER_GEOMETRY);
+
+    if (command == NULL)
+        return;
+
+    memcpy(&frame->vertices[frame->num_vertices], new_vertices, count * sizeof(SDL_Vertex));
+
+    for (int i = 0; i < index_count; i++)
+        frame->indices[frame->num_indices + i] = new_indices != NULL ? new_indices[i] : i;
+
+    command->texture = texture;
+    command->first = frame->num_vertices;
+    command->count = count;
+    command->first_index = frame->num_indices;
+    command->num_indices = index_count;
+    frame->num_vertices += count;
+    frame->num_indices += index_count;
+}
+
+/**
+ * Returns the statistics of the last frame.
+ *
+ * @return A RenderStats object.
+ */
+RenderStats render_get_stats(void)
+{
+    if (frames_mutex == NULL)
+        return last_stats;
+
+    SDL_LockMutex(frames_mutex);
+    RenderStats stats = last_stats;
+    SDL_UnlockMutex(frames_mutex);
+
+    return stats;
+}
+
+/**
+ * Hands the recorded frame over to the render thread and starts recording the next one.
+ * A frame that was not drawn yet is replaced, unless it draws into textures,
+ * whose content is kept between frames; In that case, waits until it is drawn.
+ *
+ * @return void
+ */
+void render_publish_frame(void)
+{
+    frame->cursor = cursor;
+
+    SDL_LockMutex(frames_mutex);
+
+    while (latest != NULL && latest->has_targets)
+        SDL_CondWait(frames_cond, frames_mutex);
+
+    RenderFrame *next = latest;
+
+    if (next != NULL)
+    {
+        // Textures of the replaced frame are destroyed with the new one
+        if (render_reserve((void **)&frame->destroyed_textures, &frame->max_destroyed_textures,
+                           frame->num_destroyed_textures + next->num_destroyed_textures, sizeof(SDL_Texture *)))
+        {
+            memcpy(&frame->destroyed_textures[frame->num_destroyed_textures], next->destroyed_textures,
+                   next->num_destroyed_textures * sizeof(SDL_Texture *));
+            frame->num_destroyed_textures += next->num_destroyed_textures;
+        }
+
+        render_reset_frame(next);
+    }
+    else
+    {
+        for (int i = 0; i < RENDER_FRAMES && next == NULL; i++)
+        {
+            if (&frames[i] != frame && &frames[i] != drawn)
+                next = &frames[i];
+        }
+    }
+
+    latest = frame;
+    SDL_CondBroadcast(frames_cond);
+    SDL_UnlockMutex(frames_mutex);
+
+    frame = next;
+    frame->stats = (RenderStats){0};
+    layer = RENDER_LAYER_WORLD;
+    target = NULL;
+}
+
+/**
+ * Makes sure that an array of the command buffer can hold a number of items,
+ * doubling its capacity as needed. Memory is kept between frames.
+ *
+ * @param items A pointer to the array.
+ * @param capacity A pointer to the capacity of the array.
+ * @param count The number of items the array must hold.
+ * @param item_size The size of each item.
+ *
+ * @return True if the array is large enough, false otherwise.
+ */
+static bool render_reserve(void **items, int *capacity, int count, size_t item_size)
+{
+    if (count <= *capacity)
+        return true;
+
+    int new_capacity = *capacity > 0 ? *capacity : RENDER_INITIAL_CAPACITY;
+
+    while (new_capacity < count)
+        new_capacity *= 2;
+
+    void *new_items = realloc(*items, new_capacity * item_size);
+
+    if (new_items == NULL)
+    {
+        fprintf(stderr, "Error: Could not allocate memory for render commands.\n");
+        return false;
+    }
+
+    *items = new_items;
+    *capacity = new_capacity;
+
+    return true;
+}
+
+/**
+ * Empties a frame, keeping its memory.
+ *
+ * @param empty_frame A pointer to the frame.
+ *
+ * @return void
+ */
+static void render_reset_frame(RenderFrame *empty_frame)
+{
+    empty_frame->num_commands = 0;
+    empty_frame->num_points = 0;
+    empty_frame->num_rects = 0;
+    empty_frame->num_vertices = 0;
+    empty_frame->num_indices = 0;
+    empty_frame->num_destroyed_textures = 0;
+    empty_frame->has_targets = false;
+}
+
+/**
+ * Makes a renderer call. Must be called on the render thread.
+ *
+ * @param call A pointer to the call.
+ *
+ * @return void
+ */
+static void render_run_call(RenderRequest *call)
+{
+    switch (call->type)
+    {
+    case RENDER_REQUEST_CREATE_TEXTURE:
+        call->texture = SDL_CreateTexture(renderer, call->format, call->access, call->w, call->h);
+        break;
+    case RENDER_REQUEST_CREATE_TEXTURE_FROM_SURFACE:
+        call->texture = SDL_CreateTextureFromSurface(renderer, call->surface);
+        break;
+    case RENDER_REQUEST_SET_BLEND_MODE:
+        call->result = SDL_SetTextureBlendMode(call->texture, call->blend_mode);
+        break;
+    case RENDER_REQUEST_SET_SCALE_MODE:
+        call->result = SDL_SetTextureScaleMode(call->texture, call->scale_mode);
+        break;
+    }
+
+    call->is_done = true;
+}
+
+/**
+ * Makes the pending renderer call of the recording thread, if any, and wakes the thread.
+ * Must be called on the render thread, with the frames locked.
+ *
+ * @return void
+ */
+static void render_run_request(void)
+{
+    if (request == NULL)
+        return;
+
+    render_run_call(request);
+    request = NULL;
+    SDL_CondBroadcast(frames_cond);
+}
+
+/**
+ * Sets the blend mode of the commands recorded after it.
+ *
+ * @param mode The blend mode.
+ *
+ * @return void
+ */
+void render_set_blend_mode(SDL_BlendMode mode)
+{
+    blend_mode = mode;
+}
+
+/**
+ * Sets the cursor, which is shown when the frame is drawn. The cursor is kept between frames.
+ *
+ * @param new_cursor The cursor.
+ *
+ * @return The previous cursor, so that callers can restore it.
+ */
+SDL_Cursor *render_set_cursor(SDL_Cursor *new_cursor)
+{
+    SDL_Cursor *previous_cursor = cursor;
+    cursor = new_cursor;
+
+    return previous_cursor;
+}
+
+/**
+ * Sets the color of the primitives recorded after it.
+ *
+ * @param r The red channel.
+ * @param g The green channel.
+ * @param b The blue channel.
+ * @param a The alpha channel.
+ *
+ * @return void
+ */
+void render_set_draw_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    draw_color.r = r;
+    draw_color.g = g;
+    draw_color.b = b;
+    draw_color.a = a;
+}
+
+/**
+ * Sets the layer of the commands recorded after it. Layers are drawn from back to front,
+ * whatever the order in which they were recorded. Resets to RENDER_LAYER_WORLD every frame.
+ *
+ * @param new_layer The layer.
+ *
+ * @return The previous layer, so that callers can restore it.
+ */
+unsigned short render_set_layer(unsigned short new_layer)
+{
+    unsigned short previous_layer = layer;
+    layer = new_layer;
+
+    return previous_layer;
+}
+
+/**
+ * Sets the render target of the commands recorded after it.
+ *
+ * @param new_target A target texture, or NULL for the screen.
+ *
+ * @return The previous target, so that callers can restore it.
+ */
+SDL_Texture *render_set_target(SDL_Texture *new_target)
+{
+    SDL_Texture *previous_target = target;
+    target = new_target;
+
+    return previous_target;
+}
+
+/**
+ * Sets the blend mode of a texture on the render thread.
+ *
+ * @param texture The texture.
+ * @param blend_mode The blend mode.
+ *
+ * @return True if the blend mode was set, false if the renderer does not support it.
+ */
+bool render_set_texture_blend_mode(SDL_Texture *texture, SDL_BlendMode blend_mode)
+{
+    RenderRequest call = {.type = RENDER_REQUEST_SET_BLEND_MODE, .texture = texture, .blend_mode = blend_mode};
+
+    render_call(&call);
+
+    return call.result == 0;
+}
+
+/**
+ * Sets the scale mode of a texture on the render thread.
+ *
+ * @param texture The texture.
+ * @param scale_mode The scale mode.
+ *
+ * @return void
+ */
+void render_set_texture_scale_mode(SDL_Texture *texture, SDL_ScaleMode scale_mode)
+{
+    RenderRequest call = {.type = RENDER_REQUEST_SET_SCALE_MODE, .texture = texture, .scale_mode = scale_mode};
+
+    render_call(&call);
+}
+
+/**
+ * Sorts the recorded commands by target, layer and state, merges compatible neighbours
+ * and draws them. Textures queued for destruction are destroyed afterwards.
+ * Only used when frames are recorded and drawn on the same thread.
+ *
+ * @return void
+ */
+void render_submit(void)
+{
+    drawn = frame;
+    render_draw_commands();
+}
+
+/**
+ * Waits for a new frame from the recording thread and takes it to be drawn,
+ * making the renderer calls of the recording thread in the meantime.
+ *
+ * @param timeout The maximum time to wait, in milliseconds.
+ *
+ * @return True if a frame was taken, false if there was none in time.
+ */
+bool render_wait_frame(Uint32 timeout)
+{
+    Uint32 start_time = SDL_GetTicks();
+
+    SDL_LockMutex(frames_mutex);
+
+    while (true)
+    {
+        render_run_request();
+
+        Uint32 elapsed = SDL_GetTicks() - start_time;
+
+        if (latest != NULL || elapsed >= timeout)
+            break;
+
+        SDL_CondWaitTimeout(frames_cond, frames_mutex, timeout - elapsed);
+    }
+
+    bool has_frame = latest != NULL;
+
+    if (has_frame)
+    {
+        drawn = latest;
+        latest = NULL;
+        SDL_CondBroadcast(frames_cond);
+    }
+
+    SDL_UnlockMutex(frames_mutex);
+
+    return has_frame;
+}
\ No newline at end of file
@@ -0,0 +1,433 @@
+/*
+ * replay.c
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include <SDL2/SDL.h>
+
+#include "../include/constants.h"
+#include "../include/enums.h"
+#include "../include/structs.h"
+#include "../include/replay.h"
+
+// External variable definitions
+extern SDL_DisplayMode display_mode;
+
+// Static variable definitions
+static FILE *replay_file = NULL;
+static int replay_mode = REPLAY_OFF;
+static ReplayEvent frame_events[REPLAY_MAX_FRAME_EVENTS];
+static unsigned short num_frame_events = 0;
+static unsigned short next_frame_event = 0;
+static Uint32 frame_ticks = 0;
+static int frame_mouse_x = 0;
+static int frame_mouse_y = 0;
+static Uint32 frame_checksum = 0;
+static unsigned int frames = 0;
+static unsigned int divergent_frames = 0;
+static Uint64 start_counter = 0;
+
+// Static function prototypes
+static Uint32 replay_checksum(const GameState *, const InputState *, const Ship *);
+static void replay_create_header(ReplayHeader *);
+static void replay_decode_event(const ReplayEvent *, SDL_Event *);
+static void replay_encode_event(const SDL_Event *, ReplayEvent *);
+
+/**
+ * Begins a new frame. In record mode, captures the clock and the mouse state for this frame.
+ * In playback mode, reads the next frame record from the replay file.
+ *
+ * @return False if the end of the replay file has been reached, true otherwise.
+ */
+bool replay_begin_frame(void)
+{
+    if (replay_mode == REPLAY_RECORD)
+    {
+        frame_ticks = SDL_GetTicks();
+        SDL_GetMouseState(&frame_mouse_x, &frame_mouse_y);
+        num_frame_events = 0;
+    }
+    else if (replay_mode == REPLAY_PLAY)
+    {
+        Sint32 mouse[2];
+
+        if (fread(&frame_ticks, sizeof(frame_ticks), 1, replay_file) != 1 ||
+            fread(mouse, sizeof(mouse), 1, replay_file) != 1 ||
+            fread(&num_frame_events, sizeof(num_frame_events), 1, replay_file) != 1 ||
+            num_frame_events > REPLAY_MAX_FRAME_EVENTS ||
+            fread(frame_events, sizeof(ReplayEvent), num_frame_events, replay_file) != num_frame_events ||
+            fread(&frame_checksum, sizeof(frame_checksum), 1, replay_file) != 1)
+            return false;
+
+        frame_mouse_x = mouse[0];
+        frame_mouse_y = mouse[1];
+        next_frame_event = 0;
+    }
+
+    return true;
+}
+
+/**
+ * Calculates a checksum of the simulation state at the end of a frame.
+ * Used to detect whether a replay diverges from its recording.
+ *
+ * @param game_state A pointer to the current GameState object.
+ * @param input_state A pointer to the current InputState object.
+ * @param ship A pointer to the current Ship object.
+ *
+ * @return A 32-bit FNV-1a hash of the simulation state.
+ */
+static Uint32 replay_checksum(const GameState *game_state, const InputState *input_state, const Ship *ship)
+{
+    double values[] = {
+        ship->position.x,
+        ship->position.y,
+        ship->vx,
+        ship->vy,
+        ship->angle,
+        (double)game_state->game_scale,
+        input_state->mouse_position.x,
+        input_state->mouse_position.y,
+        game_state->state};
+
+    const unsigned char *bytes = (const unsigned char *)values;
+    Uint32 hash = 2166136261u;
+
+    for (size_t i = 0; i < sizeof(values); i++)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/**
+ * Fills a replay header with the settings that affect procedural generation.
+ *
+ * @param header A pointer to the ReplayHeader to fill.
+ *
+ * @return void
+ */
+static void replay_create_header(ReplayHeader *header)
+{
+    memset(header, 0, sizeof(ReplayHeader));
+    memcpy(header->magic, REPLAY_MAGIC, sizeof(header->magic));
+    header->version = REPLAY_VERSION;
+    header->display_w = display_mode.w;
+    header->display_h = display_mode.h;
+    header->fps = FPS;
+    header->galaxy_scale = GALAXY_SCALE;
+    header->universe_start_x = UNIVERSE_START_X;
+    header->universe_start_y = UNIVERSE_START_Y;
+    header->galaxy_start_x = GALAXY_START_X;
+    header->galaxy_start_y = GALAXY_START_Y;
+}
+
+/**
+ * Converts a recorded event back to an SDL_Event.
+ *
+ * @param replay_event A pointer to the recorded event.
+ * @param event A pointer to the SDL_Event to fill.
+ *
+ * @return void
+ */
+static void replay_decode_event(const ReplayEvent *replay_event, SDL_Event *event)
+{
+    memset(event, 0, sizeof(SDL_Event));
+    event->type = replay_event->type;
+
+    switch (replay_event->type)
+    {
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+        event->button.x = replay_event->x;
+        event->button.y = replay_event->y;
+        event->button.button = replay_event->code;
+        break;
+    case SDL_MOUSEMOTION:
+        event->motion.x = replay_event->x;
+        event->motion.y = replay_event->y;
+        event->motion.state = replay_event->code;
+        break;
+    case SDL_MOUSEWHEEL:
+        event->wheel.x = replay_event->x;
+        event->wheel.y = replay_event->y;
+        break;
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+        event->key.keysym.scancode = replay_event->code;
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * Converts an SDL_Event to its compact recorded form.
+ *
+ * @param event A pointer to the SDL_Event to convert.
+ * @param replay_event A pointer to the ReplayEvent to fill.
+ *
+ * @return void
+ */
+static void replay_encode_event(const SDL_Event *event, ReplayEvent *replay_event)
+{
+    memset(replay_event, 0, sizeof(ReplayEvent));
+    replay_event->type = event->type;
+
+    switch (event->type)
+    {
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+        replay_event->x = event->button.x;
+        replay_event->y = event->button.y;
+        replay_event->code = event->button.button;
+        break;
+    case SDL_MOUSEMOTION:
+        replay_event->x = event->motion.x;
+        replay_event->y = event->motion.y;
+        replay_event->code = event->motion.state;
+        break;
+    case SDL_MOUSEWHEEL:
+        replay_event->x = event->wheel.x;
+        replay_event->y = event->wheel.y;
+        break;
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+        replay_event->code = event->key.keysym.scancode;
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * Ends the current frame. In record mode, writes the frame record to the replay file.
+ * In playback mode, compares the simulation state with the recorded one.
+ *
+ * @param game_state A pointer to the current GameState object.
+ * @param input_state A pointer to the current InputState object.
+ * @param ship A pointer to the current Ship object.
+ *
+ * @return void
+ */
+void replay_end_frame(const GameState *game_state, const InputState *input_state, const Ship *ship)
+{
+    if (replay_mode == REPLAY_OFF)
+        return;
+
+    Uint32 checksum = replay_checksum(game_state, input_state, ship);
+
+    if (replay_mode == REPLAY_RECORD)
+    {
+        Sint32 mouse[2] = {frame_mouse_x, frame_mouse_y};
+
+        fwrite(&frame_ticks, sizeof(frame_ticks), 1, replay_file);
+        fwrite(mouse, sizeof(mouse), 1, replay_file);
+        fwrite(&num_frame_events, sizeof(num_frame_events), 1, replay_file);
+        fwrite(frame_events, sizeof(ReplayEvent), num_frame_events, replay_file);
+        fwrite(&checksum, sizeof(checksum), 1, replay_file);
+    }
+    else if (replay_mode == REPLAY_PLAY)
+    {
+        if (checksum != frame_checksum)
+        {
+            if (divergent_frames == 0)
+                fprintf(stderr, "Warning: Replay diverged from recording at frame %u.\n", frames);
+
+            divergent_frames++;
+        }
+    }
+
+    frames++;
+}
+
+/**
+ * Returns the mouse position of the current frame.
+ * While recording or playing back, all calls within a frame return the recorded frame position.
+ *
+ * @param x A pointer to store the x-coordinate of the mouse.
+ * @param y A pointer to store the y-coordinate of the mouse.
+ *
+ * @return void
+ */
+void replay_get_mouse_state(int *x, int *y)
+{
+    if (replay_mode == REPLAY_OFF)
+    {
+        SDL_GetMouseState(x, y);
+        return;
+    }
+
+    *x = frame_mouse_x;
+    *y = frame_mouse_y;
+}
+
+/**
+ * Returns the number of milliseconds since SDL was initialized.
+ * While recording or playing back, all calls within a frame return the recorded frame time.
+ *
+ * @return The number of milliseconds as an unsigned 32-bit integer.
+ */
+Uint32 replay_get_ticks(void)
+{
+    if (replay_mode == REPLAY_OFF)
+        return SDL_GetTicks();
+
+    return frame_ticks;
+}
+
+/**
+ * Checks whether a replay is being played back.
+ *
+ * @return True if in playback mode, false otherwise.
+ */
+bool replay_is_playing(void)
+{
+    return replay_mode == REPLAY_PLAY;
+}
+
+/**
+ * Event source that wraps SDL_PollEvent. In record mode, every polled event is also stored
+ * in the current frame record. In playback mode, events come from the replay file.
+ *
+ * @param event A pointer to the SDL_Event to fill.
+ *
+ * @return 1 if an event was returned, 0 if there are no more events for this frame.
+ */
+int replay_poll_event(SDL_Event *event)
+{
+    if (replay_mode == REPLAY_PLAY)
+    {
+        if (next_frame_event >= num_frame_events)
+            return 0;
+
+        replay_decode_event(&frame_events[next_frame_event++], event);
+
+        return 1;
+    }
+
+    if (!SDL_PollEvent(event))
+        return 0;
+
+    if (replay_mode == REPLAY_RECORD)
+    {
+        if (num_frame_events < REPLAY_MAX_FRAME_EVENTS)
+            replay_encode_event(event, &frame_events[num_frame_events++]);
+        else
+            fprintf(stderr, "Warning: Dropped event from recording at frame %u.\n", frames);
+    }
+
+    return 1;
+}
+
+/**
+ * Opens a replay file for playback and applies its recorded display size.
+ * Must be called before the game is reset, since the display size affects generation.
+ *
+ * @param path The path of the replay file.
+ *
+ * @return True if the replay file is valid, false otherwise.
+ */
+bool replay_start_playback(const char *path)
+{
+    replay_file = fopen(path, "rb");
+
+    if (replay_file == NULL)
+    {
+        fprintf(stderr, "Error: Could not open replay file %s.\n", path);
+        return false;
+    }
+
+    ReplayHeader header;
+    ReplayHeader expected;
+    replay_create_header(&expected);
+
+    if (fread(&header, sizeof(ReplayHeader), 1, replay_file) != 1 ||
+        memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+        header.version != expected.version)
+    {
+        fprintf(stderr, "Error: Invalid replay file %s.\n", path);
+        fclose(replay_file);
+        replay_file = NULL;
+        return false;
+    }
+
+    if (header.fps != expected.fps ||
+        header.galaxy_scale != expected.galaxy_scale ||
+        header.universe_start_x != expected.universe_start_x ||
+        header.universe_start_y != expected.universe_start_y ||
+        header.galaxy_start_x != expected.galaxy_start_x ||
+        header.galaxy_start_y != expected.galaxy_start_y)
+    {
+        fprintf(stderr, "Error: Replay file %s was recorded with different settings.\n", path);
+        fclose(replay_file);
+        replay_file = NULL;
+        return false;
+    }
+
+    // Generation depends on camera size, so use the recorded one
+    display_mode.w = header.display_w;
+    display_mode.h = header.display_h;
+
+    replay_mode = REPLAY_PLAY;
+    frames = 0;
+    divergent_frames = 0;
+    start_counter = SDL_GetPerformanceCounter();
+
+    return true;
+}
+
+/**
+ * Opens a replay file for recording and writes its header.
+ *
+ * @param path The path of the replay file.
+ *
+ * @return True if the replay file was created, false otherwise.
+ */
+bool replay_start_recording(const char *path)
+{
+    replay_file = fopen(path, "wb");
+
+    if (replay_file == NULL)
+    {
+        fprintf(stderr, "Error: Could not create replay file %s.\n", path);
+        return false;
+    }
+
+    ReplayHeader header;
+    replay_create_header(&header);
+    fwrite(&header, sizeof(ReplayHeader), 1, replay_file);
+
+    replay_mode = REPLAY_RECORD;
+    frames = 0;
+
+    return true;
+}
+
+/**
+ * Closes the replay file. After playback, prints a summary of the run.
+ *
+ * @return void
+ */
+void replay_stop(void)
+{
+    if (replay_mode == REPLAY_OFF)
+        return;
+
+    if (replay_mode == REPLAY_PLAY)
+    {
+        double elapsed = (double)(SDL_GetPerformanceCounter() - start_counter) * 1000 / SDL_GetPerformanceFrequency();
+
+        printf("Replay: %u frames in %.1f ms (%.3f ms/frame), %u divergent frames\n",
+               frames, elapsed, frames > 0 ? elapsed / frames : 0, divergent_frames);
+    }
+
+    fclose(replay_file);
+    replay_file = NULL;
+    replay_mode = REPLAY_OFF;
+}
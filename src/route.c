@@ -0,0 +1,1322 @@
+/*
+ * route.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include <SDL2/SDL.h>
+#include "../lib/pcg-c-basic-0.9/pcg_basic.h"
+
+#include "../include/constants.h"
+#include "../include/enums.h"
+#include "../include/structs.h"
+#include "../include/route.h"
+
+// Static variable definitions
+static RouteJob *job = NULL; // Route of the waypoint being planned
+static bool is_async = true;
+static RouteCacheEntry cache[ROUTE_CACHE_SIZE];
+static unsigned int cache_clock = 0;
+
+// Static function prototypes
+static int route_add_obstacle(RoutePlanner *, RouteSection *);
+static int route_build_path(RoutePlanner *, int last_node, PathPoint **path);
+static PathPoint *route_connect_cached_path(const NavigationState *, const RouteJob *, const RouteCacheEntry *, int *num_points);
+static void route_destroy_planner(RoutePlanner *);
+static void route_expand(RoutePlanner *, int node);
+static int route_find_blocker(RoutePlanner *, Point a, Point b);
+static RouteCacheEntry *route_find_cache_entry(const RouteKey *);
+static void route_free_cache_entry(RouteCacheEntry *);
+static double route_get_cutoff(RoutePlanner *, RouteSection *);
+static int route_get_node_obstacle(int node);
+static Point route_get_node_position(const RoutePlanner *, int node);
+static RouteSection *route_get_section(RoutePlanner *, int64_t x, int64_t y);
+static bool route_grow_sections(RoutePlanner *);
+static bool route_init_planner(RoutePlanner *, Galaxy *, uint64_t initseq, Point start, Point destination);
+static bool route_is_segment_clear(const NavigationState *, const RouteJob *, Point a, Point b);
+static int route_pop_open(RoutePlanner *);
+static void route_publish_path(RouteJob *, PathPoint *path, int num_points, bool is_complete, float progress);
+static void route_push_open(RoutePlanner *, int node, double f);
+static void route_relax(RoutePlanner *, int from, int to);
+static void route_relax_tangents(RoutePlanner *, int from, int obstacle, int depth);
+static void route_relax_vertex(RoutePlanner *, int from, int to, int depth);
+static void route_release_job(RouteJob *);
+static void route_run_job(void *data);
+static unsigned short route_search(RoutePlanner *, int max_expansions);
+static void route_store_cache(const RouteKey *, const PathPoint *path, int num_points);
+
+/**
+ * Adds the star of a section to the obstacles of the planner, together with the nodes around it.
+ *
+ * @param planner A pointer to the RoutePlanner.
+ * @param section A pointer to a section with a star.
+ *
+ * @return The index of the obstacle, or -1 if memory could not be allocated.
+ */
+static int route_add_obstacle(RoutePlanner *planner, RouteSection *section)
+{
+    if (section->obstacle >= 0)
+        return section->obstacle;
+
+    if (planner->num_obstacles >= planner->max_obstacles)
+    {
+        int max_obstacles = 2 * planner->max_obstacles;
+        RouteObstacle *obstacles = realloc(planner->obstacles, max_obstacles * sizeof(RouteObstacle));
+
+        if (obstacles != NULL)
+            planner->obstacles = obstacles;
+
+        RouteNode *nodes = realloc(planner->nodes, (ROUTE_NODE_VERTICES + max_obstacles * ROUTE_OBSTACLE_VERTICES) * sizeof(RouteNode));
+
+        if (nodes != NULL)
+            planner->nodes = nodes;
+
+        if (obstacles == NULL || nodes == NULL)
+        {
+            fprintf(stderr, "Error: Could not allocate memory for route obstacles.\n");
+            planner->is_out_of_memory = true;
+            return -1;
+        }
+
+        for (int i = ROUTE_NODE_VERTICES + planner->max_obstacles * ROUTE_OBSTACLE_VERTICES; i < ROUTE_NODE_VERTICES + max_obstacles * ROUTE_OBSTACLE_VERTICES; i++)
+            planner->nodes[i] = (RouteNode){.g = INFINITY, .parent = -1, .is_closed = false};
+
+        planner->max_obstacles = max_obstacles;
+    }
+
+    RouteObstacle *obstacle = &planner->obstacles[planner->num_obstacles];
+    obstacle->position.x = section->x * (double)GALAXY_SECTION_SIZE;
+    obstacle->position.y = section->y * (double)GALAXY_SECTION_SIZE;
+    obstacle->cutoff = route_get_cutoff(planner, section);
+
+    section->obstacle = planner->num_obstacles++;
+
+    return section->obstacle;
+}
+
+/**
+ * Runs the route planner on routes of increasing length through the current galaxy, up to its diameter,
+ * and prints the planning time, the size of the search and the length of the routes.
+ *
+ * @param nav_state A pointer to the current NavigationState object.
+ * @param runs The number of routes to plan for each length.
+ *
+ * @return void
+ */
+void route_benchmark(const NavigationState *nav_state, int runs)
+{
+    double diameter = 2 * nav_state->current_galaxy->radius * GALAXY_SCALE;
+
+    // Use a local rng, so that every run plans the same routes
+    pcg32_random_t rng;
+    pcg32_srandom_r(&rng, ROUTE_BENCHMARK_SEED, nav_state->initseq);
+
+    printf("Route benchmark: galaxy %s, %.0f sections wide, %d routes per length\n",
+           nav_state->current_galaxy->name, diameter / GALAXY_SECTION_SIZE, runs);
+    printf("  %8s %10s %10s %10s %10s %8s %8s\n", "sections", "ms/route", "max ms", "nodes", "obstacles", "stretch", "failed");
+
+    for (double length = GALAXY_SECTION_SIZE; length <= 2 * diameter; length *= 2)
+    {
+        if (length > diameter)
+            length = diameter;
+
+        double total_time = 0;
+        double max_time = 0;
+        double total_stretch = 0;
+        long total_nodes = 0;
+        long total_obstacles = 0;
+        int failed = 0;
+
+        for (int i = 0; i < runs; i++)
+        {
+            // Routes run in random directions, through random points that keep both ends inside the galaxy
+            double angle = (pcg32_random_r(&rng) % 3600) * M_PI / 1800;
+            double max_offset = sqrt(diameter * diameter - length * length) / 2;
+            double offset = ((pcg32_random_r(&rng) % 2001) / 1000.0 - 1) * max_offset;
+            Point center = {.x = -sin(angle) * offset, .y = cos(angle) * offset};
+            Point start = {.x = center.x - cos(angle) * length / 2, .y = center.y - sin(angle) * length / 2};
+            Point destination = {.x = center.x + cos(angle) * length / 2, .y = center.y + sin(angle) * length / 2};
+
+            RoutePlanner planner;
+            PathPoint *path = NULL;
+            int num_points = 0;
+            Uint64 start_counter = SDL_GetPerformanceCounter();
+
+            if (route_init_planner(&planner, nav_state->current_galaxy, nav_state->initseq, start, destination))
+            {
+                if (route_search(&planner, ROUTE_MAX_EXPANSIONS) == ROUTE_SEARCH_FOUND)
+                    num_points = route_build_path(&planner, ROUTE_NODE_DESTINATION, &path);
+
+                total_nodes += planner.expansions;
+                total_obstacles += planner.num_obstacles;
+                route_destroy_planner(&planner);
+            }
+
+            double elapsed = (double)(SDL_GetPerformanceCounter() - start_counter) * 1000 / SDL_GetPerformanceFrequency();
+            total_time += elapsed;
+
+            if (elapsed > max_time)
+                max_time = elapsed;
+
+            if (num_points == 0)
+            {
+                failed++;
+                continue;
+            }
+
+            double path_length = 0;
+
+            for (int j = 1; j < num_points; j++)
+                path_length += hypot(path[j].position.x - path[j - 1].position.x, path[j].position.y - path[j - 1].position.y);
+
+            total_stretch += path_length / length;
+            free(path);
+        }
+
+        printf("  %8.0f %10.3f %10.3f %10.0f %10.0f %8.4f %8d\n",
+               length / GALAXY_SECTION_SIZE, total_time / runs, max_time,
+               (double)total_nodes / runs, (double)total_obstacles / runs,
+               runs > failed ? total_stretch / (runs - failed) : 0, failed);
+
+        if (length >= diameter)
+            break;
+    }
+}
+
+/**
+ * Builds the path found by the search, from the start to a node. Points that can be skipped
+ * with a clear line are left out. If the node is not the destination, the destination is added
+ * after it, so that a partial path still leads to the destination.
+ *
+ * @param planner A pointer to the RoutePlanner.
+ * @param last_node The last node of the path.
+ * @param path A pointer to the array of path points to allocate. The caller must free it.
+ *
+ * @return The number of points in the path, or 0 if memory could not be allocated.
+ */
+static int route_build_path(RoutePlanner *planner, int last_node, PathPoint **path)
+{
+    int num_nodes = last_node == ROUTE_NODE_DESTINATION ? 0 : 1;
+
+    for (int node = last_node; node >= 0; node = planner->nodes[node].parent)
+        num_nodes++;
+
+    Point *points = malloc(num_nodes * sizeof(Point));
+    *path = malloc(num_nodes * sizeof(PathPoint));
+
+    if (points == NULL || *path == NULL)
+    {
+        fprintf(stderr, "Error: Could not allocate memory for route.\n");
+        free(points);
+        free(*path);
+        *path = NULL;
+        return 0;
+    }
+
+    int i = num_nodes;
+
+    if (last_node != ROUTE_NODE_DESTINATION)
+        points[--i] = planner->destination;
+
+    for (int node = last_node; node >= 0; node = planner->nodes[node].parent)
+        points[--i] = route_get_node_position(planner, node);
+
+    // Shorten the path where a later point is in line of sight
+    int num_points = 0;
+    i = 0;
+
+    (*path)[num_points++] = (PathPoint){.type = PATH_POINT_STRAIGHT, .position = points[0]};
+
+    while (i < num_nodes - 1)
+    {
+        int next = i + 1;
+
+        for (int j = i + ROUTE_SMOOTHING_LOOKAHEAD < num_nodes - 1 ? i + ROUTE_SMOOTHING_LOOKAHEAD : num_nodes - 1; j > i + 1; j--)
+        {
+            if (route_find_blocker(planner, points[i], points[j]) == ROUTE_BLOCKER_NONE)
+            {
+                next = j;
+                break;
+            }
+        }
+
+        (*path)[num_points++] = (PathPoint){.type = PATH_POINT_TURN, .position = points[next]};
+        i = next;
+    }
+
+    (*path)[num_points - 1].type = PATH_POINT_STRAIGHT;
+    free(points);
+
+    return num_points;
+}
+
+/**
+ * Cancels the route being planned. The planning job stops at its next step and frees the job.
+ *
+ * @return void
+ */
+void route_cancel_job(void)
+{
+    if (job == NULL)
+        return;
+
+    jobs_cancel_handle(&job->handle);
+    route_release_job(job);
+    job = NULL;
+}
+
+/**
+ * Removes all cached routes, e.g. when a new game starts.
+ *
+ * @return void
+ */
+void route_clear_cache(void)
+{
+    for (int i = 0; i < ROUTE_CACHE_SIZE; i++)
+        route_free_cache_entry(&cache[i]);
+}
+
+/**
+ * Connects the start of a job to a cached route. The connector is a straight segment
+ * from the start to the start of the cached route. The last segment is moved to the destination,
+ * since a planet moves after the route is planned. The rest of the route was checked when it was planned,
+ * so only these two segments are checked again; Neither may cross a star cutoff.
+ *
+ * @param nav_state A pointer to the current NavigationState object.
+ * @param job A pointer to the RouteJob.
+ * @param entry A pointer to the cached route.
+ * @param num_points A pointer to the number of points of the connected path.
+ *
+ * @return The connected path, which the caller must free, or NULL if the route must be planned again.
+ */
+static PathPoint *route_connect_cached_path(const NavigationState *nav_state, const RouteJob *job, const RouteCacheEntry *entry, int *num_points)
+{
+    Point cached_start = entry->path[0].position;
+    Point cached_destination = entry->path[entry->num_points - 1].position;
+    bool has_connector = cached_start.x != job->start.x || cached_start.y != job->start.y;
+    bool has_moved = cached_destination.x != job->destination.x || cached_destination.y != job->destination.y;
+
+    if (has_connector && !route_is_segment_clear(nav_state, job, job->start, cached_start))
+        return NULL;
+
+    if (has_moved && !route_is_segment_clear(nav_state, job, entry->path[entry->num_points - 2].position, job->destination))
+        return NULL;
+
+    *num_points = entry->num_points + (has_connector ? 1 : 0);
+    PathPoint *path = malloc(*num_points * sizeof(PathPoint));
+
+    if (path == NULL)
+    {
+        fprintf(stderr, "Error: Could not allocate memory for route.\n");
+        return NULL;
+    }
+
+    memcpy(&path[has_connector ? 1 : 0], entry->path, entry->num_points * sizeof(PathPoint));
+
+    if (has_connector)
+    {
+        path[0] = (PathPoint){.type = PATH_POINT_STRAIGHT, .position = job->start};
+        path[1].type = PATH_POINT_TURN;
+    }
+
+    // A planet has moved since the route was planned
+    path[*num_points - 1].position = job->destination;
+
+    return path;
+}
+
+/**
+ * Frees the memory of a planner.
+ *
+ * @param planner A pointer to the RoutePlanner.
+ *
+ * @return void
+ */
+static void route_destroy_planner(RoutePlanner *planner)
+{
+    free(planner->sections);
+    free(planner->obstacles);
+    free(planner->nodes);
+    free(planner->open);
+
+    planner->sections = NULL;
+    planner->obstacles = NULL;
+    planner->nodes = NULL;
+    planner->open = NULL;
+}
+
+/**
+ * Expands a node. Its successors are the destination if it is in line of sight, the tangent vertices
+ * of the first star that blocks the way to the destination, and the neighbor vertices on its own star.
+ *
+ * @param planner A pointer to the RoutePlanner.
+ * @param node The node to expand.
+ *
+ * @return void
+ */
+static void route_expand(RoutePlanner *planner, int node)
+{
+    int obstacle = route_get_node_obstacle(node);
+    int blocker = route_find_blocker(planner, route_get_node_position(planner, node), planner->destination);
+
+    // The search fails at its next step
+    if (blocker == ROUTE_BLOCKER_ERROR)
+        return;
+
+    if (blocker == ROUTE_BLOCKER_NONE)
+        route_relax(planner, node, ROUTE_NODE_DESTINATION);
+    else if (blocker != obstacle)
+        route_relax_tangents(planner, node, blocker, 0);
+
+    // Go around the star of the node
+    if (obstacle >= 0)
+    {
+        int first = ROUTE_NODE_VERTICES + obstacle * ROUTE_OBSTACLE_VERTICES;
+        int vertex = node - first;
+
+        route_relax_vertex(planner, node, first + (vertex + 1) % ROUTE_OBSTACLE_VERTICES, 0);
+        route_relax_vertex(planner, node, first + (vertex + ROUTE_OBSTACLE_VERTICES - 1) % ROUTE_OBSTACLE_VERTICES, 0);
+    }
+}
+
+/**
+ * Finds the first star whose cutoff blocks a segment. Stars around the start or the destination
+ * do not block. Section occupancy is evaluated lazily, only along the segment, and star classes
+ * only for stars that are close enough to reach it.
+ *
+ * @param planner A pointer to the RoutePlanner.
+ * @param a The start of the segment.
+ * @param b The end of the segment.
+ *
+ * @return The obstacle index of the star, ROUTE_BLOCKER_NONE if the segment is clear, or ROUTE_BLOCKER_ERROR
+ *         if memory could not be allocated, in which case the planner is out of memory.
+ */
+static int route_find_blocker(RoutePlanner *planner, Point a, Point b)
+{
+    double max_cutoff = STAR_6 * GALAXY_SECTION_SIZE / 2.0;
+    double dx = b.x - a.x;
+    double dy = b.y - a.y;
+    double length_squared = dx * dx + dy * dy;
+
+    // Sweep the sections along the major axis (u) of the segment, from a to b
+    bool is_steep = fabs(dy) > fabs(dx);
+    double u_a = (is_steep ? a.y : a.x) / GALAXY_SECTION_SIZE;
+    double v_a = (is_steep ? a.x : a.y) / GALAXY_SECTION_SIZE;
+    double u_b = (is_steep ? b.y : b.x) / GALAXY_SECTION_SIZE;
+    double v_b = (is_steep ? b.x : b.y) / GALAXY_SECTION_SIZE;
+    int step = u_b >= u_a ? 1 : -1;
+    double slope = u_b != u_a ? (v_b - v_a) / (u_b - u_a) : 0;
+    int64_t u_first = step > 0 ? (int64_t)floor(u_a) - ROUTE_SECTION_MARGIN : (int64_t)ceil(u_a) + ROUTE_SECTION_MARGIN;
+    int64_t u_last = step > 0 ? (int64_t)ceil(u_b) + ROUTE_SECTION_MARGIN : (int64_t)floor(u_b) - ROUTE_SECTION_MARGIN;
+    // The blocker is kept by position, since the table may grow during the sweep
+    bool has_blocker = false;
+    int64_t blocker_x = 0;
+    int64_t blocker_y = 0;
+    double blocker_t = INFINITY;
+
+    for (int64_t u = u_first; (u - u_last) * step <= 0; u += step)
+    {
+        // Stars in later columns are closest to the segment further along it than the blocker
+        if (has_blocker && ((u - u_a) * step - ROUTE_SECTION_MARGIN) > blocker_t * fabs(u_b - u_a))
+            break;
+
+        // Part of the segment that stars in this column can reach
+        double from = fmax(fmin(u_a, u_b), u - ROUTE_SECTION_MARGIN);
+        double to = fmin(fmax(u_a, u_b), u + ROUTE_SECTION_MARGIN);
+
+        if (from > to)
+            from = to = fabs(u - u_a) < fabs(u - u_b) ? u_a : u_b;
+
+        double w1 = v_a + (from - u_a) * slope;
+        double w2 = v_a + (to - u_a) * slope;
+        int64_t v_min = (int64_t)floor(fmin(w1, w2)) - ROUTE_SECTION_MARGIN;
+        int64_t v_max = (int64_t)ceil(fmax(w1, w2)) + ROUTE_SECTION_MARGIN;
+
+        for (int64_t v = v_min; v <= v_max; v++)
+        {
+            int64_t x = is_steep ? v : u;
+            int64_t y = is_steep ? u : v;
+            RouteSection *section = route_get_section(planner, x, y);
+
+            if (section == NULL)
+                return ROUTE_BLOCKER_ERROR;
+
+            if (!section->has_star)
+                continue;
+
+            // Closest point of the segment to the star
+            Point center = {.x = x * (double)GALAXY_SECTION_SIZE, .y = y * (double)GALAXY_SECTION_SIZE};
+            double t = length_squared > 0 ? ((center.x - a.x) * dx + (center.y - a.y) * dy) / length_squared : 0;
+            t = fmax(0, fmin(1, t));
+
+            double distance = hypot(a.x + t * dx - center.x, a.y + t * dy - center.y);
+
+            if (distance >= max_cutoff || t >= blocker_t)
+                continue;
+
+            double cutoff = route_get_cutoff(planner, section);
+
+            if (distance >= cutoff)
+                continue;
+
+            if (hypot(planner->start.x - center.x, planner->start.y - center.y) < cutoff ||
+                hypot(planner->destination.x - center.x, planner->destination.y - center.y) < cutoff)
+                continue;
+
+            has_blocker = true;
+            blocker_x = x;
+            blocker_y = y;
+            blocker_t = t;
+        }
+    }
+
+    if (!has_blocker)
+        return ROUTE_BLOCKER_NONE;
+
+    int obstacle = route_add_obstacle(planner, route_get_section(planner, blocker_x, blocker_y));
+
+    return obstacle >= 0 ? obstacle : ROUTE_BLOCKER_ERROR;
+}
+
+/**
+ * Finds the cached route of a key.
+ *
+ * @param key A pointer to the RouteKey.
+ *
+ * @return A pointer to the cached route, or NULL if there is none.
+ */
+static RouteCacheEntry *route_find_cache_entry(const RouteKey *key)
+{
+    for (int i = 0; i < ROUTE_CACHE_SIZE; i++)
+    {
+        if (cache[i].in_use &&
+            cache[i].key.section_x == key->section_x && cache[i].key.section_y == key->section_y &&
+            cache[i].key.planet_index == key->planet_index &&
+            cache[i].key.star_position.x == key->star_position.x && cache[i].key.star_position.y == key->star_position.y &&
+            cache[i].key.galaxy_position.x == key->galaxy_position.x && cache[i].key.galaxy_position.y == key->galaxy_position.y)
+        {
+            cache[i].last_used = ++cache_clock;
+            return &cache[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Frees a cached route.
+ *
+ * @param entry A pointer to the cached route.
+ *
+ * @return void
+ */
+static void route_free_cache_entry(RouteCacheEntry *entry)
+{
+    free(entry->path);
+    *entry = (RouteCacheEntry){0};
+}
+
+/**
+ * Returns the cutoff of the star in a section. The class of the star is calculated the first time.
+ *
+ * @param planner A pointer to the RoutePlanner.
+ * @param section A pointer to a section with a star.
+ *
+ * @return The cutoff of the star.
+ */
+static double route_get_cutoff(RoutePlanner *planner, RouteSection *section)
+{
+    if (section->class == 0)
+    {
+        Point position = {.x = section->x * (double)GALAXY_SECTION_SIZE, .y = section->y * (double)GALAXY_SECTION_SIZE};
+        double distance = stars_nearest_star_distance(position, planner->galaxy, planner->initseq, GALAXY_DENSITY);
+
+        section->class = stars_size_class(distance);
+    }
+
+    return GALAXY_SECTION_SIZE * section->class / 2.0;
+}
+
+/**
+ * Returns the obstacle a node is a vertex of.
+ *
+ * @param node The node.
+ *
+ * @return The obstacle index, or -1 for the start and the destination.
+ */
+static int route_get_node_obstacle(int node)
+{
+    if (node < ROUTE_NODE_VERTICES)
+        return -1;
+
+    return (node - ROUTE_NODE_VERTICES) / ROUTE_OBSTACLE_VERTICES;
+}
+
+/**
+ * Returns the position of a node. Vertices lie on a polygon whose edges keep ROUTE_CLEARANCE from the star.
+ *
+ * @param planner A pointer to the RoutePlanner.
+ * @param node The node.
+ *
+ * @return The position of the node.
+ */
+static Point route_get_node_position(const RoutePlanner *planner, int node)
+{
+    if (node == ROUTE_NODE_START)
+        return planner->start;
+
+    if (node == ROUTE_NODE_DESTINATION)
+        return planner->destination;
+
+    const RouteObstacle *obstacle = &planner->obstacles[route_get_node_obstacle(node)];
+    int vertex = (node - ROUTE_NODE_VERTICES) % ROUTE_OBSTACLE_VERTICES;
+    double radius = obstacle->cutoff * ROUTE_CLEARANCE / cos(M_PI / ROUTE_OBSTACLE_VERTICES);
+    double angle = 2 * M_PI * vertex / ROUTE_OBSTACLE_VERTICES;
+
+    return (Point){.x = obstacle->position.x + radius * cos(angle), .y = obstacle->position.y + radius * sin(angle)};
+}
+
+/**
+ * Returns the progress of the route being planned, as the part of the distance to the destination
+ * covered by the best partial path.
+ *
+ * @return The progress, from 0 to 1.
+ */
+float route_get_progress(void)
+{
+    if (job == NULL)
+        return 1;
+
+    SDL_LockMutex(job->mutex);
+    float progress = job->progress;
+    SDL_UnlockMutex(job->mutex);
+
+    return progress;
+}
+
+/**
+ * Returns a section from the occupancy table, and checks whether it has a star the first time it is requested.
+ *
+ * @param planner A pointer to the RoutePlanner.
+ * @param x The x-coordinate of the section, in sections.
+ * @param y The y-coordinate of the section, in sections.
+ *
+ * @return A pointer to the section, or NULL if the memory budget has been reached.
+ */
+static RouteSection *route_get_section(RoutePlanner *planner, int64_t x, int64_t y)
+{
+    uint64_t hash = (uint64_t)x * 0x9E3779B97F4A7C15ULL ^ (uint64_t)y * 0xC2B2AE3D27D4EB4FULL;
+    int mask = planner->max_sections - 1;
+    int index = (int)((hash ^ (hash >> 32)) & mask);
+
+    while (planner->sections[index].in_use)
+    {
+        if (planner->sections[index].x == x && planner->sections[index].y == y)
+            return &planner->sections[index];
+
+        index = (index + 1) & mask;
+    }
+
+    // Keep the table at most half full
+    if (2 * (planner->num_sections + 1) > planner->max_sections)
+    {
+        if (!route_grow_sections(planner))
+            return NULL;
+
+        return route_get_section(planner, x, y);
+    }
+
+    RouteSection *section = &planner->sections[index];
+    section->in_use = true;
+    section->x = x;
+    section->y = y;
+    section->has_star = stars_section_has_star((Point){.x = x * (double)GALAXY_SECTION_SIZE, .y = y * (double)GALAXY_SECTION_SIZE}, planner->galaxy, planner->initseq);
+    section->class = 0;
+    section->obstacle = -1;
+    planner->num_sections++;
+
+    return section;
+}
+
+/**
+ * Doubles the size of the occupancy table.
+ *
+ * @param planner A pointer to the RoutePlanner.
+ *
+ * @return True if the table was resized, false if the memory budget has been reached.
+ */
+static bool route_grow_sections(RoutePlanner *planner)
+{
+    int max_sections = 2 * planner->max_sections;
+
+    if (max_sections > ROUTE_MAX_SECTIONS)
+    {
+        planner->is_out_of_memory = true;
+        return false;
+    }
+
+    RouteSection *sections = calloc(max_sections, sizeof(RouteSection));
+
+    if (sections == NULL)
+    {
+        fprintf(stderr, "Error: Could not allocate memory for route sections.\n");
+        planner->is_out_of_memory = true;
+        return false;
+    }
+
+    RouteSection *old_sections = planner->sections;
+    int old_max_sections = planner->max_sections;
+
+    planner->sections = sections;
+    planner->max_sections = max_sections;
+
+    for (int i = 0; i < old_max_sections; i++)
+    {
+        if (!old_sections[i].in_use)
+            continue;
+
+        uint64_t hash = (uint64_t)old_sections[i].x * 0x9E3779B97F4A7C15ULL ^ (uint64_t)old_sections[i].y * 0xC2B2AE3D27D4EB4FULL;
+        int index = (int)((hash ^ (hash >> 32)) & (max_sections - 1));
+
+        while (sections[index].in_use)
+            index = (index + 1) & (max_sections - 1);
+
+        sections[index] = old_sections[i];
+    }
+
+    free(old_sections);
+
+    return true;
+}
+
+/**
+ * Allocates the memory of a planner for a route between two points, and adds the start to the open set.
+ *
+ * @param planner A pointer to the RoutePlanner to initialize.
+ * @param galaxy A pointer to the Galaxy of the route.
+ * @param initseq The initialization sequence used for the RNG of stars.
+ * @param start The start of the route.
+ * @param destination The destination of the route.
+ *
+ * @return True if the planner was initialized, false otherwise.
+ */
+static bool route_init_planner(RoutePlanner *planner, Galaxy *galaxy, uint64_t initseq, Point start, Point destination)
+{
+    *planner = (RoutePlanner){0};
+    planner->galaxy = galaxy;
+    planner->initseq = initseq;
+    planner->start = start;
+    planner->destination = destination;
+    planner->max_sections = 4096;
+    planner->max_obstacles = 64;
+    planner->max_open = 256;
+    planner->sections = calloc(planner->max_sections, sizeof(RouteSection));
+    planner->obstacles = malloc(planner->max_obstacles * sizeof(RouteObstacle));
+    planner->nodes = malloc((ROUTE_NODE_VERTICES + planner->max_obstacles * ROUTE_OBSTACLE_VERTICES) * sizeof(RouteNode));
+    planner->open = malloc(planner->max_open * sizeof(RouteOpenEntry));
+
+    if (planner->sections == NULL || planner->obstacles == NULL || planner->nodes == NULL || planner->open == NULL)
+    {
+        fprintf(stderr, "Error: Could not allocate memory for route planner.\n");
+        route_destroy_planner(planner);
+        return false;
+    }
+
+    for (int i = 0; i < ROUTE_NODE_VERTICES + planner->max_obstacles * ROUTE_OBSTACLE_VERTICES; i++)
+        planner->nodes[i] = (RouteNode){.g = INFINITY, .parent = -1, .is_closed = false};
+
+    planner->best_node = ROUTE_NODE_START;
+    planner->best_distance = hypot(destination.x - start.x, destination.y - start.y);
+    planner->nodes[ROUTE_NODE_START].g = 0;
+    route_push_open(planner, ROUTE_NODE_START, planner->best_distance);
+
+    return true;
+}
+
+/**
+ * Checks whether a segment crosses the cutoff of a star that has been generated around the ship
+ * or the camera, without generating sections. Stars around the start or the destination do not block,
+ * as in route_find_blocker().
+ *
+ * @param nav_state A pointer to the current NavigationState object.
+ * @param job A pointer to the RouteJob.
+ * @param a The start of the segment.
+ * @param b The end of the segment.
+ *
+ * @return True if the segment is clear, false otherwise.
+ */
+static bool route_is_segment_clear(const NavigationState *nav_state, const RouteJob *job, Point a, Point b)
+{
+    double dx = b.x - a.x;
+    double dy = b.y - a.y;
+    double length_squared = dx * dx + dy * dy;
+
+    for (int s = 0; s < MAX_STARS; s++)
+    {
+        for (StarEntry *entry = nav_state->stars[s]; entry != NULL; entry = entry->next)
+        {
+            Point center = entry->star->position;
+            double cutoff = entry->star->cutoff;
+
+            // Closest point of the segment to the star
+            double t = length_squared > 0 ? ((center.x - a.x) * dx + (center.y - a.y) * dy) / length_squared : 0;
+            t = fmax(0, fmin(1, t));
+
+            if (hypot(a.x + t * dx - center.x, a.y + t * dy - center.y) >= cutoff)
+                continue;
+
+            if (hypot(job->start.x - center.x, job->start.y - center.y) < cutoff ||
+                hypot(job->destination.x - center.x, job->destination.y - center.y) < cutoff)
+                continue;
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Checks whether a route is being planned.
+ *
+ * @return True if a route is being planned, false otherwise.
+ */
+bool route_is_planning(void)
+{
+    return job != NULL;
+}
+
+/**
+ * Takes the latest path of the route being planned, if there is a new one. Partial paths lead
+ * to the destination through the expanded node closest to it, and are replaced as planning continues.
+ * The job is released once its final path is taken, and the path is cached if it was planned.
+ *
+ * @param path A pointer to the path. Set to the new path, which the caller must free.
+ * @param num_points A pointer to the number of points. Set to the number of points of the new path.
+ *
+ * @return True if a new path was taken, false otherwise.
+ */
+bool route_poll_job(PathPoint **path, int *num_points)
+{
+    if (job == NULL)
+        return false;
+
+    SDL_LockMutex(job->mutex);
+
+    bool has_update = job->has_update;
+    bool is_complete = job->is_complete;
+    bool is_found = job->is_found;
+
+    if (has_update)
+    {
+        *path = job->path;
+        *num_points = job->num_points;
+        job->path = NULL;
+        job->has_update = false;
+    }
+
+    SDL_UnlockMutex(job->mutex);
+
+    if (is_complete)
+    {
+        // Cache the route without the ship position
+        if (has_update && is_found)
+        {
+            int offset = job->origin.x != job->start.x || job->origin.y != job->start.y ? 1 : 0;
+            route_store_cache(&job->key, *path + offset, *num_points - offset);
+        }
+
+        route_release_job(job);
+        job = NULL;
+    }
+
+    return has_update;
+}
+
+/**
+ * Removes the entry with the lowest estimated path length from the open set.
+ *
+ * @param planner A pointer to the RoutePlanner.
+ *
+ * @return The node of the entry.
+ */
+static int route_pop_open(RoutePlanner *planner)
+{
+    RouteOpenEntry *open = planner->open;
+    int node = open[0].node;
+    RouteOpenEntry last = open[--planner->num_open];
+    int i = 0;
+
+    while (2 * i + 1 < planner->num_open)
+    {
+        int child = 2 * i + 1;
+
+        if (child + 1 < planner->num_open && open[child + 1].f < open[child].f)
+            child++;
+
+        if (open[child].f >= last.f)
+            break;
+
+        open[i] = open[child];
+        i = child;
+    }
+
+    open[i] = last;
+
+    return node;
+}
+
+/**
+ * Replaces the path of a job, for the main thread to take. The origin of the job is added
+ * before the path if it is not the start.
+ *
+ * @param job A pointer to the RouteJob.
+ * @param path The path. The job takes ownership of it.
+ * @param num_points The number of points in the path.
+ * @param is_complete Whether this is the final path.
+ * @param progress The progress of planning, from 0 to 1.
+ *
+ * @return void
+ */
+static void route_publish_path(RouteJob *job, PathPoint *path, int num_points, bool is_complete, float progress)
+{
+    if (path != NULL && (job->origin.x != job->start.x || job->origin.y != job->start.y))
+    {
+        PathPoint *full_path = malloc((num_points + 1) * sizeof(PathPoint));
+
+        if (full_path != NULL)
+        {
+            full_path[0] = (PathPoint){.type = PATH_POINT_STRAIGHT, .position = job->origin};
+            memcpy(&full_path[1], path, num_points * sizeof(PathPoint));
+            num_points++;
+        }
+
+        free(path);
+        path = full_path;
+    }
+
+    SDL_LockMutex(job->mutex);
+
+    free(job->path);
+    job->path = path;
+    job->num_points = path != NULL ? num_points : 0;
+    job->has_update = path != NULL;
+    job->is_complete = is_complete;
+    job->progress = progress;
+
+    SDL_UnlockMutex(job->mutex);
+}
+
+/**
+ * Adds a node to the open set. A node that is already in the set is added again;
+ * The older entry is skipped when it is removed, since the node is closed by then.
+ *
+ * @param planner A pointer to the RoutePlanner.
+ * @param node The node.
+ * @param f The estimated length of the path through the node.
+ *
+ * @return void
+ */
+static void route_push_open(RoutePlanner *planner, int node, double f)
+{
+    if (planner->num_open >= planner->max_open)
+    {
+        RouteOpenEntry *open = realloc(planner->open, 2 * planner->max_open * sizeof(RouteOpenEntry));
+
+        if (open == NULL)
+        {
+            fprintf(stderr, "Error: Could not allocate memory for route open set.\n");
+            planner->is_out_of_memory = true;
+            return;
+        }
+
+        planner->open = open;
+        planner->max_open *= 2;
+    }
+
+    int i = planner->num_open++;
+
+    while (i > 0 && planner->open[(i - 1) / 2].f > f)
+    {
+        planner->open[i] = planner->open[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+
+    planner->open[i] = (RouteOpenEntry){.f = f, .node = node};
+}
+
+/**
+ * Updates a node if the path through another node is shorter. The caller checks the line of sight.
+ *
+ * @param planner A pointer to the RoutePlanner.
+ * @param from The node the path comes from.
+ * @param to The node to update.
+ *
+ * @return void
+ */
+static void route_relax(RoutePlanner *planner, int from, int to)
+{
+    if (planner->nodes[to].is_closed)
+        return;
+
+    Point a = route_get_node_position(planner, from);
+    Point b = route_get_node_position(planner, to);
+    double g = planner->nodes[from].g + hypot(b.x - a.x, b.y - a.y);
+
+    if (g >= planner->nodes[to].g)
+        return;
+
+    planner->nodes[to].g = g;
+    planner->nodes[to].parent = from;
+
+    route_push_open(planner, to, g + ROUTE_HEURISTIC_WEIGHT * hypot(planner->destination.x - b.x, planner->destination.y - b.y));
+}
+
+/**
+ * Relaxes the two vertices of a star polygon that are tangent from a node, i.e. the ways around the star.
+ *
+ * @param planner A pointer to the RoutePlanner.
+ * @param from The node.
+ * @param obstacle The obstacle to go around.
+ * @param depth The number of obstacles that blocked the way to this one.
+ *
+ * @return void
+ */
+static void route_relax_tangents(RoutePlanner *planner, int from, int obstacle, int depth)
+{
+    Point p = route_get_node_position(planner, from);
+    int first = ROUTE_NODE_VERTICES + obstacle * ROUTE_OBSTACLE_VERTICES;
+    int tangents[2];
+    int num_tangents = 0;
+
+    // A vertex is tangent if both its neighbors are on the same side of the line to it
+    for (int i = 0; i < ROUTE_OBSTACLE_VERTICES && num_tangents < 2; i++)
+    {
+        Point vertex = route_get_node_position(planner, first + i);
+        Point previous = route_get_node_position(planner, first + (i + ROUTE_OBSTACLE_VERTICES - 1) % ROUTE_OBSTACLE_VERTICES);
+        Point next = route_get_node_position(planner, first + (i + 1) % ROUTE_OBSTACLE_VERTICES);
+        double side_previous = (vertex.x - p.x) * (previous.y - p.y) - (vertex.y - p.y) * (previous.x - p.x);
+        double side_next = (vertex.x - p.x) * (next.y - p.y) - (vertex.y - p.y) * (next.x - p.x);
+
+        if (side_previous * side_next > 0)
+            tangents[num_tangents++] = first + i;
+    }
+
+    // Inside the polygon, but outside the cutoff, use the vertices on either side
+    if (num_tangents < 2)
+    {
+        const RouteObstacle *star = &planner->obstacles[obstacle];
+        double angle = atan2(p.y - star->position.y, p.x - star->position.x);
+        int vertex = (int)floor(angle / (2 * M_PI / ROUTE_OBSTACLE_VERTICES));
+
+        vertex = (vertex % ROUTE_OBSTACLE_VERTICES + ROUTE_OBSTACLE_VERTICES) % ROUTE_OBSTACLE_VERTICES;
+        tangents[0] = first + vertex;
+        tangents[1] = first + (vertex + 1) % ROUTE_OBSTACLE_VERTICES;
+        num_tangents = 2;
+    }
+
+    for (int i = 0; i < num_tangents; i++)
+        route_relax_vertex(planner, from, tangents[i], depth);
+}
+
+/**
+ * Relaxes a vertex if it is in line of sight. Otherwise, tries the ways around the star that blocks it.
+ *
+ * @param planner A pointer to the RoutePlanner.
+ * @param from The node the path comes from.
+ * @param to The vertex.
+ * @param depth The number of obstacles that blocked the way to this vertex.
+ *
+ * @return void
+ */
+static void route_relax_vertex(RoutePlanner *planner, int from, int to, int depth)
+{
+    if (planner->nodes[to].is_closed)
+        return;
+
+    int blocker = route_find_blocker(planner, route_get_node_position(planner, from), route_get_node_position(planner, to));
+
+    if (blocker == ROUTE_BLOCKER_ERROR)
+        return;
+
+    if (blocker == ROUTE_BLOCKER_NONE)
+        route_relax(planner, from, to);
+    else if (depth < ROUTE_MAX_DETOUR_DEPTH && blocker != route_get_node_obstacle(from) && blocker != route_get_node_obstacle(to))
+        route_relax_tangents(planner, from, blocker, depth + 1);
+}
+
+/**
+ * Releases a reference to a job, and frees it if it was the last one.
+ *
+ * @param job A pointer to the RouteJob.
+ *
+ * @return void
+ */
+static void route_release_job(RouteJob *job)
+{
+    if (!jobs_release_handle(&job->handle))
+        return;
+
+    SDL_DestroyMutex(job->mutex);
+    free(job->path);
+    free(job->galaxy);
+    free(job);
+}
+
+/**
+ * Plans the route of a job, publishing partial paths while searching. Runs on a worker thread of the job system,
+ * or in the calling thread if planning is synchronous.
+ *
+ * @param data A pointer to the RouteJob.
+ *
+ * @return void
+ */
+static void route_run_job(void *data)
+{
+    RouteJob *job = data;
+    RoutePlanner planner;
+    PathPoint *path = NULL;
+    int num_points = 0;
+
+    if (route_init_planner(&planner, job->galaxy, job->initseq, job->start, job->destination))
+    {
+        double distance = planner.best_distance;
+        Uint32 last_publish_time = SDL_GetTicks();
+        unsigned short status;
+
+        do
+        {
+            status = route_search(&planner, ROUTE_JOB_STEP);
+
+            if (status == ROUTE_SEARCH_RUNNING && is_async && SDL_GetTicks() - last_publish_time >= ROUTE_JOB_PUBLISH_INTERVAL)
+            {
+                num_points = route_build_path(&planner, planner.best_node, &path);
+
+                if (num_points > 0)
+                    route_publish_path(job, path, num_points, false, distance > 0 ? 1 - planner.best_distance / distance : 1);
+
+                last_publish_time = SDL_GetTicks();
+            }
+        } while (status == ROUTE_SEARCH_RUNNING && !jobs_is_handle_cancelled(&job->handle));
+
+        num_points = 0;
+        path = NULL;
+
+        if (status == ROUTE_SEARCH_FOUND && !jobs_is_handle_cancelled(&job->handle))
+        {
+            num_points = route_build_path(&planner, ROUTE_NODE_DESTINATION, &path);
+            job->is_found = num_points > 0;
+        }
+        else if (status == ROUTE_SEARCH_FAILED)
+            fprintf(stderr, "Warning: No route found after %d nodes, using a straight path.\n", planner.expansions);
+
+        route_destroy_planner(&planner);
+    }
+
+    if (!jobs_is_handle_cancelled(&job->handle))
+    {
+        if (num_points == 0)
+        {
+            path = malloc(2 * sizeof(PathPoint));
+
+            if (path != NULL)
+            {
+                path[0] = (PathPoint){.type = PATH_POINT_STRAIGHT, .position = job->start};
+                path[1] = (PathPoint){.type = PATH_POINT_STRAIGHT, .position = job->destination};
+                num_points = 2;
+            }
+        }
+
+        route_publish_path(job, path, num_points, true, 1);
+    }
+
+    route_release_job(job);
+}
+
+/**
+ * Continues the search for the shortest path from the start to the destination.
+ *
+ * @param planner A pointer to the RoutePlanner.
+ * @param max_expansions The number of nodes to expand before returning.
+ *
+ * @return ROUTE_SEARCH_FOUND if the destination was reached, ROUTE_SEARCH_FAILED if there is no path
+ *         within the planning budget, or ROUTE_SEARCH_RUNNING if the search is not finished.
+ */
+static unsigned short route_search(RoutePlanner *planner, int max_expansions)
+{
+    int last_expansion = planner->expansions + max_expansions;
+
+    while (planner->expansions < last_expansion)
+    {
+        if (planner->num_open == 0 || planner->expansions >= ROUTE_MAX_EXPANSIONS || planner->is_out_of_memory)
+            return ROUTE_SEARCH_FAILED;
+
+        int node = route_pop_open(planner);
+
+        if (planner->nodes[node].is_closed)
+            continue;
+
+        planner->nodes[node].is_closed = true;
+
+        if (node == ROUTE_NODE_DESTINATION)
+            return ROUTE_SEARCH_FOUND;
+
+        Point position = route_get_node_position(planner, node);
+        double distance = hypot(planner->destination.x - position.x, planner->destination.y - position.y);
+
+        if (distance < planner->best_distance)
+        {
+            planner->best_node = node;
+            planner->best_distance = distance;
+        }
+
+        planner->expansions++;
+        route_expand(planner, node);
+    }
+
+    return ROUTE_SEARCH_RUNNING;
+}
+
+/**
+ * Sets whether routes are planned on a background thread. Replays plan synchronously,
+ * so that paths are available on the same frames as when they were recorded.
+ *
+ * @param async Whether to plan on a background thread.
+ *
+ * @return void
+ */
+void route_set_async(bool async)
+{
+    is_async = async;
+}
+
+/**
+ * Starts planning the route of the waypoint on a worker thread, and cancels the previous one.
+ * A route cached for the same galaxy, ship section and destination is reused instead, if its first
+ * and last segments are still clear; Otherwise the cached route is invalidated. The path is taken with route_poll_job().
+ *
+ * @param nav_state A pointer to the current NavigationState object.
+ * @param origin The position of the ship. Added before the start if they differ.
+ * @param start The start of the route, outside the cutoff of the star around the ship.
+ * @param destination The destination of the route.
+ * @param star_position The position of the destination star.
+ * @param planet_index The index of the destination planet, or -1 for the star.
+ *
+ * @return void
+ */
+void route_start_job(const NavigationState *nav_state, Point origin, Point start, Point destination, Point star_position, int planet_index)
+{
+    route_cancel_job();
+
+    RouteJob *new_job = (RouteJob *)calloc(1, sizeof(RouteJob));
+
+    if (new_job == NULL)
+    {
+        fprintf(stderr, "Error: Could not allocate memory for route job.\n");
+        return;
+    }
+
+    new_job->galaxy = (Galaxy *)malloc(sizeof(Galaxy));
+    new_job->mutex = SDL_CreateMutex();
+
+    if (new_job->galaxy == NULL || new_job->mutex == NULL)
+    {
+        fprintf(stderr, "Error: Could not create route job.\n");
+        free(new_job->galaxy);
+
+        if (new_job->mutex != NULL)
+            SDL_DestroyMutex(new_job->mutex);
+
+        free(new_job);
+        return;
+    }
+
+    // Only the fields used to generate stars are copied
+    memcpy(new_job->galaxy->name, nav_state->current_galaxy->name, sizeof(new_job->galaxy->name));
+    new_job->galaxy->class = nav_state->current_galaxy->class;
+    new_job->galaxy->radius = nav_state->current_galaxy->radius;
+    new_job->galaxy->position = nav_state->current_galaxy->position;
+    new_job->initseq = nav_state->initseq;
+    new_job->key = (RouteKey){.galaxy_position = nav_state->current_galaxy->position,
+                              .section_x = (int64_t)floor(origin.x / GALAXY_SECTION_SIZE),
+                              .section_y = (int64_t)floor(origin.y / GALAXY_SECTION_SIZE),
+                              .star_position = star_position,
+                              .planet_index = planet_index};
+    new_job->origin = origin;
+    new_job->start = start;
+    new_job->destination = destination;
+
+    jobs_init_handle(&new_job->handle);
+    job = new_job;
+
+    RouteCacheEntry *entry = route_find_cache_entry(&job->key);
+
+    if (entry != NULL)
+    {
+        int num_points;
+        PathPoint *path = route_connect_cached_path(nav_state, job, entry, &num_points);
+
+        if (path != NULL)
+        {
+            // The cached route is final; Release the reference of the planning job
+            route_publish_path(job, path, num_points, true, 1);
+            route_release_job(job);
+            return;
+        }
+
+        route_free_cache_entry(entry);
+    }
+
+    if (!is_async)
+    {
+        route_run_job(job);
+        return;
+    }
+
+    // The waypoint was requested by the player, so it is planned before the work around the ship
+    jobs_submit(route_run_job, job, JOB_TAG_ROUTE, 0);
+}
+
+/**
+ * Caches a route. The least recently used route is replaced if the cache is full.
+ *
+ * @param key A pointer to the RouteKey of the route.
+ * @param path The path, from the start of the route.
+ * @param num_points The number of points in the path.
+ *
+ * @return void
+ */
+static void route_store_cache(const RouteKey *key, const PathPoint *path, int num_points)
+{
+    RouteCacheEntry *entry = route_find_cache_entry(key);
+
+    if (entry == NULL)
+    {
+        entry = &cache[0];
+
+        for (int i = 0; i < ROUTE_CACHE_SIZE; i++)
+        {
+            if (!cache[i].in_use || (entry->in_use && cache[i].last_used < entry->last_used))
+                entry = &cache[i];
+        }
+    }
+
+    route_free_cache_entry(entry);
+    entry->path = malloc(num_points * sizeof(PathPoint));
+
+    if (entry->path == NULL)
+    {
+        fprintf(stderr, "Error: Could not allocate memory for cached route.\n");
+        return;
+    }
+
+    memcpy(entry->path, path, num_points * sizeof(PathPoint));
+    entry->in_use = true;
+    entry->key = *key;
+    entry->num_points = num_points;
+    entry->last_used = ++cache_clock;
+}
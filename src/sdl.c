@@ -18,6 +18,12 @@ extern TTF_Font *fonts[];
 extern SDL_DisplayMode display_mode;
 extern SDL_Renderer *renderer;
 
+// Static variable definitions
+static SDL_Surface *framebuffer = NULL; // Render target of the offscreen backend
+
+// Static function prototypes
+static bool sdl_initialize_offscreen(void);
+
 /**
  * Cleans up SDL and TTF resources by closing all open fonts, quitting IMG and TTF,
  * destroying the renderer and window, and quitting SDL.
@@ -28,6 +34,8 @@ extern SDL_Renderer *renderer;
  */
 void sdl_cleanup(SDL_Window *window)
 {
+    text_destroy_atlases();
+
     for (int i = 0; i < FONT_COUNT; i++)
     {
         TTF_CloseFont(fonts[i]);
@@ -37,6 +45,13 @@ void sdl_cleanup(SDL_Window *window)
     TTF_Quit();
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
+
+    if (framebuffer != NULL)
+    {
+        SDL_FreeSurface(framebuffer);
+        framebuffer = NULL;
+    }
+
     SDL_Quit();
 }
 
@@ -44,10 +59,16 @@ void sdl_cleanup(SDL_Window *window)
  * Initializes SDL with given window and renderer, and sets up the rendering context.
  *
  * @param window A pointer to the SDL_Window to be created.
+ * @param backend The rendering backend. BACKEND_HIDDEN creates a hidden window without vsync, e.g. for replays.
+ * BACKEND_OFFSCREEN renders into a surface with SDL's software renderer, without a window or vsync,
+ * at the size already set in display_mode, e.g. by a scenario.
  * @return True if SDL was successfully initialized, and false otherwise.
  */
-bool sdl_initialize(SDL_Window *window)
+bool sdl_initialize(SDL_Window *window, unsigned short backend)
 {
+    if (backend == BACKEND_OFFSCREEN)
+        return sdl_initialize_offscreen();
+
     // Attempt to initialize SDL
     if (SDL_Init(SDL_INIT_EVERYTHING) != 0)
     {
@@ -63,6 +84,8 @@ bool sdl_initialize(SDL_Window *window)
         return false;
     }
 
+    bool headless = backend == BACKEND_HIDDEN;
+
     // Create a window
     // Use the flag SDL_WINDOW_OPENGL to load OpenGL
     window = SDL_CreateWindow("Gravity",
@@ -70,7 +93,7 @@ bool sdl_initialize(SDL_Window *window)
                               SDL_WINDOWPOS_CENTERED,
                               display_mode.w,
                               display_mode.h,
-                              0);
+                              headless ? SDL_WINDOW_HIDDEN : 0);
 
     if (window == NULL)
     {
@@ -80,13 +103,13 @@ bool sdl_initialize(SDL_Window *window)
     }
 
     // Make Fullscreen
-    if (FULLSCREEN)
+    if (FULLSCREEN && !headless)
         SDL_SetWindowFullscreen(window, SDL_WINDOW_FULLSCREEN);
 
     // Create a 2D rendering context for the window
     Uint32 render_flags;
 
-    if (VSYNC_ON)
+    if (VSYNC_ON && !headless)
         render_flags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC;
     else
         render_flags = SDL_RENDERER_ACCELERATED;
@@ -107,9 +130,56 @@ bool sdl_initialize(SDL_Window *window)
     return true;
 }
 
+/**
+ * Initializes SDL without video and creates a software renderer that draws into an offscreen surface.
+ * Frames do not depend on the GPU or its driver, so the framebuffer can be compared against golden images.
+ *
+ * @return True if SDL was successfully initialized, and false otherwise.
+ */
+static bool sdl_initialize_offscreen(void)
+{
+    // No window, so there is no need for the video subsystem
+    if (SDL_Init(SDL_INIT_TIMER | SDL_INIT_EVENTS) != 0)
+    {
+        SDL_Log("Could not initialize SDL: %s\n", SDL_GetError());
+        return false;
+    }
+
+    if (display_mode.w <= 0 || display_mode.h <= 0)
+    {
+        display_mode.w = OFFSCREEN_DISPLAY_WIDTH;
+        display_mode.h = OFFSCREEN_DISPLAY_HEIGHT;
+    }
+
+    framebuffer = SDL_CreateRGBSurfaceWithFormat(0, display_mode.w, display_mode.h, 32, SDL_PIXELFORMAT_ARGB8888);
+
+    if (framebuffer == NULL)
+    {
+        SDL_Log("Could not create framebuffer: %s\n", SDL_GetError());
+        SDL_Quit();
+        return false;
+    }
+
+    renderer = SDL_CreateSoftwareRenderer(framebuffer);
+
+    if (renderer == NULL)
+    {
+        SDL_Log("Could not create software renderer: %s\n", SDL_GetError());
+        SDL_FreeSurface(framebuffer);
+        framebuffer = NULL;
+        SDL_Quit();
+        return false;
+    }
+
+    // Set blend mode
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+    return true;
+}
+
 /**
  * Initializes the SDL_ttf library and loads fonts into memory.
- * Loads fonts into fonts array.
+ * Loads fonts into fonts array and creates a glyph atlas for each font size.
  *
  * @param window A pointer to the SDL window to be used for rendering.
  *
@@ -218,5 +288,12 @@ bool sdl_ttf_load_fonts(SDL_Window *window)
         return false;
     }
 
+    // Create glyph atlases for text labels
+    if (!text_create_atlases())
+    {
+        SDL_Log("Could not create glyph atlases\n");
+        return false;
+    }
+
     return true;
 }
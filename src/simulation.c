@@ -0,0 +1,255 @@
+/*
+ * simulation.c
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#include <SDL2/SDL.h>
+
+#include "../include/constants.h"
+#include "../include/enums.h"
+#include "../include/structs.h"
+#include "../include/simulation.h"
+
+// Static variable definitions
+static SDL_Thread *thread = NULL;
+static SDL_atomic_t is_running;
+static SDL_mutex *events_mutex = NULL;
+static SDL_Event events[SIMULATION_MAX_EVENTS]; // Input events from the main thread, oldest first
+static int first_event = 0;
+static int num_events = 0;
+
+// Static function prototypes
+static int simulation_poll_event(SDL_Event *);
+static int simulation_run(void *data);
+
+/**
+ * Checks whether the simulation thread is running. It stops once the game state is QUIT.
+ *
+ * @return True if the simulation is running, false otherwise.
+ */
+bool simulation_is_running(void)
+{
+    return SDL_AtomicGet(&is_running);
+}
+
+/**
+ * Event source of the simulation thread, which takes the events forwarded by the main thread.
+ *
+ * @param event A pointer to the SDL_Event to fill.
+ *
+ * @return 1 if an event was returned, 0 if there are no more events for this frame.
+ */
+static int simulation_poll_event(SDL_Event *event)
+{
+    SDL_LockMutex(events_mutex);
+
+    int has_event = num_events > 0;
+
+    if (has_event)
+    {
+        *event = events[first_event];
+        first_event = (first_event + 1) % SIMULATION_MAX_EVENTS;
+        num_events--;
+    }
+
+    SDL_UnlockMutex(events_mutex);
+
+    return has_event;
+}
+
+/**
+ * Forwards an input event from the main thread to the simulation.
+ *
+ * @param event A pointer to the event.
+ *
+ * @return void
+ */
+void simulation_push_event(const SDL_Event *event)
+{
+    SDL_LockMutex(events_mutex);
+
+    if (num_events < SIMULATION_MAX_EVENTS)
+    {
+        events[(first_event + num_events) % SIMULATION_MAX_EVENTS] = *event;
+        num_events++;
+    }
+    else
+        fprintf(stderr, "Warning: Simulation input queue is full, dropping event.\n");
+
+    SDL_UnlockMutex(events_mutex);
+}
+
+/**
+ * Simulation thread. Runs frames at the frame rate and hands each one over to the render thread,
+ * until the game state is QUIT.
+ *
+ * @param data A pointer to the Simulation.
+ *
+ * @return 0
+ */
+static int simulation_run(void *data)
+{
+    Simulation *simulation = data;
+
+    if (PROFILER_ON)
+        trace_name_thread("simulation");
+
+    while (simulation->game_state->state != QUIT)
+    {
+        unsigned int start_time = SDL_GetTicks();
+
+        simulation_run_frame(simulation, simulation_poll_event);
+
+        // The recorded frame is the snapshot drawn by the render thread
+        render_publish_frame();
+
+        unsigned int end_time = SDL_GetTicks();
+
+        // Set frame rate
+        if ((1000 / FPS) > end_time - start_time)
+            SDL_Delay((1000 / FPS) - (end_time - start_time));
+    }
+
+    SDL_AtomicSet(&is_running, 0);
+
+    return 0;
+}
+
+/**
+ * Runs a frame of the game: processes input events, updates the current state and records its draw commands.
+ *
+ * @param simulation A pointer to the Simulation.
+ * @param poll_event A function that returns the input events of the frame, with the signature of SDL_PollEvent.
+ *
+ * @return void
+ */
+void simulation_run_frame(Simulation *simulation, int (*poll_event)(SDL_Event *))
+{
+    GameState *game_state = simulation->game_state;
+    InputState *input_state = simulation->input_state;
+    GameEvents *game_events = simulation->game_events;
+    NavigationState *nav_state = simulation->nav_state;
+    Camera *camera = simulation->camera;
+
+    // Process events
+    PROFILER_BEGIN(PROFILER_SCOPE_EVENTS);
+    events_loop(game_state, input_state, game_events, nav_state, camera, poll_event);
+    PROFILER_END(PROFILER_SCOPE_EVENTS);
+
+    benchmark_end_stage(BENCHMARK_STAGE_EVENTS);
+
+    PROFILER_BEGIN(PROFILER_SCOPE_UPDATE);
+
+    switch (game_state->state)
+    {
+    case MENU:
+        menu_run_state(game_state, input_state, game_events->is_game_started, nav_state, simulation->bstars, simulation->menustars, camera);
+        break;
+    case NAVIGATE:
+        game_run_navigate_state(game_state, input_state, game_events, nav_state, simulation->bstars, simulation->ship, camera);
+        break;
+    case MAP:
+        game_run_map_state(game_state, input_state, game_events, nav_state, simulation->bstars, simulation->ship, camera);
+        break;
+    case UNIVERSE:
+        game_run_universe_state(game_state, input_state, game_events, nav_state, simulation->ship, camera);
+        break;
+    case NEW:
+        game_reset(game_state, input_state, game_events, nav_state, simulation->bstars, simulation->ship, camera, true);
+        break;
+    case CONTROLS:
+        controls_run_state(game_state, input_state, game_events->is_game_started, nav_state, simulation->bstars, simulation->menustars, camera);
+        break;
+    default:
+        menu_run_state(game_state, input_state, game_events->is_game_started, nav_state, simulation->bstars, simulation->menustars, camera);
+        break;
+    }
+
+    // Set mouse cursor
+    events_set_cursor(game_state, input_state);
+
+    PROFILER_END(PROFILER_SCOPE_UPDATE);
+    PROFILER_BEGIN(PROFILER_SCOPE_CONSOLE);
+
+    // Draw FPS
+    if (input_state->fps_on && FPS_ON)
+    {
+        console_measure_fps(game_state, &simulation->last_time, &simulation->frame_count);
+        console_draw_fps(game_state->fps, camera);
+    }
+
+    // Draw profiler
+    if (input_state->profiler_on && PROFILER_ON)
+        profiler_draw(camera);
+
+    // Draw counters
+    if (input_state->counters_on && PROFILER_ON)
+        counters_draw(nav_state, camera);
+
+    PROFILER_END(PROFILER_SCOPE_CONSOLE);
+
+    if (PROFILER_ON)
+    {
+        profiler_end_frame();
+        trace_end_frame();
+        counters_end_frame();
+    }
+
+    benchmark_end_stage(BENCHMARK_STAGE_UPDATE);
+}
+
+/**
+ * Starts running the simulation on its own thread. The calling thread becomes the render thread,
+ * which forwards input events with simulation_push_event() and draws the recorded frames.
+ *
+ * @param simulation A pointer to the Simulation, which must outlive the thread.
+ *
+ * @return True if the thread was started, false otherwise.
+ */
+bool simulation_start(Simulation *simulation)
+{
+    events_mutex = SDL_CreateMutex();
+
+    if (events_mutex == NULL || !render_create_frames())
+    {
+        SDL_Log("Could not start simulation thread: %s\n", SDL_GetError());
+        SDL_DestroyMutex(events_mutex);
+        events_mutex = NULL;
+        return false;
+    }
+
+    SDL_AtomicSet(&is_running, 1);
+    thread = SDL_CreateThread(simulation_run, "simulation", simulation);
+
+    if (thread == NULL)
+    {
+        SDL_Log("Could not start simulation thread: %s\n", SDL_GetError());
+        SDL_AtomicSet(&is_running, 0);
+        SDL_DestroyMutex(events_mutex);
+        events_mutex = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Waits for the simulation thread to stop.
+ *
+ * @return void
+ */
+void simulation_stop(void)
+{
+    if (thread == NULL)
+        return;
+
+    SDL_WaitThread(thread, NULL);
+    thread = NULL;
+
+    SDL_DestroyMutex(events_mutex);
+    events_mutex = NULL;
+    first_event = 0;
+    num_events = 0;
+}
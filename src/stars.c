@@ -16,17 +16,34 @@
 #include "../include/stars.h"
 
 // External variable definitions
-extern TTF_Font *fonts[];
 extern SDL_Renderer *renderer;
 extern SDL_Color colors[];
 
+// Static variable definitions
+static StarsPrefetch *prefetches[STARS_PREFETCH_SHIFTS]; // Regions the ship heads to, generated in the background
+static StarsPopulation *populations[STARS_POPULATE_BUDGET]; // Visible star systems, populated in the background
+static bool is_async = true;
+
 // Static function prototypes
 static void stars_add_entry(StarEntry *stars[], Point, Star *);
+static void stars_add_prefetch(StarEntry *stars[], StarsPrefetch *);
+static void stars_adopt_population(NavigationState *, StarsPopulation *);
 void stars_cleanup_planets(CelestialBody *);
-static Star *stars_create_star(const NavigationState *, Point, int preview);
+static StarsPrefetch *stars_create_prefetch(const Galaxy *, Point origin, Point target);
+static Star *stars_create_star(Galaxy *, uint64_t initseq, Point, int preview);
 static void stars_delete_entry(StarEntry *stars[], Point);
 static bool stars_entry_exists(StarEntry *stars[], Point);
+static void stars_generate_region(StarEntry *stars[], Galaxy *, uint64_t initseq, double bx, double by);
+static bool stars_is_drawn_as_point(const CelestialBody *, unsigned short lod, long double scale);
+static bool stars_is_equal_table(StarEntry *a[], StarEntry *b[]);
+static bool stars_is_region_in_galaxy(const Galaxy *, double bx, double by);
+static bool stars_merge_prefetch(NavigationState *, Point origin, Point target);
 static int stars_planet_size_class(float radius);
+static int stars_predict_region_lines(Point position, float vx, float vy, Point lines[]);
+static void stars_release_population(StarsPopulation *);
+static void stars_release_prefetch(StarsPrefetch *);
+static void stars_run_population(void *data);
+static void stars_run_prefetch(void *data);
 
 /**
  * Adds a new star entry to the hash table of stars at the given position.
@@ -57,6 +74,195 @@ static void stars_add_entry(StarEntry *stars[], Point position, Star *star)
     stars[index] = entry;
 }
 
+/**
+ * Adds the stars of a region generated ahead of the ship to a hash table of stars.
+ * The stars move to the table, or are freed if the table already has them.
+ *
+ * @param stars An array of pointers to StarEntry structures, representing the hash table of stars.
+ * @param prefetch A pointer to the StarsPrefetch whose job has finished.
+ *
+ * @return void
+ */
+static void stars_add_prefetch(StarEntry *stars[], StarsPrefetch *prefetch)
+{
+    for (int i = 0; i < prefetch->num_stars; i++)
+    {
+        Star *star = prefetch->stars[i];
+
+        if (stars_entry_exists(stars, star->position))
+            free(star);
+        else
+            stars_add_entry(stars, star->position, star);
+    }
+
+    prefetch->num_stars = 0;
+}
+
+/**
+ * Moves the planets and moons of a star system populated in the background to its star in the hash table.
+ * The system is dropped if the star has been deleted or populated meanwhile.
+ *
+ * @param nav_state A pointer to the current NavigationState object.
+ * @param population A pointer to the StarsPopulation.
+ *
+ * @return void
+ */
+static void stars_adopt_population(NavigationState *nav_state, StarsPopulation *population)
+{
+    Star *system = population->star;
+
+    // The job was cancelled before it populated the system
+    if (!system->initialized)
+        return;
+
+    // Generate unique index for hash table
+    uint64_t index = maths_hash_position_to_index(system->position, MAX_STARS, ENTITY_STAR);
+
+    StarEntry *entry = nav_state->stars[index];
+
+    while (entry != NULL)
+    {
+        Star *star = entry->star;
+
+        if (star != NULL && maths_points_equal(star->position, system->position) && strcmp(star->name, system->name) == 0)
+        {
+            if (star->initialized)
+                return;
+
+            for (int i = 0; i < MAX_PLANETS_MOONS; i++)
+            {
+                star->planets[i] = system->planets[i];
+                system->planets[i] = NULL;
+
+                if (star->planets[i] != NULL)
+                    star->planets[i]->parent = star;
+            }
+
+            star->num_planets = system->num_planets;
+            star->initialized = 1;
+
+            return;
+        }
+
+        entry = entry->next;
+    }
+}
+
+/**
+ * Flies through random regions of the current galaxy, shifting the region by one section at a time,
+ * and prints the time of a shift when the new sections are scanned in the frame, the time of the job
+ * that generates them ahead of the ship and the time of merging its stars in the frame instead,
+ * and whether the two hash tables are identical.
+ *
+ * @param nav_state A pointer to the current NavigationState object.
+ * @param runs The number of flights.
+ *
+ * @return void
+ */
+void stars_benchmark_prefetch(const NavigationState *nav_state, int runs)
+{
+    StarEntry *scan_stars[MAX_STARS] = {NULL};
+    StarEntry *prefetch_stars[MAX_STARS] = {NULL};
+    Galaxy *galaxy = nav_state->current_galaxy;
+    uint64_t initseq = maths_hash_position_to_uint64_2(galaxy->position);
+    double frequency = SDL_GetPerformanceFrequency();
+    double total_scan_time = 0;
+    double total_job_time = 0;
+    double total_merge_time = 0;
+    int different = 0;
+    int directions[8][2] = {{-1, -1}, {0, -1}, {1, -1}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+
+    // Use a local rng, so that every run takes the same flights
+    pcg32_random_t rng;
+    pcg32_srandom_r(&rng, STARS_BENCHMARK_SEED, STARS_BENCHMARK_SEED);
+
+    printf("Stars prefetch benchmark: %d flights of %d region shifts in %s, regions of %d x %d sections\n",
+           runs, STARS_BENCHMARK_SHIFTS, galaxy->name, GALAXY_REGION_SIZE, GALAXY_REGION_SIZE);
+    printf("  %10s %10s %10s %8s %10s\n", "scan ms", "job ms", "merge ms", "speedup", "identical");
+
+    for (int i = 0; i < runs; i++)
+    {
+        // Flights start on random section lines inside the galaxy and head one section at a time
+        // in one of eight directions
+        double angle = (pcg32_random_r(&rng) % 3600) * M_PI / 1800;
+        double distance = (pcg32_random_r(&rng) % 1001) / 1000.0 * galaxy->radius * GALAXY_SCALE;
+        double bx = maths_get_nearest_section_line(cos(angle) * distance, GALAXY_SECTION_SIZE);
+        double by = maths_get_nearest_section_line(sin(angle) * distance, GALAXY_SECTION_SIZE);
+        int direction = pcg32_random_r(&rng) % 8;
+        int dx = directions[direction][0];
+        int dy = directions[direction][1];
+        double scan_time = 0;
+        double job_time = 0;
+        double merge_time = 0;
+        bool is_identical = true;
+
+        stars_generate_region(scan_stars, galaxy, initseq, bx, by);
+        stars_generate_region(prefetch_stars, galaxy, initseq, bx, by);
+
+        for (int j = 0; j < STARS_BENCHMARK_SHIFTS; j++)
+        {
+            Point origin = {.x = bx, .y = by};
+            Point target = {.x = bx + dx * GALAXY_SECTION_SIZE, .y = by + dy * GALAXY_SECTION_SIZE};
+
+            // The frame scans the region it shifts to
+            Uint64 start_counter = SDL_GetPerformanceCounter();
+            stars_generate_region(scan_stars, galaxy, initseq, target.x, target.y);
+            scan_time += (SDL_GetPerformanceCounter() - start_counter) * 1000 / frequency;
+
+            // The job generates the new sections ahead of the ship, and the frame merges them
+            StarsPrefetch *prefetch = stars_create_prefetch(galaxy, origin, target);
+
+            if (prefetch == NULL)
+                return;
+
+            start_counter = SDL_GetPerformanceCounter();
+            stars_run_prefetch(prefetch);
+            job_time += (SDL_GetPerformanceCounter() - start_counter) * 1000 / frequency;
+
+            start_counter = SDL_GetPerformanceCounter();
+            stars_add_prefetch(prefetch_stars, prefetch);
+            merge_time += (SDL_GetPerformanceCounter() - start_counter) * 1000 / frequency;
+
+            stars_release_prefetch(prefetch);
+
+            stars_delete_outside_region(scan_stars, nav_state, target.x, target.y, GALAXY_REGION_SIZE);
+            stars_delete_outside_region(prefetch_stars, nav_state, target.x, target.y, GALAXY_REGION_SIZE);
+
+            if (!stars_is_equal_table(scan_stars, prefetch_stars))
+                is_identical = false;
+
+            bx = target.x;
+            by = target.y;
+        }
+
+        double speedup = merge_time > 0 ? scan_time / merge_time : 0;
+
+        printf("  %10.3f %10.3f %10.3f %8.2f %10s\n",
+               scan_time / STARS_BENCHMARK_SHIFTS, job_time / STARS_BENCHMARK_SHIFTS, merge_time / STARS_BENCHMARK_SHIFTS,
+               speedup, is_identical ? "yes" : "no");
+
+        total_scan_time += scan_time;
+        total_job_time += job_time;
+        total_merge_time += merge_time;
+
+        if (!is_identical)
+            different++;
+
+        stars_clear_table(scan_stars, nav_state, true);
+        stars_clear_table(prefetch_stars, nav_state, true);
+    }
+
+    if (runs <= 0)
+        return;
+
+    double speedup = total_merge_time > 0 ? total_scan_time / total_merge_time : 0;
+    int num_shifts = runs * STARS_BENCHMARK_SHIFTS;
+
+    printf("  %10.3f %10.3f %10.3f %8.2f %10s\n",
+           total_scan_time / num_shifts, total_job_time / num_shifts, total_merge_time / num_shifts,
+           speedup, different == 0 ? "yes" : "no");
+}
+
 /**
  * Cleans up the planets of a celestial body by freeing the path array.
  *
@@ -74,6 +280,42 @@ void stars_cleanup_planets(CelestialBody *body)
     }
 }
 
+/**
+ * Cancels the star systems that are populated in the background.
+ *
+ * @return void
+ */
+void stars_clear_populations(void)
+{
+    for (int i = 0; i < STARS_POPULATE_BUDGET; i++)
+    {
+        if (populations[i] == NULL)
+            continue;
+
+        jobs_cancel_handle(&populations[i]->handle);
+        stars_release_population(populations[i]);
+        populations[i] = NULL;
+    }
+}
+
+/**
+ * Cancels the regions that are generated ahead of the ship.
+ *
+ * @return void
+ */
+void stars_clear_prefetch(void)
+{
+    for (int i = 0; i < STARS_PREFETCH_SHIFTS; i++)
+    {
+        if (prefetches[i] == NULL)
+            continue;
+
+        jobs_cancel_handle(&prefetches[i]->handle);
+        stars_release_prefetch(prefetches[i]);
+        prefetches[i] = NULL;
+    }
+}
+
 /**
  * Clears the hash table of stars, except for the buffer_star.
  *
@@ -104,19 +346,77 @@ void stars_clear_table(StarEntry *stars[], const NavigationState *nav_state, boo
     }
 }
 
+/**
+ * Copies a star into a snapshot, such as current_star, and counts the bytes copied.
+ *
+ * @param destination A pointer to the Star to copy to.
+ * @param source A pointer to the Star to copy.
+ *
+ * @return void
+ */
+void stars_copy_star(Star *destination, const Star *source)
+{
+    memcpy(destination, source, sizeof(Star));
+    COUNTERS_ADD(COUNTER_STAR_COPY_BYTES, sizeof(Star));
+}
+
+/**
+ * Creates the prefetch of the region the ship heads to, with one reference for the main thread
+ * and one for its job.
+ *
+ * @param galaxy A pointer to the current Galaxy object.
+ * @param origin The center of the region the ship comes from.
+ * @param target The center of the region the ship heads to.
+ *
+ * @return A pointer to the StarsPrefetch, or NULL if it could not be created.
+ */
+static StarsPrefetch *stars_create_prefetch(const Galaxy *galaxy, Point origin, Point target)
+{
+    StarsPrefetch *prefetch = (StarsPrefetch *)calloc(1, sizeof(StarsPrefetch));
+
+    if (prefetch == NULL)
+    {
+        fprintf(stderr, "Error: Could not allocate memory for region prefetch.\n");
+        return NULL;
+    }
+
+    prefetch->galaxy = (Galaxy *)malloc(sizeof(Galaxy));
+
+    if (prefetch->galaxy == NULL)
+    {
+        fprintf(stderr, "Error: Could not allocate memory for region prefetch.\n");
+        free(prefetch);
+        return NULL;
+    }
+
+    // Only the fields used to generate stars are copied
+    memcpy(prefetch->galaxy->name, galaxy->name, sizeof(prefetch->galaxy->name));
+    prefetch->galaxy->class = galaxy->class;
+    prefetch->galaxy->radius = galaxy->radius;
+    prefetch->galaxy->position = galaxy->position;
+    prefetch->initseq = maths_hash_position_to_uint64_2(galaxy->position);
+    prefetch->origin = origin;
+    prefetch->target = target;
+
+    jobs_init_handle(&prefetch->handle);
+
+    return prefetch;
+}
+
 /**
  * Creates a new Star object with given parameters.
  *
- * @param nav_state A pointer to the current NavigationState object.
+ * @param galaxy A pointer to the Galaxy of the star.
+ * @param initseq The initialization sequence of the galaxy, used for the RNG.
  * @param position A point struct representing the position of the star.
  * @param preview An integer representing whether or not the star is a preview.
  *
  * @return Returns a pointer to a new Star object.
  */
-static Star *stars_create_star(const NavigationState *nav_state, Point position, int preview)
+static Star *stars_create_star(Galaxy *galaxy, uint64_t initseq, Point position, int preview)
 {
     // Find distance to nearest star
-    double distance = stars_nearest_star_distance(position, nav_state->current_galaxy, nav_state->initseq, GALAXY_DENSITY);
+    double distance = stars_nearest_star_distance(position, galaxy, initseq, GALAXY_DENSITY);
 
     // Get star class
     unsigned short class = stars_size_class(distance);
@@ -132,6 +432,7 @@ static Star *stars_create_star(const NavigationState *nav_state, Point position,
 
     // Seed with a fixed constant
     pcg32_srandom_r(&rng, seed, seed); // Unique sequence for this seed
+    COUNTERS_ADD(COUNTER_SEEDS_STARS, 1);
 
     switch (class)
     {
@@ -174,6 +475,11 @@ static Star *stars_create_star(const NavigationState *nav_state, Point position,
         return NULL;
     }
 
+    COUNTERS_ADD(COUNTER_STARS_CREATED, 1);
+
+    if (PROFILER_ON)
+        trace_count_allocation(sizeof(Star));
+
     // Generate unique star position hash
     uint64_t position_hash = maths_hash_position_to_uint64(position);
 
@@ -203,7 +509,8 @@ static Star *stars_create_star(const NavigationState *nav_state, Point position,
     star->parent = NULL;
     star->level = LEVEL_STAR;
     star->is_selected = false;
-    sprintf(star->galaxy_name, "%s", nav_state->current_galaxy->name);
+    sprintf(star->galaxy_name, "%s", galaxy->name);
+    star->galaxy_position = galaxy->position;
 
     star->waypoint_button = (WaypointButton){
         .rect = (SDL_Rect){.x = 0,
@@ -212,7 +519,6 @@ static Star *stars_create_star(const NavigationState *nav_state, Point position,
                            .h = 0}};
 
     star->waypoint_path = NULL;
-    star->waypoint_points = 0;
 
     return star;
 }
@@ -241,14 +547,11 @@ static void stars_delete_entry(StarEntry *stars[], Point position)
             if (entry->star != NULL && entry->star->planets[0] != NULL)
                 stars_cleanup_planets(entry->star);
 
-            if (entry->star->waypoint_path != NULL)
-            {
-                free(entry->star->waypoint_path);
-                entry->star->waypoint_path = NULL;
-            }
+            path_destroy(entry->star->waypoint_path);
 
             free(entry->star);
             entry->star = NULL;
+            COUNTERS_ADD(COUNTER_STARS_EVICTED, 1);
 
             if (previous == NULL)
                 stars[index] = entry->next;
@@ -319,8 +622,10 @@ void stars_delete_outside_region(StarEntry *stars[], const NavigationState *nav_
  */
 void stars_draw_info_box(NavigationState *nav_state, const Star *star, const Camera *camera)
 {
+    unsigned short previous_layer = render_set_layer(RENDER_LAYER_UI);
+
     // Draw background box
-    SDL_SetRenderDrawColor(renderer, 12, 12, 12, 230);
+    render_set_draw_color(12, 12, 12, 230);
     int width = INFO_BOX_WIDTH;
     int padding = INFO_BOX_PADDING;
     int inner_padding = 40;
@@ -332,7 +637,7 @@ void stars_draw_info_box(NavigationState *nav_state, const Star *star, const Cam
     info_box_rect.w = width;
     info_box_rect.h = height;
 
-    SDL_RenderFillRect(renderer, &info_box_rect);
+    render_fill_rect(&info_box_rect);
 
     // Create info array
     InfoBoxEntry entries[STAR_INFO_COUNT];
@@ -373,18 +678,14 @@ void stars_draw_info_box(NavigationState *nav_state, const Star *star, const Cam
     sprintf(entries[STAR_INFO_PLANETS].text, "Planets: %*s%s", 5, "", planets_text);
     entries[STAR_INFO_PLANETS].font_size = FONT_SIZE_15;
 
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 0);
+    render_set_draw_color(255, 255, 255, 0);
 
     for (int i = 0; i < STAR_INFO_COUNT; i++)
     {
-        // Create a texture from the entry text
-        SDL_Surface *text_surface = TTF_RenderText_Blended(fonts[entries[i].font_size], entries[i].text, colors[COLOR_WHITE_180]);
-        SDL_Texture *text_texture = SDL_CreateTextureFromSurface(renderer, text_surface);
-        entries[i].text_texture = text_texture;
-        entries[i].texture_rect.w = text_surface->w;
-        entries[i].texture_rect.h = text_surface->h;
-
-        SDL_FreeSurface(text_surface);
+        // Get a label for the entry text
+        entries[i].text_label = text_get_label(entries[i].text, entries[i].font_size, colors[COLOR_WHITE_180]);
+        entries[i].texture_rect.w = entries[i].text_label->w;
+        entries[i].texture_rect.h = entries[i].text_label->h;
     }
 
     // Name
@@ -394,12 +695,12 @@ void stars_draw_info_box(NavigationState *nav_state, const Star *star, const Cam
     entries[STAR_INFO_NAME].rect.x = camera->w - (width - 2.5 * padding);
     entries[STAR_INFO_NAME].rect.y = padding;
 
-    SDL_RenderFillRect(renderer, &entries[STAR_INFO_NAME].rect);
+    render_fill_rect(&entries[STAR_INFO_NAME].rect);
 
     entries[STAR_INFO_NAME].texture_rect.x = entries[STAR_INFO_NAME].rect.x + inner_padding;
     entries[STAR_INFO_NAME].texture_rect.y = entries[STAR_INFO_NAME].rect.y + (entries[STAR_INFO_NAME].rect.h - entries[STAR_INFO_NAME].texture_rect.h) / 2;
 
-    SDL_RenderCopy(renderer, entries[STAR_INFO_NAME].text_texture, NULL, &entries[STAR_INFO_NAME].texture_rect);
+    text_draw_label(entries[STAR_INFO_NAME].text_label, entries[STAR_INFO_NAME].texture_rect.x, entries[STAR_INFO_NAME].texture_rect.y);
 
     // Set the position for the rest of the entries
     int entry_height = 30;
@@ -411,14 +712,14 @@ void stars_draw_info_box(NavigationState *nav_state, const Star *star, const Cam
         entries[i].rect.x = camera->w - (width - 2.5 * padding);
         entries[i].rect.y = padding + name_height + (i - 1) * entry_height;
 
-        SDL_RenderFillRect(renderer, &entries[i].rect);
+        render_fill_rect(&entries[i].rect);
 
         // Set the position of the text within the entry
         entries[i].texture_rect.x = entries[i].rect.x + inner_padding;
         entries[i].texture_rect.y = entries[i].rect.y + (entries[i].rect.h - entries[i].texture_rect.h) / 2;
 
-        // Render the text texture onto the entry
-        SDL_RenderCopy(renderer, entries[i].text_texture, NULL, &entries[i].texture_rect);
+        // Render the text label onto the entry
+        text_draw_label(entries[i].text_label, entries[i].texture_rect.x, entries[i].texture_rect.y);
     }
 
     // Star circle
@@ -435,15 +736,10 @@ void stars_draw_info_box(NavigationState *nav_state, const Star *star, const Cam
     }
 
     // Draw line
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 30);
-    SDL_RenderDrawLine(renderer, x_star, y_star, x_star, padding + height);
+    render_set_draw_color(255, 255, 255, 30);
+    render_draw_line(x_star, y_star, x_star, padding + height);
 
-    // Destroy the textures
-    for (int i = 0; i < STAR_INFO_COUNT; i++)
-    {
-        SDL_DestroyTexture(entries[i].text_texture);
-        entries[i].text_texture = NULL;
-    }
+    render_set_layer(previous_layer);
 }
 
 /**
@@ -458,6 +754,8 @@ void stars_draw_info_box(NavigationState *nav_state, const Star *star, const Cam
  */
 void stars_draw_planets_info_box(InputState *input_state, NavigationState *nav_state, Star *star, const Camera *camera)
 {
+    unsigned short previous_layer = render_set_layer(RENDER_LAYER_UI);
+
     int width = INFO_BOX_WIDTH;
     int padding = INFO_BOX_PADDING;
     int inner_padding = 2 * padding;
@@ -489,14 +787,14 @@ void stars_draw_planets_info_box(InputState *input_state, NavigationState *nav_s
     }
 
     // Draw background box
-    SDL_SetRenderDrawColor(renderer, 17, 17, 17, 255);
+    render_set_draw_color(17, 17, 17, 255);
     SDL_Rect info_box_rect;
     info_box_rect.x = camera->w - (width + padding);
     info_box_rect.y = padding + info_box_height;
     info_box_rect.w = width;
     info_box_rect.h = height;
 
-    SDL_RenderFillRect(renderer, &info_box_rect);
+    render_fill_rect(&info_box_rect);
 
     // Calculate scaling factors from star class
     int planets_scaling_factor;
@@ -528,16 +826,16 @@ void stars_draw_planets_info_box(InputState *input_state, NavigationState *nav_s
 
     // Draw separator line
     int x = camera->w - (width - 1.4 * inner_padding);
-    SDL_SetRenderDrawColor(renderer, star->color.r, star->color.g, star->color.b, 50);
-    SDL_RenderDrawLine(renderer, camera->w - (width + padding), padding + info_box_height, camera->w - padding, padding + info_box_height);
+    render_set_draw_color(star->color.r, star->color.g, star->color.b, 50);
+    render_draw_line(camera->w - (width + padding), padding + info_box_height, camera->w - padding, padding + info_box_height);
 
     // Draw orbits line
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 30);
+    render_set_draw_color(255, 255, 255, 30);
 
     int y1_line = padding + info_box_height + 1; // + 1 line
     int y2_line = camera->h - padding;
     int line_height = y2_line - y1_line - padding; // Decrease by <padding> so that last planet does not overflow box
-    SDL_RenderDrawLine(renderer, x, y1_line, x, y2_line);
+    render_draw_line(x, y1_line, x, y2_line);
 
     // Planets
     float y_so_far = y1_line; // Line represents star cutoff distance
@@ -570,8 +868,8 @@ void stars_draw_planets_info_box(InputState *input_state, NavigationState *nav_s
                 // Draw moon and orbit
                 float moon_orbit = star->planets[i]->planets[j]->orbit_radius * line_width / star->planets[i]->cutoff;
                 float moon_radius = star->planets[i]->planets[j]->radius / planets_scaling_factor;
-                SDL_SetRenderDrawColor(renderer, 255, 255, 255, 30);
-                SDL_RenderDrawLine(renderer, x_so_far, y_so_far, x_so_far + moon_orbit, y_so_far);
+                render_set_draw_color(255, 255, 255, 30);
+                render_draw_line(x_so_far, y_so_far, x_so_far + moon_orbit, y_so_far);
                 x_so_far += moon_orbit + 2 * moon_radius;
                 gfx_draw_fill_circle(renderer, x_so_far - moon_radius, y_so_far, moon_radius, star->planets[i]->planets[j]->color);
             }
@@ -604,6 +902,8 @@ void stars_draw_planets_info_box(InputState *input_state, NavigationState *nav_s
             }
         }
     }
+
+    render_set_layer(previous_layer);
 }
 
 /**
@@ -613,11 +913,12 @@ void stars_draw_planets_info_box(InputState *input_state, NavigationState *nav_s
  * @param input_state A pointer to the current InputState object.
  * @param nav_state A pointer to the current NavigationState object.
  * @param body The celestial body to draw.
+ * @param lod The level of detail of the star system, from stars_get_lod(). STAR_LOD_SYSTEM in Navigate.
  * @param camera A pointer to the current Camera object.
  *
  * @return void
  */
-void stars_draw_star_system(GameState *game_state, const InputState *input_state, NavigationState *nav_state, CelestialBody *body, const Camera *camera)
+void stars_draw_star_system(GameState *game_state, const InputState *input_state, NavigationState *nav_state, CelestialBody *body, unsigned short lod, const Camera *camera)
 {
     double distance;
     Point position;
@@ -668,10 +969,7 @@ void stars_draw_star_system(GameState *game_state, const InputState *input_state
                 colors[COLOR_WHITE_255].b,
                 orbit_opacity};
 
-            if (2 * body->orbit_radius * game_state->game_scale > camera->h)
-                gfx_draw_circle_approximation(renderer, camera, x, y, (int)radius, orbit_color);
-            else
-                gfx_draw_circle(renderer, camera, x, y, (int)radius, orbit_color);
+            gfx_draw_circle(renderer, camera, x, y, (int)radius, orbit_color);
         }
 
         // Draw waypoint circle
@@ -685,18 +983,15 @@ void stars_draw_star_system(GameState *game_state, const InputState *input_state
             SDL_Color waypoint_circle_color = nav_state->waypoint_star->color;
             waypoint_circle_color.a = 150;
 
-            if (2 * cutoff_radius > camera->h)
-                gfx_draw_circle_approximation(renderer, camera, body_x, body_y, (int)cutoff_radius, waypoint_circle_color);
-            else
-                gfx_draw_circle(renderer, camera, body_x, body_y, (int)cutoff_radius, waypoint_circle_color);
+            gfx_draw_circle(renderer, camera, body_x, body_y, (int)cutoff_radius, waypoint_circle_color);
         }
 
         // Draw moons
-        int max_planets = MAX_MOONS;
+        int max_planets = lod == STAR_LOD_SYSTEM ? MAX_MOONS : 0;
 
         for (int i = 0; i < max_planets && body->planets[i] != NULL; i++)
         {
-            stars_draw_star_system(game_state, input_state, nav_state, body->planets[i], camera);
+            stars_draw_star_system(game_state, input_state, nav_state, body->planets[i], lod, camera);
         }
     }
     else if (body->level == LEVEL_STAR)
@@ -731,14 +1026,17 @@ void stars_draw_star_system(GameState *game_state, const InputState *input_state
 
                     // Seed with a fixed constant
                     pcg32_srandom_r(&rng, seed, seed);
+                    COUNTERS_ADD(COUNTER_SEEDS_STAR_SYSTEMS, 1);
 
                     stars_populate_body(body, star_position, rng, game_state->game_scale);
                 }
 
                 // Draw planets
-                for (int i = 0; i < MAX_PLANETS && body->planets[i] != NULL; i++)
+                int max_planets = lod >= STAR_LOD_ORBITS ? MAX_PLANETS : 0;
+
+                for (int i = 0; i < max_planets && body->planets[i] != NULL; i++)
                 {
-                    stars_draw_star_system(game_state, input_state, nav_state, body->planets[i], camera);
+                    stars_draw_star_system(game_state, input_state, nav_state, body->planets[i], lod, camera);
                 }
 
                 // Update current_star
@@ -747,7 +1045,7 @@ void stars_draw_star_system(GameState *game_state, const InputState *input_state
                      gfx_is_object_in_camera(camera, body->position.x, body->position.y, body->radius, game_state->game_scale)))
                 {
                     if (strcmp(nav_state->current_star->name, body->name) != 0)
-                        memcpy(nav_state->current_star, body, sizeof(Star));
+                        stars_copy_star(nav_state->current_star, body);
                 }
 
                 // Draw cutoff area circle
@@ -759,12 +1057,7 @@ void stars_draw_star_system(GameState *game_state, const InputState *input_state
                     color_code = COLOR_MAGENTA_100;
 
                 if (input_state->orbits_on && strcmp(nav_state->waypoint_star->name, body->name) != 0)
-                {
-                    if (2 * radius * game_state->game_scale > camera->h)
-                        gfx_draw_circle_approximation(renderer, camera, x, y, radius, colors[color_code]);
-                    else
-                        gfx_draw_circle(renderer, camera, x, y, radius, colors[color_code]);
-                }
+                    gfx_draw_circle(renderer, camera, x, y, radius, colors[color_code]);
             }
         }
         else if (game_state->state == NAVIGATE)
@@ -779,20 +1072,20 @@ void stars_draw_star_system(GameState *game_state, const InputState *input_state
 
                 for (int i = 0; i < max_planets && body->planets[i] != NULL; i++)
                 {
-                    stars_draw_star_system(game_state, input_state, nav_state, body->planets[i], camera);
+                    stars_draw_star_system(game_state, input_state, nav_state, body->planets[i], lod, camera);
                 }
 
                 // Update buffer_star
                 if (strcmp(nav_state->buffer_star->name, body->name) != 0)
-                    memcpy(nav_state->buffer_star, body, sizeof(Star));
+                    stars_copy_star(nav_state->buffer_star, body);
 
                 // Update current_star
                 if (strcmp(nav_state->current_star->name, body->name) != 0)
-                    memcpy(nav_state->current_star, body, sizeof(Star));
+                    stars_copy_star(nav_state->current_star, body);
 
                 // Update selected_star
                 if (strcmp(nav_state->selected_star->name, body->name) != 0)
-                    memcpy(nav_state->selected_star, body, sizeof(Star));
+                    stars_copy_star(nav_state->selected_star, body);
 
                 nav_state->selected_star->is_selected = true;
             }
@@ -812,7 +1105,7 @@ void stars_draw_star_system(GameState *game_state, const InputState *input_state
                 else
                     color_code = COLOR_MAGENTA_70;
 
-                gfx_draw_circle_approximation(renderer, camera, x, y, cutoff, colors[color_code]);
+                gfx_draw_circle(renderer, camera, x, y, cutoff, colors[color_code]);
             }
         }
     }
@@ -824,7 +1117,13 @@ void stars_draw_star_system(GameState *game_state, const InputState *input_state
         int center_x = (body->position.x - camera->x) * game_state->game_scale;
         int center_y = (body->position.y - camera->y) * game_state->game_scale;
 
-        gfx_draw_fill_circle(renderer, center_x, center_y, (int)radius, body->color);
+        if (stars_is_drawn_as_point(body, lod, game_state->game_scale))
+        {
+            render_set_draw_color(body->color.r, body->color.g, body->color.b, body->color.a);
+            render_draw_point(center_x, center_y);
+        }
+        else
+            gfx_draw_fill_circle(renderer, center_x, center_y, (int)radius, body->color);
     }
     // Draw body projection
     else if (PROJECT_BODIES_ON)
@@ -869,11 +1168,12 @@ void stars_draw_star_system(GameState *game_state, const InputState *input_state
  * @param input_state A pointer to the current InputState object.
  * @param nav_state A pointer to the current NavigationState object.
  * @param body The celestial body to draw.
+ * @param lod The level of detail of the star system, from stars_get_lod(). At least STAR_LOD_ORBITS.
  * @param camera A pointer to the current Camera object.
  *
  * @return void
  */
-void stars_draw_universe_star_system(GameState *game_state, const InputState *input_state, NavigationState *nav_state, CelestialBody *body, const Camera *camera)
+void stars_draw_universe_star_system(GameState *game_state, const InputState *input_state, NavigationState *nav_state, CelestialBody *body, unsigned short lod, const Camera *camera)
 {
     double distance;
 
@@ -916,11 +1216,11 @@ void stars_draw_universe_star_system(GameState *game_state, const InputState *in
         }
 
         // Draw moons
-        int max_planets = MAX_MOONS;
+        int max_planets = lod == STAR_LOD_SYSTEM ? MAX_MOONS : 0;
 
         for (int i = 0; i < max_planets && body->planets[i] != NULL; i++)
         {
-            stars_draw_universe_star_system(game_state, input_state, nav_state, body->planets[i], camera);
+            stars_draw_universe_star_system(game_state, input_state, nav_state, body->planets[i], lod, camera);
         }
     }
     else if (body->level == LEVEL_STAR)
@@ -928,7 +1228,7 @@ void stars_draw_universe_star_system(GameState *game_state, const InputState *in
         // Draw planets
         for (int i = 0; i < MAX_PLANETS && body->planets[i] != NULL; i++)
         {
-            stars_draw_universe_star_system(game_state, input_state, nav_state, body->planets[i], camera);
+            stars_draw_universe_star_system(game_state, input_state, nav_state, body->planets[i], lod, camera);
         }
     }
 
@@ -937,7 +1237,13 @@ void stars_draw_universe_star_system(GameState *game_state, const InputState *in
     int center_x = (nav_state->current_galaxy->position.x - camera->x + body->position.x / GALAXY_SCALE) * game_state->game_scale * GALAXY_SCALE;
     int center_y = (nav_state->current_galaxy->position.y - camera->y + body->position.y / GALAXY_SCALE) * game_state->game_scale * GALAXY_SCALE;
 
-    gfx_draw_fill_circle(renderer, center_x, center_y, (int)radius, body->color);
+    if (stars_is_drawn_as_point(body, lod, game_state->game_scale))
+    {
+        render_set_draw_color(body->color.r, body->color.g, body->color.b, body->color.a);
+        render_draw_point(center_x, center_y);
+    }
+    else
+        gfx_draw_fill_circle(renderer, center_x, center_y, (int)radius, body->color);
 }
 
 /**
@@ -996,6 +1302,7 @@ void stars_generate(GameState *game_state, GameEvents *game_events, NavigationSt
     // Keep track of current nearest section lines position
     double bx = maths_get_nearest_section_line(offset.x, GALAXY_SECTION_SIZE);
     double by = maths_get_nearest_section_line(offset.y, GALAXY_SECTION_SIZE);
+    Point previous_line = nav_state->cross_line;
 
     // Check if this is the first time calling this function
     if (!game_events->start_stars_generation)
@@ -1037,7 +1344,9 @@ void stars_generate(GameState *game_state, GameEvents *game_events, NavigationSt
         Point cross_section_offset;
         cross_section_offset.x = maths_get_nearest_section_line(universe_position.x, UNIVERSE_SECTION_SIZE);
         cross_section_offset.y = maths_get_nearest_section_line(universe_position.y, UNIVERSE_SECTION_SIZE);
+        PROFILER_BEGIN(PROFILER_SCOPE_GALAXIES);
         galaxies_generate(game_events, nav_state, cross_section_offset);
+        PROFILER_END(PROFILER_SCOPE_GALAXIES);
 
         // Search for nearest galaxy to universe_position, including current galaxy
         Galaxy *next_galaxy = galaxies_nearest_circumference(nav_state, universe_position, false);
@@ -1048,10 +1357,18 @@ void stars_generate(GameState *game_state, GameEvents *game_events, NavigationSt
             game_events->found_galaxy = true;
 
             // Update previous_galaxy
-            memcpy(nav_state->previous_galaxy, nav_state->current_galaxy, sizeof(Galaxy));
+            galaxies_copy_galaxy(nav_state->previous_galaxy, nav_state->current_galaxy);
 
             // Update current_galaxy
-            memcpy(nav_state->current_galaxy, next_galaxy, sizeof(Galaxy));
+            galaxies_copy_galaxy(nav_state->current_galaxy, next_galaxy);
+
+            // Work for the previous galaxy is no longer needed
+            jobs_cancel(JOB_TAG_REGION | JOB_TAG_GALAXY);
+            stars_clear_prefetch();
+            stars_clear_populations();
+
+            if (PROFILER_ON)
+                trace_add_instant("switch galaxy");
 
             // Get current position relative to new galaxy
             double angle = atan2(universe_position.y - next_galaxy->position.y, universe_position.x - next_galaxy->position.x);
@@ -1078,7 +1395,13 @@ void stars_generate(GameState *game_state, GameEvents *game_events, NavigationSt
                 nav_state->galaxy_offset.buffer_y = nav_state->galaxy_offset.current_y;
 
                 // Update buffer_galaxy
-                memcpy(nav_state->buffer_galaxy, nav_state->current_galaxy, sizeof(Galaxy));
+                galaxies_copy_galaxy(nav_state->buffer_galaxy, nav_state->current_galaxy);
+
+                // The waypoint path is in the coordinates of the previous galaxy; The next leg is planned from here
+                route_cancel_job();
+                path_destroy(nav_state->waypoint_star->waypoint_path);
+                nav_state->waypoint_star->waypoint_path = NULL;
+                nav_state->next_path_point = 1;
 
                 // Delete stars from previous galaxy
                 stars_clear_table(nav_state->stars, nav_state, true);
@@ -1115,6 +1438,37 @@ void stars_generate(GameState *game_state, GameEvents *game_events, NavigationSt
     else
         game_events->has_exited_galaxy = false;
 
+    // Set galaxy hash as initseq
+    nav_state->initseq = maths_hash_position_to_uint64_2(nav_state->current_galaxy->position);
+
+    // Take the stars of the new sections if they were generated ahead of the ship
+    Point line = {.x = bx, .y = by};
+    bool is_prefetched = !game_events->start_stars_generation && stars_merge_prefetch(nav_state, previous_line, line);
+
+    if (!is_prefetched)
+        stars_generate_region(nav_state->stars, nav_state->current_galaxy, nav_state->initseq, bx, by);
+
+    // Delete stars that end up outside the region
+    stars_delete_outside_region(nav_state->stars, nav_state, bx, by, GALAXY_REGION_SIZE);
+
+    // First star generation complete
+    game_events->start_stars_generation = false;
+}
+
+/**
+ * Generates the stars of a region of GALAXY_REGION_SIZE * GALAXY_REGION_SIZE sections
+ * that are not in the hash table yet.
+ *
+ * @param stars An array of pointers to StarEntry structures, representing the hash table of stars.
+ * @param galaxy A pointer to the Galaxy object.
+ * @param initseq The initialization sequence of the galaxy, used for the RNG.
+ * @param bx The x coordinate of the center of the region.
+ * @param by The y coordinate of the center of the region.
+ *
+ * @return void
+ */
+static void stars_generate_region(StarEntry *stars[], Galaxy *galaxy, uint64_t initseq, double bx, double by)
+{
     // Define a region of GALAXY_REGION_SIZE * GALAXY_REGION_SIZE
     // bx,by are at the center of this area
     double ix, iy;
@@ -1122,29 +1476,22 @@ void stars_generate(GameState *game_state, GameEvents *game_events, NavigationSt
     double right_boundary = bx + ((GALAXY_REGION_SIZE / 2) * GALAXY_SECTION_SIZE);
     double top_boundary = by - ((GALAXY_REGION_SIZE / 2) * GALAXY_SECTION_SIZE);
     double bottom_boundary = by + ((GALAXY_REGION_SIZE / 2) * GALAXY_SECTION_SIZE);
-
-    // Add a buffer zone of <GALAXY_REGION_SIZE> sections beyond galaxy radius
-    int radius_plus_buffer = (nav_state->current_galaxy->radius * GALAXY_SCALE) + GALAXY_REGION_SIZE * GALAXY_SECTION_SIZE;
-    int in_horizontal_bounds = left_boundary > -radius_plus_buffer && right_boundary < radius_plus_buffer;
-    int in_vertical_bounds = top_boundary > -radius_plus_buffer && bottom_boundary < radius_plus_buffer;
+    bool is_in_galaxy = stars_is_region_in_galaxy(galaxy, bx, by);
 
     // Use a local rng
     pcg32_random_t rng;
 
     // Density scaling parameter
-    double a = nav_state->current_galaxy->radius * GALAXY_SCALE / 2.0f;
-
-    // Set galaxy hash as initseq
-    nav_state->initseq = maths_hash_position_to_uint64_2(nav_state->current_galaxy->position);
+    double a = galaxy->radius * GALAXY_SCALE / 2.0f;
 
-    for (ix = left_boundary; ix < right_boundary && in_horizontal_bounds; ix += GALAXY_SECTION_SIZE)
+    for (ix = left_boundary; ix < right_boundary && is_in_galaxy; ix += GALAXY_SECTION_SIZE)
     {
-        for (iy = top_boundary; iy < bottom_boundary && in_vertical_bounds; iy += GALAXY_SECTION_SIZE)
+        for (iy = top_boundary; iy < bottom_boundary; iy += GALAXY_SECTION_SIZE)
         {
             // Check that point is within galaxy radius
             double distance_from_center = sqrt(ix * ix + iy * iy);
 
-            if (distance_from_center > (nav_state->current_galaxy->radius * GALAXY_SCALE))
+            if (distance_from_center > (galaxy->radius * GALAXY_SCALE))
                 continue;
 
             // Create rng seed by combining x,y values
@@ -1152,7 +1499,8 @@ void stars_generate(GameState *game_state, GameEvents *game_events, NavigationSt
             uint64_t seed = maths_hash_position_to_uint64(position);
 
             // Seed with a fixed constant
-            pcg32_srandom_r(&rng, seed, nav_state->initseq);
+            pcg32_srandom_r(&rng, seed, initseq);
+            COUNTERS_ADD(COUNTER_SEEDS_STAR_SECTIONS, 1);
 
             // Calculate density based on distance from center
             double density = (GALAXY_DENSITY / pow((distance_from_center / a + 1), 6));
@@ -1162,25 +1510,19 @@ void stars_generate(GameState *game_state, GameEvents *game_events, NavigationSt
             if (has_star)
             {
                 // Check whether star exists in hash table
-                if (stars_entry_exists(nav_state->stars, position))
+                if (stars_entry_exists(stars, position))
                     continue;
                 else
                 {
                     // Create star
-                    Star *star = stars_create_star(nav_state, position, false);
+                    Star *star = stars_create_star(galaxy, initseq, position, false);
 
                     // Add star to hash table
-                    stars_add_entry(nav_state->stars, position, star);
+                    stars_add_entry(stars, position, star);
                 }
             }
         }
     }
-
-    // Delete stars that end up outside the region
-    stars_delete_outside_region(nav_state->stars, nav_state, bx, by, GALAXY_REGION_SIZE);
-
-    // First star generation complete
-    game_events->start_stars_generation = false;
 }
 
 /**
@@ -1297,6 +1639,7 @@ void stars_generate_preview(GameEvents *game_events, NavigationState *nav_state,
 
             // Seed with a fixed constant
             pcg32_srandom_r(&rng, seed, nav_state->initseq);
+            COUNTERS_ADD(COUNTER_SEEDS_STAR_SECTIONS, 1);
 
             // Calculate density based on distance from center
             double density = (GALAXY_DENSITY / pow((distance_from_center / a + 1), 6));
@@ -1311,7 +1654,7 @@ void stars_generate_preview(GameEvents *game_events, NavigationState *nav_state,
                 else
                 {
                     // Create star
-                    Star *star = stars_create_star(nav_state, position, true);
+                    Star *star = stars_create_star(nav_state->current_galaxy, nav_state->initseq, position, true);
 
                     // Add star to hash table
                     stars_add_entry(nav_state->stars, position, star);
@@ -1339,6 +1682,31 @@ void stars_generate_preview(GameEvents *game_events, NavigationState *nav_state,
     stars_delete_outside_region(nav_state->stars, nav_state, bx, by, region_size);
 }
 
+/**
+ * Chooses how much of a star system to draw in Map and Universe, from its projected size.
+ * Evaluated once per star and frame.
+ *
+ * @param star A pointer to the Star.
+ * @param scale The scale of the star system on the screen.
+ *
+ * @return The level of detail, one of STAR_LOD_POINT, STAR_LOD_DISC, STAR_LOD_ORBITS and STAR_LOD_SYSTEM.
+ */
+unsigned short stars_get_lod(const Star *star, long double scale)
+{
+    double cutoff_radius = star->cutoff * scale;
+
+    if (cutoff_radius >= STAR_LOD_SYSTEM_RADIUS)
+        return STAR_LOD_SYSTEM;
+
+    if (cutoff_radius >= STAR_LOD_ORBITS_RADIUS)
+        return STAR_LOD_ORBITS;
+
+    if (star->radius * scale >= STAR_LOD_DISC_RADIUS)
+        return STAR_LOD_DISC;
+
+    return STAR_LOD_POINT;
+}
+
 /**
  * Initializes a Star structure with default values.
  *
@@ -1372,6 +1740,7 @@ void stars_initialize_star(Star *star)
     star->level = 0;
     star->is_selected = false;
     memset(star->galaxy_name, 0, sizeof(star->galaxy_name));
+    star->galaxy_position = (Point){0, 0};
 
     star->waypoint_button = (WaypointButton){
         .rect = (SDL_Rect){.x = 0,
@@ -1380,58 +1749,172 @@ void stars_initialize_star(Star *star)
                            .h = 0}};
 
     star->waypoint_path = NULL;
-    star->waypoint_points = 0;
 }
 
 /**
- * Calculates the distance from a given position to the nearest star in the current galaxy.
- * Searches inner circumferences of points first and works towards outward circumferences.
+ * Checks whether a body is drawn as a point. Stars are points at STAR_LOD_POINT,
+ * and planets and moons are points while their projected radius is below STAR_LOD_DISC_RADIUS.
  *
- * @param position The position from which to calculate the distance.
- * @param current_galaxy A pointer to the current Galaxy object.
- * @param initseq The initialization sequence used for the RNG.
- * @param galaxy_density The density of stars in the current galaxy.
+ * @param body A pointer to the CelestialBody.
+ * @param lod The level of detail of its star system.
+ * @param scale The scale the body is drawn at.
  *
- * @return The distance from the given position to the nearest star in the current galaxy.
- *         If no star is found within the galaxy, the function returns 7 * GALAXY_SECTION_SIZE.
+ * @return True if the body is drawn as a point, false if it is drawn as a disc.
  */
-double stars_nearest_star_distance(Point position, Galaxy *current_galaxy, uint64_t initseq, int galaxy_density)
+static bool stars_is_drawn_as_point(const CelestialBody *body, unsigned short lod, long double scale)
 {
-    // We use 6 * GALAXY_SECTION_SIZE as max, since a CLASS_6 star needs 6 + 1 empty sections
-    // We search inner circumferences of points first and work towards outward circumferences
-    // If we find a star, the function returns.
-
-    // Keep track of checked points
-    Point checked_points[MAX_NEAREST_STARS];
-    int num_checked_points = 0;
+    if (body->level == LEVEL_STAR)
+        return lod == STAR_LOD_POINT;
 
-    // Use a local rng
-    pcg32_random_t rng;
+    return body->radius * scale < STAR_LOD_DISC_RADIUS;
+}
 
-    // Density scaling parameter
-    double a = current_galaxy->radius * GALAXY_SCALE / 2.0f;
+/**
+ * Checks whether two hash tables of stars have stars at the same positions.
+ * Chains can be in any order, as the stars are added in a different order.
+ *
+ * @param a An array of pointers to StarEntry structures.
+ * @param b An array of pointers to StarEntry structures.
+ *
+ * @return True if the tables are identical, false otherwise.
+ */
+static bool stars_is_equal_table(StarEntry *a[], StarEntry *b[])
+{
+    int num_a = 0;
+    int num_b = 0;
 
-    for (int i = 1; i <= 6; i++)
+    for (int s = 0; s < MAX_STARS; s++)
     {
-        for (double ix = position.x - i * GALAXY_SECTION_SIZE; ix <= position.x + i * GALAXY_SECTION_SIZE; ix += GALAXY_SECTION_SIZE)
+        for (StarEntry *entry = a[s]; entry != NULL; entry = entry->next)
         {
-            for (double iy = position.y - i * GALAXY_SECTION_SIZE; iy <= position.y + i * GALAXY_SECTION_SIZE; iy += GALAXY_SECTION_SIZE)
-            {
-                if (ix == position.x && iy == position.y)
-                    continue;
+            Point position = {.x = entry->x, .y = entry->y};
 
-                Point p = {ix, iy};
+            if (!stars_entry_exists(b, position))
+                return false;
 
-                if (maths_check_point_in_array(p, checked_points, num_checked_points))
-                    continue;
+            num_a++;
+        }
 
-                checked_points[num_checked_points++] = p;
+        for (StarEntry *entry = b[s]; entry != NULL; entry = entry->next)
+            num_b++;
+    }
 
-                // Create rng seed by combining x,y values
-                uint64_t seed = maths_hash_position_to_uint64(p);
+    return num_a == num_b;
+}
 
-                // Seed with a fixed constant
-                pcg32_srandom_r(&rng, seed, initseq);
+/**
+ * Checks whether a region is near enough to the galaxy to have stars.
+ * Regions up to <GALAXY_REGION_SIZE> sections beyond the galaxy radius are checked.
+ *
+ * @param galaxy A pointer to the Galaxy.
+ * @param bx The x coordinate of the center of the region.
+ * @param by The y coordinate of the center of the region.
+ *
+ * @return True if the region is in the galaxy, false otherwise.
+ */
+static bool stars_is_region_in_galaxy(const Galaxy *galaxy, double bx, double by)
+{
+    double left_boundary = bx - ((GALAXY_REGION_SIZE / 2) * GALAXY_SECTION_SIZE);
+    double right_boundary = bx + ((GALAXY_REGION_SIZE / 2) * GALAXY_SECTION_SIZE);
+    double top_boundary = by - ((GALAXY_REGION_SIZE / 2) * GALAXY_SECTION_SIZE);
+    double bottom_boundary = by + ((GALAXY_REGION_SIZE / 2) * GALAXY_SECTION_SIZE);
+
+    // Add a buffer zone of <GALAXY_REGION_SIZE> sections beyond galaxy radius
+    int radius_plus_buffer = (galaxy->radius * GALAXY_SCALE) + GALAXY_REGION_SIZE * GALAXY_SECTION_SIZE;
+    int in_horizontal_bounds = left_boundary > -radius_plus_buffer && right_boundary < radius_plus_buffer;
+    int in_vertical_bounds = top_boundary > -radius_plus_buffer && bottom_boundary < radius_plus_buffer;
+
+    return in_horizontal_bounds && in_vertical_bounds;
+}
+
+/**
+ * Adds the stars of a region generated ahead of the ship to the hash table of stars, if the ship
+ * shifted from the origin to the target of the prefetch and its job has finished.
+ * Other prefetches for the target are dropped, and the region is generated as usual.
+ *
+ * @param nav_state A pointer to the current NavigationState object.
+ * @param origin The center of the previous region.
+ * @param target The center of the current region.
+ *
+ * @return True if the stars of the region were added, false otherwise.
+ */
+static bool stars_merge_prefetch(NavigationState *nav_state, Point origin, Point target)
+{
+    bool is_merged = false;
+
+    for (int i = 0; i < STARS_PREFETCH_SHIFTS; i++)
+    {
+        StarsPrefetch *prefetch = prefetches[i];
+
+        if (prefetch == NULL || !maths_points_equal(prefetch->target, target))
+            continue;
+
+        if (maths_points_equal(prefetch->origin, origin) &&
+            maths_points_equal(prefetch->galaxy->position, nav_state->current_galaxy->position) &&
+            jobs_is_handle_done(&prefetch->handle))
+        {
+            stars_add_prefetch(nav_state->stars, prefetch);
+            is_merged = true;
+        }
+
+        jobs_cancel_handle(&prefetch->handle);
+        stars_release_prefetch(prefetch);
+        prefetches[i] = NULL;
+    }
+
+    return is_merged;
+}
+
+/**
+ * Calculates the distance from a given position to the nearest star in the current galaxy.
+ * Searches inner circumferences of points first and works towards outward circumferences.
+ *
+ * @param position The position from which to calculate the distance.
+ * @param current_galaxy A pointer to the current Galaxy object.
+ * @param initseq The initialization sequence used for the RNG.
+ * @param galaxy_density The density of stars in the current galaxy.
+ *
+ * @return The distance from the given position to the nearest star in the current galaxy.
+ *         If no star is found within the galaxy, the function returns 7 * GALAXY_SECTION_SIZE.
+ */
+double stars_nearest_star_distance(Point position, Galaxy *current_galaxy, uint64_t initseq, int galaxy_density)
+{
+    // We use 6 * GALAXY_SECTION_SIZE as max, since a CLASS_6 star needs 6 + 1 empty sections
+    // We search inner circumferences of points first and work towards outward circumferences
+    // If we find a star, the function returns.
+
+    // Keep track of checked points
+    Point checked_points[MAX_NEAREST_STARS];
+    int num_checked_points = 0;
+
+    // Use a local rng
+    pcg32_random_t rng;
+
+    // Density scaling parameter
+    double a = current_galaxy->radius * GALAXY_SCALE / 2.0f;
+
+    for (int i = 1; i <= 6; i++)
+    {
+        for (double ix = position.x - i * GALAXY_SECTION_SIZE; ix <= position.x + i * GALAXY_SECTION_SIZE; ix += GALAXY_SECTION_SIZE)
+        {
+            for (double iy = position.y - i * GALAXY_SECTION_SIZE; iy <= position.y + i * GALAXY_SECTION_SIZE; iy += GALAXY_SECTION_SIZE)
+            {
+                if (ix == position.x && iy == position.y)
+                    continue;
+
+                Point p = {ix, iy};
+
+                if (maths_check_point_in_array(p, checked_points, num_checked_points))
+                    continue;
+
+                checked_points[num_checked_points++] = p;
+
+                // Create rng seed by combining x,y values
+                uint64_t seed = maths_hash_position_to_uint64(p);
+
+                // Seed with a fixed constant
+                pcg32_srandom_r(&rng, seed, initseq);
+                COUNTERS_ADD(COUNTER_SEEDS_STAR_SECTIONS, 1);
 
                 // Calculate density based on distance from center
                 /*
@@ -1520,62 +2003,6 @@ Star *stars_nearest_star_in_nav_state(const NavigationState *nav_state, Point po
     return closest;
 }
 
-/**
- * Finds the nearest stars to the given point. Searches an area of
- * (6 * GALAXY_SECTION_SIZE) * (6 * GALAXY_SECTION_SIZE).
- *
- * @param nav_state A pointer to the current NavigationState object.
- * @param position The point to search for nearest stars.
- * @param stars An array of pointers to stars in which to store the nearest stars.
- *
- * @return Number of stars found.
- */
-int stars_nearest_stars_to_point(const NavigationState *nav_state, Point position, Star *stars[])
-{
-    // Use a local rng
-    pcg32_random_t rng;
-
-    // Density scaling parameter
-    double a = nav_state->current_galaxy->radius * GALAXY_SCALE / 2.0f;
-
-    int index = 0;
-
-    for (double ix = position.x - 6 * GALAXY_SECTION_SIZE; ix <= position.x + 6 * GALAXY_SECTION_SIZE; ix += GALAXY_SECTION_SIZE)
-    {
-        for (double iy = position.y - 6 * GALAXY_SECTION_SIZE; iy <= position.y + 6 * GALAXY_SECTION_SIZE; iy += GALAXY_SECTION_SIZE)
-        {
-            // Check that point is within galaxy radius
-            double distance_from_center = sqrt(ix * ix + iy * iy);
-
-            if (distance_from_center > (nav_state->current_galaxy->radius * GALAXY_SCALE))
-                continue;
-
-            Point p = {ix, iy};
-
-            // Create rng seed by combining x,y values
-            uint64_t seed = maths_hash_position_to_uint64(p);
-
-            // Seed with a fixed constant
-            pcg32_srandom_r(&rng, seed, nav_state->initseq);
-
-            // Calculate density based on distance from center
-            double density = (GALAXY_DENSITY / pow((distance_from_center / a + 1), 6));
-
-            int has_star = abs(pcg32_random_r(&rng)) % 1000 < density;
-
-            if (has_star)
-            {
-                // Create star
-                Star *star = stars_create_star(nav_state, p, false);
-
-                stars[index] = star;
-                index++;
-            }
-        }
-    }
-
-    return index;
-}
 
 /**
  * Determines the planet size class based on its radius.
@@ -1614,6 +2041,8 @@ static int stars_planet_size_class(float radius)
  */
 void stars_populate_body(CelestialBody *body, Point position, pcg32_random_t rng, long double scale)
 {
+    COUNTERS_ADD(COUNTER_POPULATE_CALLS, 1);
+
     if (body->level == LEVEL_STAR && body->initialized == 1)
         return;
 
@@ -1719,6 +2148,9 @@ void stars_populate_body(CelestialBody *body, Point position, pcg32_random_t rng
                     return;
                 }
 
+                if (PROFILER_ON)
+                    trace_count_allocation(sizeof(Planet));
+
                 planet->initialized = i;
                 memset(planet->name, 0, sizeof(planet->name));
                 strcpy(planet->name, body->name);                               // Copy star name to planet name
@@ -1791,7 +2223,6 @@ void stars_populate_body(CelestialBody *body, Point position, pcg32_random_t rng
                                        .h = 0}};
 
                 planet->waypoint_path = NULL;
-                planet->waypoint_points = 0;
 
                 i++;
 
@@ -1900,6 +2331,9 @@ void stars_populate_body(CelestialBody *body, Point position, pcg32_random_t rng
                     return;
                 }
 
+                if (PROFILER_ON)
+                    trace_count_allocation(sizeof(Planet));
+
                 moon->initialized = i;
                 memset(moon->name, 0, sizeof(moon->name));
                 strcpy(moon->name, body->name);                             // Copy planet name to moon name
@@ -1950,7 +2384,6 @@ void stars_populate_body(CelestialBody *body, Point position, pcg32_random_t rng
                                        .h = 0}};
 
                 moon->waypoint_path = NULL;
-                moon->waypoint_points = 0;
 
                 i++;
             }
@@ -1960,6 +2393,453 @@ void stars_populate_body(CelestialBody *body, Point position, pcg32_random_t rng
     }
 }
 
+/**
+ * Populates the star systems of the visible stars in the background, nearest to the cursor first,
+ * up to <STARS_POPULATE_BUDGET> systems at a time, so that a system is ready when its star is hovered
+ * or selected. Systems that are ready are moved to their stars first.
+ * Without worker threads, systems are populated when their star is hovered, as before.
+ *
+ * @param input_state A pointer to the current InputState object.
+ * @param nav_state A pointer to the current NavigationState object.
+ * @param camera A pointer to the current Camera object.
+ * @param state The current state, MAP or UNIVERSE.
+ * @param scale The current scale.
+ *
+ * @return void
+ */
+void stars_populate_visible(const InputState *input_state, NavigationState *nav_state, const Camera *camera, int state, long double scale)
+{
+    if (!is_async || jobs_get_num_workers() == 0)
+        return;
+
+    // Adopt the systems that are ready
+    int num_free = 0;
+
+    for (int i = 0; i < STARS_POPULATE_BUDGET; i++)
+    {
+        if (populations[i] != NULL && jobs_is_handle_done(&populations[i]->handle))
+        {
+            stars_adopt_population(nav_state, populations[i]);
+            stars_release_population(populations[i]);
+            populations[i] = NULL;
+        }
+
+        if (populations[i] == NULL)
+            num_free++;
+    }
+
+    if (num_free == 0)
+        return;
+
+    // Find the visible stars without a system that are nearest to the cursor, by distance on screen
+    Star *nearest[STARS_POPULATE_BUDGET];
+    double distances[STARS_POPULATE_BUDGET];
+    int num_nearest = 0;
+
+    for (int s = 0; s < MAX_STARS; s++)
+    {
+        for (StarEntry *entry = nav_state->stars[s]; entry != NULL; entry = entry->next)
+        {
+            Star *star = entry->star;
+
+            if (star == NULL || star->initialized || strcmp(nav_state->current_galaxy->name, star->galaxy_name) != 0)
+                continue;
+
+            double x, y;
+
+            if (state == UNIVERSE)
+            {
+                x = (nav_state->current_galaxy->position.x - camera->x + star->position.x / GALAXY_SCALE) * scale * GALAXY_SCALE;
+                y = (nav_state->current_galaxy->position.y - camera->y + star->position.y / GALAXY_SCALE) * scale * GALAXY_SCALE;
+            }
+            else
+            {
+                x = (star->position.x - camera->x) * scale;
+                y = (star->position.y - camera->y) * scale;
+            }
+
+            if (x < 0 || x >= camera->w || y < 0 || y >= camera->h)
+                continue;
+
+            double distance = maths_distance_between_points(input_state->mouse_position.x, input_state->mouse_position.y, x, y);
+
+            if (num_nearest == num_free && distance >= distances[num_nearest - 1])
+                continue;
+
+            // Skip the systems that are being populated
+            bool is_started = false;
+
+            for (int i = 0; i < STARS_POPULATE_BUDGET && !is_started; i++)
+                is_started = populations[i] != NULL && strcmp(populations[i]->star->name, star->name) == 0;
+
+            if (is_started)
+                continue;
+
+            // Insert in order of distance, dropping the farthest star if the list is full
+            int j = num_nearest < num_free ? num_nearest++ : num_nearest - 1;
+
+            for (; j > 0 && distances[j - 1] > distance; j--)
+            {
+                nearest[j] = nearest[j - 1];
+                distances[j] = distances[j - 1];
+            }
+
+            nearest[j] = star;
+            distances[j] = distance;
+        }
+    }
+
+    // Start the populations
+    for (int i = 0, n = 0; i < STARS_POPULATE_BUDGET && n < num_nearest; i++)
+    {
+        if (populations[i] != NULL)
+            continue;
+
+        StarsPopulation *population = (StarsPopulation *)calloc(1, sizeof(StarsPopulation));
+
+        if (population == NULL)
+        {
+            fprintf(stderr, "Error: Could not allocate memory for star system population.\n");
+            return;
+        }
+
+        population->star = (Star *)malloc(sizeof(Star));
+
+        if (population->star == NULL)
+        {
+            fprintf(stderr, "Error: Could not allocate memory for star system population.\n");
+            free(population);
+            return;
+        }
+
+        // The job populates a copy, so that the star is not written while it is drawn
+        stars_copy_star(population->star, nearest[n]);
+        population->star->waypoint_path = NULL;
+        population->scale = scale;
+
+        jobs_init_handle(&population->handle);
+        populations[i] = population;
+
+        // Distances on screen run before the prefetches, whose distances are in the galaxy
+        jobs_submit(stars_run_population, population, JOB_TAG_GALAXY, distances[n]);
+        n++;
+    }
+}
+
+/**
+ * Predicts the region shifts of the ship, by extrapolating its velocity up to <STARS_PREFETCH_LOOKAHEAD> seconds.
+ * A shift happens when the ship passes the middle of a section, and the nearest section line changes.
+ *
+ * @param position The position of the ship.
+ * @param vx The horizontal velocity of the ship.
+ * @param vy The vertical velocity of the ship.
+ * @param lines The centers of the regions, starting with the current one. Holds <STARS_PREFETCH_SHIFTS> + 1 points.
+ *
+ * @return The number of centers.
+ */
+static int stars_predict_region_lines(Point position, float vx, float vy, Point lines[])
+{
+    Point line = {.x = maths_get_nearest_section_line(position.x, GALAXY_SECTION_SIZE),
+                  .y = maths_get_nearest_section_line(position.y, GALAXY_SECTION_SIZE)};
+    int num_lines = 0;
+    double time = 0;
+
+    lines[num_lines++] = line;
+
+    while (num_lines <= STARS_PREFETCH_SHIFTS)
+    {
+        // Time until the ship passes the middle of the section in each direction
+        double time_x = INFINITY;
+        double time_y = INFINITY;
+
+        if (vx > 0)
+            time_x = (line.x + GALAXY_SECTION_SIZE / 2 - position.x) / vx;
+        else if (vx < 0)
+            time_x = (line.x - GALAXY_SECTION_SIZE / 2 - position.x) / vx;
+
+        if (vy > 0)
+            time_y = (line.y + GALAXY_SECTION_SIZE / 2 - position.y) / vy;
+        else if (vy < 0)
+            time_y = (line.y - GALAXY_SECTION_SIZE / 2 - position.y) / vy;
+
+        double step = fmax(fmin(time_x, time_y), 0);
+
+        if (time + step > STARS_PREFETCH_LOOKAHEAD)
+            break;
+
+        time += step;
+        position.x += vx * step;
+        position.y += vy * step;
+
+        if (time_x <= time_y)
+            line.x += vx > 0 ? GALAXY_SECTION_SIZE : -GALAXY_SECTION_SIZE;
+
+        if (time_y <= time_x)
+            line.y += vy > 0 ? GALAXY_SECTION_SIZE : -GALAXY_SECTION_SIZE;
+
+        lines[num_lines++] = line;
+    }
+
+    return num_lines;
+}
+
+/**
+ * Generates the regions the ship heads to in the background, so that the frame that shifts
+ * the region only adds their stars. Prefetches the ship no longer heads to are cancelled.
+ *
+ * @param nav_state A pointer to the current NavigationState object.
+ * @param ship A pointer to the Ship object.
+ *
+ * @return void
+ */
+void stars_prefetch_regions(const NavigationState *nav_state, const Ship *ship)
+{
+    if (!is_async)
+        return;
+
+    Point lines[STARS_PREFETCH_SHIFTS + 1];
+    int num_lines = stars_predict_region_lines(nav_state->navigate_offset, ship->vx, ship->vy, lines);
+
+    // Cancel the prefetches for other shifts
+    for (int i = 0; i < STARS_PREFETCH_SHIFTS; i++)
+    {
+        StarsPrefetch *prefetch = prefetches[i];
+
+        if (prefetch == NULL)
+            continue;
+
+        bool is_predicted = false;
+
+        for (int j = 0; j + 1 < num_lines && !is_predicted; j++)
+            is_predicted = maths_points_equal(prefetch->origin, lines[j]) && maths_points_equal(prefetch->target, lines[j + 1]);
+
+        if (!is_predicted || !maths_points_equal(prefetch->galaxy->position, nav_state->current_galaxy->position))
+        {
+            jobs_cancel_handle(&prefetch->handle);
+            stars_release_prefetch(prefetch);
+            prefetches[i] = NULL;
+        }
+    }
+
+    // Start the prefetches for new shifts
+    for (int j = 0; j + 1 < num_lines; j++)
+    {
+        int free_index = -1;
+        bool is_started = false;
+
+        for (int i = 0; i < STARS_PREFETCH_SHIFTS; i++)
+        {
+            if (prefetches[i] == NULL)
+                free_index = free_index < 0 ? i : free_index;
+            else if (maths_points_equal(prefetches[i]->origin, lines[j]) && maths_points_equal(prefetches[i]->target, lines[j + 1]))
+                is_started = true;
+        }
+
+        if (is_started || free_index < 0)
+            continue;
+
+        StarsPrefetch *prefetch = stars_create_prefetch(nav_state->current_galaxy, lines[j], lines[j + 1]);
+
+        if (prefetch == NULL)
+            return;
+
+        prefetches[free_index] = prefetch;
+
+        jobs_submit(stars_run_prefetch, prefetch, JOB_TAG_REGION, jobs_get_priority(prefetch->target, nav_state->navigate_offset, ship->position));
+    }
+}
+
+/**
+ * Releases a reference to a population, and frees it if it was the last one.
+ *
+ * @param population A pointer to the StarsPopulation.
+ *
+ * @return void
+ */
+static void stars_release_population(StarsPopulation *population)
+{
+    if (!jobs_release_handle(&population->handle))
+        return;
+
+    // Planets and moons that were not moved to the star
+    for (int i = 0; i < MAX_PLANETS_MOONS && population->star->planets[i] != NULL; i++)
+    {
+        Planet *planet = population->star->planets[i];
+
+        for (int j = 0; j < MAX_PLANETS_MOONS && planet->planets[j] != NULL; j++)
+            free(planet->planets[j]);
+
+        free(planet);
+    }
+
+    free(population->star);
+    free(population);
+}
+
+/**
+ * Releases a reference to a prefetch, and frees it if it was the last one.
+ *
+ * @param prefetch A pointer to the StarsPrefetch.
+ *
+ * @return void
+ */
+static void stars_release_prefetch(StarsPrefetch *prefetch)
+{
+    if (!jobs_release_handle(&prefetch->handle))
+        return;
+
+    // Stars that were not added to the hash table
+    for (int i = 0; i < prefetch->num_stars; i++)
+        free(prefetch->stars[i]);
+
+    free(prefetch->stars);
+    free(prefetch->galaxy);
+    free(prefetch);
+}
+
+/**
+ * Populates the star system of a copy of a star, with the same rng as when the star is hovered.
+ * Runs on a worker thread of the job system.
+ *
+ * @param data A pointer to the StarsPopulation.
+ *
+ * @return void
+ */
+static void stars_run_population(void *data)
+{
+    StarsPopulation *population = data;
+
+    if (!jobs_is_handle_cancelled(&population->handle))
+    {
+        Point star_position = {.x = population->star->position.x, .y = population->star->position.y};
+
+        // Use a local rng
+        pcg32_random_t rng;
+
+        // Create rng seed by combining x,y values
+        uint64_t seed = maths_hash_position_to_uint64(star_position);
+
+        // Seed with a fixed constant
+        pcg32_srandom_r(&rng, seed, seed);
+        COUNTERS_ADD(COUNTER_SEEDS_STAR_SYSTEMS, 1);
+
+        stars_populate_body(population->star, star_position, rng, population->scale);
+    }
+
+    jobs_finish_handle(&population->handle);
+    stars_release_population(population);
+}
+
+/**
+ * Generates the stars of the sections of a region that are outside the region the ship comes from,
+ * with the same test as stars_generate(). Runs on a worker thread of the job system.
+ *
+ * @param data A pointer to the StarsPrefetch.
+ *
+ * @return void
+ */
+static void stars_run_prefetch(void *data)
+{
+    StarsPrefetch *prefetch = data;
+    Galaxy *galaxy = prefetch->galaxy;
+    double half_size = (GALAXY_REGION_SIZE / 2) * GALAXY_SECTION_SIZE;
+    bool is_cancelled = jobs_is_handle_cancelled(&prefetch->handle);
+
+    // Stars of the origin exist, unless it was too far from the galaxy to be generated
+    bool has_origin = stars_is_region_in_galaxy(galaxy, prefetch->origin.x, prefetch->origin.y);
+
+    if (!is_cancelled && stars_is_region_in_galaxy(galaxy, prefetch->target.x, prefetch->target.y))
+    {
+        prefetch->stars = (Star **)malloc(GALAXY_REGION_SIZE * GALAXY_REGION_SIZE * sizeof(Star *));
+
+        if (prefetch->stars == NULL)
+        {
+            fprintf(stderr, "Error: Could not allocate memory for region prefetch.\n");
+            stars_release_prefetch(prefetch);
+            return;
+        }
+
+        for (double ix = prefetch->target.x - half_size; ix < prefetch->target.x + half_size && !is_cancelled; ix += GALAXY_SECTION_SIZE)
+        {
+            for (double iy = prefetch->target.y - half_size; iy < prefetch->target.y + half_size; iy += GALAXY_SECTION_SIZE)
+            {
+                if (has_origin &&
+                    ix >= prefetch->origin.x - half_size && ix < prefetch->origin.x + half_size &&
+                    iy >= prefetch->origin.y - half_size && iy < prefetch->origin.y + half_size)
+                    continue;
+
+                Point position = {.x = ix, .y = iy};
+
+                if (!stars_section_has_star(position, galaxy, prefetch->initseq))
+                    continue;
+
+                Star *star = stars_create_star(galaxy, prefetch->initseq, position, false);
+
+                if (star != NULL)
+                    prefetch->stars[prefetch->num_stars++] = star;
+            }
+
+            is_cancelled = jobs_is_handle_cancelled(&prefetch->handle);
+        }
+    }
+
+    if (!is_cancelled)
+        jobs_finish_handle(&prefetch->handle);
+
+    stars_release_prefetch(prefetch);
+}
+
+/**
+ * Sets whether regions ahead of the ship and visible star systems are generated on worker threads.
+ * Replays generate them on the calling thread when they are needed instead, so that the stars
+ * of each frame do not depend on the timing of the workers.
+ *
+ * @param async Whether to generate on worker threads.
+ *
+ * @return void
+ */
+void stars_set_async(bool async)
+{
+    is_async = async;
+}
+
+/**
+ * Checks whether a section of a galaxy has a star, without creating it.
+ * Uses the same test as star generation.
+ *
+ * @param position The position of the section.
+ * @param galaxy A pointer to the Galaxy object.
+ * @param initseq The initialization sequence used for the RNG.
+ *
+ * @return True if the section has a star, false otherwise.
+ */
+bool stars_section_has_star(Point position, const Galaxy *galaxy, uint64_t initseq)
+{
+    // Check that point is within galaxy radius
+    double distance_from_center = sqrt(position.x * position.x + position.y * position.y);
+
+    if (distance_from_center > (galaxy->radius * GALAXY_SCALE))
+        return false;
+
+    // Use a local rng
+    pcg32_random_t rng;
+
+    // Create rng seed by combining x,y values
+    uint64_t seed = maths_hash_position_to_uint64(position);
+
+    // Seed with a fixed constant
+    pcg32_srandom_r(&rng, seed, initseq);
+    COUNTERS_ADD(COUNTER_SEEDS_STAR_SECTIONS, 1);
+
+    // Density scaling parameter
+    double a = galaxy->radius * GALAXY_SCALE / 2.0f;
+
+    // Calculate density based on distance from center
+    double density = (GALAXY_DENSITY / pow((distance_from_center / a + 1), 6));
+
+    return abs(pcg32_random_r(&rng)) % 1000 < density;
+}
+
 /**
  * Determine the size class of a star based on its distance.
  *
@@ -2023,6 +2903,9 @@ void stars_update_orbital_positions(GameState *game_state, const InputState *inp
     {
         if (game_state->state == NAVIGATE)
         {
+            // Orbits stay in absolute doubles: in the local frame of the ship, floats would lose
+            // precision for the bodies far from it, and their orbits would drift
+
             // Update body position
             body->position.x += body->parent->dx;
             body->position.y += body->parent->dy;
@@ -2102,6 +2985,7 @@ void stars_update_orbital_positions(GameState *game_state, const InputState *inp
 
                     // Seed with a fixed constant
                     pcg32_srandom_r(&rng, seed, seed);
+                    COUNTERS_ADD(COUNTER_SEEDS_STAR_SYSTEMS, 1);
 
                     stars_populate_body(body, star_position, rng, game_state->game_scale);
                 }
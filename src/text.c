@@ -0,0 +1,295 @@
+/*
+ * text.c
+ */
+
+#include <string.h>
+#include <stdbool.h>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include "../include/constants.h"
+#include "../include/enums.h"
+#include "../include/structs.h"
+#include "../include/text.h"
+
+// External variable definitions
+extern TTF_Font *fonts[];
+
+// Static variable definitions
+static GlyphAtlas atlases[FONT_COUNT];
+static TextLabel labels[TEXT_CACHE_SIZE];
+static unsigned int labels_clock = 0;
+static int indices[6 * TEXT_MAX_LENGTH];
+
+// Static function prototypes
+static Uint32 text_hash(const char *text, unsigned short font_size, SDL_Color);
+static void text_layout_label(TextLabel *, const char *text, unsigned short font_size, SDL_Color);
+
+/**
+ * Creates one glyph atlas per font size. Each Latin-1 character is rendered once in white,
+ * so that labels can be drawn in any color by tinting their vertices.
+ *
+ * @return True if all atlases were created, false otherwise.
+ */
+bool text_create_atlases(void)
+{
+    for (int i = 0; i < TEXT_MAX_LENGTH; i++)
+    {
+        indices[6 * i + 0] = 4 * i + 0;
+        indices[6 * i + 1] = 4 * i + 1;
+        indices[6 * i + 2] = 4 * i + 2;
+        indices[6 * i + 3] = 4 * i + 2;
+        indices[6 * i + 4] = 4 * i + 3;
+        indices[6 * i + 5] = 4 * i + 0;
+    }
+
+    for (int font_size = 0; font_size < FONT_COUNT; font_size++)
+    {
+        GlyphAtlas *atlas = &atlases[font_size];
+        SDL_Surface *glyph_surfaces[TEXT_GLYPH_COUNT];
+        int cell_w = 0;
+        int cell_h = 0;
+
+        // Render glyphs as one-character strings, so that their boxes match TTF_RenderText_Blended
+        for (int j = 0; j < TEXT_GLYPH_COUNT; j++)
+        {
+            char glyph_text[2] = {(char)(TEXT_FIRST_GLYPH + j), '\0'};
+            glyph_surfaces[j] = TTF_RenderText_Blended(fonts[font_size], glyph_text, (SDL_Color){255, 255, 255, 255});
+
+            // Control characters have no glyph
+            if (glyph_surfaces[j] == NULL)
+                glyph_surfaces[j] = TTF_RenderText_Blended(fonts[font_size], "?", (SDL_Color){255, 255, 255, 255});
+
+            if (glyph_surfaces[j] == NULL)
+            {
+                SDL_Log("Could not render glyph: %s\n", SDL_GetError());
+
+                for (int k = 0; k < j; k++)
+                    SDL_FreeSurface(glyph_surfaces[k]);
+
+                return false;
+            }
+
+            cell_w = glyph_surfaces[j]->w > cell_w ? glyph_surfaces[j]->w : cell_w;
+            cell_h = glyph_surfaces[j]->h > cell_h ? glyph_surfaces[j]->h : cell_h;
+        }
+
+        int rows = (TEXT_GLYPH_COUNT + TEXT_ATLAS_COLUMNS - 1) / TEXT_ATLAS_COLUMNS;
+        atlas->w = TEXT_ATLAS_COLUMNS * (cell_w + 1);
+        atlas->h = rows * (cell_h + 1);
+        atlas->height = cell_h;
+
+        SDL_Surface *atlas_surface = SDL_CreateRGBSurfaceWithFormat(0, atlas->w, atlas->h, 32, SDL_PIXELFORMAT_ARGB8888);
+
+        if (atlas_surface == NULL)
+        {
+            SDL_Log("Could not create glyph atlas: %s\n", SDL_GetError());
+
+            for (int j = 0; j < TEXT_GLYPH_COUNT; j++)
+                SDL_FreeSurface(glyph_surfaces[j]);
+
+            return false;
+        }
+
+        for (int j = 0; j < TEXT_GLYPH_COUNT; j++)
+        {
+            // Copy alpha as is instead of blending onto the empty atlas
+            SDL_SetSurfaceBlendMode(glyph_surfaces[j], SDL_BLENDMODE_NONE);
+
+            atlas->glyphs[j].x = (j % TEXT_ATLAS_COLUMNS) * (cell_w + 1);
+            atlas->glyphs[j].y = (j / TEXT_ATLAS_COLUMNS) * (cell_h + 1);
+            atlas->glyphs[j].w = glyph_surfaces[j]->w;
+            atlas->glyphs[j].h = glyph_surfaces[j]->h;
+
+            SDL_BlitSurface(glyph_surfaces[j], NULL, atlas_surface, &atlas->glyphs[j]);
+            SDL_FreeSurface(glyph_surfaces[j]);
+        }
+
+        atlas->texture = render_create_texture_from_surface(atlas_surface);
+        SDL_FreeSurface(atlas_surface);
+
+        if (atlas->texture == NULL)
+        {
+            SDL_Log("Could not create glyph atlas texture: %s\n", SDL_GetError());
+            return false;
+        }
+
+        render_set_texture_blend_mode(atlas->texture, SDL_BLENDMODE_BLEND);
+        COUNTERS_ADD(COUNTER_TEXT_TEXTURES, 1);
+    }
+
+    return true;
+}
+
+/**
+ * Destroys the glyph atlases and empties the label cache.
+ *
+ * @return void
+ */
+void text_destroy_atlases(void)
+{
+    for (int i = 0; i < FONT_COUNT; i++)
+    {
+        if (atlases[i].texture != NULL)
+            SDL_DestroyTexture(atlases[i].texture);
+
+        atlases[i].texture = NULL;
+    }
+
+    for (int i = 0; i < TEXT_CACHE_SIZE; i++)
+        labels[i].in_use = false;
+}
+
+/**
+ * Draws a label with its top-left corner at (x, y), in a single draw call.
+ *
+ * @param label A pointer to the TextLabel to draw.
+ * @param x The x-coordinate of the label.
+ * @param y The y-coordinate of the label.
+ *
+ * @return void
+ */
+void text_draw_label(TextLabel *label, int x, int y)
+{
+    if (label->num_glyphs == 0)
+        return;
+
+    // Vertices keep the last position; Move them only when the label moves
+    if (x != label->x || y != label->y)
+    {
+        float dx = x - label->x;
+        float dy = y - label->y;
+
+        for (int i = 0; i < 4 * label->num_glyphs; i++)
+        {
+            label->vertices[i].position.x += dx;
+            label->vertices[i].position.y += dy;
+        }
+
+        label->x = x;
+        label->y = y;
+    }
+
+    render_geometry(atlases[label->font_size].texture, label->vertices, 4 * label->num_glyphs, indices, 6 * label->num_glyphs);
+}
+
+/**
+ * Returns the cached label for a text, font size and color. The text is laid out
+ * only the first time it is requested, or after it has been evicted from the cache.
+ *
+ * @param text The text of the label.
+ * @param font_size The font size of the label.
+ * @param color The color of the label.
+ *
+ * @return A pointer to the TextLabel. It stays valid until TEXT_CACHE_SIZE other labels have been requested.
+ */
+TextLabel *text_get_label(const char *text, unsigned short font_size, SDL_Color color)
+{
+    Uint32 hash = text_hash(text, font_size, color);
+    TextLabel *label = &labels[0];
+
+    labels_clock++;
+
+    for (int i = 0; i < TEXT_CACHE_SIZE; i++)
+    {
+        if (labels[i].in_use && labels[i].hash == hash &&
+            labels[i].font_size == font_size &&
+            labels[i].color.r == color.r && labels[i].color.g == color.g && labels[i].color.b == color.b && labels[i].color.a == color.a &&
+            strncmp(labels[i].text, text, TEXT_MAX_LENGTH - 1) == 0)
+        {
+            labels[i].last_used = labels_clock;
+            return &labels[i];
+        }
+
+        if (!labels[i].in_use || (label->in_use && labels[i].last_used < label->last_used))
+            label = &labels[i];
+    }
+
+    text_layout_label(label, text, font_size, color);
+    label->hash = hash;
+    label->last_used = labels_clock;
+
+    return label;
+}
+
+/**
+ * Calculates an FNV-1a hash of a label's text, font size and color.
+ *
+ * @param text The text of the label.
+ * @param font_size The font size of the label.
+ * @param color The color of the label.
+ *
+ * @return The hash.
+ */
+static Uint32 text_hash(const char *text, unsigned short font_size, SDL_Color color)
+{
+    Uint32 hash = 2166136261u;
+
+    for (int i = 0; i < TEXT_MAX_LENGTH - 1 && text[i] != '\0'; i++)
+        hash = (hash ^ (Uint8)text[i]) * 16777619u;
+
+    hash = (hash ^ font_size) * 16777619u;
+    hash = (hash ^ ((Uint32)color.r << 24 | (Uint32)color.g << 16 | (Uint32)color.b << 8 | color.a)) * 16777619u;
+
+    return hash;
+}
+
+/**
+ * Builds the quads of a label from the glyph atlas of its font size.
+ * Characters outside the atlas are drawn as '?'. The text is interpreted as Latin-1, like TTF_RenderText_Blended.
+ *
+ * @param label A pointer to the TextLabel to lay out.
+ * @param text The text of the label.
+ * @param font_size The font size of the label.
+ * @param color The color of the label.
+ *
+ * @return void
+ */
+static void text_layout_label(TextLabel *label, const char *text, unsigned short font_size, SDL_Color color)
+{
+    const GlyphAtlas *atlas = &atlases[font_size];
+    int x = 0;
+
+    label->in_use = true;
+    label->font_size = font_size;
+    label->color = color;
+    label->x = 0;
+    label->y = 0;
+    label->num_glyphs = 0;
+
+    strncpy(label->text, text, TEXT_MAX_LENGTH - 1);
+    label->text[TEXT_MAX_LENGTH - 1] = '\0';
+
+    for (int i = 0; label->text[i] != '\0'; i++)
+    {
+        int c = (Uint8)label->text[i];
+
+        if (c < TEXT_FIRST_GLYPH || c > TEXT_LAST_GLYPH)
+            c = '?';
+
+        const SDL_Rect *glyph = &atlas->glyphs[c - TEXT_FIRST_GLYPH];
+
+        // Glyph boxes are as wide as their advance, so quads are placed side by side
+        if (c != ' ')
+        {
+            SDL_Vertex *vertices = &label->vertices[4 * label->num_glyphs];
+            float u1 = (float)glyph->x / atlas->w;
+            float v1 = (float)glyph->y / atlas->h;
+            float u2 = (float)(glyph->x + glyph->w) / atlas->w;
+            float v2 = (float)(glyph->y + glyph->h) / atlas->h;
+
+            vertices[0] = (SDL_Vertex){{x, 0}, color, {u1, v1}};
+            vertices[1] = (SDL_Vertex){{x + glyph->w, 0}, color, {u2, v1}};
+            vertices[2] = (SDL_Vertex){{x + glyph->w, glyph->h}, color, {u2, v2}};
+            vertices[3] = (SDL_Vertex){{x, glyph->h}, color, {u1, v2}};
+
+            label->num_glyphs++;
+        }
+
+        x += glyph->w;
+    }
+
+    label->w = x;
+    label->h = atlas->height;
+}
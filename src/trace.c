@@ -0,0 +1,366 @@
+/*
+ * trace.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include <SDL2/SDL.h>
+
+#include "../include/constants.h"
+#include "../include/enums.h"
+#include "../include/structs.h"
+#include "../include/trace.h"
+
+// Static variable definitions
+static TraceEvent *events = NULL;
+static SDL_atomic_t num_events = {TRACE_MAX_EVENTS}; // Events added to the capture; Further events are dropped once it reaches <TRACE_MAX_EVENTS>, as between captures
+static int num_captured = 0;                          // Events of the capture being written
+static SDL_atomic_t allocated;                        // Bytes allocated in the current frame
+static SDL_SpinLock threads_lock = 0;
+static SDL_threadID thread_ids[TRACE_MAX_THREADS];
+static const char *thread_names[TRACE_MAX_THREADS];
+static int num_threads = 0;
+static SDL_Thread *writer = NULL;
+static char path[256];
+static Uint64 frequency = 0;
+static Uint64 origin = 0;      // Performance counter at the start of the capture
+static Uint64 frame_start = 0; // Performance counter at the end of the previous frame
+static int num_frames = 0;      // Frames in the capture
+static int frames_to_start = 0; // Frames until the capture starts, or 0 if it has started
+static int frames_left = 0;     // Frames left in the capture, or 0 if there is no capture
+
+// Static function prototypes
+static void trace_add_event(char phase, const char *name, Uint64 start, Uint64 duration, int value);
+static void trace_begin_capture(void);
+static void trace_end_capture(void);
+static int trace_write(void *data);
+
+/**
+ * Adds a counter to the capture, such as the bytes allocated in a frame.
+ *
+ * @param name The name of the counter. It must outlive the capture.
+ * @param value The value of the counter.
+ *
+ * @return void
+ */
+void trace_add_counter(const char *name, int value)
+{
+    trace_add_event('C', name, SDL_GetPerformanceCounter(), 0, value);
+}
+
+/**
+ * Adds an event of the current thread to the capture. Any thread can add events;
+ * Each one claims its own slot and marks it as written when it is complete.
+ *
+ * @param phase 'X' for a span, 'i' for an instant or 'C' for a counter.
+ * @param name The name of the event. It must outlive the capture.
+ * @param start The performance counter at the start of the event.
+ * @param duration The duration of a span, in performance counter ticks.
+ * @param value The value of a counter.
+ *
+ * @return void
+ */
+static void trace_add_event(char phase, const char *name, Uint64 start, Uint64 duration, int value)
+{
+    if (!trace_is_capturing())
+        return;
+
+    int index = SDL_AtomicAdd(&num_events, 1);
+
+    if (index >= TRACE_MAX_EVENTS)
+        return;
+
+    TraceEvent *event = &events[index];
+
+    event->phase = phase;
+    event->name = name;
+    event->thread = SDL_ThreadID();
+    event->start = start;
+    event->duration = duration;
+    event->value = value;
+
+    SDL_AtomicSet(&event->is_written, 1);
+}
+
+/**
+ * Adds an instant to the capture, such as a change of game state.
+ *
+ * @param name The name of the instant. It must outlive the capture.
+ *
+ * @return void
+ */
+void trace_add_instant(const char *name)
+{
+    trace_add_event('i', name, SDL_GetPerformanceCounter(), 0, 0);
+}
+
+/**
+ * Adds a span of the current thread to the capture, such as a profiler scope or a job.
+ *
+ * @param name The name of the span. It must outlive the capture.
+ * @param start The performance counter at the start of the span.
+ * @param end The performance counter at the end of the span.
+ *
+ * @return void
+ */
+void trace_add_span(const char *name, Uint64 start, Uint64 end)
+{
+    trace_add_event('X', name, start, end - start, 0);
+}
+
+/**
+ * Starts recording the events of the capture.
+ *
+ * @return void
+ */
+static void trace_begin_capture(void)
+{
+    origin = SDL_GetPerformanceCounter();
+    frame_start = origin;
+    SDL_AtomicSet(&allocated, 0);
+
+    frames_left = num_frames;
+
+    // Adding events is allowed from here on
+    SDL_AtomicSet(&num_events, 0);
+}
+
+/**
+ * Counts memory allocated by generation, which is added to the capture as a counter each frame.
+ *
+ * @param size The number of bytes allocated.
+ *
+ * @return void
+ */
+void trace_count_allocation(size_t size)
+{
+    if (trace_is_capturing())
+        SDL_AtomicAdd(&allocated, (int)size);
+}
+
+/**
+ * Ends a capture that is running and waits for the trace to be written, then frees the events.
+ *
+ * @return void
+ */
+void trace_destroy(void)
+{
+    if (frames_left > 0)
+        trace_end_capture();
+
+    frames_to_start = 0;
+
+    if (writer != NULL)
+    {
+        SDL_WaitThread(writer, NULL);
+        writer = NULL;
+    }
+
+    free(events);
+    events = NULL;
+}
+
+/**
+ * Stops recording events and writes the capture on a background thread,
+ * so that writing does not hold up the frames after the capture.
+ *
+ * @return void
+ */
+static void trace_end_capture(void)
+{
+    // Events added from here on are dropped
+    num_captured = SDL_AtomicSet(&num_events, TRACE_MAX_EVENTS);
+    frames_left = 0;
+
+    writer = SDL_CreateThread(trace_write, "trace", NULL);
+
+    if (writer == NULL)
+        SDL_Log("Could not write trace: %s\n", SDL_GetError());
+}
+
+/**
+ * Ends a frame of the simulation. Adds the frame and the bytes allocated during it to the capture,
+ * and starts or ends the capture at the frames it was requested for.
+ *
+ * @return void
+ */
+void trace_end_frame(void)
+{
+    if (frames_left > 0)
+    {
+        Uint64 frame_end = SDL_GetPerformanceCounter();
+
+        trace_add_span("frame", frame_start, frame_end);
+        trace_add_counter("allocated bytes", SDL_AtomicSet(&allocated, 0));
+        frame_start = frame_end;
+
+        if (--frames_left == 0)
+            trace_end_capture();
+    }
+    else if (frames_to_start > 0 && --frames_to_start == 0)
+        trace_begin_capture();
+}
+
+/**
+ * Checks whether events are being recorded.
+ *
+ * @return True if a capture is running, false otherwise.
+ */
+bool trace_is_capturing(void)
+{
+    return SDL_AtomicGet(&num_events) < TRACE_MAX_EVENTS;
+}
+
+/**
+ * Names the current thread in the traces. Threads that are not named appear by id.
+ *
+ * @param name The name of the thread. It must outlive the traces.
+ *
+ * @return void
+ */
+void trace_name_thread(const char *name)
+{
+    SDL_AtomicLock(&threads_lock);
+
+    if (num_threads < TRACE_MAX_THREADS)
+    {
+        thread_ids[num_threads] = SDL_ThreadID();
+        thread_names[num_threads] = name;
+        num_threads++;
+    }
+
+    SDL_AtomicUnlock(&threads_lock);
+}
+
+/**
+ * Requests a capture of a window of frames, which is written in the Chrome trace event format
+ * once it ends. It can be opened in chrome://tracing or Perfetto.
+ *
+ * @param file_path The path of the trace file, or NULL for a name with the current time.
+ * @param first_frame The number of frames before the capture starts; 0 starts it with the next frame.
+ * @param frames The number of frames to capture.
+ *
+ * @return True if the capture was requested, false if a capture is already running or requested.
+ */
+bool trace_start(const char *file_path, int first_frame, int frames)
+{
+    if (frames_left > 0 || frames_to_start > 0)
+        return false;
+
+    if (first_frame < 0 || frames <= 0)
+    {
+        fprintf(stderr, "Error: Invalid trace frames.\n");
+        return false;
+    }
+
+    // The events of the previous capture are reused once it is written
+    if (writer != NULL)
+    {
+        SDL_WaitThread(writer, NULL);
+        writer = NULL;
+    }
+
+    if (events == NULL)
+    {
+        events = (TraceEvent *)calloc(TRACE_MAX_EVENTS, sizeof(TraceEvent));
+
+        if (events == NULL)
+        {
+            fprintf(stderr, "Error: Could not allocate memory for trace events.\n");
+            return false;
+        }
+    }
+
+    if (file_path != NULL)
+        snprintf(path, sizeof(path), "%s", file_path);
+    else
+        snprintf(path, sizeof(path), "trace-%u.json", SDL_GetTicks());
+
+    frequency = SDL_GetPerformanceFrequency();
+    num_frames = frames;
+
+    if (first_frame == 0)
+        trace_begin_capture();
+    else
+        frames_to_start = first_frame;
+
+    return true;
+}
+
+/**
+ * Writes the events of the capture to the trace file, on a thread of low priority.
+ *
+ * @param data Unused.
+ *
+ * @return 0
+ */
+static int trace_write(void *data)
+{
+    SDL_SetThreadPriority(SDL_THREAD_PRIORITY_LOW);
+
+    int count = num_captured < TRACE_MAX_EVENTS ? num_captured : TRACE_MAX_EVENTS;
+    const char *separator = "";
+    FILE *file = fopen(path, "w");
+
+    if (file == NULL)
+        fprintf(stderr, "Error: Could not open trace file %s.\n", path);
+    else
+    {
+        fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+        SDL_AtomicLock(&threads_lock);
+
+        for (int i = 0; i < num_threads; i++)
+        {
+            fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,\"args\":{\"name\":\"%s\"}}",
+                    separator, (unsigned long)thread_ids[i], thread_names[i]);
+            separator = ",";
+        }
+
+        SDL_AtomicUnlock(&threads_lock);
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        TraceEvent *event = &events[i];
+
+        // Threads that claimed a slot before the capture ended may still be writing it
+        while (!SDL_AtomicGet(&event->is_written))
+            SDL_Delay(1);
+
+        if (file != NULL)
+        {
+            double ts = (double)(Sint64)(event->start - origin) * 1000000 / frequency;
+
+            fprintf(file, "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f",
+                    separator, event->name, event->phase, (unsigned long)event->thread, ts);
+
+            if (event->phase == 'X')
+                fprintf(file, ",\"dur\":%.3f}", (double)event->duration * 1000000 / frequency);
+            else if (event->phase == 'C')
+                fprintf(file, ",\"args\":{\"value\":%d}}", event->value);
+            else
+                fprintf(file, ",\"s\":\"p\"}");
+
+            separator = ",";
+        }
+
+        SDL_AtomicSet(&event->is_written, 0);
+    }
+
+    if (file == NULL)
+        return 0;
+
+    fprintf(file, "\n]}\n");
+    fclose(file);
+
+    printf("Wrote %d trace events to %s\n", count, path);
+
+    if (num_captured > TRACE_MAX_EVENTS)
+        printf("Dropped %d trace events; Raise TRACE_MAX_EVENTS to keep them\n", num_captured - TRACE_MAX_EVENTS);
+
+    return 0;
+}
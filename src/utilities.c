@@ -3,6 +3,7 @@
  */
 
 #include <stdlib.h>
+#include <errno.h>
 #include <stdbool.h>
 
 #include <SDL2/SDL.h>
@@ -107,6 +108,16 @@ void utils_cleanup_resources(GameState *game_state, InputState *input_state, Nav
 
     // Clean up bstars
     free(bstars);
+
+    // Clean up galaxy cloud, disc and background star textures
+    gfx_destroy_galaxy_clouds();
+    gfx_destroy_disc_textures();
+    gfx_destroy_bstars_textures();
+
+    // Clean up point batch, compositor layers and render commands
+    batch_destroy();
+    compositor_destroy();
+    render_destroy();
 }
 
 /**
@@ -123,4 +134,31 @@ void utils_convert_seconds_to_time_string(int seconds, char timeString[])
     int minutes = (seconds % 3600) / 60;
     int secs = seconds % 60;
     sprintf(timeString, "%02d:%02d:%02d", hours, minutes, secs);
+}
+
+/**
+ * Parses a decimal integer, such as the value of a command-line option.
+ *
+ * @param text The text to parse. It must hold the whole number and nothing else.
+ * @param min The smallest valid value.
+ * @param max The largest valid value.
+ * @param value A pointer to the integer to store the value in. It is unchanged if the text is invalid.
+ *
+ * @return True if the text is a number from min to max, false otherwise.
+ */
+bool utils_parse_int(const char *text, int min, int max, int *value)
+{
+    if (text == NULL || *text == '\0')
+        return false;
+
+    char *end;
+    errno = 0;
+    long number = strtol(text, &end, 10);
+
+    if (errno != 0 || *end != '\0' || number < min || number > max)
+        return false;
+
+    *value = (int)number;
+
+    return true;
 }
\ No newline at end of file